@@ -11,6 +11,7 @@
 #include "llvh/Support/MathExtras.h"
 
 #include <array>
+#include <atomic>
 #include <bitset>
 
 namespace hermes {
@@ -136,6 +137,20 @@ class BitArray {
       allBits_[wordIdx] &= ~mask;
   }
 
+  /// Set the bit at \p idx to 1 with an atomic read-modify-write, so that
+  /// threads setting bits in the same word do not lose each other's updates.
+  /// \return true if the bit was 0 before the call.
+  inline bool atomicSet(size_t idx) {
+    static_assert(
+        sizeof(std::atomic<uintptr_t>) == sizeof(uintptr_t),
+        "Words must be usable as atomics");
+    assert(idx < N && "Index must be within the bitset");
+    const uintptr_t mask = 1ULL << (idx % kBitsPerWord);
+    const size_t wordIdx = idx / kBitsPerWord;
+    auto *word = reinterpret_cast<std::atomic<uintptr_t> *>(&allBits_[wordIdx]);
+    return !(word->fetch_or(mask, std::memory_order_relaxed) & mask);
+  }
+
   /// Set all bits to 0.
   inline void reset() {
     std::fill_n(allBits_.begin(), kNumWords, 0);
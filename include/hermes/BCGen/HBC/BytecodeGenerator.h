@@ -216,6 +216,14 @@ class BytecodeFunctionGenerator : public BytecodeInstructionGenerator {
   void
   updateJumpTableOffset(offset_t loc, uint32_t jumpTableOffset, uint32_t cs);
 
+  /// Replace the opcode of each instruction which is immediately followed by
+  /// an instruction it can be fused with by the matching superinstruction.
+  /// Superinstructions have the same size as the instruction they replace,
+  /// so no offsets change. Fused pairs don't overlap.
+  /// Must be called after all jumps have been resolved, and before the jump
+  /// tables are added.
+  void fuseSuperInstructions();
+
   /// Change the opcode of a long jump instruction into a short jump.
   inline void longToShortJump(offset_t loc) {
     switch (opcodes_[loc]) {
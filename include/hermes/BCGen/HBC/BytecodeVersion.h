@@ -19,8 +19,8 @@ namespace hermes {
 namespace hbc {
 
 // Bytecode version generated by this version of the compiler.
-// Updated: Feb 23, 2022
-const static uint32_t BYTECODE_VERSION = 85;
+// Updated: Oct 16, 2026
+const static uint32_t BYTECODE_VERSION = 88;
 
 } // namespace hbc
 } // namespace hermes
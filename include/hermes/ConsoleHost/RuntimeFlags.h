@@ -143,6 +143,33 @@ static opt<bool> Intl(
     init(RuntimeConfig::getDefaultIntl()),
     cat(RuntimeCategory));
 
+static opt<bool> EnableJIT(
+    "Xjit",
+    desc("Compile hot functions to native code (x86-64 Linux only)"),
+    init(RuntimeConfig::getDefaultEnableJIT()),
+    cat(RuntimeCategory));
+
+static opt<bool> ForceJIT(
+    "Xforce-jit",
+    desc("Compile every function to native code on its first call"),
+    init(RuntimeConfig::getDefaultForceJIT()),
+    Hidden,
+    cat(RuntimeCategory));
+
+static opt<bool> RegexAutomaton(
+    "Xregex-automaton",
+    desc("Fall back to a linear-time automaton for regexes which backtrack "
+         "excessively"),
+    init(RuntimeConfig::getDefaultEnableRegexAutomaton()),
+    cat(RuntimeCategory));
+
+static opt<bool> ForceRegexAutomaton(
+    "Xforce-regex-automaton",
+    desc("Match regexes with their automaton whenever they have one"),
+    init(RuntimeConfig::getDefaultForceRegexAutomaton()),
+    Hidden,
+    cat(RuntimeCategory));
+
 static llvh::cl::opt<bool> StopAfterInit(
     "stop-after-module-init",
     llvh::cl::desc("Exit once module loading is finished. Useful "
@@ -13,7 +13,10 @@
 
 namespace hermes {
 
-/// Inline single use functions.
+/// Inline functions into their direct call sites. Functions with a single
+/// call are always inlined, and small functions are also duplicated into
+/// several call sites, within a limit on the growth of each function and of
+/// the module.
 class Inlining : public ModulePass {
  public:
   explicit Inlining() : hermes::ModulePass("Inlining") {}
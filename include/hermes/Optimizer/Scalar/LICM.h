@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_OPTIMIZER_SCALAR_LICM_H
+#define HERMES_OPTIMIZER_SCALAR_LICM_H
+
+#include "hermes/IR/IR.h"
+#include "hermes/Optimizer/PassManager/Pass.h"
+
+namespace hermes {
+
+/// Loop invariant code motion. Discovers the natural loops of a function and,
+/// from the innermost loop outwards, moves the pure computations whose
+/// operands do not change in the loop to its preheader, creating one when
+/// needed. Loads of frame variables which cannot be written while the loop
+/// runs are hoisted as well.
+class LICM : public FunctionPass {
+ public:
+  explicit LICM() : FunctionPass("LICM") {}
+  ~LICM() override = default;
+
+  bool runOnFunction(Function *F) override;
+};
+
+} // namespace hermes
+
+#endif // HERMES_OPTIMIZER_SCALAR_LICM_H
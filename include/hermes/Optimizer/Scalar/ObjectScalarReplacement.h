@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_OPTIMIZER_SCALAR_OBJECTSCALARREPLACEMENT_H
+#define HERMES_OPTIMIZER_SCALAR_OBJECTSCALARREPLACEMENT_H
+
+#include "hermes/IR/IR.h"
+#include "hermes/Optimizer/PassManager/Pass.h"
+
+namespace hermes {
+
+/// Replaces the object literals which don't escape the function, and whose
+/// properties are only read and written by name, with one stack location per
+/// property. Mem2Reg then turns the locations into SSA values, so that both
+/// the allocation and the property accesses disappear.
+class ObjectScalarReplacement : public FunctionPass {
+ public:
+  explicit ObjectScalarReplacement()
+      : FunctionPass("ObjectScalarReplacement") {}
+  ~ObjectScalarReplacement() override = default;
+
+  bool runOnFunction(Function *F) override;
+};
+
+} // namespace hermes
+
+#endif // HERMES_OPTIMIZER_SCALAR_OBJECTSCALARREPLACEMENT_H
@@ -66,6 +66,18 @@ inline uint32_t decodeSurrogatePair(uint32_t hi, uint32_t lo) {
       0x10000;
 }
 
+/// \return the high surrogate encoding the astral code point \p cp.
+inline char16_t highSurrogate(uint32_t cp) {
+  assert(!isMemberOfBMP(cp) && cp <= UNICODE_MAX_VALUE && "Not astral");
+  return ((cp - 0x10000) >> 10) + UTF16_HIGH_SURROGATE;
+}
+
+/// \return the low surrogate encoding the astral code point \p cp.
+inline char16_t lowSurrogate(uint32_t cp) {
+  assert(!isMemberOfBMP(cp) && cp <= UNICODE_MAX_VALUE && "Not astral");
+  return ((cp - 0x10000) & 0x3FF) + UTF16_LOW_SURROGATE;
+}
+
 /// \return true if the codepoint is not ASCII and is a Unicode letter.
 bool isUnicodeOnlyLetter(uint32_t cp);
 /// \return true if the codepoint is not ASCII and is a Unicode space.
@@ -35,6 +35,10 @@ constexpr uint32_t kNotMatched = UINT32_MAX;
 /// The maximum number of times we will backtrack.
 constexpr uint32_t kBacktrackLimit = 1u << 30;
 
+/// The maximum number of times we will backtrack in a regex which also has an
+/// automaton, before switching to the automaton.
+constexpr uint32_t kAutomatonBacktrackLimit = 1u << 16;
+
 /// A CapturedRange represents a range of the input string captured by a capture
 /// group. A CaptureGroup may also not have matched, in which case its start is
 /// set to kNotMatched. Note that an unmatched capture group is different than a
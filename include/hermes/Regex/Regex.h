@@ -97,6 +97,40 @@ class Regex {
     return markedCount_++;
   }
 
+  /// Emit a prefilter into \p bcs describing where matches may start, unless
+  /// it would not rule out any start positions.
+  void emitPrefilter(RegexBytecodeStream &bcs) const {
+    // Regexes anchored at the start are only tried at one position.
+    if (matchConstraints_ & MatchConstraintAnchoredAtStart)
+      return;
+    RegexPrefilter prefilter{};
+    llvh::SmallVector<char16_t, 16> prefix;
+    Node::appendLiteralPrefixForList(nodes_, prefix);
+    if (!prefix.empty()) {
+      prefilter.addFirstCodeUnit(prefix.front());
+      if (prefix.size() > constants::kMaxPrefilterPrefixLength)
+        prefix.resize(constants::kMaxPrefilterPrefixLength);
+    } else if (
+        Node::addFirstCodeUnitsForList(nodes_, prefilter) !=
+            Node::MatchStart::CodeUnits ||
+        prefilter.mayStartWithAnything()) {
+      return;
+    }
+    bcs.emitPrefilter(prefilter, prefix);
+  }
+
+  /// Emit an automaton program into \p bcs, unless the regex uses a feature
+  /// the automaton does not support, like backreferences and lookarounds, or
+  /// the program would be too large.
+  void emitAutomaton(RegexBytecodeStream &bcs) const {
+    uint32_t start = bcs.currentOffset();
+    if (Node::emitAutomatonForList(nodes_, bcs, 0) &&
+        bcs.currentOffset() <= constants::kMaxAutomatonBytecodeSize)
+      bcs.setAutomatonOffset(start);
+    else
+      bcs.truncate(start);
+  }
+
   /// Given that the node \p splicePoint is in our node list, remove all nodes
   /// after it. \return a list of the removed nodes.
   NodeList spliceOut(Node *splicePoint) {
@@ -131,9 +165,13 @@ class Regex {
         markedCount_,
         static_cast<uint16_t>(loopCount_),
         flags_.toByte(),
-        matchConstraints_};
+        matchConstraints_,
+        0,
+        0};
     RegexBytecodeStream bcs(header);
     Node::compile(nodes_, bcs);
+    emitPrefilter(bcs);
+    emitAutomaton(bcs);
     return bcs.acquireBytecode();
   }
 
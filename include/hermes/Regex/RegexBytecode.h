@@ -8,6 +8,7 @@
 #ifndef HERMES_REGEX_REGEXBYTECODE_H
 #define HERMES_REGEX_REGEXBYTECODE_H
 
+#include "llvh/ADT/ArrayRef.h"
 #include "llvh/ADT/DenseMap.h"
 #include "llvh/Support/Casting.h"
 
@@ -256,6 +257,14 @@ struct Width1LoopInsn : public Insn {
   JumpTarget32 notTakenTarget;
 };
 
+/// An instruction which resets the marked subexpressions [mexpBegin, mexpEnd)
+/// to unmatched, at the start of each iteration of a loop. It only appears in
+/// automaton programs, where loops are unrolled and have no BeginLoopInsn.
+struct ClearCapturesInsn : public Insn {
+  uint16_t mexpBegin;
+  uint16_t mexpEnd;
+};
+
 /// A header that appears at the beginning of a bytecode stream.
 struct RegexBytecodeHeader {
   /// Number of capture groups.
@@ -269,6 +278,68 @@ struct RegexBytecodeHeader {
 
   /// Constraints on what strings can match this regex.
   MatchConstraintSet constraints;
+
+  /// Offset of the RegexPrefilter following the instructions, relative to the
+  /// end of the header like jump targets, or 0 if there is none.
+  uint32_t prefilterOffset;
+
+  /// Offset of the automaton program, which follows the instructions and any
+  /// prefilter and runs until the end of the bytecode, or 0 if there is none.
+  /// It is relative to the end of the header like jump targets, and so are
+  /// the jump targets within it.
+  uint32_t automatonOffset;
+};
+
+/// Describes where a match of a regex may start, so that the executor can skip
+/// positions at which the regex cannot match without running any instructions.
+/// It is emitted after the last instruction and is followed by prefixLength
+/// char16_t code units. Every match consumes at least one code unit.
+struct RegexPrefilter {
+  /// For each code unit c below 256, bit (c % 8) of firstCodeUnits[c / 8] is
+  /// set if a match may start with c.
+  uint8_t firstCodeUnits[32];
+
+  /// Whether a match may start with a code unit of 256 or above.
+  bool firstCodeUnitsAboveLatin1;
+
+  /// Number of code units which every match starts with. May be 0, in which
+  /// case only firstCodeUnits is known.
+  uint8_t prefixLength;
+
+  /// Add \p cu to the code units a match may start with.
+  void addFirstCodeUnit(uint32_t cu) {
+    if (cu < 256)
+      firstCodeUnits[cu / 8] |= 1 << (cu % 8);
+    else
+      firstCodeUnitsAboveLatin1 = true;
+  }
+
+  /// Add the inclusive range [\p first, \p last] to the code units a match
+  /// may start with.
+  void addFirstCodeUnitRange(uint32_t first, uint32_t last) {
+    for (uint32_t cu = first; cu <= last && cu < 256; ++cu)
+      addFirstCodeUnit(cu);
+    if (last >= 256)
+      firstCodeUnitsAboveLatin1 = true;
+  }
+
+  /// \return whether a match may start with the code unit \p cu.
+  bool mayStartWith(uint32_t cu) const {
+    if (cu < 256)
+      return firstCodeUnits[cu / 8] & (1 << (cu % 8));
+    return firstCodeUnitsAboveLatin1;
+  }
+
+  /// \return whether a match may start with any code unit, so that the
+  /// prefilter rules nothing out.
+  bool mayStartWithAnything() const {
+    if (!firstCodeUnitsAboveLatin1)
+      return false;
+    for (uint8_t bits : firstCodeUnits)
+      if (bits != 0xFF)
+        return false;
+    return true;
+  }
 };
 
 LLVM_PACKED_END;
@@ -340,6 +411,40 @@ class RegexBytecodeStream {
     return bytes_.size() - sizeof(RegexBytecodeHeader);
   }
 
+  /// Emit \p prefilter followed by the code units of \p prefix, which must
+  /// come after the last instruction, and point the header at it.
+  void emitPrefilter(
+      RegexPrefilter prefilter,
+      llvh::ArrayRef<char16_t> prefix) {
+    assert(prefix.size() <= UINT8_MAX && "Prefix too long");
+    prefilter.prefixLength = prefix.size();
+    reinterpret_cast<RegexBytecodeHeader *>(bytes_.data())->prefilterOffset =
+        currentOffset();
+    const uint8_t *prefilterBytes =
+        reinterpret_cast<const uint8_t *>(&prefilter);
+    bytes_.insert(
+        bytes_.end(), prefilterBytes, prefilterBytes + sizeof(prefilter));
+    const uint8_t *prefixBytes =
+        reinterpret_cast<const uint8_t *>(prefix.data());
+    bytes_.insert(
+        bytes_.end(),
+        prefixBytes,
+        prefixBytes + prefix.size() * sizeof(char16_t));
+  }
+
+  /// Point the header at the automaton program starting at \p offset, which
+  /// runs until the end of the bytecode.
+  void setAutomatonOffset(uint32_t offset) {
+    reinterpret_cast<RegexBytecodeHeader *>(bytes_.data())->automatonOffset =
+        offset;
+  }
+
+  /// Discard everything emitted at or after \p offset.
+  void truncate(uint32_t offset) {
+    assert(offset <= currentOffset() && "Truncating past the end");
+    bytes_.resize(sizeof(RegexBytecodeHeader) + offset);
+  }
+
   /// \return the bytecode, transferring ownership of it to the caller.
   std::vector<uint8_t> acquireBytecode() {
     assert(!acquired_ && "Bytecode already acquired");
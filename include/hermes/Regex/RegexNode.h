@@ -56,6 +56,18 @@ class Node {
   using CodePoint = uint32_t;
   using CodePointList = llvh::SmallVector<CodePoint, 5>;
 
+  /// How the matches of a node begin, as reported by addFirstCodeUnits().
+  enum class MatchStart {
+    /// The node never consumes any input.
+    Empty,
+    /// Every match of the node starts with one of the code units that were
+    /// added to the prefilter.
+    CodeUnits,
+    /// Nothing is known about how matches start, including whether they
+    /// consume any input.
+    Unknown,
+  };
+
   /// Default constructor and destructor.
   Node() = default;
   virtual ~Node() = default;
@@ -82,6 +94,51 @@ class Node {
     return result;
   }
 
+  /// Append to \p prefix the code units which every match of the list of
+  /// nodes \p nodes starts with.
+  /// \return whether every match of the list consists of exactly those code
+  /// units.
+  static bool appendLiteralPrefixForList(
+      const NodeList &nodes,
+      llvh::SmallVectorImpl<char16_t> &prefix) {
+    for (const auto &node : nodes) {
+      if (!node->appendLiteralPrefix(prefix))
+        return false;
+    }
+    return true;
+  }
+
+  /// Add the code units which matches of the list of nodes \p nodes may start
+  /// with to \p prefilter, skipping over nodes which never consume input.
+  static MatchStart addFirstCodeUnitsForList(
+      const NodeList &nodes,
+      RegexPrefilter &prefilter) {
+    for (const auto &node : nodes) {
+      MatchStart start = node->addFirstCodeUnits(prefilter);
+      if (start != MatchStart::Empty)
+        return start;
+    }
+    return MatchStart::Empty;
+  }
+
+  /// Emit the list of nodes \p nodes, nested \p depth levels deep, to the
+  /// automaton program in \p bcs.
+  /// \return false if the automaton cannot run the list, in which case part of
+  /// it may have been emitted.
+  static bool emitAutomatonForList(
+      const NodeList &nodes,
+      RegexBytecodeStream &bcs,
+      uint32_t depth) {
+    if (depth > constants::kMaxAutomatonDepth)
+      return false;
+    for (Node *node : nodes) {
+      if (bcs.currentOffset() > constants::kMaxAutomatonBytecodeSize ||
+          !node->emitAutomaton(bcs, depth))
+        return false;
+    }
+    return true;
+  }
+
   /// Reverse the order of the node list \p nodes, and recursively ask each node
   /// to reverse the order of its children.
   inline static void reverseNodeList(NodeList &nodes);
@@ -111,6 +168,35 @@ class Node {
     return 0;
   }
 
+  /// Append to \p prefix the code units which every match of this node starts
+  /// with.
+  /// \return whether every match of this node consists of exactly those code
+  /// units, so that the nodes after it may extend the prefix. The default is
+  /// for nodes which never consume any input.
+  virtual bool appendLiteralPrefix(
+      llvh::SmallVectorImpl<char16_t> &prefix) const {
+    return true;
+  }
+
+  /// Add the code units which matches of this node may start with to
+  /// \p prefilter. The default is for nodes which never consume any input.
+  virtual MatchStart addFirstCodeUnits(RegexPrefilter &prefilter) const {
+    return MatchStart::Empty;
+  }
+
+  /// Emit this node, nested \p depth levels deep, to the automaton program in
+  /// \p bcs. Every instruction in that program matches exactly one character
+  /// or none, and loops are unrolled.
+  /// \return false if the automaton cannot run this node.
+  /// The default emits the same instructions as emitStep(), which is right for
+  /// assertions and for nodes that match a single character.
+  virtual bool emitAutomaton(RegexBytecodeStream &bcs, uint32_t depth) {
+    NodeList *children = emitStep(bcs);
+    assert(!children && "Nodes with children must override emitAutomaton");
+    (void)children;
+    return true;
+  }
+
   /// \return whether this is a goal node.
   virtual bool isGoal() const {
     return false;
@@ -226,6 +312,65 @@ class LoopNode final : public Node {
     return {&loopee_};
   }
 
+  /// A loop which must execute at least once starts like its loopee, but may
+  /// then repeat or stop anywhere.
+  bool appendLiteralPrefix(
+      llvh::SmallVectorImpl<char16_t> &prefix) const override {
+    if (min_ > 0)
+      appendLiteralPrefixForList(loopee_, prefix);
+    return false;
+  }
+
+  MatchStart addFirstCodeUnits(RegexPrefilter &prefilter) const override {
+    if (min_ == 0)
+      return MatchStart::Unknown;
+    MatchStart start = addFirstCodeUnitsForList(loopee_, prefilter);
+    return start == MatchStart::CodeUnits ? start : MatchStart::Unknown;
+  }
+
+  /// The automaton has no loop counters, so the loopee is repeated min_ times,
+  /// followed by either a loop or max_ - min_ optional repetitions. Optional
+  /// iterations which match the empty string must fail (see RepeatMatcher in
+  /// ES2022 22.2.2.3.1), which the automaton cannot check, so they are only
+  /// supported for loopees which never match the empty string.
+  bool emitAutomaton(RegexBytecodeStream &bcs, uint32_t depth) override {
+    if (max_ > min_ && !(loopeeConstraints_ & MatchConstraintNonEmpty))
+      return false;
+    for (uint32_t i = 0; i < min_; i++) {
+      if (!emitAutomatonIteration(bcs, depth))
+        return false;
+    }
+    if (max_ == min_)
+      return true;
+
+    // Each optional iteration starts with an alternation whose primary branch
+    // enters the loopee if we are greedy, and exits the loop otherwise.
+    bool unbounded = max_ == std::numeric_limits<uint32_t>::max();
+    uint32_t optionalCount = unbounded ? 1 : max_ - min_;
+    std::vector<RegexBytecodeStream::InstructionWrapper<AlternationInsn>>
+        greedyExits;
+    std::vector<RegexBytecodeStream::InstructionWrapper<Jump32Insn>> exits;
+    for (uint32_t i = 0; i < optionalCount; i++) {
+      uint32_t iterationStart = bcs.currentOffset();
+      auto altInsn = bcs.emit<AlternationInsn>();
+      if (greedy_) {
+        greedyExits.push_back(altInsn);
+      } else {
+        exits.push_back(bcs.emit<Jump32Insn>());
+        altInsn->secondaryBranch = bcs.currentOffset();
+      }
+      if (!emitAutomatonIteration(bcs, depth))
+        return false;
+      if (unbounded)
+        bcs.emit<Jump32Insn>()->target = iterationStart;
+    }
+    for (auto &altInsn : greedyExits)
+      altInsn->secondaryBranch = bcs.currentOffset();
+    for (auto &jump : exits)
+      jump->target = bcs.currentOffset();
+    return true;
+  }
+
  protected:
   void reverseChildren() override {
     reverseNodeList(loopee_);
@@ -281,6 +426,18 @@ class LoopNode final : public Node {
     return nullptr;
   }
 
+  /// Emit one iteration of the loop to the automaton program in \p bcs,
+  /// resetting the capture groups it contains first.
+  /// \return false if the automaton cannot run the loopee.
+  bool emitAutomatonIteration(RegexBytecodeStream &bcs, uint32_t depth) {
+    if (mexpBegin_ != mexpEnd_) {
+      auto clearInsn = bcs.emit<ClearCapturesInsn>();
+      clearInsn->mexpBegin = mexpBegin_;
+      clearInsn->mexpEnd = mexpEnd_;
+    }
+    return emitAutomatonForList(loopee_, bcs, depth + 1);
+  }
+
   // Checks if the loopee always matches exactly one character so that we can
   /// make this a width 1 loop. See BeginWidth1LoopInsn in RegexBytecode.h.
   bool isWidth1Loop() const {
@@ -353,6 +510,22 @@ class AlternationNode final : public Node {
     return restConstraints_.front() | Super::matchConstraints();
   }
 
+  bool appendLiteralPrefix(
+      llvh::SmallVectorImpl<char16_t> &prefix) const override {
+    return false;
+  }
+
+  /// An alternation starts with the union of what its alternatives start
+  /// with, provided that none of them can match without consuming input.
+  MatchStart addFirstCodeUnits(RegexPrefilter &prefilter) const override {
+    for (const NodeList &alternative : alternatives_) {
+      if (addFirstCodeUnitsForList(alternative, prefilter) !=
+          MatchStart::CodeUnits)
+        return MatchStart::Unknown;
+    }
+    return MatchStart::CodeUnits;
+  }
+
   virtual llvh::SmallVector<NodeList *, 1> getChildren() override {
     llvh::SmallVector<NodeList *, 1> ret;
     ret.reserve(alternatives_.size());
@@ -368,6 +541,26 @@ class AlternationNode final : public Node {
     }
   }
 
+  /// The automaton program has the same layout as the bytecode, see
+  /// emitStep().
+  bool emitAutomaton(RegexBytecodeStream &bcs, uint32_t depth) override {
+    std::vector<RegexBytecodeStream::InstructionWrapper<Jump32Insn>> jumps;
+    for (size_t i = 0; i + 1 < alternatives_.size(); i++) {
+      auto altInsn = bcs.emit<AlternationInsn>();
+      altInsn->primaryConstraints = elementConstraints_[i];
+      altInsn->secondaryConstraints = restConstraints_[i + 1];
+      if (!emitAutomatonForList(alternatives_[i], bcs, depth + 1))
+        return false;
+      jumps.push_back(bcs.emit<Jump32Insn>());
+      altInsn->secondaryBranch = bcs.currentOffset();
+    }
+    if (!emitAutomatonForList(alternatives_.back(), bcs, depth + 1))
+      return false;
+    for (auto &jump : jumps)
+      jump->target = bcs.currentOffset();
+    return true;
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     // Instruction stream looks like:
@@ -444,6 +637,23 @@ class MarkedSubexpressionNode final : public Node {
     return {&contents_};
   }
 
+  bool appendLiteralPrefix(
+      llvh::SmallVectorImpl<char16_t> &prefix) const override {
+    return appendLiteralPrefixForList(contents_, prefix);
+  }
+
+  MatchStart addFirstCodeUnits(RegexPrefilter &prefilter) const override {
+    return addFirstCodeUnitsForList(contents_, prefilter);
+  }
+
+  bool emitAutomaton(RegexBytecodeStream &bcs, uint32_t depth) override {
+    bcs.emit<BeginMarkedSubexpressionInsn>()->mexp = mexp_;
+    if (!emitAutomatonForList(contents_, bcs, depth + 1))
+      return false;
+    bcs.emit<EndMarkedSubexpressionInsn>()->mexp = mexp_;
+    return true;
+  }
+
   virtual MatchConstraintSet matchConstraints() const override {
     return contentsConstraints_ | Super::matchConstraints();
   }
@@ -469,6 +679,23 @@ class BackRefNode final : public Node {
  public:
   explicit BackRefNode(unsigned mexp) : mexp_(mexp) {}
 
+  /// A backreference may match anything, including nothing if its group did
+  /// not participate.
+  bool appendLiteralPrefix(
+      llvh::SmallVectorImpl<char16_t> &prefix) const override {
+    return false;
+  }
+
+  MatchStart addFirstCodeUnits(RegexPrefilter &prefilter) const override {
+    return MatchStart::Unknown;
+  }
+
+  /// What a backreference matches depends on the captures of the thread, so
+  /// it cannot be part of an automaton.
+  bool emitAutomaton(RegexBytecodeStream &bcs, uint32_t depth) override {
+    return false;
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     bcs.emit<BackRefInsn>()->mexp = mexp_;
@@ -557,6 +784,15 @@ class MatchAnyNode final : public Node {
     return !unicode_;
   }
 
+  bool appendLiteralPrefix(
+      llvh::SmallVectorImpl<char16_t> &prefix) const override {
+    return false;
+  }
+
+  MatchStart addFirstCodeUnits(RegexPrefilter &prefilter) const override {
+    return MatchStart::Unknown;
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     if (unicode_) {
@@ -622,6 +858,55 @@ class MatchCharNode final : public Node {
     return true;
   }
 
+  bool appendLiteralPrefix(
+      llvh::SmallVectorImpl<char16_t> &prefix) const override {
+    if (icase_)
+      return false;
+    for (CodePoint c : chars_) {
+      if (isMemberOfBMP(c)) {
+        prefix.push_back(c);
+      } else {
+        prefix.push_back(highSurrogate(c));
+        prefix.push_back(lowSurrogate(c));
+      }
+    }
+    return true;
+  }
+
+  MatchStart addFirstCodeUnits(RegexPrefilter &prefilter) const override {
+    if (chars_.empty())
+      return MatchStart::Empty;
+    CodePoint c = chars_.front();
+    if (!icase_) {
+      prefilter.addFirstCodeUnit(isMemberOfBMP(c) ? c : highSurrogate(c));
+      return MatchStart::CodeUnits;
+    }
+    // Only ASCII characters canonicalize to ASCII characters, except for a
+    // few characters above Latin-1 with the unicode flag (like the Kelvin sign
+    // for 'k'). Leave other case-insensitive characters alone.
+    if (!isASCII(c))
+      return MatchStart::Unknown;
+    prefilter.addFirstCodeUnit(c);
+    if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z'))
+      prefilter.addFirstCodeUnit(c ^ 0x20);
+    if (unicode_)
+      prefilter.firstCodeUnitsAboveLatin1 = true;
+    return MatchStart::CodeUnits;
+  }
+
+  /// The automaton matches one character per instruction, so emit each
+  /// character on its own rather than as MatchNChar8 runs.
+  bool emitAutomaton(RegexBytecodeStream &bcs, uint32_t depth) override {
+    for (const CodePoint &c : chars_) {
+      llvh::ArrayRef<CodePoint> single{c};
+      if (isASCII(c))
+        emitASCIIList(single, bcs);
+      else
+        emitNonASCIIList(single, bcs);
+    }
+    return true;
+  }
+
   /// \return whether matching the code point \p cp may require
   /// decoding a surrogate pair from the input string.
   bool mayRequireDecodingSurrogatePair(uint32_t cp) const {
@@ -839,6 +1124,46 @@ class BracketNode : public Node {
     return !unicode_;
   }
 
+  bool appendLiteralPrefix(
+      llvh::SmallVectorImpl<char16_t> &prefix) const override {
+    return false;
+  }
+
+  MatchStart addFirstCodeUnits(RegexPrefilter &prefilter) const override {
+    if (negate_)
+      return MatchStart::Unknown;
+    for (CharacterClass cc : classes_) {
+      if (cc.inverted_)
+        return MatchStart::Unknown;
+      switch (cc.type_) {
+        case CharacterClass::Digits:
+          prefilter.addFirstCodeUnitRange('0', '9');
+          break;
+        case CharacterClass::Words:
+          prefilter.addFirstCodeUnitRange('0', '9');
+          prefilter.addFirstCodeUnitRange('A', 'Z');
+          prefilter.addFirstCodeUnitRange('a', 'z');
+          prefilter.addFirstCodeUnit('_');
+          break;
+        case CharacterClass::Spaces:
+          prefilter.addFirstCodeUnitRange('\t', '\r');
+          prefilter.addFirstCodeUnit(' ');
+          prefilter.addFirstCodeUnit(0xA0);
+          prefilter.firstCodeUnitsAboveLatin1 = true;
+          break;
+      }
+    }
+    // Astral code points start with a high surrogate, which is above Latin-1
+    // like the rest of the range.
+    CodePointSet cps = icase_
+        ? makeCanonicallyEquivalent(codePointSet_, unicode_)
+        : codePointSet_;
+    for (const CodePointRange &range : cps.ranges())
+      prefilter.addFirstCodeUnitRange(
+          range.first, range.first + range.length - 1);
+    return MatchStart::CodeUnits;
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     if (unicode_) {
@@ -912,6 +1237,12 @@ class LookaroundNode : public Node {
     return {&exp_};
   }
 
+  /// The automaton only moves forwards through the input and cannot run an
+  /// assertion on the side.
+  bool emitAutomaton(RegexBytecodeStream &bcs, uint32_t depth) override {
+    return false;
+  }
+
  private:
   // Override emitStep() to compile our lookahead expression.
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
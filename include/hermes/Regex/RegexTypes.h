@@ -42,6 +42,13 @@ enum MatchFlagType {
 
   /// Do not search for a match past the search start location.
   matchOnlyAtStart = 1 << 3,
+
+  /// Never use the automaton, even when the regex has one.
+  matchNoAutomaton = 1 << 4,
+
+  /// Use the automaton right away when the regex has one, instead of only
+  /// once backtracking becomes excessive.
+  matchForceAutomaton = 1 << 5,
 };
 
 inline constexpr MatchFlagType operator~(MatchFlagType x) {
@@ -152,6 +159,19 @@ constexpr uint16_t kMaxCaptureGroupCount = 65535;
 /// Maximum number of supported loops.
 constexpr uint16_t kMaxLoopCount = 65535;
 
+/// Maximum number of literal prefix code units stored in a prefilter. Longer
+/// prefixes are truncated, which only makes the prefilter less selective.
+constexpr uint8_t kMaxPrefilterPrefixLength = 32;
+
+/// Maximum size of the bytecode of a regex, including its automaton program,
+/// for which an automaton program is emitted. Counted loops are unrolled in
+/// the automaton program, so this mostly limits those.
+constexpr uint32_t kMaxAutomatonBytecodeSize = 1u << 16;
+
+/// Maximum nesting depth of groups, loops and alternations for which an
+/// automaton program is emitted.
+constexpr uint32_t kMaxAutomatonDepth = 128;
+
 } // namespace constants
 
 /// After compiling a regex, there are certain properties we can test for that
@@ -8,8 +8,49 @@
 #ifndef HERMES_SUPPORT_JSON_H
 #define HERMES_SUPPORT_JSON_H
 
+#include <cassert>
+
 namespace hermes {
 
+/// Appends the escaped form of \p ch, which must be a backslash, a double
+/// quote or a character below U+0020, to \p output.
+template <typename Output>
+void escapeCharForJSON(Output &output, char16_t ch) {
+#define ESCAPE(ch, replace)    \
+  case ch:                     \
+    output.push_back(u'\\');   \
+    output.push_back(replace); \
+    break
+
+  switch (ch) {
+    // Quote.2.a.
+    ESCAPE(u'\\', u'\\');
+    ESCAPE(u'"', u'"');
+    // Quote.2.b.
+    ESCAPE(u'\b', u'b');
+    ESCAPE(u'\f', u'f');
+    ESCAPE(u'\n', u'n');
+    ESCAPE(u'\r', u'r');
+    ESCAPE(u'\t', u't');
+    default:
+      assert(ch < u' ' && "character does not need escaping");
+      // Quote.2.c.
+      output.append({u'\\', u'u', u'0', u'0'});
+      output.push_back(u'0' + (ch / 16));
+      if (ch % 16 < 10) {
+        output.push_back(u'0' + (ch % 16));
+      } else {
+        output.push_back(u'a' + (ch % 16 - 10));
+      }
+  }
+#undef ESCAPE
+}
+
+/// \return whether \p ch must be escaped in a JSON string.
+inline bool needsEscapeForJSON(char16_t ch) {
+  return ch < u' ' || ch == u'"' || ch == u'\\';
+}
+
 /// Quotes a string given by \p view and puts the quoted version into \p output.
 /// \p view should be utf16-encoded, and \p output will be as well.
 /// \post output is a container that has a sequential list of utf16 characters
@@ -20,36 +61,11 @@ void quoteStringForJSON(Output &output, StringView view) {
   output.push_back(u'"');
   // Quote.2.
   for (char16_t ch : view) {
-#define ESCAPE(ch, replace)    \
-  case ch:                     \
-    output.push_back(u'\\');   \
-    output.push_back(replace); \
-    break
-
-    switch (ch) {
-      // Quote.2.a.
-      ESCAPE(u'\\', u'\\');
-      ESCAPE(u'"', u'"');
-      // Quote.2.b.
-      ESCAPE(u'\b', u'b');
-      ESCAPE(u'\f', u'f');
-      ESCAPE(u'\n', u'n');
-      ESCAPE(u'\r', u'r');
-      ESCAPE(u'\t', u't');
-      default:
-        if (ch < u' ') {
-          // Quote.2.c.
-          output.append({u'\\', u'u', u'0', u'0'});
-          output.push_back(u'0' + (ch / 16));
-          if (ch % 16 < 10) {
-            output.push_back(u'0' + (ch % 16));
-          } else {
-            output.push_back(u'a' + (ch % 16 - 10));
-          }
-        } else {
-          // Quote.2.d.
-          output.push_back(ch);
-        }
+    if (needsEscapeForJSON(ch)) {
+      escapeCharForJSON(output, ch);
+    } else {
+      // Quote.2.d.
+      output.push_back(ch);
     }
   }
   // Quote.3.
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_SUPPORT_STRINGSEARCH_H
+#define HERMES_SUPPORT_STRINGSEARCH_H
+
+#include "llvh/ADT/ArrayRef.h"
+#include "llvh/ADT/Optional.h"
+
+namespace hermes {
+
+/// Find the first occurrence of \p needle in \p haystack, comparing code units.
+/// ASCII and UTF-16 strings may be mixed.
+///
+/// Short needles are found by scanning the haystack for positions where both
+/// the first and last characters of the needle match, several positions at a
+/// time with SIMD instructions where they are available (SSE2 or AVX2 on
+/// x86-64, NEON on AArch64), and comparing the rest of the needle only there.
+/// Long needles use Boyer-Moore-Horspool, which skips ahead by up to the
+/// length of the needle.
+///
+/// \return the index of the first match, or None if there is none. An empty
+///   needle matches at index 0.
+llvh::Optional<size_t> searchString(
+    llvh::ArrayRef<char> haystack,
+    llvh::ArrayRef<char> needle);
+llvh::Optional<size_t> searchString(
+    llvh::ArrayRef<char> haystack,
+    llvh::ArrayRef<char16_t> needle);
+llvh::Optional<size_t> searchString(
+    llvh::ArrayRef<char16_t> haystack,
+    llvh::ArrayRef<char> needle);
+llvh::Optional<size_t> searchString(
+    llvh::ArrayRef<char16_t> haystack,
+    llvh::ArrayRef<char16_t> needle);
+
+} // namespace hermes
+
+#endif // HERMES_SUPPORT_STRINGSEARCH_H
@@ -59,6 +59,22 @@ class UTF16Stream {
     return *this;
   }
 
+  /// Returns the UTF16 units which are available from the current stream
+  /// position without converting more input, so that they can be scanned in
+  /// bulk.
+  /// \pre hasChar returns true, which guarantees that the result is not empty.
+  llvh::ArrayRef<char16_t> available() const {
+    assert(cur_ != end_ && "must check hasChar");
+    return llvh::ArrayRef<char16_t>(cur_, end_);
+  }
+
+  /// Advances the stream by \p count UTF16 units.
+  /// \pre count <= available().size().
+  void skip(size_t count) {
+    assert(count <= static_cast<size_t>(end_ - cur_) && "skipping too far");
+    cur_ += count;
+  }
+
  private:
   /// Tries to convert more data. Returns true if more data was converted.
   bool refill();
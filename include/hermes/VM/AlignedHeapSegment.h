@@ -176,6 +176,10 @@ class AlignedHeapSegment {
   /// Mark the given \p cell.  Assumes the given address is a valid heap object.
   inline static void setCellMarkBit(const GCCell *cell);
 
+  /// Same as \c setCellMarkBit, but safe to call from several threads at
+  /// once. \return true if the cell was not already marked.
+  inline static bool atomicSetCellMarkBit(const GCCell *cell);
+
   /// Return whether the given \p cell is marked.  Assumes the given address is
   /// a valid heap object.
   inline static bool getCellMarkBit(const GCCell *cell);
@@ -394,6 +398,13 @@ void AlignedHeapSegment::setCellMarkBit(const GCCell *cell) {
   markBits->mark(ind);
 }
 
+/*static*/
+bool AlignedHeapSegment::atomicSetCellMarkBit(const GCCell *cell) {
+  MarkBitArrayNC *markBits = markBitArrayCovering(cell);
+  size_t ind = markBits->addressToIndex(cell);
+  return markBits->atomicMark(ind);
+}
+
 /*static*/
 bool AlignedHeapSegment::getCellMarkBit(const GCCell *cell) {
   MarkBitArrayNC *markBits = markBitArrayCovering(cell);
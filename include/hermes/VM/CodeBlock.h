@@ -14,6 +14,7 @@
 #include "hermes/Support/SourceErrorManager.h"
 #include "hermes/VM/HermesValue.h"
 #include "hermes/VM/IdentifierTable.h"
+#include "hermes/VM/JIT/Config.h"
 #include "hermes/VM/Profiler.h"
 #include "hermes/VM/PropertyCache.h"
 #include "hermes/VM/SerializedLiteralParser.h"
@@ -29,9 +30,18 @@ namespace vm {
 
 class RuntimeModule;
 class CodeBlock;
-
-/// A pointer to JIT-compiled function.
-typedef CallResult<HermesValue> (*JITCompiledFunctionPtr)(Runtime &runtime);
+class JITContext;
+
+/// A pointer to JIT-compiled function. It runs the function in the frame
+/// already set up by the interpreter, whose registers start at \p frameRegs,
+/// until it reaches a Ret or an instruction throws. The address of that
+/// instruction is stored in \p ip, and the interpreter resumes from it.
+/// \return RETURNED when stopped at a Ret, or EXCEPTION when an instruction
+///   threw.
+typedef ExecutionStatus (*JITCompiledFunctionPtr)(
+    Runtime *runtime,
+    PinnedHermesValue *frameRegs,
+    const inst::Inst **ip);
 
 /// A sequence of instructions representing the body of a function.
 class CodeBlock final
@@ -57,6 +67,27 @@ class CodeBlock final
   /// cache.
   const uint32_t writePropCacheOffset_;
 
+  /// Secondary entries for polymorphic property cache sites, indexed like the
+  /// property cache. Allocated when the first site in this CodeBlock observes
+  /// a second hidden class.
+  std::unique_ptr<PolymorphicPropertyCacheEntry[]> polyPropertyCache_;
+
+  /// Prototype chain entries for property cache sites, indexed like the
+  /// property cache. Allocated when the first read in this CodeBlock resolves
+  /// on a prototype.
+  std::unique_ptr<PrototypeCacheEntry[]> protoPropertyCache_;
+
+#ifdef HERMESVM_JIT
+  friend class JITContext;
+
+  /// Native code generated for this function by the JIT, if any.
+  JITCompiledFunctionPtr JITCompiled_{nullptr};
+
+  /// Number of times this function has been entered, used by the JIT to find
+  /// hot functions. JITContext::kNeverCompile once compilation has failed.
+  uint32_t jitCallCount_{0};
+#endif
+
 #ifndef HERMESVM_LEAN
   /// Compiles a lazy CodeBlock. Intended to be called from lazyCompile.
   void lazyCompileImpl(Runtime &runtime);
@@ -268,6 +299,46 @@ class CodeBlock final
     return &propertyCache()[writePropCacheOffset_ + idx];
   }
 
+  /// \return the secondary entries of the property cache site whose primary
+  /// entry is \p entry, or nullptr if no site in this CodeBlock has become
+  /// polymorphic yet.
+  inline PolymorphicPropertyCacheEntry *getPolyCacheEntry(
+      const PropertyCacheEntry *entry) {
+    if (LLVM_LIKELY(!polyPropertyCache_))
+      return nullptr;
+    return &polyPropertyCache_[entry - propertyCache()];
+  }
+
+  /// \return the prototype chain entry of the property cache site whose
+  /// primary entry is \p entry, or nullptr if no read in this CodeBlock has
+  /// been cached on a prototype yet.
+  inline PrototypeCacheEntry *getProtoCacheEntry(
+      const PropertyCacheEntry *entry) {
+    if (LLVM_LIKELY(!protoPropertyCache_))
+      return nullptr;
+    return &protoPropertyCache_[entry - propertyCache()];
+  }
+
+  /// \return the prototype chain entry of the property cache site whose
+  /// primary entry is \p entry, allocating the entries if necessary.
+  PrototypeCacheEntry *getOrCreateProtoCacheEntry(
+      const PropertyCacheEntry *entry);
+
+  /// \return the state of the property cache site whose primary entry is
+  /// \p entry.
+  PropertyCacheState getPropertyCacheState(const PropertyCacheEntry *entry);
+
+  /// Add the class \p clazz with property slot \p slot to the property cache
+  /// site whose primary entry is \p entry, after a lookup missed all of the
+  /// site's entries. The primary entry is filled first, then the polymorphic
+  /// entries; once those are full the site becomes megamorphic and is no
+  /// longer updated.
+  /// \return the state of the site after the insertion.
+  PropertyCacheState addPropertyCacheEntry(
+      PropertyCacheEntry *entry,
+      CompressedPointer clazz,
+      SlotIndex slot);
+
   // Mark all hidden classes in the property cache as roots.
   void markCachedHiddenClasses(Runtime &runtime, WeakRootAcceptor &acceptor);
 
@@ -280,7 +351,10 @@ class CodeBlock final
   /// \return an estimate of the size of additional memory used by this
   /// CodeBlock.
   size_t additionalMemorySize() const {
-    return propertyCacheSize_ * sizeof(PropertyCacheEntry);
+    return propertyCacheSize_ *
+        (sizeof(PropertyCacheEntry) +
+         (polyPropertyCache_ ? sizeof(PolymorphicPropertyCacheEntry) : 0) +
+         (protoPropertyCache_ ? sizeof(PrototypeCacheEntry) : 0));
   }
 
 #ifdef HERMES_ENABLE_DEBUGGER
@@ -40,6 +40,7 @@
 #include "llvh/ADT/DenseMap.h"
 #include "llvh/Support/ErrorHandling.h"
 
+#include <array>
 #include <cassert>
 #include <chrono>
 #include <cstdint>
@@ -347,6 +348,14 @@ class GCBase {
     /// time spent on the mutator.
     StatsAccumulator<double> gcWallTime;
 
+    /// Number of buckets in gcPauseHistogram.
+    static constexpr unsigned kNumPauseBuckets = 11;
+
+    /// Histogram of the GC wall times that count towards gcWallTime. Bucket 0
+    /// counts pauses under 0.25ms, and each following bucket doubles that
+    /// bound. The last bucket counts every pause of 128ms or more.
+    std::array<unsigned, kNumPauseBuckets> gcPauseHistogram{};
+
     /// Summary statistics for GC CPU times.
     StatsAccumulator<double> gcCPUTime;
 
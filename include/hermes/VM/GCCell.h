@@ -14,9 +14,11 @@
 #include "hermes/VM/HeapAlign.h"
 #include "hermes/VM/VTable.h"
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 namespace hermes {
 namespace vm {
@@ -213,6 +215,45 @@ class GCCell {
     return isMarked();
   }
 
+  /// The next two functions are variants of the above for parallel
+  /// evacuation, where several GC threads may race to forward the same cell.
+  /// The header is only ever accessed atomically through them.
+
+  /// \return the allocated size of this cell, or 0 if it has already been
+  /// forwarded, in which case \p forwardedCell is set to its new location.
+  /// NOTE: this should only be used by the GC.
+  uint32_t getAllocatedSizeIfNotForwarded(
+      AssignableCompressedPointer &forwardedCell) const {
+    const CompressedPointer::RawType raw =
+        atomicHeader()->load(std::memory_order_acquire);
+    if (raw & 0x1) {
+      forwardedCell = CompressedPointer::fromRaw(raw - 0x1);
+      return 0;
+    }
+    KindAndSize kindAndSize;
+    std::memcpy(&kindAndSize, &raw, sizeof(raw));
+    return kindAndSize.getSize();
+  }
+
+  /// Install a marked forwarding pointer to \p cell, unless another thread
+  /// has already forwarded this cell.
+  /// \return the forwarding pointer held by this cell after the call, which is
+  ///   \p cell if and only if this thread installed it.
+  /// NOTE: this should only be used by the GC.
+  CompressedPointer trySetMarkedForwardingPointer(CompressedPointer cell) {
+    CompressedPointer::RawType expected =
+        atomicHeader()->load(std::memory_order_acquire);
+    if (!(expected & 0x1) &&
+        atomicHeader()->compare_exchange_strong(
+            expected,
+            cell.getRaw() | 0x1,
+            std::memory_order_acq_rel,
+            std::memory_order_acquire))
+      return cell;
+    assert((expected & 0x1) && "Header changed without being forwarded");
+    return CompressedPointer::fromRaw(expected - 0x1);
+  }
+
   const GCCell *nextCell() const {
     return reinterpret_cast<const GCCell *>(
         reinterpret_cast<const char *>(this) + getAllocatedSize());
@@ -269,6 +310,18 @@ class GCCell {
   static constexpr uint32_t maxSize() {
     return KindAndSize::maxSize();
   }
+
+ private:
+  /// View the header as an atomic word, for use by parallel evacuation.
+  std::atomic<CompressedPointer::RawType> *atomicHeader() const {
+    static_assert(
+        sizeof(std::atomic<CompressedPointer::RawType>) ==
+                sizeof(forwardingPointer_) &&
+            sizeof(KindAndSize) == sizeof(forwardingPointer_),
+        "Cell header must be a single atomic word");
+    return reinterpret_cast<std::atomic<CompressedPointer::RawType> *>(
+        const_cast<AssignableCompressedPointer *>(&forwardingPointer_));
+  }
 };
 
 /// A VariableSizeRuntimeCell is a GCCell with a variable size only known
@@ -24,6 +24,7 @@
 #include <condition_variable>
 #include <cstdint>
 #include <deque>
+#include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
@@ -342,6 +343,8 @@ class HadesGC final : public GCBase {
   class MarkWeakRootsAcceptor;
   class OldGen;
   class Executor;
+  class WorkerPool;
+  class ParallelEvacuation;
 
   struct CopyListCell final : public GCCell {
     // Linked list of cells pointing to the next cell that was copied.
@@ -410,6 +413,14 @@ class HadesGC final : public GCBase {
     /// \post This function either successfully allocates, or reports OOM.
     GCCell *alloc(uint32_t sz);
 
+    /// Allocate into OG from the free list only, without growing the heap.
+    /// \return A pointer to \p sz bytes of memory, or nullptr if no free cell
+    ///   can hold them.
+    /// \pre gcMutex_ must be held before calling this function.
+    GCCell *allocFromFreelist(uint32_t sz) {
+      return search(sz);
+    }
+
     /// Adds the given region of memory to the free list for this segment.
     void addCellToFreelist(void *addr, uint32_t sz, size_t segmentIdx);
 
@@ -511,7 +522,8 @@ class HadesGC final : public GCBase {
     /// Sweep the next segment and advance the internal sweep iterator. If there
     /// are no more segments left to sweep, update OG collection stats with
     /// numbers from the sweep. \p backgroundThread indicates  whether this call
-    /// was made from the background thread.
+    /// was made from the background thread. On the background thread, this may
+    /// sweep a batch of segments at once, one per concurrent GC thread.
     bool sweepNext(bool backgroundThread);
 
     /// Initialize the internal sweep iterator. This will reset the internal
@@ -527,19 +539,36 @@ class HadesGC final : public GCBase {
     /// \return The number of bytes of native memory in use by this OldGen.
     size_t getMemorySize() const;
 
+    /// Emit the page count and occupancy of each size class that is in use
+    /// into \p json.
+    void printSizeClassStats(JSONEmitter &json) const;
+
    private:
     /// \return the index of the bucket in freelistBuckets_ corresponding to
     /// \p size.
     /// \post The returned index is less than kNumFreelistBuckets.
     static uint32_t getFreelistBucket(uint32_t size);
 
-    /// Adds the given region of memory to the free list for the segment that is
-    /// currently being swept. This does not update the Freelist bits, those
-    /// should all be updated in a single pass at the end of sweeping.
+    /// Adds the given region of memory to the free list for the segment at
+    /// \p segmentIdx, which is being swept. This does not update the Freelist
+    /// bits, those should all be updated in a single pass at the end of
+    /// sweeping the segment.
     void addCellToFreelistFromSweep(
         char *freeRangeStart,
         char *freeRangeEnd,
-        bool setHead);
+        bool setHead,
+        size_t segmentIdx);
+
+    /// Sweep the segment at \p segmentIdx on the calling thread.
+    void sweepSegment(size_t segmentIdx, bool backgroundThread);
+
+    /// Sweep the next \p numSegments segments, one on each of as many threads.
+    /// Must be called on the background thread.
+    void sweepSegmentsInParallel(size_t numSegments);
+
+    /// Update the free list bit arrays to match the free list heads of the
+    /// segment at \p segmentIdx, after it has been swept.
+    void updateFreelistBitsAfterSweep(size_t segmentIdx);
 
     HadesGC &gc_;
 
@@ -615,6 +644,59 @@ class HadesGC final : public GCBase {
     std::array<llvh::SparseBitVector<>, kNumFreelistBuckets>
         freelistBucketSegmentBitArray_;
 
+    /// Small cells are allocated from pages that each hold cells of a single
+    /// size, which keeps promotion to a bump allocation and groups cells of
+    /// the same type together. There is one size class for each size below
+    /// kMaxSizeClassCellSize, in multiples of heapAlign.
+    static constexpr uint32_t kMaxSizeClassCellSize = 256;
+    static constexpr size_t kNumSizeClasses =
+        kMaxSizeClassCellSize >> LogHeapAlign;
+    static_assert(
+        kMaxSizeClassCellSize <= kMinSizeForLargeBlock,
+        "Every size class must have its own small freelist bucket");
+
+    /// The number of bytes taken from the freelist at once for a new page,
+    /// rounded down to a multiple of the size of the class.
+    static constexpr uint32_t kSizeClassPageSize = 4096;
+
+    struct SizeClass {
+      /// The part of the current page that has not been allocated yet. It is
+      /// made of FreelistCells of the size of this class that are not on any
+      /// freelist, so that the heap stays parseable.
+      char *level{nullptr};
+      char *end{nullptr};
+      /// The index of the segment containing the current page.
+      size_t segmentIdx{0};
+      /// The number of pages that have been created for this class.
+      uint64_t numPages{0};
+    };
+    std::array<SizeClass, kNumSizeClasses> sizeClasses_;
+
+    /// The number of bytes in live and free cells of each size class, as
+    /// found by sweeping.
+    struct SizeClassUsage {
+      std::array<uint64_t, kNumSizeClasses> liveBytes{};
+      std::array<uint64_t, kNumSizeClasses> freeBytes{};
+
+      void addLive(uint32_t sz) {
+        if (sz < kMaxSizeClassCellSize)
+          liveBytes[sz >> LogHeapAlign] += sz;
+      }
+      void addFree(uint32_t sz) {
+        if (sz < kMaxSizeClassCellSize)
+          freeBytes[sz >> LogHeapAlign] += sz;
+      }
+      void add(const SizeClassUsage &other) {
+        for (size_t i = 0; i < kNumSizeClasses; ++i) {
+          liveBytes[i] += other.liveBytes[i];
+          freeBytes[i] += other.freeBytes[i];
+        }
+      }
+    };
+
+    /// The usage of each size class at the end of the last completed sweep.
+    SizeClassUsage sizeClassUsage_;
+
     /// Tracks the current progress of sweeping.
     struct SweepIterator {
       /// The current segment being swept, this should start at the end and move
@@ -626,6 +708,9 @@ class HadesGC final : public GCBase {
       /// sweep.
       uint64_t sweptBytes{0};
       uint64_t sweptExternalBytes{0};
+
+      /// The usage of each size class in the segments swept so far.
+      SizeClassUsage sizeClassUsage;
     } sweepIterator_;
 
     /// Searches the OG for a space to allocate memory into.
@@ -633,6 +718,25 @@ class HadesGC final : public GCBase {
     ///   if no such space exists.
     GCCell *search(uint32_t sz);
 
+    /// Find and remove a free cell that can hold \p sz bytes, splitting it if
+    /// necessary, without accounting for it as allocated.
+    /// \param[out] segmentIdx The index of the segment containing the cell.
+    /// \return A pointer to uninitialized memory, or null if no free cell is
+    ///   large enough.
+    GCCell *searchFreelists(uint32_t sz, size_t &segmentIdx);
+
+    /// Allocate \p sz bytes from the page of its size class, starting a new
+    /// page if the current one is full. Prefers exact-size cells on the
+    /// freelist, so that memory freed by the sweeper is reused first.
+    /// \pre sz < kMaxSizeClassCellSize
+    /// \return A pointer to uninitialized memory, or null if there is neither
+    ///   a free cell of this size nor one large enough for a new page.
+    GCCell *allocFromSizeClass(uint32_t sz);
+
+    /// Stop allocating from any size class page in the segment at \p
+    /// segmentIdx. Its unallocated cells are left for the sweeper to free.
+    void dropSizeClassPages(size_t segmentIdx);
+
     /// Common path for when an allocation has succeeded.
     /// \param cell The free memory that will soon have an object allocated into
     ///   it.
@@ -721,6 +825,47 @@ class HadesGC final : public GCBase {
   /// concurrently with the mutator.
   std::unique_ptr<Executor> backgroundExecutor_;
 
+  /// Number of threads, including the mutator, that work on the
+  /// stop-the-world phases of a collection. If 1, they run on the mutator
+  /// alone.
+  const unsigned numGCThreads_;
+
+  /// Number of threads that mark and sweep the OG concurrently with the
+  /// mutator. If 1, that work runs on the background thread alone.
+  const unsigned numConcurrentThreads_;
+
+  /// Helper threads for parallel YG evacuation and OG collection. Created on
+  /// first use, so that runtimes that never need them do not pay for idle
+  /// threads. Only used by the thread that holds gcMutex_.
+  std::unique_ptr<WorkerPool> workerPool_;
+
+  /// Set while workerPool_ is running a task. The helpers work on behalf of
+  /// the thread that holds gcMutex_, and synchronise among themselves where
+  /// they modify shared GC data structures.
+  bool gcWorkersActive_{false};
+
+  /// Number of YG collections that evacuated in parallel.
+  uint64_t numParallelYGCollections_{0};
+
+  /// Number of steps of concurrent marking that were shared between several
+  /// threads.
+  uint64_t numParallelMarkSteps_{0};
+
+  /// Number of steps of sweeping that swept several segments at once.
+  uint64_t numParallelSweepSteps_{0};
+
+  /// When the sweep phase of the current OG collection began.
+  std::chrono::steady_clock::time_point sweepBeginTime_{};
+
+  /// Wall time, in seconds, from the end of marking to the end of sweeping in
+  /// each OG collection. Memory only becomes available for reuse as its
+  /// segment is swept, so this bounds how long the heap keeps growing after
+  /// marking has found the garbage.
+  StatsAccumulator<double> ogSweepTime_;
+
+  /// Largest segmentFootprint() reached so far.
+  uint64_t peakSegmentFootprint_{0};
+
   /// This tracks the current status of execution in the background thread. The
   /// future should be set every time work is enqueued onto the executor. After
   /// that, whenever we need to wait for execution in the background thread to
@@ -882,6 +1027,25 @@ class HadesGC final : public GCBase {
   template <typename Acceptor>
   void youngGenEvacuateImpl(Acceptor &acceptor, bool doCompaction);
 
+  /// Run \p task on the calling thread and on helpers from workerPool_, so
+  /// that \p numThreads threads run it in total. Each thread passes a distinct
+  /// index in [0, numThreads) to \p task, where 0 is the calling thread.
+  /// Creates workerPool_ on first use. Must be called with gcMutex_ held.
+  void runOnWorkers(
+      unsigned numThreads,
+      const std::function<void(unsigned)> &task);
+
+  /// \return true if the next YG collection should evacuate live objects with
+  /// the help of workerPool_, instead of on the mutator alone.
+  /// \param doCompaction Whether the compactee is evacuated as well.
+  bool shouldEvacuateInParallel(bool doCompaction);
+
+  /// Parallel counterpart of youngGenEvacuateImpl, which shares root marking,
+  /// dirty card scanning and copying between the mutator and workerPool_.
+  /// \return the number of bytes that were evacuated.
+  template <bool CompactionEnabled>
+  uint64_t youngGenEvacuateParallel(bool doCompaction);
+
   /// In the "no GC before TTI" mode, move the Young Gen heap segment to the
   /// Old Gen without scanning for garbage.
   /// \return true if a promotion occurred, false if it did not.
@@ -960,6 +1124,18 @@ class HadesGC final : public GCBase {
   ///   compaction cannot occur no matter what.
   void prepareCompactee(bool forceCompaction);
 
+  /// Walk the cells on the dirty cards of \p seg, up to its level at the
+  /// time of the call. Cells that extend past the bounds of a run of dirty
+  /// cards are passed to \p visitRange along with those bounds, and all other
+  /// cells to \p visitCell. Unmarked cells are skipped unless \p
+  /// visitUnmarked is true.
+  template <typename RangeCallback, typename CellCallback>
+  void forEachDirtyCardCell(
+      HeapSegment &seg,
+      bool visitUnmarked,
+      RangeCallback visitRange,
+      CellCallback visitCell);
+
   /// Search a single segment for pointers that may need to be updated as the
   /// YG/compactee are evacuated.
   template <bool CompactionEnabled>
@@ -127,6 +127,12 @@ class HeapSnapshot {
       HeapSizeType selfSize,
       HeapSizeType traceNodeID);
 
+  /// \return whether a node with the ID \p id has been emitted. This lets
+  /// several cells which share a piece of native memory emit its node once.
+  bool hasNode(NodeID id) const {
+    return nodeToIndex_.count(id);
+  }
+
   void addNamedEdge(EdgeType type, llvh::StringRef name, NodeID toNode);
   void addIndexedEdge(EdgeType type, EdgeIndex index, NodeID toNode);
 
@@ -60,7 +60,6 @@ HERMES_VM_GCOBJECT(JSCallSite);
 HERMES_VM_GCOBJECT(JSGenerator);
 HERMES_VM_GCOBJECT(Domain);
 HERMES_VM_GCOBJECT(RequireContext);
-HERMES_VM_GCOBJECT(HashMapEntry);
 HERMES_VM_GCOBJECT(OrderedHashMap);
 HERMES_VM_GCOBJECT(JSWeakMapImplBase);
 HERMES_VM_GCOBJECT(JSArrayIterator);
@@ -111,6 +110,14 @@ template <typename T>
 class BufferedStringPrimitive;
 template <typename T>
 struct IsGCObject<BufferedStringPrimitive<T>> : public std::true_type {};
+template <typename T>
+class RopeStringPrimitive;
+template <typename T>
+struct IsGCObject<RopeStringPrimitive<T>> : public std::true_type {};
+template <typename T>
+class SlicedStringPrimitive;
+template <typename T>
+struct IsGCObject<SlicedStringPrimitive<T>> : public std::true_type {};
 
 template <size_t Size>
 struct EmptyCell;
@@ -218,6 +225,18 @@ struct HermesValueTraits<BufferedStringPrimitive<char>, true>
 template <>
 struct HermesValueTraits<BufferedStringPrimitive<char16_t>, true>
     : public StringTraitsImpl<BufferedStringPrimitive<char16_t>> {};
+template <>
+struct HermesValueTraits<RopeStringPrimitive<char>, true>
+    : public StringTraitsImpl<RopeStringPrimitive<char>> {};
+template <>
+struct HermesValueTraits<RopeStringPrimitive<char16_t>, true>
+    : public StringTraitsImpl<RopeStringPrimitive<char16_t>> {};
+template <>
+struct HermesValueTraits<SlicedStringPrimitive<char>, true>
+    : public StringTraitsImpl<SlicedStringPrimitive<char>> {};
+template <>
+struct HermesValueTraits<SlicedStringPrimitive<char16_t>, true>
+    : public StringTraitsImpl<SlicedStringPrimitive<char16_t>> {};
 
 template <class T>
 struct HermesValueTraits<T, true> {
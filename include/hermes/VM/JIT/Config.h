@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_JIT_CONFIG_H
+#define HERMES_VM_JIT_CONFIG_H
+
+/// \def HERMESVM_JIT
+/// Defined when the baseline JIT is built. It is only available on x86-64
+/// Linux, and requires HERMESVM_ALLOW_JIT. Whether it is used is still decided
+/// at run time by RuntimeConfig::getEnableJIT().
+#if defined(HERMESVM_ALLOW_JIT) && defined(__x86_64__) && defined(__linux__)
+#define HERMESVM_JIT
+#endif
+
+#endif // HERMES_VM_JIT_CONFIG_H
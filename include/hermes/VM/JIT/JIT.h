@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_JIT_JIT_H
+#define HERMES_VM_JIT_JIT_H
+
+#include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/JIT/Config.h"
+
+#ifdef HERMESVM_JIT
+
+#include <memory>
+
+namespace hermes {
+namespace vm {
+
+class ExecHeap;
+
+/// The state of the baseline JIT owned by a Runtime: the policy deciding
+/// which functions are compiled, and the executable memory holding their code.
+///
+/// The JIT translates the bytecode of a CodeBlock into a straight sequence of
+/// machine code, one template per instruction. Arithmetic, comparisons and
+/// jumps on numbers are inlined, everything else calls the same runtime
+/// functions as the interpreter. Compiled code runs in the frame set up by the
+/// interpreter, so the two can be freely mixed.
+class JITContext {
+ public:
+  /// A function without loops is compiled when it is entered for this many
+  /// times. Functions with loops are compiled on their first entry, since
+  /// there is no way to switch to compiled code in the middle of a call.
+  static constexpr uint32_t kCallThreshold = 16;
+
+  /// Value of CodeBlock::jitCallCount_ for functions which must not be
+  /// compiled, typically because they contain unsupported instructions.
+  static constexpr uint32_t kNeverCompile = ~0u;
+
+  /// \param enable whether compilation is enabled at all.
+  /// \param force compile every function on its first entry, regardless of
+  ///   how hot it is. Used for testing.
+  JITContext(bool enable, bool force);
+  ~JITContext();
+
+  bool isEnabled() const {
+    return enabled_;
+  }
+
+  /// \return the native code of \p codeBlock, compiling it first if it has
+  /// become hot, or nullptr if it must be interpreted.
+  inline JITCompiledFunctionPtr compile(
+      Runtime &runtime,
+      CodeBlock *codeBlock) {
+    if (LLVM_LIKELY(codeBlock->JITCompiled_))
+      return codeBlock->JITCompiled_;
+    if (LLVM_LIKELY(!enabled_) || codeBlock->jitCallCount_ == kNeverCompile)
+      return nullptr;
+    uint32_t count = ++codeBlock->jitCallCount_;
+    if (count != 1 && count != kCallThreshold)
+      return nullptr;
+    return compileImpl(runtime, codeBlock);
+  }
+
+ private:
+  /// Decide whether \p codeBlock should be compiled now, and compile it.
+  JITCompiledFunctionPtr compileImpl(Runtime &runtime, CodeBlock *codeBlock);
+
+  /// Whether the JIT is enabled.
+  const bool enabled_;
+
+  /// Compile functions on their first entry.
+  const bool force_;
+
+  /// Memory holding the generated code, allocated on first use.
+  std::unique_ptr<ExecHeap> heap_;
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMESVM_JIT
+
+#endif // HERMES_VM_JIT_JIT_H
@@ -213,6 +213,15 @@ class ArrayImpl : public JSObject {
     return getIndexedStorage(runtime)->at(runtime, index - beginIndex_);
   }
 
+  /// Store \p value at \p index, which must be equal to the end index, if
+  /// that can be done without growing the storage. Does not allocate.
+  /// \return true if the value was stored, false if the storage is full.
+  static bool appendWithinCapacity(
+      ArrayImpl *self,
+      Runtime &runtime,
+      size_type index,
+      SmallHermesValue value);
+
  private:
   /// The first index contained in the storage.
   uint32_t beginIndex_{0};
@@ -327,6 +336,35 @@ class JSArray final : public ArrayImpl {
   static CallResult<Handle<JSArray>>
   create(Runtime &runtime, size_type capacity, size_type length);
 
+  /// Fast path for storing \p valueHandle at \p index, used by the
+  /// interpreter before resorting to JSObject::putComputed_RJS(). It handles
+  /// overwriting an existing element inline, and creating a new element in
+  /// putNewElementFast(). Everything else is left to the slow path.
+  /// \pre selfHandle->hasFastIndexProperties().
+  /// \return true if the value was stored, false if the slow path must be
+  ///   taken instead.
+  static bool tryPutIndexedFast(
+      Handle<JSArray> selfHandle,
+      Runtime &runtime,
+      uint32_t index,
+      Handle<> valueHandle) {
+    JSArray *self = *selfHandle;
+    assert(self->hasFastIndexProperties() && "array has index-like properties");
+    if (LLVM_LIKELY(
+            index >= self->getBeginIndex() && index < self->getEndIndex() &&
+            !self->unsafeAt(runtime, index).isEmpty())) {
+      if (LLVM_UNLIKELY(self->flags_.frozen))
+        return false;
+      // Encoding may allocate, so reload the array afterwards.
+      auto shv = SmallHermesValue::encodeHermesValue(*valueHandle, runtime);
+      self = *selfHandle;
+      self->getIndexedStorage(runtime)->set(
+          runtime, index - self->getBeginIndex(), shv);
+      return true;
+    }
+    return putNewElementFast(selfHandle, runtime, index, valueHandle);
+  }
+
   /// A convenience method for setting the \c .length property of the array.
   /// It performs the necessary checks and updates the property. It could fail
   /// if the property is not writable or if there are read-only index-like
@@ -359,6 +397,20 @@ class JSArray final : public ArrayImpl {
     setDirectSlotValue<lengthPropIndex()>(self, newLength, runtime.getHeap());
   }
 
+  /// Store \p valueHandle at \p index, which is not an existing element,
+  /// without the generic property machinery. This handles filling a hole
+  /// inside the storage, and appending right after the end of the storage
+  /// within its capacity. The array must be extensible, and no object on its
+  /// prototype chain may have an element \p index. If the store grows the
+  /// length, the array must have the standard array class, which guarantees
+  /// that its length is writable.
+  /// \return true if the value was stored, false otherwise.
+  static bool putNewElementFast(
+      Handle<JSArray> selfHandle,
+      Runtime &runtime,
+      uint32_t index,
+      Handle<> valueHandle);
+
   /// Update the JavaScript '.length' property, which also resizes the array.
   /// The writability of the property \b MUST already have been checked.
   /// If not sure, use \c putNamed().
@@ -8,15 +8,17 @@
 #ifndef HERMES_VM_JSLIB_SORTING_H
 #define HERMES_VM_JSLIB_SORTING_H
 
+#include <algorithm>
 #include <cstdint>
+#include <vector>
 
 #include "hermes/VM/CallResult.h"
 
 /// Defines custom sorting routines used in cases that we can't use std::sort.
-/// std::sort doesn't always use std::swap, performing operations that bypass
-/// the user-defined swap routines. When calling [[Put]] and [[Delete]], we
-/// can't bypass those operations, so we use a custom SortModel and define our
-/// own swap and less functions, which are used by these sorting functions.
+/// The comparison used by JavaScript sorts can call into JavaScript, so it can
+/// fail, and it isn't guaranteed to be consistent. The sorting routines here
+/// stop at the first failing comparison, and always terminate without going
+/// out of bounds, whatever the comparison returns.
 
 namespace hermes {
 namespace vm {
@@ -38,9 +40,491 @@ class SortModel {
   virtual ~SortModel() = 0;
 };
 
-/// QuickSort to sort elements in the range [begin, end). Returns immediately
-/// with ExecutionStatus::EXCEPTION if any compare or swap operations fail.
-ExecutionStatus quickSort(SortModel *sm, uint32_t begin, uint32_t end);
+/// Stable sort of the elements in the range [begin, end) of \p sm. The order
+/// is computed first, comparing elements in their original positions, and the
+/// elements are then moved to their final position with at most one swap per
+/// element. Returns immediately with ExecutionStatus::EXCEPTION if any compare
+/// or swap operations fail.
+ExecutionStatus timSort(SortModel *sm, uint32_t begin, uint32_t end);
+
+namespace detail {
+
+/// Implementation of TimSort over an array of \p T, which must be cheap to
+/// copy. \p Less is called as less(x, y) and returns CallResult<bool>, true if
+/// x must be ordered before y.
+/// Natural runs (ascending, or strictly descending and then reversed) are
+/// extended to a minimum length with a binary insertion sort, and merged
+/// while keeping the lengths of the pending runs balanced. Merges switch to
+/// exponential search (galloping) when one run keeps winning, so presorted
+/// and partially sorted inputs take close to n comparisons.
+template <typename T, typename Less>
+class TimSorter {
+ public:
+  TimSorter(T *a, uint32_t n, Less &less) : a_(a), n_(n), less_(less) {}
+
+  ExecutionStatus sort() {
+    if (n_ < 2)
+      return ExecutionStatus::RETURNED;
+    uint32_t minRun = minRunLength(n_);
+    for (uint32_t lo = 0; lo < n_;) {
+      auto runRes = countRunAndMakeAscending(lo);
+      if (LLVM_UNLIKELY(runRes == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      uint32_t runLen = *runRes;
+      if (runLen < minRun) {
+        uint32_t force = std::min(minRun, n_ - lo);
+        if (LLVM_UNLIKELY(
+                binaryInsertionSort(lo, lo + force, lo + runLen) ==
+                ExecutionStatus::EXCEPTION))
+          return ExecutionStatus::EXCEPTION;
+        runLen = force;
+      }
+      runs_.push_back({lo, runLen});
+      if (LLVM_UNLIKELY(mergeCollapse() == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      lo += runLen;
+    }
+    while (runs_.size() > 1) {
+      size_t i = runs_.size() - 2;
+      if (i > 0 && runs_[i - 1].len < runs_[i + 1].len)
+        --i;
+      if (LLVM_UNLIKELY(mergeAt(i) == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+    }
+    return ExecutionStatus::RETURNED;
+  }
+
+ private:
+  /// A pending run, a[base, base + len), which is sorted.
+  struct Run {
+    uint32_t base;
+    uint32_t len;
+  };
+
+  /// Number of consecutive wins of one run after which a merge starts
+  /// galloping.
+  static constexpr uint32_t kMinGallop = 7;
+
+  /// Runs shorter than this are not worth merging.
+  static constexpr uint32_t kMinMerge = 32;
+
+  T *const a_;
+  const uint32_t n_;
+  Less &less_;
+
+  /// Adaptive galloping threshold, lowered while galloping pays off.
+  uint32_t minGallop_ = kMinGallop;
+
+  /// Pending runs, from left to right.
+  std::vector<Run> runs_{};
+
+  /// Scratch space holding the shorter run of a merge.
+  std::vector<T> tmp_{};
+
+  /// \return the minimum run length for an array of \p n elements: a value in
+  /// [kMinMerge / 2, kMinMerge] such that n / minRun is a power of 2, or
+  /// slightly less than one.
+  static uint32_t minRunLength(uint32_t n) {
+    uint32_t r = 0;
+    while (n >= kMinMerge) {
+      r |= n & 1;
+      n >>= 1;
+    }
+    return n + r;
+  }
+
+  /// Find the length of the run starting at \p lo, and reverse it if it is
+  /// strictly descending, which cannot break stability.
+  CallResult<uint32_t> countRunAndMakeAscending(uint32_t lo) {
+    uint32_t hi = lo + 1;
+    if (hi == n_)
+      return 1;
+    auto res = less_(a_[hi], a_[lo]);
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    ++hi;
+    bool descending = *res;
+    for (; hi < n_; ++hi) {
+      res = less_(a_[hi], a_[hi - 1]);
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      if (*res != descending)
+        break;
+    }
+    if (descending)
+      std::reverse(a_ + lo, a_ + hi);
+    return hi - lo;
+  }
+
+  /// Sort a[lo, hi), where a[lo, start) is already sorted, by inserting each
+  /// of the remaining elements after a binary search.
+  ExecutionStatus
+  binaryInsertionSort(uint32_t lo, uint32_t hi, uint32_t start) {
+    for (; start < hi; ++start) {
+      T pivot = a_[start];
+      uint32_t left = lo, right = start;
+      while (left < right) {
+        uint32_t mid = left + (right - left) / 2;
+        auto res = less_(pivot, a_[mid]);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+          return ExecutionStatus::EXCEPTION;
+        if (*res)
+          right = mid;
+        else
+          left = mid + 1;
+      }
+      std::move_backward(a_ + left, a_ + start, a_ + start + 1);
+      a_[left] = pivot;
+    }
+    return ExecutionStatus::RETURNED;
+  }
+
+  /// Merge adjacent runs until the lengths of the pending runs, from right to
+  /// left, grow at least as fast as the Fibonacci numbers. The invariant is
+  /// checked on the top four runs, which is enough for it to hold on the whole
+  /// stack.
+  ExecutionStatus mergeCollapse() {
+    while (runs_.size() > 1) {
+      size_t i = runs_.size() - 2;
+      if ((i > 0 && runs_[i - 1].len <= runs_[i].len + runs_[i + 1].len) ||
+          (i > 1 && runs_[i - 2].len <= runs_[i - 1].len + runs_[i].len)) {
+        if (runs_[i - 1].len < runs_[i + 1].len)
+          --i;
+      } else if (runs_[i].len > runs_[i + 1].len) {
+        break;
+      }
+      if (LLVM_UNLIKELY(mergeAt(i) == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+    }
+    return ExecutionStatus::RETURNED;
+  }
+
+  /// Merge the pending runs at \p i and \p i + 1.
+  ExecutionStatus mergeAt(size_t i) {
+    uint32_t base1 = runs_[i].base;
+    uint32_t len1 = runs_[i].len;
+    uint32_t base2 = runs_[i + 1].base;
+    uint32_t len2 = runs_[i + 1].len;
+    runs_[i].len = len1 + len2;
+    runs_.erase(runs_.begin() + i + 1);
+
+    // Elements of the first run which are not greater than the first element
+    // of the second run are already in place.
+    T key = a_[base2];
+    auto res = gallopRight(key, a_ + base1, len1, 0);
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    base1 += *res;
+    len1 -= *res;
+    if (len1 == 0)
+      return ExecutionStatus::RETURNED;
+
+    // So are the elements of the second run which are not less than the last
+    // element of the first run.
+    key = a_[base1 + len1 - 1];
+    res = gallopLeft(key, a_ + base2, len2, len2 - 1);
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    len2 = *res;
+    if (len2 == 0)
+      return ExecutionStatus::RETURNED;
+
+    return len1 <= len2 ? mergeLo(base1, len1, base2, len2)
+                        : mergeHi(base1, len1, base2, len2);
+  }
+
+  /// \return the position at which \p key should be inserted in the sorted
+  /// range base[0, len) so that it comes before the elements equal to it,
+  /// i.e. the number of elements less than \p key. The search starts at
+  /// \p hint, which must be less than \p len.
+  CallResult<uint32_t>
+  gallopLeft(const T &key, const T *base, uint32_t len, uint32_t hint) {
+    int64_t lastOfs = 0, ofs = 1;
+    auto res = less_(base[hint], key);
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    if (*res) {
+      // base[hint] < key: gallop right until base[hint + lastOfs] < key <=
+      // base[hint + ofs].
+      int64_t maxOfs = len - hint;
+      while (ofs < maxOfs) {
+        res = less_(base[hint + ofs], key);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+          return ExecutionStatus::EXCEPTION;
+        if (!*res)
+          break;
+        lastOfs = ofs;
+        ofs = ofs * 2 + 1;
+      }
+      ofs = std::min(ofs, maxOfs);
+      lastOfs += hint;
+      ofs += hint;
+    } else {
+      // key <= base[hint]: gallop left until base[hint - ofs] < key <=
+      // base[hint - lastOfs].
+      int64_t maxOfs = hint + 1;
+      while (ofs < maxOfs) {
+        res = less_(base[hint - ofs], key);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+          return ExecutionStatus::EXCEPTION;
+        if (*res)
+          break;
+        lastOfs = ofs;
+        ofs = ofs * 2 + 1;
+      }
+      ofs = std::min(ofs, maxOfs);
+      int64_t tmp = lastOfs;
+      lastOfs = hint - ofs;
+      ofs = hint - tmp;
+    }
+    // Binary search in base(lastOfs, ofs].
+    ++lastOfs;
+    while (lastOfs < ofs) {
+      int64_t mid = lastOfs + (ofs - lastOfs) / 2;
+      res = less_(base[mid], key);
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      if (*res)
+        lastOfs = mid + 1;
+      else
+        ofs = mid;
+    }
+    return static_cast<uint32_t>(ofs);
+  }
+
+  /// Like gallopLeft(), but \return the position after the elements equal to
+  /// \p key, i.e. the number of elements not greater than \p key.
+  CallResult<uint32_t>
+  gallopRight(const T &key, const T *base, uint32_t len, uint32_t hint) {
+    int64_t lastOfs = 0, ofs = 1;
+    auto res = less_(key, base[hint]);
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    if (*res) {
+      // key < base[hint]: gallop left until base[hint - ofs] <= key <
+      // base[hint - lastOfs].
+      int64_t maxOfs = hint + 1;
+      while (ofs < maxOfs) {
+        res = less_(key, base[hint - ofs]);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+          return ExecutionStatus::EXCEPTION;
+        if (!*res)
+          break;
+        lastOfs = ofs;
+        ofs = ofs * 2 + 1;
+      }
+      ofs = std::min(ofs, maxOfs);
+      int64_t tmp = lastOfs;
+      lastOfs = hint - ofs;
+      ofs = hint - tmp;
+    } else {
+      // base[hint] <= key: gallop right until base[hint + lastOfs] <= key <
+      // base[hint + ofs].
+      int64_t maxOfs = len - hint;
+      while (ofs < maxOfs) {
+        res = less_(key, base[hint + ofs]);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+          return ExecutionStatus::EXCEPTION;
+        if (*res)
+          break;
+        lastOfs = ofs;
+        ofs = ofs * 2 + 1;
+      }
+      ofs = std::min(ofs, maxOfs);
+      lastOfs += hint;
+      ofs += hint;
+    }
+    // Binary search in base(lastOfs, ofs].
+    ++lastOfs;
+    while (lastOfs < ofs) {
+      int64_t mid = lastOfs + (ofs - lastOfs) / 2;
+      res = less_(key, base[mid]);
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      if (*res)
+        ofs = mid;
+      else
+        lastOfs = mid + 1;
+    }
+    return static_cast<uint32_t>(ofs);
+  }
+
+  /// Merge a[base1, base1 + len1) and a[base2, base2 + len2), with
+  /// base2 == base1 + len1 and len1 <= len2, from left to right. The first run
+  /// is moved to tmp_, and the hole it leaves always ends before the next
+  /// unmerged element of the second run, so that element is never
+  /// overwritten. If a comparison fails, the rest of tmp_ is copied back to
+  /// the hole, so the array is a permutation of its original content.
+  ExecutionStatus
+  mergeLo(uint32_t base1, uint32_t len1, uint32_t base2, uint32_t len2) {
+    tmp_.assign(a_ + base1, a_ + base1 + len1);
+    T *tmp = tmp_.data();
+    uint32_t c1 = 0, c2 = base2, dest = base1;
+    const uint32_t end1 = len1, end2 = base2 + len2;
+    uint32_t minGallop = minGallop_;
+    ExecutionStatus status = ExecutionStatus::RETURNED;
+
+    while (c1 < end1 && c2 < end2) {
+      // Take one element at a time until one run wins often enough.
+      uint32_t count1 = 0, count2 = 0;
+      do {
+        auto res = less_(a_[c2], tmp[c1]);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+          status = ExecutionStatus::EXCEPTION;
+          goto done;
+        }
+        if (*res) {
+          a_[dest++] = a_[c2++];
+          ++count2;
+          count1 = 0;
+          if (c2 == end2)
+            goto done;
+        } else {
+          a_[dest++] = tmp[c1++];
+          ++count1;
+          count2 = 0;
+          if (c1 == end1)
+            goto done;
+        }
+      } while ((count1 | count2) < minGallop);
+
+      // Gallop while it finds long enough stretches of either run.
+      do {
+        auto res = gallopRight(a_[c2], tmp + c1, end1 - c1, 0);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+          status = ExecutionStatus::EXCEPTION;
+          goto done;
+        }
+        count1 = *res;
+        std::copy(tmp + c1, tmp + c1 + count1, a_ + dest);
+        dest += count1;
+        c1 += count1;
+        if (c1 == end1)
+          goto done;
+        a_[dest++] = a_[c2++];
+        if (c2 == end2)
+          goto done;
+
+        res = gallopLeft(tmp[c1], a_ + c2, end2 - c2, 0);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+          status = ExecutionStatus::EXCEPTION;
+          goto done;
+        }
+        count2 = *res;
+        // dest < c2 because there are elements left in tmp.
+        std::copy(a_ + c2, a_ + c2 + count2, a_ + dest);
+        dest += count2;
+        c2 += count2;
+        if (c2 == end2)
+          goto done;
+        a_[dest++] = tmp[c1++];
+        if (c1 == end1)
+          goto done;
+        if (minGallop > 1)
+          --minGallop;
+      } while (count1 >= kMinGallop || count2 >= kMinGallop);
+      // Penalize leaving the galloping mode.
+      minGallop += 2;
+    }
+
+  done:
+    minGallop_ = std::max(minGallop, 1u);
+    std::copy(tmp + c1, tmp + end1, a_ + dest);
+    return status;
+  }
+
+  /// Like mergeLo(), but from right to left, when len1 > len2. The second run
+  /// is moved to tmp_.
+  ExecutionStatus
+  mergeHi(uint32_t base1, uint32_t len1, uint32_t base2, uint32_t len2) {
+    tmp_.assign(a_ + base2, a_ + base2 + len2);
+    T *tmp = tmp_.data();
+    // c1, c2 and dest are one past the next element to read or write.
+    uint32_t c1 = base1 + len1, c2 = len2, dest = base2 + len2;
+    uint32_t minGallop = minGallop_;
+    ExecutionStatus status = ExecutionStatus::RETURNED;
+
+    while (c1 > base1 && c2 > 0) {
+      uint32_t count1 = 0, count2 = 0;
+      do {
+        auto res = less_(tmp[c2 - 1], a_[c1 - 1]);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+          status = ExecutionStatus::EXCEPTION;
+          goto done;
+        }
+        if (*res) {
+          a_[--dest] = a_[--c1];
+          ++count1;
+          count2 = 0;
+          if (c1 == base1)
+            goto done;
+        } else {
+          a_[--dest] = tmp[--c2];
+          ++count2;
+          count1 = 0;
+          if (c2 == 0)
+            goto done;
+        }
+      } while ((count1 | count2) < minGallop);
+
+      do {
+        auto res =
+            gallopRight(tmp[c2 - 1], a_ + base1, c1 - base1, c1 - base1 - 1);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+          status = ExecutionStatus::EXCEPTION;
+          goto done;
+        }
+        count1 = c1 - base1 - *res;
+        // dest > c1 because there are elements left in tmp.
+        std::copy_backward(a_ + c1 - count1, a_ + c1, a_ + dest);
+        dest -= count1;
+        c1 -= count1;
+        if (c1 == base1)
+          goto done;
+        a_[--dest] = tmp[--c2];
+        if (c2 == 0)
+          goto done;
+
+        res = gallopLeft(a_[c1 - 1], tmp, c2, c2 - 1);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+          status = ExecutionStatus::EXCEPTION;
+          goto done;
+        }
+        count2 = c2 - *res;
+        std::copy_backward(tmp + c2 - count2, tmp + c2, a_ + dest);
+        dest -= count2;
+        c2 -= count2;
+        if (c2 == 0)
+          goto done;
+        a_[--dest] = a_[--c1];
+        if (c1 == base1)
+          goto done;
+        if (minGallop > 1)
+          --minGallop;
+      } while (count1 >= kMinGallop || count2 >= kMinGallop);
+      minGallop += 2;
+    }
+
+  done:
+    minGallop_ = std::max(minGallop, 1u);
+    std::copy(tmp, tmp + c2, a_ + dest - c2);
+    return status;
+  }
+};
+
+} // namespace detail
+
+/// Stable sort of the elements in [begin, end) with TimSort. \p less is called
+/// as less(x, y) on two elements, and returns CallResult<bool>, true if x must
+/// be ordered before y. Returns immediately with ExecutionStatus::EXCEPTION if
+/// a comparison fails, in which case the range holds its original elements in
+/// an unspecified order.
+template <typename T, typename Less>
+ExecutionStatus timSort(T *begin, T *end, Less less) {
+  detail::TimSorter<T, Less> sorter{
+      begin, static_cast<uint32_t>(end - begin), less};
+  return sorter.sort();
+}
 
 } // namespace vm
 } // namespace hermes
@@ -51,19 +51,30 @@ class JSMapImpl final : public JSObject {
     return ExecutionStatus::RETURNED;
   }
 
-  /// Advance iterator and return the next.
-  HashMapEntry *iteratorNext(Runtime &runtime, HashMapEntry *entry) {
-    return storage_.getNonNull(runtime)->iteratorNext(runtime, entry);
+  /// Advance the iteration cursor \p table, \p pos to the next entry.
+  /// \return false if there is none. See OrderedHashMap::iteratorNext().
+  bool iteratorNext(Runtime &runtime, SegmentedArray *&table, uint32_t &pos) {
+    return storage_.getNonNull(runtime)->iteratorNext(runtime, table, pos);
+  }
+
+  /// \return the key of the entry at position \p pos.
+  HermesValue keyAt(Runtime &runtime, uint32_t pos) {
+    return storage_.getNonNull(runtime)->keyAt(runtime, pos);
+  }
+
+  /// \return the value of the entry at position \p pos.
+  HermesValue valueAt(Runtime &runtime, uint32_t pos) {
+    return storage_.getNonNull(runtime)->valueAt(runtime, pos);
   }
 
   /// Add a value.
-  static void addValue(
+  static ExecutionStatus addValue(
       Handle<JSMapImpl> self,
       Runtime &runtime,
       Handle<> key,
       Handle<> value) {
     self->assertInitialized();
-    OrderedHashMap::insert(
+    return OrderedHashMap::insert(
         runtime.makeHandle<OrderedHashMap>(self->storage_),
         runtime,
         key,
@@ -99,9 +110,10 @@ class JSMapImpl final : public JSObject {
   }
 
   /// Clear all elements from the storage.
-  static void clear(Handle<JSMapImpl> self, Runtime &runtime) {
+  static ExecutionStatus clear(Handle<JSMapImpl> self, Runtime &runtime) {
     self->assertInitialized();
-    self->storage_.getNonNull(runtime)->clear(runtime);
+    return OrderedHashMap::clear(
+        runtime.makeHandle<OrderedHashMap>(self->storage_), runtime);
   }
 
   /// Call \p callbackfn for each entry, with \p thisArg as this.
@@ -111,15 +123,20 @@ class JSMapImpl final : public JSObject {
       Handle<Callable> callbackfn,
       Handle<> thisArg) {
     self->assertInitialized();
-    MutableHandle<HashMapEntry> entry{runtime};
+    // The cursor's table is kept alive by a handle, since the callback may
+    // rehash the storage.
+    MutableHandle<SegmentedArray> table{runtime};
+    uint32_t pos = 0;
     GCScopeMarkerRAII marker{runtime};
-    for (entry = self->storage_.getNonNull(runtime)->iteratorNext(runtime);
-         entry;
-         entry = self->storage_.getNonNull(runtime)->iteratorNext(
-             runtime, entry.get())) {
+    for (;;) {
       marker.flush();
-      HermesValue key = entry->key;
-      HermesValue value = entry->value;
+      SegmentedArray *cursorTable = table.get();
+      if (!self->iteratorNext(runtime, cursorTable, pos))
+        break;
+      table = cursorTable;
+      HermesValue key = self->keyAt(runtime, pos);
+      HermesValue value = self->valueAt(runtime, pos);
+      ++pos;
       assert(!key.isEmpty() && "Invalid key encountered");
       assert(!value.isEmpty() && "Invalid value encountered");
       if (LLVM_UNLIKELY(
@@ -213,30 +230,31 @@ class JSMapIteratorImpl final : public JSObject {
       // Iteration has not yet reached the end previously.
       assert(self->data_ && "Storage uninitialized");
       // Advance the iterator.
-      self->itr_.set(
-          runtime,
-          self->data_.getNonNull(runtime)->iteratorNext(
-              runtime, self->itr_.get(runtime)),
-          runtime.getHeap());
-      if (self->itr_) {
+      SegmentedArray *table = self->itrTable_.get(runtime);
+      uint32_t pos = self->itrPos_;
+      if (self->data_.getNonNull(runtime)->iteratorNext(runtime, table, pos)) {
+        // Resume after this entry next time.
+        self->itrTable_.set(runtime, table, runtime.getHeap());
+        self->itrPos_ = pos + 1;
         switch (self->iterationKind_) {
           case IterationKind::Key:
-            value = self->itr_.getNonNull(runtime)->key;
+            value = self->data_.getNonNull(runtime)->keyAt(runtime, pos);
             break;
           case IterationKind::Value:
-            value = self->itr_.getNonNull(runtime)->value;
+            value = self->data_.getNonNull(runtime)->valueAt(runtime, pos);
             break;
           case IterationKind::Entry: {
             // If we are iterating both key and value, we need to create an
-            // array.
+            // array. No JS runs until the entry is read, so it stays at the
+            // same position.
             auto arrRes = JSArray::create(runtime, 2, 2);
             if (arrRes == ExecutionStatus::EXCEPTION) {
               return ExecutionStatus::EXCEPTION;
             }
             auto arrHandle = *arrRes;
-            value = self->itr_.getNonNull(runtime)->key;
+            value = self->data_.getNonNull(runtime)->keyAt(runtime, pos);
             JSArray::setElementAt(arrHandle, runtime, 0, value);
-            value = self->itr_.getNonNull(runtime)->value;
+            value = self->data_.getNonNull(runtime)->valueAt(runtime, pos);
             JSArray::setElementAt(arrHandle, runtime, 1, value);
             value = arrHandle.getHermesValue();
             break;
@@ -250,6 +268,7 @@ class JSMapIteratorImpl final : public JSObject {
         // reached the end.
         self->iterationFinished_ = true;
         self->data_.setNull(runtime.getHeap());
+        self->itrTable_.setNull(runtime.getHeap());
       }
     }
     return createIterResultObject(runtime, value, self->iterationFinished_)
@@ -272,8 +291,11 @@ class JSMapIteratorImpl final : public JSObject {
   /// initialized or the iteration has ended.
   GCPointer<JSMapImpl<JSMapTypeTraits<C>::ContainerKind>> data_{nullptr};
 
-  /// Iteration pointer to the element storage in the Map.
-  GCPointer<HashMapEntry> itr_{nullptr};
+  /// The iteration cursor in the element storage of the Map: the entry table
+  /// and the position of the next entry to visit in it. A null table means
+  /// that the iteration has not started.
+  GCPointer<SegmentedArray> itrTable_{nullptr};
+  uint32_t itrPos_{0};
 
   IterationKind iterationKind_;
 
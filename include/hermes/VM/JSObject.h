@@ -433,6 +433,11 @@ class JSObject : public GCCell {
     return flags_.proxyObject;
   }
 
+  /// \return true if this object has indexed storage.
+  bool hasIndexedStorage() const {
+    return flags_.indexedStorage;
+  }
+
   /// \return true if this object has fast indexed storage, meaning no property
   ///   checks need to be made when reading an indexed value.
   bool hasFastIndexProperties() const {
@@ -909,8 +914,8 @@ class JSObject : public GCCell {
   /// The following three methods implement ES5.1 8.12.3.
   /// getNamed is an optimized path for getting a property with a SymbolID when
   /// it is statically known that the SymbolID is not index-like.
-  /// If \p cacheEntry is not null, and the result is suitable for use in a
-  /// property cache, populate the cache.
+  /// If \p cacheEntry is not null, and the result is an own property of
+  /// \p selfHandle suitable for use in a property cache, populate the cache.
   static CallResult<PseudoHandle<>> getNamed_RJS(
       Handle<JSObject> selfHandle,
       Runtime &runtime,
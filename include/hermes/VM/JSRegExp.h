@@ -10,6 +10,7 @@
 
 #include "hermes/Regex/RegexTypes.h"
 #include "hermes/VM/JSObject.h"
+#include "hermes/VM/RegExpCache.h"
 #include "hermes/VM/RegExpMatch.h"
 #include "hermes/VM/SmallXString.h"
 
@@ -45,6 +46,8 @@ class JSRegExp final : public JSObject {
   /// Initializes RegExp with existing bytecode. Populates fields for the
   /// pattern and flags, but performs no validation on them. It is assumed that
   /// the bytecode is correct and corresponds to the given pattern/flags.
+  /// The bytecode is shared with the runtime's RegExpCache rather than copied
+  /// when it has the same pattern and flags cached.
   static void initialize(
       Handle<JSRegExp> selfHandle,
       Runtime &runtime,
@@ -54,7 +57,7 @@ class JSRegExp final : public JSObject {
 
   /// Initialize a RegExp based on another RegExp \p otherHandle. If \p flags
   /// matches the internal flags of the other RegExp, this lets us avoid
-  /// recompiling by just copying the bytecode.
+  /// recompiling by just sharing its bytecode.
   static ExecutionStatus initialize(
       Handle<JSRegExp> selfHandle,
       Runtime &runtime,
@@ -65,7 +68,8 @@ class JSRegExp final : public JSObject {
   /// error. If valid, set the source and flags to the given strings, and set
   /// the standard properties of the RegExp according to the flags. Note that
   /// RegExps are not mutable (with the exception of the lastIndex property).
-  /// Compiles the \p pattern and \p flags to RegExp bytecode.
+  /// Compiles the \p pattern and \p flags to RegExp bytecode, unless the
+  /// runtime's RegExpCache already has it.
   static ExecutionStatus initialize(
       Handle<JSRegExp> selfHandle,
       Runtime &runtime,
@@ -124,8 +128,20 @@ class JSRegExp final : public JSObject {
  private:
   ~JSRegExp();
 
-  /// Store a copy of the \p bytecode array.
-  void initializeBytecode(llvh::ArrayRef<uint8_t> bytecode);
+  /// Set the pattern and the lastIndex property, which every initialize()
+  /// overload does first.
+  static void initializeProperties(
+      Handle<JSRegExp> selfHandle,
+      Runtime &runtime,
+      Handle<StringPrimitive> pattern);
+
+  /// Use \p bytecode, and the syntax flags in its header.
+  void initializeBytecode(SharedRegExpBytecode bytecode);
+
+  /// \return the bytecode of this RegExp.
+  llvh::ArrayRef<uint8_t> getBytecode() const {
+    return bytecode_->bytes();
+  }
 
   /// The order of properties here is important to avoid wasting space. When
   /// compressed pointers are enabled, JSObject has an odd number of 4 byte
@@ -133,8 +149,9 @@ class JSRegExp final : public JSObject {
   /// that the native pointer is always 8 byte aligned without extra padding.
   GCPointer<StringPrimitive> pattern_;
 
-  uint8_t *bytecode_{};
-  uint32_t bytecodeSize_{0};
+  /// The compiled bytecode, which is immutable and may be shared with other
+  /// RegExps and the runtime's RegExpCache.
+  SharedRegExpBytecode bytecode_{};
 
   regex::SyntaxFlags syntaxFlags_ = {};
 
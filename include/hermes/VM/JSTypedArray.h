@@ -151,6 +151,20 @@ class JSTypedArrayBase : public JSObject {
       size_type size,
       uint8_t byteWidth);
 
+  /// Read the element at \p index, dispatching on the CellKind of this array
+  /// rather than going through the ObjectVTable.
+  /// \return the element, or None if this array is detached or \p index is
+  ///   out of bounds.
+  inline OptValue<HermesValue> getElementFast(
+      Runtime &runtime,
+      uint32_t index);
+
+  /// Convert \p number to the element type of this array and store it at
+  /// \p index, dispatching on the CellKind of this array.
+  /// \return false if this array is detached or \p index is out of bounds,
+  ///   in which case nothing is stored.
+  inline bool putElementFast(Runtime &runtime, uint32_t index, double number);
+
  protected:
   /// buffer_ is the underlying buffer which holds the data to be viewed.
   /// This buffer may be shared with other JSTypedArray instantiations.
@@ -326,6 +340,40 @@ inline double JSTypedArray<double, CellKind::Float64ArrayKind>::toDestType(
   using name##Array = JSTypedArray<type, CellKind::name##ArrayKind>;
 #include "hermes/VM/TypedArrays.def"
 
+inline OptValue<HermesValue> JSTypedArrayBase::getElementFast(
+    Runtime &runtime,
+    uint32_t index) {
+  if (LLVM_UNLIKELY(!attached(runtime) || index >= length_))
+    return llvh::None;
+  switch (getKind()) {
+#define TYPED_ARRAY(name, type)              \
+  case CellKind::name##ArrayKind:            \
+    return SafeNumericEncoder<type>::encode( \
+        vmcast<name##Array>(this)->at(runtime, index));
+#include "hermes/VM/TypedArrays.def"
+    default:
+      llvm_unreachable("Invalid TypedArray kind");
+  }
+}
+
+inline bool JSTypedArrayBase::putElementFast(
+    Runtime &runtime,
+    uint32_t index,
+    double number) {
+  if (LLVM_UNLIKELY(!attached(runtime) || index >= length_))
+    return false;
+  switch (getKind()) {
+#define TYPED_ARRAY(name, type)                    \
+  case CellKind::name##ArrayKind:                  \
+    vmcast<name##Array>(this)->at(runtime, index) = \
+        name##Array::toDestType(number);           \
+    return true;
+#include "hermes/VM/TypedArrays.def"
+    default:
+      llvm_unreachable("Invalid TypedArray kind");
+  }
+}
+
 } // namespace vm
 } // namespace hermes
 
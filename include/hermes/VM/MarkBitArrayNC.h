@@ -55,6 +55,10 @@ class MarkBitArrayNC {
   /// range of the array.
   inline void mark(size_t ind);
 
+  /// Same as \c mark, but safe to call from several threads at once.
+  /// \return true if the bit was not already marked.
+  inline bool atomicMark(size_t ind);
+
   /// Clears the bit array.
   inline void clear();
 
@@ -140,6 +144,11 @@ void MarkBitArrayNC::mark(size_t ind) {
   bitArray_.set(ind, true);
 }
 
+bool MarkBitArrayNC::atomicMark(size_t ind) {
+  assert(ind < kNumBits && "precondition: ind must be within the index range");
+  return bitArray_.atomicSet(ind);
+}
+
 void MarkBitArrayNC::clear() {
   bitArray_.reset();
 }
@@ -9,74 +9,30 @@
 #define HERMES_VM_ORDERED_HASHMAP_H
 
 #include "hermes/Support/ErrorHandling.h"
-#include "hermes/VM/ArrayStorage.h"
 #include "hermes/VM/Runtime.h"
+#include "hermes/VM/SegmentedArray.h"
 
-#include <vector>
+#include <memory>
 
 namespace hermes {
 namespace vm {
 
-/// HashMapEntry is a gc-managed entry in the OrderedHashMap.
-/// We use HashMapEntry to form two separate linked lists,
-/// one that tracks the insertion order for iteration purpose, one
-/// tracks the list of entries in a hash table bucket for hash operations.
-class HashMapEntry final : public GCCell {
- public:
-  static const VTable vt;
-
-  /// The key.
-  GCHermesValue key;
-
-  /// The value.
-  GCHermesValue value;
-
-  /// Previous entry in insertion order.
-  GCPointer<HashMapEntry> prevIterationEntry{nullptr};
-
-  /// Next entry in insertion order.
-  GCPointer<HashMapEntry> nextIterationEntry{nullptr};
-
-  /// Next entry in the hash table bucket.
-  GCPointer<HashMapEntry> nextEntryInBucket{nullptr};
-
-  static constexpr CellKind getCellKind() {
-    return CellKind::HashMapEntryKind;
-  }
-  static bool classof(const GCCell *cell) {
-    return cell->getKind() == CellKind::HashMapEntryKind;
-  }
-
-  static CallResult<PseudoHandle<HashMapEntry>> create(Runtime &runtime);
-
-  /// Indicates whether this entry has been deleted.
-  bool isDeleted() const {
-    assert(key.isEmpty() == value.isEmpty() && "Inconsistent deleted status");
-    return value.isEmpty();
-  }
-
-  /// Mark this entry as deleted.
-  void markDeleted(Runtime &runtime) {
-    key.setNonPtr(HermesValue::encodeEmptyValue(), runtime.getHeap());
-    value.setNonPtr(HermesValue::encodeEmptyValue(), runtime.getHeap());
-  }
-}; // HashMapEntry
-
 /// OrderedHashMap is a gc-managed hash map that maintains insertion order.
-/// The map contains two conceptual parts: a standard chained hash table,
-/// to store and lookup HermesValue; a linked list to maintain the insertion
-/// order.
-/// When an element is added, it's always appended to the end of the linked
-/// list. When an element is deleted, we mark it as deleted and remove it
-/// from the linked list, unless it's the last element.
-/// Iterators are pointers to the entries, which are always linked according
-/// to insertion order.
-/// When the size of the hash table becomes unreasonably large or small
-/// comparing to the number of alive elements, we will rehash the table.
-/// We always make sure that any entry at any moment can successfully find
-/// the next entry according to insertion order, and rely on GC to manage
-/// the "deleted" entries", free them when no more iterators are before
-/// that entry.
+/// It is laid out as a deterministic hash table: the key/value pairs are
+/// stored inline, in insertion order, in a SegmentedArray (the entry table),
+/// and a separate open-addressed index maps hashes to positions in the entry
+/// table. The index only holds uint32_t positions, and lives in native memory
+/// so that its size is not bounded by the maximum size of a GC allocation.
+/// Erasing an entry leaves a hole in the entry table and a tombstone in the
+/// index. When the entry table is full, the live entries are copied in order
+/// to a new table, sized for the number of live entries, and the old table
+/// records a pointer to its replacement. Clearing the map also moves it to a
+/// new, empty table.
+/// Iterators are a cursor made of an entry table and a position in it. A
+/// cursor on a table which has been replaced is moved to the replacement by
+/// counting the live entries before it, so iteration survives erasure,
+/// rehashing and clearing. The table may also be reallocated as it grows, in
+/// which case cursors keep their position.
 class OrderedHashMap final : public GCCell {
   friend void OrderedHashMapBuildMeta(
       const GCCell *cell,
@@ -102,11 +58,6 @@ class OrderedHashMap final : public GCCell {
   static HermesValue
   get(Handle<OrderedHashMap> self, Runtime &runtime, Handle<> key);
 
-  /// Lookup \p key in the table and \return the value if exists.
-  /// Otherwise \return nullptr.
-  static HashMapEntry *
-  find(Handle<OrderedHashMap> self, Runtime &runtime, Handle<> key);
-
   /// Insert a key/value pair into the map, if not already existing.
   static ExecutionStatus insert(
       Handle<OrderedHashMap> self,
@@ -118,74 +69,116 @@ class OrderedHashMap final : public GCCell {
   static bool
   erase(Handle<OrderedHashMap> self, Runtime &runtime, Handle<> key);
 
-  /// Clear the map.  The \p gc parameter is necessary for write barriers.
-  void clear(Runtime &runtime);
+  /// Clear the map.
+  static ExecutionStatus clear(Handle<OrderedHashMap> self, Runtime &runtime);
 
   /// \return the size of the map.
   uint32_t size() const {
     return size_;
   }
 
-  /// \return the next element in insertion order.
-  /// If \p entry is nullptr, we are starting the iteration from the first
-  /// entry that is not deleted.
-  /// Otherwise, we look for the next element after \p entry that is not
-  /// deleted.
-  HashMapEntry *iteratorNext(Runtime &runtime, HashMapEntry *entry = nullptr)
+  /// Advance the iteration cursor made of \p table and \p pos to the first
+  /// live entry at or after \p pos in insertion order. A null \p table starts
+  /// the iteration from the first entry. Callers continue the iteration from
+  /// the position after the returned entry. This never allocates.
+  /// \return true if there is such an entry, in which case \p table is the
+  /// current entry table and \p pos is the position of the entry, which can
+  /// be read with keyAt() and valueAt().
+  bool iteratorNext(Runtime &runtime, SegmentedArray *&table, uint32_t &pos)
       const;
 
-  OrderedHashMap(Runtime &runtime, Handle<ArrayStorageSmall> hashTableStorage);
+  /// \return the key of the entry at position \p pos.
+  HermesValue keyAt(PointerBase &base, uint32_t pos) const {
+    return entries_.getNonNull(base)->at(base, keySlot(pos));
+  }
 
- private:
-  /// The hashtable, with size always equal to capacity_. The number of
-  /// reachable entries from hashTable_ should be equal to size_.
-  GCPointer<ArrayStorageSmall> hashTable_{nullptr};
+  /// \return the value of the entry at position \p pos.
+  HermesValue valueAt(PointerBase &base, uint32_t pos) const {
+    return entries_.getNonNull(base)->at(base, valueSlot(pos));
+  }
 
-  /// The first entry ever inserted. We need this entry to begin an iteration.
-  GCPointer<HashMapEntry> firstIterationEntry_{nullptr};
+  OrderedHashMap(Runtime &runtime, Handle<SegmentedArray> entries);
 
-  /// The last entry inserted. We need it to add new elements afterwards.
-  GCPointer<HashMapEntry> lastIterationEntry_{nullptr};
+ private:
+  /// The entry table, with room for capacity_ entries. The slot at
+  /// kNextTableSlot is empty while the table is in use, and then points to
+  /// the table which replaced it. The slot at kSamePositionsSlot is set to
+  /// true if the entries kept their positions in the replacement. The header
+  /// is followed by the key and the value of each entry, both set to empty
+  /// once the entry is erased.
+  GCPointer<SegmentedArray> entries_{nullptr};
 
-  /// Initial capacity of the hash table.
-  static constexpr uint32_t INITIAL_CAPACITY = 16;
+  /// The open-addressed index, with indexSize_ slots. Each slot holds the
+  /// position of an entry in entries_, kEmptySlot or kDeletedSlot.
+  std::unique_ptr<uint32_t[]> index_;
 
-  /// Maximum capacity cannot exceed the maximum capacity of the underlying
-  /// ArrayStorage.
-  // It needs to be less than 1/4th the max 32-bit integer in order to use an
-  // integer-based load factor check of 0.75.
-  static constexpr uint32_t MAX_CAPACITY =
-      std::min(ArrayStorageSmall::maxElements(), UINT32_MAX / 4);
+  /// Number of slots in index_. It is a power of 2, twice as large as
+  /// capacity_ so that probe sequences stay short.
+  uint32_t indexSize_{0};
 
-  /// Capacity of the hash table.
-  uint32_t capacity_{INITIAL_CAPACITY};
+  /// Number of entries, live or erased, that fit in the entry table.
+  uint32_t capacity_{0};
 
   /// Number of alive entries in the storage.
   uint32_t size_{0};
 
-  /// Hash a HermesValue to an index to our hash table.
-  static uint32_t
-  hashToBucket(Handle<OrderedHashMap> self, Runtime &runtime, Handle<> key) {
-    auto hash = runtime.gcStableHashHermesValue(key);
-    assert(
-        (self->capacity_ & (self->capacity_ - 1)) == 0 &&
-        "capacity_ must be power of 2");
-    return hash & (self->capacity_ - 1);
+  /// Initial capacity of the entry table.
+  static constexpr uint32_t INITIAL_CAPACITY = 8;
+
+  /// Maximum capacity of the entry table. It is a power of 2, small enough
+  /// that the sizes of the entry table and of the index fit in uint32_t.
+  static constexpr uint32_t MAX_CAPACITY = 1u << 26;
+  static_assert(
+      2 + MAX_CAPACITY * 2 <= SegmentedArray::maxElements(),
+      "The entry table cannot hold MAX_CAPACITY entries");
+
+  /// Values of the index slots which don't hold an entry.
+  static constexpr uint32_t kEmptySlot = UINT32_MAX;
+  static constexpr uint32_t kDeletedSlot = UINT32_MAX - 1;
+
+  /// Layout of the entry table.
+  static constexpr uint32_t kNextTableSlot = 0;
+  static constexpr uint32_t kSamePositionsSlot = 1;
+  static constexpr uint32_t kHeaderSize = 2;
+  static uint32_t keySlot(uint32_t pos) {
+    return kHeaderSize + pos * 2;
+  }
+  static uint32_t valueSlot(uint32_t pos) {
+    return kHeaderSize + 1 + pos * 2;
+  }
+
+  /// \return the number of entries, live or erased, in \p table.
+  static uint32_t numEntries(PointerBase &base, const SegmentedArray *table) {
+    return (table->size(base) - kHeaderSize) / 2;
   }
 
-  /// Remove a node from the linked list.
-  void removeLinkedListNode(Runtime &runtime, HashMapEntry *entry, GC &gc);
+  /// \return the hash of \p key used to probe the index.
+  static uint32_t hashKey(Runtime &runtime, Handle<> key) {
+    uint64_t hash = runtime.gcStableHashHermesValue(key);
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+  }
 
-  /// Lookup an entry with key as \p key in a given \p bucket.
-  HashMapEntry *
-  lookupInBucket(Runtime &runtime, uint32_t bucket, HermesValue key);
+  /// Probe the index for \p key, whose hash is \p hash.
+  /// \return the index slot holding its entry if it is in the map. Otherwise
+  /// \return the slot where an entry for it should be recorded.
+  uint32_t findSlot(PointerBase &base, HermesValue key, uint32_t hash) const;
 
-  /// Adjust the capacity of the hashtable and rehash if necessary.
-  /// We make decisions based on the Load Factor (size / capacity).
-  /// Rehash if load factor is outside of the range of [0.25, 0.75].
-  static ExecutionStatus rehashIfNecessary(
+  /// Move the live entries to a new entry table with room for \p newCapacity
+  /// entries, and rebuild the index for it. If \p dropEntries is true, no
+  /// entry is moved, which leaves the map empty.
+  static ExecutionStatus rehash(
       Handle<OrderedHashMap> self,
-      Runtime &runtime);
+      Runtime &runtime,
+      uint32_t newCapacity,
+      bool dropEntries);
+
+  /// \return the native memory used by an index of \p indexSize slots.
+  static uint32_t indexBytes(uint32_t indexSize) {
+    return indexSize * sizeof(uint32_t);
+  }
+
+  static void _finalizeImpl(GCCell *cell, GC &gc);
+  static size_t _mallocSizeImpl(GCCell *cell);
 }; // OrderedHashMap
 } // namespace vm
 } // namespace hermes
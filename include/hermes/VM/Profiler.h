@@ -18,6 +18,7 @@
 #define RECORD_OPCODE_START_TIME               \
   curOpcode = (unsigned)ip->opCode;            \
   runtime.opcodeExecuteFrequency[curOpcode]++; \
+  runtime.recordOpcodeSequence(ip);            \
   startTime = __rdtsc();
 
 #define UPDATE_OPCODE_TIME_SPENT \
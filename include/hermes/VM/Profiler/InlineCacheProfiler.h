@@ -8,9 +8,12 @@
 #ifndef INLINECACHE_PROFILER_H
 #define INLINECACHE_PROFILER_H
 
+#include "hermes/VM/PropertyCache.h"
 #include "hermes/VM/SymbolID.h"
 #include "llvh/ADT/DenseMap.h"
 
+#include <vector>
+
 namespace hermes {
 namespace inst {
 struct Inst;
@@ -55,6 +58,13 @@ class InlineCacheProfiler {
       ++hitCount;
     }
 
+    /// Record that the cache at the source location is in \p state, if that
+    /// differs from the last recorded state.
+    void recordState(PropertyCacheState state) {
+      if (stateChanges.empty() || stateChanges.back().second != state)
+        stateChanges.emplace_back(missCount + hitCount, state);
+    }
+
     /// Total number of inline caching misses at the source location.
     uint64_t missCount{0};
 
@@ -64,6 +74,10 @@ class InlineCacheProfiler {
     /// Internal map that keeps track of the mapping between
     /// <property, object hidden class, cached hidden class> and its frequency.
     llvh::DenseMap<ICMissKey, uint64_t> hiddenClasses;
+
+    /// Each state the cache at the source location has entered, paired with
+    /// the number of accesses at the source location when it did.
+    std::vector<std::pair<uint64_t, PropertyCacheState>> stateChanges;
   };
 
   using ICMissList = std::vector<std::pair<ICSrcKey, ICMiss>>;
@@ -83,6 +97,12 @@ class InlineCacheProfiler {
   /// Record an inline caching hit.
   bool insertICHit(CodeBlock *codeblock, uint32_t instOffset);
 
+  /// Record the state of the inline cache after it has been updated.
+  bool insertICStateChange(
+      CodeBlock *codeblock,
+      uint32_t instOffset,
+      PropertyCacheState state);
+
   /// Get the total number of inline caching misses.
   uint32_t getTotalMisses() {
     return totalMisses_;
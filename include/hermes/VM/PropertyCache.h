@@ -17,6 +17,7 @@ namespace vm {
 using SlotIndex = uint32_t;
 
 class HiddenClass;
+class JSObject;
 
 /// A cache entry for a property lookup.
 /// If the class operation that we are performing
@@ -30,6 +31,150 @@ struct PropertyCacheEntry {
   SlotIndex slot{0};
 };
 
+/// The state of a single property cache site (one GetById or PutById
+/// instruction), as it observes more hidden classes over time.
+enum class PropertyCacheState : uint8_t {
+  /// Nothing has been cached at the site yet.
+  Uninitialized,
+  /// A single hidden class is cached in the primary PropertyCacheEntry.
+  Monomorphic,
+  /// Up to PolymorphicPropertyCacheEntry::kNumEntries additional hidden
+  /// classes are cached next to the primary entry.
+  Polymorphic,
+  /// The site has seen more hidden classes than fit in its own entries. It no
+  /// longer updates them and instead consults the runtime-wide
+  /// MegamorphicPropertyCache.
+  Megamorphic,
+};
+
+/// \return a printable name for \p state.
+inline const char *propertyCacheStateName(PropertyCacheState state) {
+  switch (state) {
+    case PropertyCacheState::Uninitialized:
+      return "uninitialized";
+    case PropertyCacheState::Monomorphic:
+      return "monomorphic";
+    case PropertyCacheState::Polymorphic:
+      return "polymorphic";
+    case PropertyCacheState::Megamorphic:
+      return "megamorphic";
+  }
+  return "unknown";
+}
+
+/// Secondary entries of a property cache site which has observed more than
+/// one hidden class. These are only allocated once a site goes polymorphic,
+/// so monomorphic code pays nothing for them. The primary PropertyCacheEntry
+/// is always checked first, and these entries are checked on a primary miss.
+struct PolymorphicPropertyCacheEntry {
+  /// Number of secondary entries. Together with the primary entry, a site can
+  /// cache up to kNumEntries + 1 hidden classes.
+  static constexpr unsigned kNumEntries = 3;
+
+  /// Secondary (class, slot) pairs. Entries whose class has been collected are
+  /// cleared by the GC and are reused by subsequent insertions.
+  PropertyCacheEntry entries[kNumEntries];
+
+  /// Set when an insertion found no free entry. A megamorphic site stops
+  /// updating its own entries.
+  bool megamorphic{false};
+
+  /// \return the entry caching \p clazz, or nullptr if there is none.
+  const PropertyCacheEntry *find(CompressedPointer clazz) const {
+    for (const PropertyCacheEntry &entry : entries) {
+      if (entry.clazz == clazz)
+        return &entry;
+    }
+    return nullptr;
+  }
+};
+
+/// A cache entry for a property read which resolves on the prototype chain of
+/// the receiver rather than on the receiver itself.
+/// The entry hits when the receiver has class \c receiverClazz and each of
+/// the first \c depth objects on its prototype chain is the recorded object,
+/// still with the recorded class. Since none of these classes is a
+/// dictionary, this proves that the receiver and the intermediate prototypes
+/// still lack the property, and that the last prototype (the holder) still
+/// has it at \c slot. No property lookup is needed on a hit.
+struct PrototypeCacheEntry {
+  /// Maximum number of prototype links followed by an entry.
+  static constexpr unsigned kMaxDepth = 3;
+
+  /// One object on the prototype chain and the class it had when the entry
+  /// was created.
+  struct Link {
+    WeakRoot<JSObject> object{nullptr};
+    WeakRoot<HiddenClass> clazz{nullptr};
+  };
+
+  /// Class of the receiver, which does not have the property.
+  WeakRoot<HiddenClass> receiverClazz{nullptr};
+
+  /// Property index in the holder, which is chain[depth - 1].
+  SlotIndex slot{0};
+
+  /// Number of valid links in \c chain, 0 if the entry is empty.
+  uint8_t depth{0};
+
+  /// The prototype chain of the receiver, starting with its parent.
+  Link chain[kMaxDepth];
+};
+
+/// A small direct-mapped cache keyed by (hidden class, property name), shared
+/// by all megamorphic property cache sites of a runtime. Collisions simply
+/// overwrite the previous entry.
+class MegamorphicPropertyCache {
+ public:
+  /// Number of entries in the cache. Must be a power of two.
+  static constexpr unsigned kSize = 512;
+
+  /// \return the cached entry for property \p id of objects with class
+  /// \p clazz, or nullptr if it isn't cached.
+  const PropertyCacheEntry *find(CompressedPointer clazz, SymbolID id) const {
+    const Entry &e = entries_[index(clazz, id)];
+    return e.cache.clazz == clazz && e.id == id ? &e.cache : nullptr;
+  }
+
+  /// Cache \p slot as the location of property \p id for class \p clazz.
+  void insert(CompressedPointer clazz, SymbolID id, SlotIndex slot) {
+    Entry &e = entries_[index(clazz, id)];
+    e.cache.clazz = clazz;
+    e.cache.slot = slot;
+    e.id = id;
+  }
+
+  /// Mark the cached classes as weak roots. The property names do not need to
+  /// be marked: a live class keeps the names of its properties alive, and an
+  /// entry with a dead class can never match.
+  template <typename Acceptor>
+  void markWeakRoots(Acceptor &acceptor) {
+    for (Entry &e : entries_) {
+      if (e.cache.clazz)
+        acceptor.acceptWeak(e.cache.clazz);
+    }
+  }
+
+ private:
+  struct Entry {
+    PropertyCacheEntry cache;
+    SymbolID id;
+  };
+
+  static_assert(
+      (kSize & (kSize - 1)) == 0,
+      "MegamorphicPropertyCache size must be a power of two");
+
+  static unsigned index(CompressedPointer clazz, SymbolID id) {
+    // Hidden classes are at least 8-byte aligned, so drop the low bits.
+    auto raw = static_cast<uint64_t>(clazz.getRaw()) >> 3;
+    return (raw ^ (raw >> 9) ^ (id.unsafeGetRaw() * 0x9E3779B1u)) &
+        (kSize - 1);
+  }
+
+  Entry entries_[kSize];
+};
+
 } // namespace vm
 } // namespace hermes
 #endif // PROJECT_PROPERTYCACHE_H
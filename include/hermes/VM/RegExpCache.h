@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_REGEXPCACHE_H
+#define HERMES_VM_REGEXPCACHE_H
+
+#include "hermes/VM/GCDecl.h"
+
+#include "llvh/ADT/ArrayRef.h"
+#include "llvh/ADT/IntrusiveRefCntPtr.h"
+#include "llvh/ADT/SmallVector.h"
+#include "llvh/ADT/StringMap.h"
+
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+/// Compiled regex bytecode. It is immutable once created, so it is shared
+/// between all the JSRegExps with the same pattern and flags. It is reference
+/// counted atomically, since JSRegExps may be finalized off the mutator
+/// thread.
+class RegExpBytecodeBuffer
+    : public llvh::ThreadSafeRefCountedBase<RegExpBytecodeBuffer> {
+ public:
+  RegExpBytecodeBuffer(GC &gc, llvh::ArrayRef<uint8_t> bytes)
+      : gc_(gc), bytes_(bytes.begin(), bytes.end()) {}
+
+  /// Releases the native ID of this buffer in heap snapshots.
+  ~RegExpBytecodeBuffer();
+
+  llvh::ArrayRef<uint8_t> bytes() const {
+    return bytes_;
+  }
+
+ private:
+  GC &gc_;
+  const std::vector<uint8_t> bytes_;
+};
+
+using SharedRegExpBytecode =
+    llvh::IntrusiveRefCntPtr<const RegExpBytecodeBuffer>;
+
+/// A bounded cache of compiled regex bytecode, keyed by pattern and flags, so
+/// that creating the same RegExp repeatedly neither recompiles its pattern nor
+/// copies its bytecode. When full, the least recently used entry is evicted.
+class RegExpCache {
+ public:
+  /// Maximum number of cached patterns.
+  static constexpr size_t kCapacity = 64;
+
+  /// Patterns longer than this are not cached, to bound the memory held by
+  /// the cache.
+  static constexpr size_t kMaxPatternLength = 1024;
+
+  explicit RegExpCache(GC &gc) : gc_(gc) {}
+
+  /// \return new shared bytecode holding a copy of \p bytecode.
+  SharedRegExpBytecode create(llvh::ArrayRef<uint8_t> bytecode) const {
+    return SharedRegExpBytecode(new RegExpBytecodeBuffer(gc_, bytecode));
+  }
+
+  /// \return the cached bytecode for the pattern \p pattern compiled with the
+  /// flags \p flags (see regex::SyntaxFlags::toByte()), or null if there is
+  /// none.
+  SharedRegExpBytecode lookup(llvh::ArrayRef<char16_t> pattern, uint8_t flags);
+
+  /// Cache \p bytecode as the result of compiling \p pattern with \p flags,
+  /// evicting the least recently used entry if the cache is full.
+  void insert(
+      llvh::ArrayRef<char16_t> pattern,
+      uint8_t flags,
+      SharedRegExpBytecode bytecode);
+
+  /// Drop every cached entry.
+  void clear() {
+    entries_.clear();
+  }
+
+  /// \return the number of cached entries.
+  size_t size() const {
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    SharedRegExpBytecode bytecode;
+
+    /// The value of useCount_ when this entry was last used.
+    uint64_t lastUse;
+  };
+
+  /// The key of the pattern \p pattern with the flags \p flags: the flags
+  /// byte followed by the code units of the pattern.
+  using Key = llvh::SmallVector<char, 64>;
+  static void makeKey(
+      llvh::ArrayRef<char16_t> pattern,
+      uint8_t flags,
+      Key &key);
+
+  GC &gc_;
+
+  llvh::StringMap<Entry> entries_;
+
+  /// Incremented on every use of an entry, to order entries by recency.
+  uint64_t useCount_{0};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_REGEXPCACHE_H
@@ -26,11 +26,13 @@
 #include "hermes/VM/IdentifierTable.h"
 #include "hermes/VM/InternalProperty.h"
 #include "hermes/VM/InterpreterState.h"
+#include "hermes/VM/JIT/JIT.h"
 #include "hermes/VM/PointerBase.h"
 #include "hermes/VM/Predefined.h"
 #include "hermes/VM/Profiler.h"
 #include "hermes/VM/PropertyCache.h"
 #include "hermes/VM/PropertyDescriptor.h"
+#include "hermes/VM/RegExpCache.h"
 #include "hermes/VM/RegExpMatch.h"
 #include "hermes/VM/RuntimeModule.h"
 #include "hermes/VM/RuntimeStats.h"
@@ -567,6 +569,18 @@ class Runtime : public HandleRootOwner,
     return runtimeStats_;
   }
 
+  /// \return the cache of compiled regex bytecode.
+  RegExpCache &getRegExpCache() {
+    return regExpCache_;
+  }
+
+#ifdef HERMESVM_JIT
+  /// \return the state of the baseline JIT.
+  JITContext &getJITContext() {
+    return jitContext_;
+  }
+#endif
+
   /// Print the heap and other misc. stats to the given stream.
   void printHeapStats(llvh::raw_ostream &os);
 
@@ -779,8 +793,34 @@ class Runtime : public HandleRootOwner,
   /// Track time spent of each opcode in the interpreter, in CPU cycles.
   uint64_t timeSpent[256] = {0};
 
+  /// Track the frequency of each pair of opcodes executed one after the
+  /// other, where the second instruction immediately follows the first one in
+  /// the bytecode. Indexed by the first opcode, then the second one.
+  uint32_t opcodePairFrequency[256][256] = {};
+
+  /// Track the frequency of each triple of opcodes executed like the pairs
+  /// above. The key packs the three opcodes, first one in the highest byte.
+  llvh::DenseMap<uint32_t, uint32_t> opcodeTripleFrequency{};
+
+  /// Update the pair and triple frequencies with the instruction \p ip, which
+  /// is about to be executed.
+  void recordOpcodeSequence(const inst::Inst *ip);
+
   /// Dump opcode stats to a stream.
   void dumpOpcodeStats(llvh::raw_ostream &os) const;
+
+ private:
+  /// The opcodes of the last two instructions executed, most recent first.
+  uint8_t lastOpcodes_[2]{};
+
+  /// The end of the last instruction executed.
+  const uint8_t *lastInstEnd_{nullptr};
+
+  /// Whether the last instruction executed immediately followed the one
+  /// before it.
+  bool lastInstFollowed_{false};
+
+ public:
 #endif
 
 #if defined(HERMESVM_PROFILER_JSFUNCTION) || defined(HERMESVM_PROFILER_EXTERN)
@@ -852,6 +892,14 @@ class Runtime : public HandleRootOwner,
     return hasIntl_;
   }
 
+  bool enableRegexAutomaton() const {
+    return enableRegexAutomaton_;
+  }
+
+  bool forceRegexAutomaton() const {
+    return forceRegexAutomaton_;
+  }
+
   bool useJobQueue() const {
     return getVMExperimentFlags() & experiments::JobQueue;
   }
@@ -944,6 +992,13 @@ class Runtime : public HandleRootOwner,
       HiddenClass *objectHiddenClass,
       HiddenClass *cachedHiddenClass);
 
+  /// Records the state of the property cache site at \p cacheInst after a
+  /// cache update in InlineCacheProfiler.
+  void recordPropertyCacheState(
+      CodeBlock *codeBlock,
+      const Inst *cacheInst,
+      PropertyCacheState state);
+
   /// Resolve HiddenClass pointers from its hidden class Id.
   HiddenClass *resolveHiddenClassId(ClassId classId);
 
@@ -1117,6 +1172,12 @@ class Runtime : public HandleRootOwner,
   /// Set to true if we should enable ECMA-402 Intl APIs.
   const bool hasIntl_;
 
+  /// Set to true if regexes may fall back to their automaton.
+  const bool enableRegexAutomaton_;
+
+  /// Set to true if regexes should always use their automaton.
+  const bool forceRegexAutomaton_;
+
   /// Set to true if we should randomize stack placement etc.
   const bool shouldRandomizeMemoryLayout_;
 
@@ -1138,9 +1199,16 @@ class Runtime : public HandleRootOwner,
   /// bit values, typically 1 as test and 0 as control.
   experiments::VMExperimentFlags vmExperimentFlags_{experiments::Default};
 
+#ifdef HERMESVM_JIT
+  /// Compiled code and compilation policy of the baseline JIT.
+  JITContext jitContext_;
+#endif
+
   friend class GCScope;
   friend class HandleBase;
   friend class Interpreter;
+  friend class JITContext;
+  friend class JITHelpers;
   friend class RuntimeModule;
   friend class MarkRootsPhaseTimer;
   friend struct RuntimeOffsets;
@@ -1172,6 +1240,10 @@ class Runtime : public HandleRootOwner,
   /// Set of runtime statistics.
   instrumentation::RuntimeStats runtimeStats_;
 
+  /// Compiled regex bytecode shared between RegExps with the same pattern and
+  /// flags.
+  RegExpCache regExpCache_;
+
   /// Shared location to place native objects required by JSLib
   std::shared_ptr<RuntimeCommonStorage> commonStorage_;
 
@@ -1225,6 +1297,12 @@ class Runtime : public HandleRootOwner,
   /// Cache for property lookups in non-JS code.
   PropertyCacheEntry fixedPropCache_[(size_t)PropCacheID::_COUNT];
 
+  /// Caches shared by all megamorphic GetById and PutById sites respectively.
+  /// They are separate because a slot that can be read from the cache may not
+  /// be writable.
+  MegamorphicPropertyCache megamorphicReadCache_;
+  MegamorphicPropertyCache megamorphicWriteCache_;
+
   /// StringPrimitive representation of the first 256 characters.
   /// These are allocated as "long-lived" objects, so they don't need
   /// to be scanned as roots in young-gen collections.
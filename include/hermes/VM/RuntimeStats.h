@@ -51,6 +51,11 @@ struct RuntimeStats {
   /// Measure of of jsi Function calls (incoming to VM).
   Statistic incomingFunction;
 
+  /// Number of RegExps whose bytecode was found in, or had to be added to, the
+  /// runtime's RegExpCache.
+  uint64_t regExpCacheHits{0};
+  uint64_t regExpCacheMisses{0};
+
   /// The topmost RAIITimer in the stack.
   RAIITimer *timerStack{nullptr};
 
@@ -35,6 +35,10 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   friend class StringView;
   template <typename T>
   friend class BufferedStringPrimitive;
+  template <typename T>
+  friend class RopeStringPrimitive;
+  template <typename T>
+  friend class SlicedStringPrimitive;
 
   friend llvh::raw_ostream &operator<<(
       llvh::raw_ostream &OS,
@@ -125,11 +129,21 @@ class StringPrimitive : public VariableSizeRuntimeCell {
       COPYABLE_BASIC_STRING_MIN_LENGTH;
 
   /// Concatenation resulting in this size or larger will use
-  /// BufferedStringPrimitive. We want to ensure that they satisfy the
-  /// requirements for external strings.
+  /// BufferedStringPrimitive or RopeStringPrimitive. We want to ensure that
+  /// they satisfy the requirements for external strings.
   static constexpr uint32_t CONCAT_STRING_MIN_SIZE =
       std::max(256u, EXTERNAL_STRING_MIN_SIZE);
 
+  /// Slices shorter than this are copied, since the copy takes about as much
+  /// space as a SlicedStringPrimitive and is faster to read.
+  static constexpr uint32_t SLICED_STRING_MIN_SIZE = 32;
+
+  /// Slices of strings at least this long are copied when they are shorter
+  /// than 1/SLICED_STRING_MAX_PARENT_RATIO of the string, so that a small
+  /// slice does not keep a huge string alive.
+  static constexpr uint32_t SLICED_STRING_HUGE_PARENT_SIZE = 1u << 16;
+  static constexpr uint32_t SLICED_STRING_MAX_PARENT_RATIO = 16;
+
   static bool classof(const GCCell *cell) {
     return kindInRange(
         cell->getKind(),
@@ -243,6 +257,8 @@ class StringPrimitive : public VariableSizeRuntimeCell {
       Handle<StringPrimitive> yHandle);
 
   /// Slice the StringPrimitive at \p str, \p length characters at \p start.
+  /// Long slices share the characters of \p str rather than copying them,
+  /// see SlicedStringPrimitive.
   /// \return new StringPrimitive, representing the sliced string.
   static CallResult<HermesValue> slice(
       Runtime &runtime,
@@ -251,20 +267,15 @@ class StringPrimitive : public VariableSizeRuntimeCell {
       size_t length);
 
   /// Flatten the string if it's a rope, possibly causing allocation/GC.
-  static Handle<StringPrimitive> ensureFlat(
+  static inline Handle<StringPrimitive> ensureFlat(
       Runtime &runtime,
-      Handle<StringPrimitive> self) {
-    // In the future, ensureFlat may trigger GC as it might allocate for
-    // ropes. Move the heap here.
-    runtime.potentiallyMoveHeap();
-    return self;
-    // TODO: Deal with different subclasses (e.g. rope)
-  }
+      Handle<StringPrimitive> self);
 
   /// \return true if the string is flat.
-  bool isFlat() const {
-    return true;
-  }
+  inline bool isFlat() const;
+
+  /// \return whether this is a rope.
+  inline bool isRope() const;
 
   /// \return a StringView of this string. In the case of a rope, we will need
   /// to resolve the rope, which might involve object allocations.
@@ -339,6 +350,12 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   /// it is safe to call this function which guarantees to not trigger gc.
   static StringView createStringViewMustBeFlat(Handle<StringPrimitive> self);
 
+  /// Call \p callback on each of the flat strings that \p str consists of,
+  /// in order. That is only \p str itself, unless it is a rope which has not
+  /// been flattened yet.
+  template <typename F>
+  static void forEachFlatPiece(const StringPrimitive *str, F callback);
+
  protected:
   /// \return whether the StringPrimitive can be converted from non-uniqued to
   /// uniqued without reallocating.
@@ -761,17 +778,229 @@ inline bool isBufferedStringPrimitive(const GCCell *cell) {
       cell->getKind() == CellKind::BufferedASCIIStringPrimitiveKind;
 }
 
+/// An immutable JavaScript primitive string which is the concatenation of two
+/// other strings, its left and right children, without a copy of their
+/// characters. Concatenations that would have to copy a long string, such as
+/// prepending to it or wrapping it, produce a rope instead of a
+/// BufferedStringPrimitive, so that building a string out of a tree of
+/// concatenations takes linear rather than quadratic time.
+///
+/// The characters are copied into a buffer outside the JS heap the first time
+/// they are read. StringView does this through ensureFlat(), which then also
+/// drops the children and charges the buffer as external memory. Readers that
+/// cannot reach the GC, such as equals(), flatten the rope too, but keep the
+/// children alive until the next ensureFlat() or until the rope is collected.
+template <typename T>
+class RopeStringPrimitive final : public StringPrimitive {
+  template <typename U>
+  friend class RopeStringPrimitive;
+  friend class StringPrimitive;
+  friend PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
+      Runtime &runtime,
+      Handle<StringPrimitive> leftHnd,
+      Handle<StringPrimitive> rightHnd);
+  friend void RopeASCIIStringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+  friend void RopeUTF16StringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+
+ public:
+  /// \return the cell kind for this string.
+  static constexpr CellKind getCellKind() {
+    return std::is_same<T, char16_t>::value
+        ? CellKind::RopeUTF16StringPrimitiveKind
+        : CellKind::RopeASCIIStringPrimitiveKind;
+  }
+
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == RopeStringPrimitive::getCellKind();
+  }
+
+  /// Ropes deeper than this are no longer extended by short strings, see
+  /// internalConcatStringPrimitives().
+  static constexpr uint32_t MAX_ROPE_DEPTH = 64;
+
+ private:
+  static const VTable vt;
+
+ public:
+  /// Construct a rope for the concatenation of \p left and \p right.
+  RopeStringPrimitive(
+      Runtime &runtime,
+      Handle<StringPrimitive> left,
+      Handle<StringPrimitive> right)
+      : StringPrimitive(left->getStringLength() + right->getStringLength()),
+        depth_(1 + std::max(depthOf(*left), depthOf(*right))) {
+    leftHV_.set(HermesValue::encodeStringValue(*left), runtime.getHeap());
+    rightHV_.set(HermesValue::encodeStringValue(*right), runtime.getHeap());
+  }
+
+  /// \return the number of ropes which have not been flattened yet on the
+  /// longest path from \p str to a flat string, including \p str itself.
+  static uint32_t depthOf(const StringPrimitive *str);
+
+  /// \return whether the characters have been copied into a flat buffer.
+  bool isFlattened() const {
+    return flat_ != nullptr;
+  }
+
+ private:
+  /// Allocate a rope for the concatenation of \p leftHnd and \p rightHnd.
+  /// \pre The types must be compatible with respect to T (cannot append UTF16
+  /// to ASCII) and the combined length must have been validated.
+  static PseudoHandle<StringPrimitive> create(
+      Runtime &runtime,
+      Handle<StringPrimitive> leftHnd,
+      Handle<StringPrimitive> rightHnd);
+
+  /// \return whether the rope still refers to its children.
+  bool hasChildren() const {
+    return !leftHV_.isEmpty();
+  }
+
+  /// Copy the characters of the children into a flat buffer, if that has not
+  /// been done yet. This does not allocate in the JS heap.
+  void flattenContents() const;
+
+  /// Flatten the rope and drop its children, charging the flat buffer as
+  /// external memory of this cell.
+  void flatten(GC &gc);
+
+  /// \return a const pointer to the first character of the string.
+  const T *getRawPointer() const {
+    if (LLVM_UNLIKELY(!isFlattened()))
+      flattenContents();
+    return flat_;
+  }
+
+  size_t calcExternalMemorySize() const {
+    return isFlattened() ? getStringLength() * sizeof(T) : 0;
+  }
+
+  /// Finalizer to free the flat buffer.
+  static void _finalizeImpl(GCCell *cell, GC &gc);
+
+  /// \return the size of the flat buffer of \p cell, if it has one.
+  static size_t _mallocSizeImpl(GCCell *cell);
+
+  static std::string _snapshotNameImpl(GCCell *cell, GC &gc);
+  static void _snapshotAddEdgesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap);
+  static void _snapshotAddNodesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap);
+
+  /// The strings this is the concatenation of. Both are empty once the rope
+  /// has been flattened by ensureFlat().
+  GCHermesValue leftHV_;
+  GCHermesValue rightHV_;
+
+  /// See depthOf(), which ignores this once the rope is flattened.
+  uint32_t depth_;
+
+  /// The characters of the string once it has been flattened, allocated with
+  /// malloc. Flattening does not change the value of the string, so it is
+  /// allowed through const accessors.
+  mutable T *flat_{nullptr};
+};
+
+/// \return true if this is one of the RopeStringPrimitive classes.
+inline bool isRopeStringPrimitive(const GCCell *cell) {
+  return cell->getKind() == CellKind::RopeUTF16StringPrimitiveKind ||
+      cell->getKind() == CellKind::RopeASCIIStringPrimitiveKind;
+}
+
+/// An immutable JavaScript primitive string which is a range of the characters
+/// of another flat string, its parent, without a copy of them. The parent may
+/// be moved by the GC, so the characters are always found through the parent
+/// rather than cached. Slices of a sliced string share the same parent.
+/// StringPrimitive::slice() decides when a slice is worth sharing.
+template <typename T>
+class SlicedStringPrimitive final : public StringPrimitive {
+  friend class StringPrimitive;
+  friend void SlicedASCIIStringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+  friend void SlicedUTF16StringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+
+ public:
+  /// \return the cell kind for this string.
+  static constexpr CellKind getCellKind() {
+    return std::is_same<T, char16_t>::value
+        ? CellKind::SlicedUTF16StringPrimitiveKind
+        : CellKind::SlicedASCIIStringPrimitiveKind;
+  }
+
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == SlicedStringPrimitive::getCellKind();
+  }
+
+ private:
+  static const VTable vt;
+
+ public:
+  /// Construct a slice of \p length characters of \p parent at \p offset.
+  SlicedStringPrimitive(
+      Runtime &runtime,
+      Handle<StringPrimitive> parent,
+      uint32_t offset,
+      uint32_t length)
+      : StringPrimitive(length), offset_(offset) {
+    parentHV_.set(HermesValue::encodeStringValue(*parent), runtime.getHeap());
+  }
+
+  /// \return the string whose characters this slice refers to.
+  StringPrimitive *getParent() const {
+    return vmcast<StringPrimitive>(parentHV_);
+  }
+
+  /// \return the index of the first character of this slice in its parent.
+  uint32_t getOffset() const {
+    return offset_;
+  }
+
+ private:
+  /// Allocate a slice of \p length characters of \p parent at \p offset.
+  /// \pre \p parent is flat, is not itself a slice, and has the same
+  /// character type T.
+  static PseudoHandle<StringPrimitive> create(
+      Runtime &runtime,
+      Handle<StringPrimitive> parent,
+      uint32_t offset,
+      uint32_t length);
+
+  /// \return a const pointer to the first character of the string.
+  const T *getRawPointer() const {
+    return getParent()->template castToPointer<T>() + offset_;
+  }
+
+  /// The flat string this is a slice of.
+  GCHermesValue parentHV_;
+
+  /// The index of the first character of the slice in the parent.
+  uint32_t offset_;
+};
+
+/// \return true if this is one of the SlicedStringPrimitive classes.
+inline bool isSlicedStringPrimitive(const GCCell *cell) {
+  return cell->getKind() == CellKind::SlicedUTF16StringPrimitiveKind ||
+      cell->getKind() == CellKind::SlicedASCIIStringPrimitiveKind;
+}
+
 /// This function is not part of the API and is not supposed to be called
 /// directly. It is used internally by StringPrimitive::concat. It is used
 /// to handle the case when the result string exceeds the minimal length for
 /// buffered concatenation, or when the left string is already a
 /// BufferedStringPrimitive. Internally it does the right thing by either
-/// appending to an existing concatenation buffer, if it can, or by allocating a
-/// new one.
+/// appending to an existing concatenation buffer, if it can, by creating a
+/// rope, or by allocating a new buffer.
 /// Some cases where it needs to allocate a new buffer include:
 /// - the left string is not a BufferedStringPrimitive
 /// - appending UTF16 to ASCII
 /// - appending to the middle of the concatenation chain.
+/// Unless only a short string is appended, in which case the new buffer can be
+/// appended to in place next time, a rope is created instead of a new buffer.
 /// \pre The combined length must have been validated by the caller.
 PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
     Runtime &runtime,
@@ -838,6 +1067,42 @@ const VTable BufferedStringPrimitive<T>::vt = VTable(
 using BufferedUTF16StringPrimitive = BufferedStringPrimitive<char16_t>;
 using BufferedASCIIStringPrimitive = BufferedStringPrimitive<char>;
 
+template <typename T>
+const VTable RopeStringPrimitive<T>::vt = VTable(
+    RopeStringPrimitive<T>::getCellKind(),
+    0,
+    RopeStringPrimitive<T>::_finalizeImpl,
+    nullptr, // markWeak.
+    RopeStringPrimitive<T>::_mallocSizeImpl,
+    nullptr,
+    VTable::HeapSnapshotMetadata{
+        HeapSnapshot::NodeType::String,
+        RopeStringPrimitive<T>::_snapshotNameImpl,
+        RopeStringPrimitive<T>::_snapshotAddEdgesImpl,
+        RopeStringPrimitive<T>::_snapshotAddNodesImpl,
+        nullptr});
+
+using RopeUTF16StringPrimitive = RopeStringPrimitive<char16_t>;
+using RopeASCIIStringPrimitive = RopeStringPrimitive<char>;
+
+template <typename T>
+const VTable SlicedStringPrimitive<T>::vt = VTable(
+    SlicedStringPrimitive<T>::getCellKind(),
+    0,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    VTable::HeapSnapshotMetadata{
+        HeapSnapshot::NodeType::String,
+        SlicedStringPrimitive<T>::_snapshotNameImpl,
+        nullptr,
+        nullptr,
+        nullptr});
+
+using SlicedUTF16StringPrimitive = SlicedStringPrimitive<char16_t>;
+using SlicedASCIIStringPrimitive = SlicedStringPrimitive<char>;
+
 //===----------------------------------------------------------------------===//
 // StringPrimitive inline methods.
 
@@ -975,8 +1240,12 @@ inline const char *StringPrimitive::castToASCIIPointer() const {
     return vmcast<DynamicUniquedASCIIStringPrimitive>(this)->getRawPointer();
   } else if (vmisa<DynamicASCIIStringPrimitive>(this)) {
     return vmcast<DynamicASCIIStringPrimitive>(this)->getRawPointer();
-  } else {
+  } else if (vmisa<BufferedASCIIStringPrimitive>(this)) {
     return vmcast<BufferedASCIIStringPrimitive>(this)->getRawPointer();
+  } else if (vmisa<SlicedASCIIStringPrimitive>(this)) {
+    return vmcast<SlicedASCIIStringPrimitive>(this)->getRawPointer();
+  } else {
+    return vmcast<RopeASCIIStringPrimitive>(this)->getRawPointer();
   }
 }
 
@@ -987,8 +1256,12 @@ inline const char16_t *StringPrimitive::castToUTF16Pointer() const {
     return vmcast<DynamicUniquedUTF16StringPrimitive>(this)->getRawPointer();
   } else if (vmisa<DynamicUTF16StringPrimitive>(this)) {
     return vmcast<DynamicUTF16StringPrimitive>(this)->getRawPointer();
-  } else {
+  } else if (vmisa<BufferedUTF16StringPrimitive>(this)) {
     return vmcast<BufferedUTF16StringPrimitive>(this)->getRawPointer();
+  } else if (vmisa<SlicedUTF16StringPrimitive>(this)) {
+    return vmcast<SlicedUTF16StringPrimitive>(this)->getRawPointer();
+  } else {
+    return vmcast<RopeUTF16StringPrimitive>(this)->getRawPointer();
   }
 }
 
@@ -1042,6 +1315,10 @@ inline bool StringPrimitive::isASCII() const {
           CellKind::DynamicASCIIStringPrimitiveKind,
           CellKind::BufferedUTF16StringPrimitiveKind,
           CellKind::BufferedASCIIStringPrimitiveKind,
+          CellKind::RopeUTF16StringPrimitiveKind,
+          CellKind::RopeASCIIStringPrimitiveKind,
+          CellKind::SlicedUTF16StringPrimitiveKind,
+          CellKind::SlicedASCIIStringPrimitiveKind,
           CellKind::DynamicUniquedUTF16StringPrimitiveKind,
           CellKind::DynamicUniquedASCIIStringPrimitiveKind,
           CellKind::ExternalUTF16StringPrimitiveKind,
@@ -1053,6 +1330,32 @@ inline bool StringPrimitive::isASCII() const {
       (static_cast<uint32_t>(CellKind::DynamicASCIIStringPrimitiveKind) & 1u);
 }
 
+inline bool StringPrimitive::isRope() const {
+  return isRopeStringPrimitive(this);
+}
+
+inline bool StringPrimitive::isFlat() const {
+  if (LLVM_LIKELY(!isRope()))
+    return true;
+  return isASCII() ? vmcast<RopeASCIIStringPrimitive>(this)->isFlattened()
+                   : vmcast<RopeUTF16StringPrimitive>(this)->isFlattened();
+}
+
+/*static*/ inline Handle<StringPrimitive> StringPrimitive::ensureFlat(
+    Runtime &runtime,
+    Handle<StringPrimitive> self) {
+  // Flattening a rope only allocates outside of the JS heap, but callers
+  // should not rely on that. Move the heap here.
+  runtime.potentiallyMoveHeap();
+  if (LLVM_UNLIKELY(self->isRope())) {
+    if (self->isASCII())
+      vmcast<RopeASCIIStringPrimitive>(*self)->flatten(runtime.getHeap());
+    else
+      vmcast<RopeUTF16StringPrimitive>(*self)->flatten(runtime.getHeap());
+  }
+  return self;
+}
+
 inline bool StringPrimitive::isExternal() const {
   // We require that external cell kinds be larger than dynamic cell kinds.
   static_assert(
@@ -1061,6 +1364,10 @@ inline bool StringPrimitive::isExternal() const {
           CellKind::DynamicASCIIStringPrimitiveKind,
           CellKind::BufferedUTF16StringPrimitiveKind,
           CellKind::BufferedASCIIStringPrimitiveKind,
+          CellKind::RopeUTF16StringPrimitiveKind,
+          CellKind::RopeASCIIStringPrimitiveKind,
+          CellKind::SlicedUTF16StringPrimitiveKind,
+          CellKind::SlicedASCIIStringPrimitiveKind,
           CellKind::DynamicUniquedUTF16StringPrimitiveKind,
           CellKind::DynamicUniquedASCIIStringPrimitiveKind,
           CellKind::ExternalUTF16StringPrimitiveKind,
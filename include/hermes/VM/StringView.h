@@ -9,6 +9,7 @@
 #define HERMES_VM_STRINGVIEW_H
 
 #include "SmallXString.h"
+#include "hermes/Support/OptValue.h"
 #include "hermes/VM/Runtime.h"
 #include "hermes/VM/StringPrimitive.h"
 #include "hermes/VM/StringRefUtils.h"
@@ -318,6 +319,11 @@ class StringView {
     return slice(first - begin(), last - first);
   }
 
+  /// \return the index of the first occurrence of \p needle in this string
+  /// at or after \p start, or None if there is none. An empty needle is found
+  /// at \p start.
+  OptValue<uint32_t> find(const StringView &needle, uint32_t start = 0) const;
+
   /// \return a UTF16Ref that pointing at the beginning of the string.
   /// If the string is already UTF16, we return the pointer directly;
   /// otherwise (it's ASCII) we copy the string into the end of \p allocator,
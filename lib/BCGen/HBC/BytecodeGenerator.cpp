@@ -8,6 +8,7 @@
 #include "hermes/BCGen/HBC/BytecodeGenerator.h"
 
 #include "hermes/FrontEndDefs/Builtins.h"
+#include "hermes/Inst/InstDecode.h"
 
 #include "llvh/ADT/SmallString.h"
 #include "llvh/Support/Format.h"
@@ -179,6 +180,59 @@ void BytecodeFunctionGenerator::updateJumpTableOffset(
       sizeof(uint32_t));
 }
 
+/// \return the superinstruction fusing \p first with the instruction \p second
+/// following it, or \p first if there is none.
+static Operator superInstruction(Operator first, Operator second) {
+  // These are the most frequent adjacent pairs in opcode profiles, where the
+  // first instruction has a cheap fast path, and the second one a handler
+  // which can be entered directly.
+  switch (first) {
+    case TryGetByIdOp:
+      if (second == GetByIdShortOp)
+        return TryGetByIdThenGetByIdShortOp;
+      break;
+    case GetByIdShortOp:
+      switch (second) {
+        case GetByIdShortOp:
+          return GetByIdShortThenGetByIdShortOp;
+        case Call1Op:
+          return GetByIdShortThenCall1Op;
+        case Call2Op:
+          return GetByIdShortThenCall2Op;
+        case Call3Op:
+          return GetByIdShortThenCall3Op;
+        default:
+          break;
+      }
+      break;
+    default:
+      break;
+  }
+  return first;
+}
+
+void BytecodeFunctionGenerator::fuseSuperInstructions() {
+  assert(
+      !complete_ &&
+      "Cannot modify BytecodeFunction after call to bytecodeGenerationComplete.");
+  assert(jumpTable_.empty() && "jump tables must be added afterwards");
+  offset_t loc = 0;
+  const offset_t end = opcodes_.size();
+  while (loc < end) {
+    auto first = (Operator)opcodes_[loc];
+    offset_t next = loc + inst::getInstSize((inst::OpCode)first);
+    if (next >= end)
+      break;
+    Operator fused = superInstruction(first, (Operator)opcodes_[next]);
+    if (fused != first) {
+      opcodes_[loc] = fused;
+      // Leave the second instruction alone, so that pairs don't overlap.
+      next += inst::getInstSize((inst::OpCode)opcodes_[next]);
+    }
+    loc = next;
+  }
+}
+
 void BytecodeFunctionGenerator::bytecodeGenerationComplete() {
   assert(!complete_ && "Can only call bytecodeGenerationComplete once");
   complete_ = true;
@@ -1702,6 +1702,8 @@ void HBCISel::generate(SourceMapGenerator *outSourceMap) {
   }
 
   resolveRelocations();
+  if (bytecodeGenerationOptions_.optimizationEnabled)
+    BCFGen_->fuseSuperInstructions();
   resolveExceptionHandlers();
   addDebugSourceLocationInfo(outSourceMap);
   generateJumpTable();
@@ -62,6 +62,10 @@ void hermes::runFullOptimizationPasses(Module &M) {
   PM.addStackPromotion();
   PM.addInlining();
   PM.addStackPromotion();
+  // Inlining exposes object literals which don't escape. Replace them with
+  // stack locations, which Mem2Reg turns into SSA values.
+  PM.addObjectScalarReplacement();
+  PM.addMem2Reg();
   PM.addInstSimplify();
   PM.addDCE();
 
@@ -77,6 +81,9 @@ void hermes::runFullOptimizationPasses(Module &M) {
   PM.addCSE();
   PM.addTDZDedup();
   PM.addSimplifyCFG();
+  // Hoist loop invariant computations once the CFG is simplified, so that
+  // the loops have their final shape.
+  PM.addLICM();
 
   PM.addInstSimplify();
   PM.addFuncSigOpts();
@@ -20,9 +20,33 @@ using llvh::dyn_cast;
 using llvh::isa;
 
 STATISTIC(NumInlinedCalls, "Number of inlined calls");
+STATISTIC(
+    NumInlinedSharedCalls,
+    "Number of inlined calls to functions with several uses");
+STATISTIC(
+    NumFullyInlinedFunctions,
+    "Number of functions removed because all their calls were inlined");
+STATISTIC(NumInstructionsAdded, "Number of instructions copied by inlining");
+STATISTIC(
+    NumInstructionsRemoved,
+    "Number of calls and function instructions removed by inlining");
 
 namespace hermes {
 
+/// A function which is called from several places is only duplicated into
+/// its call sites if its estimated size is at most this many instructions.
+static const unsigned kMaxSharedCalleeSize = 16;
+
+/// Inlining may grow a function by this percentage of its initial size...
+static const unsigned kFunctionGrowthPercent = 50;
+/// ...or by this many instructions, whichever is larger.
+static const unsigned kMinFunctionGrowth = 64;
+
+/// Inlining may grow the module by this percentage of its initial size...
+static const unsigned kModuleGrowthPercent = 10;
+/// ...or by this many instructions, whichever is larger.
+static const unsigned kMinModuleGrowth = 256;
+
 /// Generate a list of basic blocks in simple depth-first-search order.
 /// Unreachable blocks are not included since we don't want to inline them.
 static llvh::SmallVector<BasicBlock *, 4> orderDFS(Function *F) {
@@ -63,6 +87,8 @@ static bool canBeInlined(Function *F, Function *intoFunction) {
     for (auto &I : *oldBB) {
       switch (I.getKind()) {
         case ValueKind::CreateArgumentsInstKind:
+        // new.target would be the one of the function we are inlining into.
+        case ValueKind::GetNewTargetInstKind:
         // TODO: we can't deal with changing the scope depth of functions yet.
         case ValueKind::CreateFunctionInstKind:
         case ValueKind::CreateGeneratorInstKind:
@@ -83,6 +109,21 @@ static bool canBeInlined(Function *F, Function *intoFunction) {
   return true;
 }
 
+/// \return the estimated size of \p F, which is the number of instructions in
+///   its reachable blocks.
+static unsigned estimateSize(Function *F) {
+  unsigned size = 0;
+  for (BasicBlock *BB : orderDFS(F))
+    size += BB->getInstList().size();
+  return size;
+}
+
+/// \return the estimated number of instructions saved by removing the call
+///   \p CI: the call itself, and the instructions which set up its arguments.
+static unsigned estimateCallSize(CallInst *CI) {
+  return 1 + CI->getNumArguments();
+}
+
 /// Inline a function into the current insertion point, which must be at the
 /// end of a basic block because a branch will be inserted.
 /// \param F the function to inline
@@ -261,69 +302,136 @@ static Value *inlineFunction(
   return returnValue ? returnValue : cast<Value>(builder.getLiteralUndefined());
 }
 
+/// Replace the call \p CI with a copy of \p FC.
+static void inlineCall(Module *M, Function *FC, CallInst *CI) {
+  Function *intoFunction = CI->getParent()->getParent();
+
+  LLVM_DEBUG(llvh::dbgs() << "Inlining function '"
+                          << FC->getInternalNameStr() << "' ";
+             FC->getContext().getSourceErrorManager().dumpCoords(
+                 llvh::dbgs(), FC->getSourceRange().Start);
+             llvh::dbgs() << " into function '"
+                          << intoFunction->getInternalNameStr() << "' ";
+             FC->getContext().getSourceErrorManager().dumpCoords(
+                 llvh::dbgs(), intoFunction->getSourceRange().Start);
+             llvh::dbgs() << "\n";);
+
+  IRBuilder builder(M);
+
+  // Split the block in two and move all instructions following the call
+  // to the new block.
+  BasicBlock *nextBlock = builder.createBasicBlock(intoFunction);
+  builder.setInsertionBlock(nextBlock);
+
+  // Move the rest of the instructions.
+  auto it = CI->getIterator();
+  ++it; // Skip over the call.
+  auto e = CI->getParent()->end();
+  while (it != e)
+    builder.transferInstructionToCurrentBlock(&*it++);
+
+  // Perform the inlining.
+  builder.setInsertionPointAfter(CI);
+
+  auto *returnValue = inlineFunction(builder, FC, CI, nextBlock);
+  CI->replaceAllUsesWith(returnValue);
+  CI->eraseFromParent();
+
+  ++NumInlinedCalls;
+}
+
 bool Inlining::runOnModule(Module *M) {
   if (!M->getContext().getOptimizationSettings().inlining)
     return false;
 
   bool changed = false;
 
+  // The size of every function, kept up to date as calls are inlined, and the
+  // number of instructions each function may still grow by.
+  llvh::DenseMap<Function *, unsigned> sizes{};
+  llvh::DenseMap<Function *, int64_t> functionBudgets{};
+  unsigned moduleSize = 0;
+  for (Function &F : *M) {
+    unsigned size = estimateSize(&F);
+    sizes[&F] = size;
+    functionBudgets[&F] =
+        std::max(kMinFunctionGrowth, size * kFunctionGrowthPercent / 100);
+    moduleSize += size;
+  }
+  int64_t moduleBudget =
+      std::max(kMinModuleGrowth, moduleSize * kModuleGrowthPercent / 100);
+
+  llvh::SmallVector<CallInst *, 4> callSites{};
   for (Function &F : *M) {
     for (Instruction *I : F.getUsers()) {
       auto *CFI = llvh::dyn_cast<CreateFunctionInst>(I);
       if (!CFI)
         continue;
 
-      // Check if the function is used only once directly by a CallInst.
-      // We can't use getCallSites() (yet) because it also considers constructor
-      // calls as well usages through environment variables.
-
-      if (!CFI->hasOneUser() ||
-          CFI->getUsers()[0]->getKind() != ValueKind::CallInstKind) {
-        continue;
+      // Collect the calls which use the closure directly as their callee.
+      // Constructor calls and other uses, such as storing the closure or
+      // passing it to another function, are left alone.
+      callSites.clear();
+      bool hasOtherUsers = false;
+      for (Instruction *U : CFI->getUsers()) {
+        auto *CI = llvh::dyn_cast<CallInst>(U);
+        if (CI && CI->getKind() == ValueKind::CallInstKind &&
+            isDirectCallee(CFI, CI)) {
+          callSites.push_back(CI);
+        } else {
+          hasOtherUsers = true;
+        }
       }
-      auto *CI = cast<CallInst>(CFI->getUsers()[0]);
-      if (!isDirectCallee(CFI, CI))
+      if (callSites.empty())
         continue;
 
-      Function *intoFunction = CI->getParent()->getParent();
+      Function *intoFunction = CFI->getParent()->getParent();
 
       auto *FC = CFI->getFunctionCode();
       if (!canBeInlined(FC, intoFunction))
         continue;
 
-      LLVM_DEBUG(llvh::dbgs() << "Inlining function '"
-                              << FC->getInternalNameStr() << "' ";
-                 FC->getContext().getSourceErrorManager().dumpCoords(
-                     llvh::dbgs(), FC->getSourceRange().Start);
-                 llvh::dbgs() << " into function '"
-                              << intoFunction->getInternalNameStr() << "' ";
-                 FC->getContext().getSourceErrorManager().dumpCoords(
-                     llvh::dbgs(), intoFunction->getSourceRange().Start);
-                 llvh::dbgs() << "\n";);
-
-      IRBuilder builder(M);
-
-      // Split the block in two and move all instructions following the call
-      // to the new block.
-      BasicBlock *nextBlock = builder.createBasicBlock(intoFunction);
-      builder.setInsertionBlock(nextBlock);
-
-      // Move the rest of the instructions.
-      auto it = CI->getIterator();
-      ++it; // Skip over the call.
-      auto e = CI->getParent()->end();
-      while (it != e)
-        builder.transferInstructionToCurrentBlock(&*it++);
-
-      // Perform the inlining.
-      builder.setInsertionPointAfter(CI);
-
-      auto *returnValue = inlineFunction(builder, FC, CI, nextBlock);
-      CI->replaceAllUsesWith(returnValue);
-      CI->eraseFromParent();
-
-      ++NumInlinedCalls;
-      changed = true;
+      unsigned calleeSize = sizes[FC];
+      bool removesCallee = !hasOtherUsers && FC->getUsers().size() == 1;
+
+      // A function with a single call is always inlined, since it is then
+      // removed and the code doesn't grow. Otherwise, the callee must be
+      // small, and inlining it must fit in the budgets.
+      if (callSites.size() > 1 || !removesCallee) {
+        if (calleeSize > kMaxSharedCalleeSize)
+          continue;
+      }
+
+      int64_t &functionBudget = functionBudgets[intoFunction];
+      unsigned numInlined = 0;
+      for (CallInst *CI : callSites) {
+        int64_t growth = (int64_t)calleeSize - estimateCallSize(CI);
+        bool isLastCall = numInlined + 1 == callSites.size();
+        // The last call of a callee which is then removed doesn't grow the
+        // code, since the callee's body is moved rather than copied.
+        if (isLastCall && removesCallee)
+          growth -= calleeSize;
+        if (growth > 0 && (growth > functionBudget || growth > moduleBudget))
+          break;
+
+        NumInstructionsAdded += calleeSize;
+        NumInstructionsRemoved += estimateCallSize(CI);
+        functionBudget -= growth;
+        moduleBudget -= growth;
+        sizes[intoFunction] += growth;
+        if (callSites.size() > 1)
+          ++NumInlinedSharedCalls;
+
+        inlineCall(M, FC, CI);
+        ++numInlined;
+        changed = true;
+      }
+
+      if (numInlined == callSites.size() && removesCallee) {
+        // The closure is now unused, and DCE will remove the callee.
+        NumInstructionsRemoved += calleeSize;
+        ++NumFullyInlinedFunctions;
+      }
     }
   }
 
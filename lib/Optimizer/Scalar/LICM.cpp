@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define DEBUG_TYPE "licm"
+#include "hermes/Optimizer/Scalar/LICM.h"
+#include "hermes/IR/Analysis.h"
+#include "hermes/IR/CFG.h"
+#include "hermes/IR/IRBuilder.h"
+#include "hermes/IR/Instrs.h"
+#include "hermes/Optimizer/Scalar/Utils.h"
+#include "hermes/Support/Statistic.h"
+
+#include "llvh/ADT/DenseMap.h"
+#include "llvh/ADT/SetVector.h"
+#include "llvh/ADT/SmallPtrSet.h"
+#include "llvh/Support/Debug.h"
+
+#include <algorithm>
+#include <memory>
+
+using namespace hermes;
+using llvh::dbgs;
+using llvh::isa;
+
+STATISTIC(NumLoops, "Number of loops found");
+STATISTIC(NumPreheaders, "Number of loop preheaders created");
+STATISTIC(NumHoisted, "Number of loop invariant instructions hoisted");
+STATISTIC(NumHoistedLoads, "Number of loop invariant frame loads hoisted");
+
+namespace {
+
+/// A natural loop: the blocks dominated by the header from which one of the
+/// back edges to the header can be reached.
+struct Loop {
+  BasicBlock *header;
+  /// The blocks of the loop, including the blocks of the nested loops.
+  llvh::SmallPtrSet<BasicBlock *, 16> blocks{};
+  /// The blocks of the loop in reverse post order, so that the definitions in
+  /// the loop are visited before their uses.
+  llvh::SmallVector<BasicBlock *, 16> order{};
+
+  explicit Loop(BasicBlock *header) : header(header) {}
+
+  bool contains(const BasicBlock *BB) const {
+    return blocks.count(const_cast<BasicBlock *>(BB));
+  }
+};
+
+using LoopList = llvh::SmallVector<std::unique_ptr<Loop>, 4>;
+
+/// Discover the natural loops of the function in \p RPO, the list of its
+/// blocks in reverse post order. Back edges sharing a header are merged into
+/// a single loop. Irreducible cycles have no back edge to a dominating header
+/// and are ignored.
+/// \return the loops, ordered so that nested loops come before the loops which
+///   contain them.
+LoopList findLoops(
+    llvh::ArrayRef<BasicBlock *> RPO,
+    const DominanceInfo &dominance) {
+  LoopList loops;
+  llvh::DenseMap<BasicBlock *, Loop *> headerToLoop;
+
+  for (BasicBlock *BB : RPO) {
+    for (auto it = succ_begin(BB), e = succ_end(BB); it != e; ++it) {
+      BasicBlock *header = *it;
+      if (!dominance.dominates(header, BB))
+        continue;
+
+      Loop *&loop = headerToLoop[header];
+      if (!loop) {
+        loops.push_back(std::make_unique<Loop>(header));
+        loop = loops.back().get();
+        loop->blocks.insert(header);
+      }
+
+      // Walk backwards from the latch to the header.
+      llvh::SmallVector<BasicBlock *, 16> worklist{BB};
+      while (!worklist.empty()) {
+        BasicBlock *cur = worklist.pop_back_val();
+        if (!loop->blocks.insert(cur).second)
+          continue;
+        for (BasicBlock *pred : predecessors(cur)) {
+          // Skip unreachable predecessors.
+          if (dominance.dominates(header, pred))
+            worklist.push_back(pred);
+        }
+      }
+    }
+  }
+
+  for (auto &loop : loops) {
+    for (BasicBlock *BB : RPO)
+      if (loop->contains(BB))
+        loop->order.push_back(BB);
+  }
+
+  // A nested loop is strictly smaller than any loop containing it.
+  std::stable_sort(
+      loops.begin(),
+      loops.end(),
+      [](const std::unique_ptr<Loop> &a, const std::unique_ptr<Loop> &b) {
+        return a->blocks.size() < b->blocks.size();
+      });
+  return loops;
+}
+
+/// \return true if the function \p F may be suspended and resumed, letting
+/// arbitrary code run in the middle of it.
+bool isSuspendable(Function *F) {
+  return isa<GeneratorInnerFunction>(F);
+}
+
+/// \return true if nothing in \p loop can change the value of \p V.
+/// \param mayExecute whether \p loop contains instructions which may execute
+///   arbitrary code.
+bool isInvariantVariable(Variable *V, const Loop &loop, bool mayExecute) {
+  // We don't know where the variables of external scopes are written.
+  if (isa<ExternalScope>(V->getParent()))
+    return false;
+
+  Function *owner = V->getParent()->getFunction();
+  Function *F = loop.header->getParent();
+  if (mayExecute && (isSuspendable(owner) || isSuspendable(F)))
+    return false;
+
+  for (auto *U : V->getUsers()) {
+    auto *SF = llvh::dyn_cast<StoreFrameInst>(U);
+    if (!SF)
+      continue;
+    if (loop.contains(SF->getParent()))
+      return false;
+    // Code called from the loop could run a closure which writes V. When all
+    // the writes are in the function which owns V, only that function can
+    // write it: the instance of V it writes is either the one of an enclosing
+    // call, which can't run until the loop is done, or the one of a new
+    // call, which the loop can't see.
+    if (mayExecute && SF->getParent()->getParent() != owner)
+      return false;
+  }
+  return true;
+}
+
+/// Finds the instructions of a loop that compute the same value in every
+/// iteration, and moves them to the loop's preheader.
+class LoopHoister {
+ public:
+  explicit LoopHoister(const Loop &loop) : loop_(loop) {
+    for (BasicBlock *BB : loop_.order)
+      for (auto &I : *BB)
+        if (I.mayExecute())
+          mayExecute_ = true;
+  }
+
+  /// Hoist the invariant instructions of the loop.
+  /// \return true if the function changed.
+  bool run();
+
+  /// \return the preheader created by run(), if any.
+  BasicBlock *getNewPreheader() const {
+    return newPreheader_;
+  }
+
+ private:
+  /// \return true if \p V doesn't change while the loop runs.
+  bool isInvariantOperand(Value *V) const {
+    auto *I = llvh::dyn_cast<Instruction>(V);
+    return !I || !loop_.contains(I->getParent()) || invariant_.count(I);
+  }
+
+  /// \return true if \p I computes the same value in every iteration and can
+  /// be executed speculatively.
+  bool canHoist(Instruction *I);
+
+  /// \return the block to hoist to, creating it if needed, or nullptr if the
+  /// loop can't have a preheader.
+  BasicBlock *getOrCreatePreheader();
+
+  const Loop &loop_;
+  /// Whether the loop contains instructions which may execute arbitrary code.
+  bool mayExecute_{false};
+  /// The instructions to hoist, in the order they must be inserted.
+  llvh::SetVector<Instruction *> invariant_{};
+  /// The preheader created for the loop, if any.
+  BasicBlock *newPreheader_{nullptr};
+};
+
+bool LoopHoister::canHoist(Instruction *I) {
+  if (auto *LF = llvh::dyn_cast<LoadFrameInst>(I))
+    return isInvariantVariable(LF->getLoadVariable(), loop_, mayExecute_);
+
+  if (!isSimpleSideEffectFreeInstruction(I))
+    return false;
+  for (unsigned i = 0, e = I->getNumOperands(); i < e; ++i) {
+    if (!isInvariantOperand(I->getOperand(i)))
+      return false;
+  }
+  return true;
+}
+
+BasicBlock *LoopHoister::getOrCreatePreheader() {
+  BasicBlock *header = loop_.header;
+  llvh::SmallSetVector<BasicBlock *, 4> outside;
+  for (BasicBlock *pred : predecessors(header))
+    if (!loop_.contains(pred))
+      outside.insert(pred);
+
+  // The entry block has no predecessor. Only plain branches are redirected to
+  // a new preheader, and only a block whose single successor is the header is
+  // used as the preheader, so that what is hoisted runs after everything that
+  // precedes the loop.
+  for (BasicBlock *pred : outside) {
+    auto *term = pred->getTerminator();
+    if (!isa<BranchInst>(term) && !isa<CondBranchInst>(term))
+      return nullptr;
+  }
+  if (outside.empty())
+    return nullptr;
+  if (outside.size() == 1 && isa<BranchInst>(outside[0]->getTerminator()))
+    return outside[0];
+
+  Function *F = header->getParent();
+  IRBuilder builder(F);
+  BasicBlock *preheader = builder.createBasicBlock(F);
+  // Keep the blocks in source order in the IR dumps.
+  F->getBasicBlockList().remove(preheader->getIterator());
+  F->getBasicBlockList().insert(header->getIterator(), preheader);
+  builder.setInsertionBlock(preheader);
+  builder.createBranchInst(header);
+
+  for (BasicBlock *pred : outside) {
+    auto *term = pred->getTerminator();
+    for (unsigned i = 0, e = term->getNumSuccessors(); i < e; ++i)
+      if (term->getSuccessor(i) == header)
+        term->setSuccessor(i, preheader);
+  }
+
+  // Merge the incoming values from outside the loop in the preheader.
+  for (auto &I : *header) {
+    auto *phi = llvh::dyn_cast<PhiInst>(&I);
+    if (!phi)
+      break;
+
+    PhiInst::ValueListType values;
+    PhiInst::BasicBlockListType blocks;
+    for (unsigned i = phi->getNumEntries(); i-- > 0;) {
+      auto entry = phi->getEntry(i);
+      if (loop_.contains(entry.second))
+        continue;
+      values.push_back(entry.first);
+      blocks.push_back(entry.second);
+      phi->removeEntry(i);
+    }
+
+    Value *incoming = values.front();
+    if (llvh::any_of(values, [&](Value *V) { return V != incoming; })) {
+      builder.setInsertionPoint(&preheader->front());
+      auto *merged = builder.createPhiInst(values, blocks);
+      merged->setType(phi->getType());
+      incoming = merged;
+    }
+    phi->addEntry(incoming, preheader);
+  }
+
+  ++NumPreheaders;
+  newPreheader_ = preheader;
+  return preheader;
+}
+
+bool LoopHoister::run() {
+  for (BasicBlock *BB : loop_.order) {
+    for (auto &I : *BB) {
+      if (canHoist(&I))
+        invariant_.insert(&I);
+    }
+  }
+  if (invariant_.empty())
+    return false;
+
+  BasicBlock *preheader = getOrCreatePreheader();
+  if (!preheader)
+    return false;
+
+  Instruction *term = preheader->getTerminator();
+  for (Instruction *I : invariant_) {
+    LLVM_DEBUG(
+        dbgs() << "Hoisting " << I->getKindStr() << " out of loop "
+               << loop_.header->getParent()->getInternalNameStr() << "\n");
+    I->moveBefore(term);
+    ++NumHoisted;
+    if (isa<LoadFrameInst>(I))
+      ++NumHoistedLoads;
+  }
+  return true;
+}
+
+} // namespace
+
+bool LICM::runOnFunction(Function *F) {
+  PostOrderAnalysis PO(F);
+  llvh::SmallVector<BasicBlock *, 16> RPO(PO.rbegin(), PO.rend());
+  DominanceInfo dominance(F);
+  LoopList loops = findLoops(RPO, dominance);
+  NumLoops += loops.size();
+
+  // Visit the innermost loops first, so that what they hoist can then be
+  // hoisted out of the loops which contain them. Creating a preheader only
+  // adds a block outside of the loop, so the blocks of the enclosing loops
+  // stay valid except for the new block, which is added to them.
+  bool changed = false;
+  for (size_t i = 0, e = loops.size(); i < e; ++i) {
+    LoopHoister hoister(*loops[i]);
+    changed |= hoister.run();
+    BasicBlock *preheader = hoister.getNewPreheader();
+    if (!preheader)
+      continue;
+    BasicBlock *header = loops[i]->header;
+    for (size_t j = i + 1; j < e; ++j) {
+      Loop &outer = *loops[j];
+      if (!outer.contains(header))
+        continue;
+      outer.blocks.insert(preheader);
+      outer.order.insert(
+          std::find(outer.order.begin(), outer.order.end(), header),
+          preheader);
+    }
+  }
+  return changed;
+}
+
+Pass *hermes::createLICM() {
+  return new LICM();
+}
+
+#undef DEBUG_TYPE
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define DEBUG_TYPE "objectscalarreplacement"
+#include "hermes/Optimizer/Scalar/ObjectScalarReplacement.h"
+#include "hermes/IR/IRBuilder.h"
+#include "hermes/IR/Instrs.h"
+#include "hermes/Support/OptValue.h"
+#include "hermes/Support/Statistic.h"
+
+#include "llvh/ADT/SmallVector.h"
+#include "llvh/Support/Debug.h"
+
+using namespace hermes;
+using llvh::dbgs;
+
+STATISTIC(NumObjects, "Number of object allocations eliminated");
+STATISTIC(NumLoads, "Number of property loads replaced");
+STATISTIC(NumStores, "Number of property stores replaced");
+
+/// Objects with more properties than this are left alone, to avoid creating
+/// too many stack locations.
+static const unsigned kMaxProperties = 16;
+
+/// \return the index of the property \p prop of \p ALI, if \p prop is the name
+/// of one of its properties.
+static OptValue<unsigned> findProperty(
+    AllocObjectLiteralInst *ALI,
+    Value *prop) {
+  for (unsigned i = 0, e = ALI->getKeyValuePairCount(); i < e; ++i) {
+    // Literals are uniqued, so comparing the pointers compares the names.
+    if (ALI->getKey(i) == prop)
+      return i;
+  }
+  return llvh::None;
+}
+
+/// \return true if \p ALI is only used to load and store its own properties.
+/// The shape of the object is then fixed: its properties are own, writable
+/// data properties, so accessing them never reaches the prototype or runs
+/// code, and the object can't be observed anywhere else.
+static bool canReplace(AllocObjectLiteralInst *ALI) {
+  if (ALI->getKeyValuePairCount() > kMaxProperties || !ALI->hasUsers())
+    return false;
+
+  for (auto *U : ALI->getUsers()) {
+    if (U->getKind() == ValueKind::LoadPropertyInstKind) {
+      auto *LPI = llvh::cast<LoadPropertyInst>(U);
+      if (LPI->getObject() == ALI && findProperty(ALI, LPI->getProperty()))
+        continue;
+      return false;
+    }
+    if (U->getKind() == ValueKind::StorePropertyInstKind) {
+      auto *SPI = llvh::cast<StorePropertyInst>(U);
+      if (SPI->getObject() == ALI && SPI->getStoredValue() != ALI &&
+          findProperty(ALI, SPI->getProperty()))
+        continue;
+      return false;
+    }
+    // Any other use lets the object escape.
+    return false;
+  }
+  return true;
+}
+
+/// Replace the properties of \p ALI with stack locations, and erase it.
+static void replaceObject(AllocObjectLiteralInst *ALI) {
+  Function *F = ALI->getParent()->getParent();
+  IRBuilder builder(F);
+  IRBuilder::InstructionDestroyer destroyer;
+
+  // Allocate the locations in the entry block, and initialize them where the
+  // object was allocated.
+  llvh::SmallVector<AllocStackInst *, 4> slots;
+  builder.setInsertionPoint(&*F->front().begin());
+  for (unsigned i = 0, e = ALI->getKeyValuePairCount(); i < e; ++i) {
+    auto *key = llvh::cast<LiteralString>(ALI->getKey(i));
+    slots.push_back(builder.createAllocStackInst(key->getValue()));
+  }
+  builder.setInsertionPoint(ALI);
+  for (unsigned i = 0, e = ALI->getKeyValuePairCount(); i < e; ++i)
+    builder.createStoreStackInst(ALI->getValue(i), slots[i]);
+
+  // Copy the users, since replacing them modifies the list.
+  llvh::SmallVector<Instruction *, 8> users(
+      ALI->getUsers().begin(), ALI->getUsers().end());
+  for (auto *U : users) {
+    builder.setInsertionPoint(U);
+    if (auto *SPI = llvh::dyn_cast<StorePropertyInst>(U)) {
+      unsigned idx = *findProperty(ALI, SPI->getProperty());
+      builder.createStoreStackInst(SPI->getStoredValue(), slots[idx]);
+      ++NumStores;
+    } else {
+      auto *LPI = llvh::cast<LoadPropertyInst>(U);
+      unsigned idx = *findProperty(ALI, LPI->getProperty());
+      LPI->replaceAllUsesWith(builder.createLoadStackInst(slots[idx]));
+      ++NumLoads;
+    }
+    destroyer.add(U);
+  }
+  destroyer.add(ALI);
+  ++NumObjects;
+}
+
+bool ObjectScalarReplacement::runOnFunction(Function *F) {
+  llvh::SmallVector<AllocObjectLiteralInst *, 4> objects;
+  for (auto &BB : *F) {
+    for (auto &I : BB) {
+      auto *ALI = llvh::dyn_cast<AllocObjectLiteralInst>(&I);
+      if (ALI && canReplace(ALI))
+        objects.push_back(ALI);
+    }
+  }
+
+  for (auto *ALI : objects) {
+    LLVM_DEBUG(
+        dbgs() << "Replacing an object with its properties in "
+               << F->getInternalNameStr() << "\n");
+    replaceObject(ALI);
+  }
+  return !objects.empty();
+}
+
+Pass *hermes::createObjectScalarReplacement() {
+  return new ObjectScalarReplacement();
+}
+
+#undef DEBUG_TYPE
@@ -12,6 +12,9 @@
 #include "llvh/ADT/SmallVector.h"
 #include "llvh/Support/TrailingObjects.h"
 
+#include <algorithm>
+#include <cstring>
+
 // This file contains the machinery for executing a regexp compiled to bytecode.
 
 namespace hermes {
@@ -89,6 +92,48 @@ struct LoopData {
   uint32_t entryPosition;
 };
 
+/// The threads of the automaton at one input position, in priority order.
+/// Each thread is at the goal or at an instruction which matches a single
+/// character, and has its own captured ranges.
+struct AutomatonThreadList {
+  /// The instruction pointer of each thread.
+  std::vector<uint32_t> ips;
+
+  /// The captured ranges of each thread, one thread after another. Each thread
+  /// has one more range than there are marked subexpressions: the first one
+  /// holds where the thread started matching.
+  std::vector<CapturedRange> ranges;
+
+  bool empty() const {
+    return ips.empty();
+  }
+
+  void clear() {
+    ips.clear();
+    ranges.clear();
+  }
+};
+
+/// Scratch space used while running the automaton.
+struct AutomatonScratch {
+  /// For each instruction offset, the last generation in which a thread
+  /// reached it. Each input position gets a new generation, so that a thread
+  /// which reaches an instruction already reached at its position (by a
+  /// thread with a higher priority) can be dropped.
+  std::vector<uint32_t> visited;
+
+  /// The current generation.
+  uint32_t generation = 0;
+
+  /// The captured ranges of the thread being added.
+  std::vector<CapturedRange> ranges;
+
+  /// The branches not yet followed while adding a thread, with their captured
+  /// ranges one branch after another.
+  std::vector<uint32_t> pendingIps;
+  std::vector<CapturedRange> pendingRanges;
+};
+
 /// Cursor is a lightweight value type which allows tracking a character pointer
 /// 'current' within a range 'first' to 'last'.
 /// A cursor may either be forwards, in which case it proceeds from 'first' to
@@ -400,6 +445,14 @@ struct Context {
   /// This is effectively a timeout on the regexp execution.
   uint32_t backtracksRemaining_ = kBacktrackLimit;
 
+  /// Where matches may start, or nullptr if the regex has no prefilter.
+  const RegexPrefilter *prefilter_ = nullptr;
+
+  /// The code units which every match starts with, copied out of the
+  /// (unaligned) bytecode following prefilter_. May be empty.
+  llvh::SmallVector<char16_t, constants::kMaxPrefilterPrefixLength>
+      prefilterPrefix_;
+
   Context(
       llvh::ArrayRef<uint8_t> bytecodeStream,
       constants::MatchFlagType flags,
@@ -414,7 +467,20 @@ struct Context {
         first_(first),
         last_(last),
         markedCount_(markedCount),
-        loopCount_(loopCount) {}
+        loopCount_(loopCount) {
+    auto header =
+        reinterpret_cast<const RegexBytecodeHeader *>(bytecodeStream.data());
+    if (header->prefilterOffset) {
+      const uint8_t *prefilterBytes = &bytecodeStream[
+          sizeof(RegexBytecodeHeader) + header->prefilterOffset];
+      prefilter_ = reinterpret_cast<const RegexPrefilter *>(prefilterBytes);
+      prefilterPrefix_.resize(prefilter_->prefixLength);
+      std::memcpy(
+          prefilterPrefix_.data(),
+          prefilterBytes + sizeof(RegexPrefilter),
+          prefilterPrefix_.size() * sizeof(char16_t));
+    }
+  }
 
   /// Run the given State \p state, by starting at its cursor and acting on its
   /// ip_ until the match succeeds or fails. If \p onlyAtStart is set, only
@@ -429,6 +495,13 @@ struct Context {
       State<Traits> *state,
       bool onlyAtStart);
 
+  /// Like match(), but run the automaton program of the regex, which must
+  /// have one, starting at the cursor of \p state. All threads advance through
+  /// the input together, and at most one of them runs each instruction at any
+  /// input position, so this takes time linear in the length of the input and
+  /// cannot overflow.
+  const CodeUnit *matchWithAutomaton(State<Traits> *state, bool onlyAtStart);
+
   /// Backtrack the given state \p s with the backtrack stack \p bts.
   /// \return true if we backtracked, false if we exhausted the stack.
   LLVM_NODISCARD
@@ -477,6 +550,22 @@ struct Context {
       const BeginLoopInsn *loop,
       BacktrackStack &bts);
 
+  /// Add a thread at the automaton instruction \p ip, with captured ranges
+  /// \p ranges and at input position \p pos, to \p threads. Instructions which
+  /// do not match a character are run right away, which may add several
+  /// threads or none at all.
+  void addAutomatonThread(
+      AutomatonThreadList &threads,
+      uint32_t ip,
+      const CapturedRange *ranges,
+      const CodeUnit *pos,
+      AutomatonScratch &scratch) const;
+
+  /// \return whether the instruction \p insn, which must match a single
+  /// character, matches the character under the cursor \p c. Advances the
+  /// cursor past the character.
+  bool matchesOneCharacter(const Insn *insn, Cursor<Traits> &c) const;
+
   /// Given a Width1Opcode \p w1opcode, return true if the given char \p c
   /// matches the instruction \p insn (with that opcode).
   template <Width1Opcode w1opcode>
@@ -504,6 +593,15 @@ struct Context {
       const CodeUnit *start,
       size_t index,
       size_t lastIndex) const;
+
+  /// Given a string \p start of length \p length, \return the first index at
+  /// or after \p index at which prefilter_ allows a match to start, or
+  /// \p length + 1 if there is none. Matches always consume input, so there
+  /// is never a candidate at \p length.
+  size_t nextPrefilterCandidate(
+      const CodeUnit *start,
+      size_t index,
+      size_t length) const;
 };
 
 /// We store loop and captured range data contiguously in a single allocation at
@@ -567,9 +665,8 @@ bool isLineTerminator(CharT c) {
 }
 
 template <class Traits>
-bool matchesLeftAnchor(Context<Traits> &ctx, State<Traits> &s) {
+bool matchesLeftAnchor(const Context<Traits> &ctx, const Cursor<Traits> &c) {
   bool matchesAnchor = false;
-  const Cursor<Traits> &c = s.cursor_;
   if (c.atLeft()) {
     // Beginning of text.
     matchesAnchor = true;
@@ -583,9 +680,8 @@ bool matchesLeftAnchor(Context<Traits> &ctx, State<Traits> &s) {
 }
 
 template <class Traits>
-bool matchesRightAnchor(Context<Traits> &ctx, State<Traits> &s) {
+bool matchesRightAnchor(const Context<Traits> &ctx, const Cursor<Traits> &c) {
   bool matchesAnchor = false;
-  const Cursor<Traits> &c = s.cursor_;
   if (c.atRight() && !(ctx.flags_ & constants::matchNotEndOfLine)) {
     matchesAnchor = true;
   } else if (
@@ -596,6 +692,25 @@ bool matchesRightAnchor(Context<Traits> &ctx, State<Traits> &s) {
   return matchesAnchor;
 }
 
+/// \return whether the cursor \p c is between a word character and a
+/// non-word character, ignoring the direction of the cursor.
+template <class Traits>
+bool matchesWordBoundary(const Context<Traits> &ctx, const Cursor<Traits> &c) {
+  const auto *charPointer = c.currentPointer();
+
+  bool prevIsWordchar = false;
+  if (!c.atLeft())
+    prevIsWordchar =
+        ctx.traits_.characterHasType(charPointer[-1], CharacterClass::Words);
+
+  bool currentIsWordchar = false;
+  if (!c.atRight())
+    currentIsWordchar =
+        ctx.traits_.characterHasType(charPointer[0], CharacterClass::Words);
+
+  return prevIsWordchar != currentIsWordchar;
+}
+
 /// \return true if all chars, stored in contiguous memory after \p insn,
 /// match the chars in state \p s in the same order. Note the count of chars
 /// is given in \p insn.
@@ -958,6 +1073,61 @@ inline size_t Context<Traits>::advanceStringIndex(
   return index + 2;
 }
 
+/// \return a pointer to the first code unit equal to \p cu in the range
+/// [\p first, \p last), or nullptr if there is none.
+static const char *
+findCodeUnit(const char *first, const char *last, char16_t cu) {
+  if (cu > 0xFF)
+    return nullptr;
+  return static_cast<const char *>(std::memchr(first, cu, last - first));
+}
+
+static const char16_t *
+findCodeUnit(const char16_t *first, const char16_t *last, char16_t cu) {
+  const char16_t *found = std::find(first, last, cu);
+  return found == last ? nullptr : found;
+}
+
+template <class Traits>
+size_t Context<Traits>::nextPrefilterCandidate(
+    const CodeUnit *start,
+    size_t index,
+    size_t length) const {
+  using UnsignedUnit = typename std::make_unsigned<CodeUnit>::type;
+  const size_t prefixLength = prefilterPrefix_.size();
+  if (index + std::max<size_t>(prefixLength, 1) > length)
+    return length + 1;
+  const CodeUnit *const end = start + length;
+  const CodeUnit *p = start + index;
+  for (;; ++p) {
+    if (prefixLength == 0) {
+      while (p != end && !prefilter_->mayStartWith(UnsignedUnit(*p)))
+        ++p;
+      if (p == end)
+        return length + 1;
+    } else {
+      // Look for the first code unit of the prefix with memchr, and only then
+      // compare the rest.
+      p = findCodeUnit(p, end - prefixLength + 1, prefilterPrefix_[0]);
+      if (!p)
+        return length + 1;
+      if (!std::equal(
+              prefilterPrefix_.begin() + 1,
+              prefilterPrefix_.end(),
+              p + 1,
+              [](char16_t cu, CodeUnit c) { return cu == UnsignedUnit(c); }))
+        continue;
+    }
+    // A unicode regex never starts matching in the middle of a surrogate pair,
+    // see advanceStringIndex.
+    if (sizeof(CodeUnit) == 2 && syntaxFlags_.unicode && p != start &&
+        isLowSurrogate(UnsignedUnit(*p)) &&
+        isHighSurrogate(UnsignedUnit(p[-1])))
+      continue;
+    return p - start;
+  }
+}
+
 template <class Traits>
 auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
     -> ExecutorResult<const CodeUnit *> {
@@ -1001,8 +1171,18 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
     goto backtrackingExhausted;                \
   } while (0)
 
-  for (size_t locIndex = 0; locIndex < locsToCheckCount;
-       locIndex = advanceStringIndex(startLoc, locIndex, charsToRight)) {
+  // When searching, skip the locations at which the prefilter says no match
+  // can start without running any instructions.
+  const bool usePrefilter = prefilter_ && !onlyAtStart;
+  auto skipToCandidate = [&](size_t locIndex) {
+    return usePrefilter
+        ? nextPrefilterCandidate(startLoc, locIndex, charsToRight)
+        : locIndex;
+  };
+
+  for (size_t locIndex = skipToCandidate(0); locIndex < locsToCheckCount;
+       locIndex = skipToCandidate(
+           advanceStringIndex(startLoc, locIndex, charsToRight))) {
     const CodeUnit *potentialMatchLocation = startLoc + locIndex;
     c.setCurrentPointer(potentialMatchLocation);
     s->ip_ = startIp;
@@ -1014,13 +1194,13 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
           return potentialMatchLocation;
 
         case Opcode::LeftAnchor:
-          if (!matchesLeftAnchor(*this, *s))
+          if (!matchesLeftAnchor(*this, c))
             BACKTRACK();
           s->ip_ += sizeof(LeftAnchorInsn);
           break;
 
         case Opcode::RightAnchor:
-          if (!matchesRightAnchor(*this, *s))
+          if (!matchesRightAnchor(*this, c))
             BACKTRACK();
           s->ip_ += sizeof(RightAnchorInsn);
           break;
@@ -1179,20 +1359,7 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
 
         case Opcode::WordBoundary: {
           const WordBoundaryInsn *insn = llvh::cast<WordBoundaryInsn>(base);
-          const auto *charPointer = c.currentPointer();
-
-          bool prevIsWordchar = false;
-          if (!c.atLeft())
-            prevIsWordchar = traits_.characterHasType(
-                charPointer[-1], CharacterClass::Words);
-
-          bool currentIsWordchar = false;
-          if (!c.atRight())
-            currentIsWordchar =
-                traits_.characterHasType(charPointer[0], CharacterClass::Words);
-
-          bool isWordBoundary = (prevIsWordchar != currentIsWordchar);
-          if (isWordBoundary ^ insn->invert)
+          if (matchesWordBoundary(*this, c) ^ insn->invert)
             s->ip_ += sizeof(WordBoundaryInsn);
           else
             BACKTRACK();
@@ -1490,6 +1657,9 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
             BACKTRACK();
           break;
         }
+
+        case Opcode::ClearCaptures:
+          llvm_unreachable("ClearCaptures only appears in automaton programs");
       }
     }
   // The search failed at this location.
@@ -1501,6 +1671,289 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
   return nullptr;
 }
 
+template <class Traits>
+bool Context<Traits>::matchesOneCharacter(const Insn *base, Cursor<Traits> &c)
+    const {
+  using W1 = Width1Opcode;
+  switch (base->opcode) {
+    case Opcode::MatchChar8:
+      return matchWidth1<W1::MatchChar8>(base, c.consume());
+    case Opcode::MatchChar16:
+      return matchWidth1<W1::MatchChar16>(base, c.consume());
+    case Opcode::MatchCharICase8:
+      return matchWidth1<W1::MatchCharICase8>(base, c.consume());
+    case Opcode::MatchCharICase16:
+      return matchWidth1<W1::MatchCharICase16>(base, c.consume());
+    case Opcode::MatchAny:
+      return matchWidth1<W1::MatchAny>(base, c.consume());
+    case Opcode::MatchAnyButNewline:
+      return matchWidth1<W1::MatchAnyButNewline>(base, c.consume());
+    case Opcode::Bracket:
+      return matchWidth1<W1::Bracket>(base, c.consume());
+
+    case Opcode::U16MatchAny:
+      c.consumeUTF16();
+      return true;
+
+    case Opcode::U16MatchAnyButNewline:
+      return !isLineTerminator(c.consumeUTF16());
+
+    case Opcode::U16MatchChar32:
+      return c.consumeUTF16() ==
+          (CodePoint)llvh::cast<U16MatchChar32Insn>(base)->c;
+
+    case Opcode::U16MatchCharICase32: {
+      const auto *insn = llvh::cast<U16MatchCharICase32Insn>(base);
+      CodePoint cp = c.consumeUTF16();
+      return cp == (CodePoint)insn->c ||
+          traits_.canonicalize(cp, true) == (CodePoint)insn->c;
+    }
+
+    case Opcode::U16Bracket: {
+      const U16BracketInsn *insn = llvh::cast<U16BracketInsn>(base);
+      const BracketRange32 *ranges =
+          reinterpret_cast<const BracketRange32 *>(insn + 1);
+      return bracketMatchesChar<Traits>(*this, insn, ranges, c.consumeUTF16());
+    }
+
+    default:
+      llvm_unreachable("Instruction does not match a single character");
+  }
+}
+
+/// \return the width of the automaton instruction \p base, which must match
+/// a single character.
+static uint32_t singleCharacterInsnWidth(const Insn *base) {
+  switch (base->opcode) {
+    case Opcode::Bracket:
+      return llvh::cast<BracketInsn>(base)->totalWidth();
+    case Opcode::U16Bracket:
+      return llvh::cast<U16BracketInsn>(base)->totalWidth();
+    case Opcode::MatchChar8:
+      return sizeof(MatchChar8Insn);
+    case Opcode::MatchChar16:
+      return sizeof(MatchChar16Insn);
+    case Opcode::MatchCharICase8:
+      return sizeof(MatchCharICase8Insn);
+    case Opcode::MatchCharICase16:
+      return sizeof(MatchCharICase16Insn);
+    case Opcode::U16MatchChar32:
+      return sizeof(U16MatchChar32Insn);
+    case Opcode::U16MatchCharICase32:
+      return sizeof(U16MatchCharICase32Insn);
+    case Opcode::MatchAny:
+    case Opcode::U16MatchAny:
+    case Opcode::MatchAnyButNewline:
+    case Opcode::U16MatchAnyButNewline:
+      return sizeof(Insn);
+    default:
+      llvm_unreachable("Instruction does not match a single character");
+  }
+}
+
+template <class Traits>
+void Context<Traits>::addAutomatonThread(
+    AutomatonThreadList &threads,
+    uint32_t ip,
+    const CapturedRange *ranges,
+    const CodeUnit *pos,
+    AutomatonScratch &scratch) const {
+  const uint8_t *const bytecode = &bytecodeStream_[sizeof(RegexBytecodeHeader)];
+  const uint32_t rangeCount = markedCount_ + 1;
+  const Cursor<Traits> c{first_, pos, last_, true /* forwards */};
+  std::vector<CapturedRange> &current = scratch.ranges;
+  current.assign(ranges, ranges + rangeCount);
+
+  // Follow the instructions from ip depth first, so that the threads are added
+  // in the order in which the backtracking executor would try them.
+  for (;;) {
+    while (scratch.visited[ip] != scratch.generation) {
+      scratch.visited[ip] = scratch.generation;
+      const Insn *base = reinterpret_cast<const Insn *>(&bytecode[ip]);
+      switch (base->opcode) {
+        case Opcode::Jump32:
+          ip = llvh::cast<Jump32Insn>(base)->target;
+          continue;
+
+        case Opcode::Alternation: {
+          const AlternationInsn *alt = llvh::cast<AlternationInsn>(base);
+          if (c.satisfiesConstraints(flags_, alt->secondaryConstraints)) {
+            scratch.pendingIps.push_back(alt->secondaryBranch);
+            scratch.pendingRanges.insert(
+                scratch.pendingRanges.end(), current.begin(), current.end());
+          }
+          if (!c.satisfiesConstraints(flags_, alt->primaryConstraints))
+            break;
+          ip += sizeof(AlternationInsn);
+          continue;
+        }
+
+        case Opcode::BeginMarkedSubexpression:
+          current[llvh::cast<BeginMarkedSubexpressionInsn>(base)->mexp + 1]
+              .start = c.offsetFromLeft();
+          ip += sizeof(BeginMarkedSubexpressionInsn);
+          continue;
+
+        case Opcode::EndMarkedSubexpression:
+          current[llvh::cast<EndMarkedSubexpressionInsn>(base)->mexp + 1].end =
+              c.offsetFromLeft();
+          ip += sizeof(EndMarkedSubexpressionInsn);
+          continue;
+
+        case Opcode::ClearCaptures: {
+          const auto *insn = llvh::cast<ClearCapturesInsn>(base);
+          for (uint32_t mexp = insn->mexpBegin; mexp != insn->mexpEnd; mexp++)
+            current[mexp + 1] = {kNotMatched, kNotMatched};
+          ip += sizeof(ClearCapturesInsn);
+          continue;
+        }
+
+        case Opcode::LeftAnchor:
+          if (!matchesLeftAnchor(*this, c))
+            break;
+          ip += sizeof(LeftAnchorInsn);
+          continue;
+
+        case Opcode::RightAnchor:
+          if (!matchesRightAnchor(*this, c))
+            break;
+          ip += sizeof(RightAnchorInsn);
+          continue;
+
+        case Opcode::WordBoundary:
+          if (!(matchesWordBoundary(*this, c) ^
+                llvh::cast<WordBoundaryInsn>(base)->invert))
+            break;
+          ip += sizeof(WordBoundaryInsn);
+          continue;
+
+        default:
+          // The goal, or an instruction which matches a single character and
+          // so has to wait for the next step.
+          threads.ips.push_back(ip);
+          threads.ranges.insert(
+              threads.ranges.end(), current.begin(), current.end());
+          break;
+      }
+      // This path has ended, either in a new thread or in a failure.
+      break;
+    }
+
+    if (scratch.pendingIps.empty())
+      return;
+    ip = scratch.pendingIps.back();
+    scratch.pendingIps.pop_back();
+    current.assign(
+        scratch.pendingRanges.end() - rangeCount, scratch.pendingRanges.end());
+    scratch.pendingRanges.resize(scratch.pendingRanges.size() - rangeCount);
+  }
+}
+
+template <class Traits>
+auto Context<Traits>::matchWithAutomaton(State<Traits> *s, bool onlyAtStart)
+    -> const CodeUnit * {
+  auto header =
+      reinterpret_cast<const RegexBytecodeHeader *>(bytecodeStream_.data());
+  assert(header->automatonOffset && "Regex has no automaton");
+  const uint8_t *const bytecode = &bytecodeStream_[sizeof(RegexBytecodeHeader)];
+  const uint32_t startIp = header->automatonOffset;
+  const uint32_t rangeCount = markedCount_ + 1;
+
+  const CodeUnit *const startLoc = s->cursor_.currentPointer();
+  const size_t charsToRight = s->cursor_.offsetFromRight();
+
+  AutomatonScratch scratch;
+  scratch.visited.resize(bytecodeStream_.size() - sizeof(RegexBytecodeHeader));
+  AutomatonThreadList threads, nextThreads;
+
+  // The captured ranges of a thread starting a new match attempt.
+  std::vector<CapturedRange> startRanges(
+      rangeCount, CapturedRange{kNotMatched, kNotMatched});
+
+  // The captured ranges and the end of the match with the highest priority
+  // found so far.
+  std::vector<CapturedRange> matchRanges;
+  const CodeUnit *matchEnd = nullptr;
+
+  const CodeUnit *pos = startLoc;
+  scratch.generation++;
+  for (;;) {
+    // Until a match is found, start a new attempt at every position, with a
+    // lower priority than the attempts which started earlier.
+    if (!matchEnd && (pos == startLoc || !onlyAtStart)) {
+      // Skip the positions at which no match can start when there is nothing
+      // else to do there.
+      if (threads.empty() && prefilter_ && !onlyAtStart) {
+        size_t index =
+            nextPrefilterCandidate(startLoc, pos - startLoc, charsToRight);
+        if (index > charsToRight)
+          break;
+        if (startLoc + index != pos) {
+          pos = startLoc + index;
+          scratch.generation++;
+        }
+      }
+      startRanges[0].start = pos - first_;
+      addAutomatonThread(threads, startIp, startRanges.data(), pos, scratch);
+    }
+    // Stop once there are no threads left and no new attempts will start.
+    if (threads.empty() && (matchEnd || onlyAtStart))
+      break;
+
+    // Find where the character at pos ends. In unicode regexes every
+    // instruction consumes a whole surrogate pair or fails on it.
+    Cursor<Traits> c{first_, pos, last_, true /* forwards */};
+    if (!c.atEnd()) {
+      if (syntaxFlags_.unicode)
+        c.consumeUTF16();
+      else
+        c.consume();
+    }
+    const CodeUnit *nextPos = c.currentPointer();
+
+    // Step every thread over that character, in priority order.
+    nextThreads.clear();
+    scratch.generation++;
+    for (size_t i = 0, e = threads.ips.size(); i < e; i++) {
+      uint32_t ip = threads.ips[i];
+      const Insn *base = reinterpret_cast<const Insn *>(&bytecode[ip]);
+      const CapturedRange *ranges = &threads.ranges[i * rangeCount];
+      if (base->opcode == Opcode::Goal) {
+        // The remaining threads have a lower priority than this match, so
+        // drop them.
+        matchRanges.assign(ranges, ranges + rangeCount);
+        matchEnd = pos;
+        break;
+      }
+      Cursor<Traits> threadCursor{first_, pos, last_, true /* forwards */};
+      if (threadCursor.atEnd() || !matchesOneCharacter(base, threadCursor))
+        continue;
+      assert(
+          threadCursor.currentPointer() == nextPos &&
+          "Instruction matched part of a character");
+      addAutomatonThread(
+          nextThreads,
+          ip + singleCharacterInsnWidth(base),
+          ranges,
+          nextPos,
+          scratch);
+    }
+    if (pos == last_)
+      break;
+    pos = nextPos;
+    std::swap(threads, nextThreads);
+  }
+
+  if (!matchEnd)
+    return nullptr;
+  s->cursor_.setCurrentPointer(matchEnd);
+  std::copy(
+      matchRanges.begin() + 1,
+      matchRanges.end(),
+      s->capturedRanges_.begin());
+  return first_ + matchRanges[0].start;
+}
+
 /// Entry point for searching a string via regex compiled bytecode.
 /// Given the bytecode \p bytecode, search the range starting at \p first up to
 /// (not including) \p last with the flags \p matchFlags. If the search
@@ -1543,12 +1996,29 @@ MatchRuntimeResult searchWithBytecodeImpl(
   bool onlyAtStart = (header->constraints & MatchConstraintAnchoredAtStart) ||
       (matchFlags & constants::matchOnlyAtStart);
 
-  auto res = ctx.match(&state, onlyAtStart);
-  if (!res) {
-    assert(res.getStatus() == ExecutionStatus::STACK_OVERFLOW);
-    return MatchRuntimeResult::StackOverflow;
+  // Regexes with an automaton normally run the backtracking executor first,
+  // since it is faster on most inputs. If it backtracks excessively, start
+  // again with the automaton, which takes linear time.
+  const bool hasAutomaton = header->automatonOffset != 0 &&
+      !(matchFlags & constants::matchNoAutomaton);
+  const CharT *matchStartLoc;
+  if (hasAutomaton && (matchFlags & constants::matchForceAutomaton)) {
+    matchStartLoc = ctx.matchWithAutomaton(&state, onlyAtStart);
+  } else {
+    if (hasAutomaton)
+      ctx.backtracksRemaining_ = kAutomatonBacktrackLimit;
+    auto res = ctx.match(&state, onlyAtStart);
+    if (res) {
+      matchStartLoc = res.getValue();
+    } else if (hasAutomaton) {
+      state = State<Traits>{cursor, markedCount, loopCount};
+      matchStartLoc = ctx.matchWithAutomaton(&state, onlyAtStart);
+    } else {
+      assert(res.getStatus() == ExecutionStatus::STACK_OVERFLOW);
+      return MatchRuntimeResult::StackOverflow;
+    }
   }
-  if (const CharT *matchStartLoc = res.getValue()) {
+  if (matchStartLoc) {
     // Match succeeded. Return captured ranges. The first range is the total
     // match, followed by any capture groups.
     if (m != nullptr) {
@@ -14,6 +14,7 @@
 #include "llvh/Support/raw_ostream.h"
 
 #include <cctype>
+#include <cstring>
 
 using llvh::StringRef;
 using namespace hermes;
@@ -275,23 +276,25 @@ void dumpInstruction(const regex::Width1LoopInsn *insn, llvh::raw_ostream &OS) {
       aligner(insn->min),
       aligner(insn->max));
 }
-} // namespace
-
-namespace hermes {
 
-void dumpRegexBytecode(llvh::ArrayRef<uint8_t> bytes, llvh::raw_ostream &OS) {
-  // Output the header and then slice it off.
-  auto *header =
-      reinterpret_cast<const regex::RegexBytecodeHeader *>(bytes.data());
+void dumpInstruction(
+    const regex::ClearCapturesInsn *insn,
+    llvh::raw_ostream &OS) {
   OS << llvh::format(
-      "  Header: marked: %u loops: %u flags: %u constraints: %u\n",
-      aligner(header->markedCount),
-      aligner(header->loopCount),
-      aligner(header->syntaxFlags),
-      header->constraints);
-  bytes = bytes.slice(sizeof *header);
-  uint32_t cursor = 0;
-  while (cursor < bytes.size()) {
+      "ClearCaptures: [%u, %u)",
+      aligner(insn->mexpBegin),
+      aligner(insn->mexpEnd));
+}
+
+/// Print the instructions in \p bytes from offset \p begin up to \p end,
+/// which must be the start of an instruction.
+void dumpInstructions(
+    llvh::ArrayRef<uint8_t> bytes,
+    uint32_t begin,
+    uint32_t end,
+    llvh::raw_ostream &OS) {
+  uint32_t cursor = begin;
+  while (cursor < end) {
     // Output offset in left column.
     OS << "  " << llvh::format_hex_no_prefix(cursor, 4) << "  ";
 
@@ -309,8 +312,86 @@ void dumpRegexBytecode(llvh::ArrayRef<uint8_t> bytes, llvh::raw_ostream &OS) {
     }
     OS << '\n';
   }
-  // We expect to have consumed exactly the size of the stream.
-  assert(cursor == bytes.size() && "Invalid instructions in regex stream");
+  // We expect to have consumed exactly the instructions.
+  assert(cursor == end && "Invalid instructions in regex stream");
+}
+
+/// Print the code unit \p cu, as itself if it is printable ASCII and as a
+/// \u escape otherwise.
+void dumpCodeUnit(char16_t cu, llvh::raw_ostream &OS) {
+  if (cu < 128 && std::isprint(cu))
+    OS << static_cast<char>(cu);
+  else
+    OS << llvh::format("\\u%04x", cu);
+}
+
+void dumpPrefilter(
+    const regex::RegexPrefilter *prefilter,
+    llvh::raw_ostream &OS) {
+  OS << "  Prefilter: ";
+  if (prefilter->prefixLength) {
+    OS << "prefix '";
+    const uint8_t *prefixBytes =
+        reinterpret_cast<const uint8_t *>(prefilter + 1);
+    for (uint32_t i = 0; i < prefilter->prefixLength; i++) {
+      char16_t cu;
+      std::memcpy(&cu, prefixBytes + i * sizeof(cu), sizeof(cu));
+      dumpCodeUnit(cu, OS);
+    }
+    OS << "'\n";
+    return;
+  }
+  // Print the first code units as ranges in a bracket.
+  OS << "first [";
+  for (uint32_t cu = 0; cu < 256; cu++) {
+    if (!prefilter->mayStartWith(cu))
+      continue;
+    uint32_t last = cu;
+    while (last + 1 < 256 && prefilter->mayStartWith(last + 1))
+      last++;
+    dumpCodeUnit(cu, OS);
+    if (last != cu) {
+      OS << '-';
+      dumpCodeUnit(last, OS);
+    }
+    cu = last;
+  }
+  if (prefilter->firstCodeUnitsAboveLatin1)
+    OS << "\\u0100-\\uffff";
+  OS << "]\n";
+}
+} // namespace
+
+namespace hermes {
+
+void dumpRegexBytecode(llvh::ArrayRef<uint8_t> bytes, llvh::raw_ostream &OS) {
+  // Output the header and then slice it off.
+  auto *header =
+      reinterpret_cast<const regex::RegexBytecodeHeader *>(bytes.data());
+  OS << llvh::format(
+      "  Header: marked: %u loops: %u flags: %u constraints: %u\n",
+      aligner(header->markedCount),
+      aligner(header->loopCount),
+      aligner(header->syntaxFlags),
+      header->constraints);
+  bytes = bytes.slice(sizeof *header);
+  // Any prefilter follows the instructions, and any automaton program follows
+  // that.
+  const uint32_t automatonBegin = header->automatonOffset;
+  const uint32_t instructionsEnd = header->prefilterOffset
+      ? header->prefilterOffset
+      : automatonBegin ? automatonBegin : bytes.size();
+  dumpInstructions(bytes, 0, instructionsEnd, OS);
+  if (header->prefilterOffset) {
+    dumpPrefilter(
+        reinterpret_cast<const regex::RegexPrefilter *>(
+            &bytes[header->prefilterOffset]),
+        OS);
+  }
+  if (automatonBegin) {
+    OS << "  Automaton:\n";
+    dumpInstructions(bytes, automatonBegin, bytes.size(), OS);
+  }
 }
 
 CompiledRegExp::CompiledRegExp(CompiledRegExp &&) = default;
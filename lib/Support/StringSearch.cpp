@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/StringSearch.h"
+
+#include "llvh/ADT/SmallVector.h"
+#include "llvh/Support/MathExtras.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define HERMES_STRINGSEARCH_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HERMES_STRINGSEARCH_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define HERMES_STRINGSEARCH_NEON
+#endif
+
+namespace hermes {
+
+namespace {
+
+/// Needles at least this long are searched for with Boyer-Moore-Horspool.
+/// Shorter needles rarely allow a long enough skip to beat comparing several
+/// positions at once.
+constexpr size_t kLongNeedleLength = 32;
+
+#if defined(HERMES_STRINGSEARCH_AVX2) || defined(HERMES_STRINGSEARCH_SSE2) || \
+    defined(HERMES_STRINGSEARCH_NEON)
+#define HERMES_STRINGSEARCH_SIMD
+
+/// Compares a block of kLanes consecutive code units of type T with a single
+/// code unit. Each block comparison results in a vector of lanes which are
+/// all ones when they matched. mask() turns that into an integer with
+/// kBitsPerLane bits per lane, starting with the lowest bits.
+template <typename T>
+struct Block;
+
+#if defined(HERMES_STRINGSEARCH_AVX2)
+
+template <>
+struct Block<char> {
+  using Vec = __m256i;
+  static constexpr size_t kLanes = 32;
+  static constexpr unsigned kBitsPerLane = 1;
+  static Vec splat(char c) {
+    return _mm256_set1_epi8(c);
+  }
+  static Vec eq(const char *p, Vec c) {
+    return _mm256_cmpeq_epi8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)), c);
+  }
+  static Vec both(Vec a, Vec b) {
+    return _mm256_and_si256(a, b);
+  }
+  static uint64_t mask(Vec v) {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(v));
+  }
+};
+
+template <>
+struct Block<char16_t> {
+  using Vec = __m256i;
+  static constexpr size_t kLanes = 16;
+  static constexpr unsigned kBitsPerLane = 2;
+  static Vec splat(char16_t c) {
+    return _mm256_set1_epi16(static_cast<short>(c));
+  }
+  static Vec eq(const char16_t *p, Vec c) {
+    return _mm256_cmpeq_epi16(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)), c);
+  }
+  static Vec both(Vec a, Vec b) {
+    return _mm256_and_si256(a, b);
+  }
+  static uint64_t mask(Vec v) {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(v));
+  }
+};
+
+#elif defined(HERMES_STRINGSEARCH_SSE2)
+
+template <>
+struct Block<char> {
+  using Vec = __m128i;
+  static constexpr size_t kLanes = 16;
+  static constexpr unsigned kBitsPerLane = 1;
+  static Vec splat(char c) {
+    return _mm_set1_epi8(c);
+  }
+  static Vec eq(const char *p, Vec c) {
+    return _mm_cmpeq_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), c);
+  }
+  static Vec both(Vec a, Vec b) {
+    return _mm_and_si128(a, b);
+  }
+  static uint64_t mask(Vec v) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(v));
+  }
+};
+
+template <>
+struct Block<char16_t> {
+  using Vec = __m128i;
+  static constexpr size_t kLanes = 8;
+  static constexpr unsigned kBitsPerLane = 2;
+  static Vec splat(char16_t c) {
+    return _mm_set1_epi16(static_cast<short>(c));
+  }
+  static Vec eq(const char16_t *p, Vec c) {
+    return _mm_cmpeq_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), c);
+  }
+  static Vec both(Vec a, Vec b) {
+    return _mm_and_si128(a, b);
+  }
+  static uint64_t mask(Vec v) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(v));
+  }
+};
+
+#elif defined(HERMES_STRINGSEARCH_NEON)
+
+/// NEON has no movemask, so narrow each byte of the comparison result to four
+/// bits instead.
+static inline uint64_t neonMask(uint8x16_t v) {
+  return vget_lane_u64(
+      vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(v), 4)), 0);
+}
+
+template <>
+struct Block<char> {
+  using Vec = uint8x16_t;
+  static constexpr size_t kLanes = 16;
+  static constexpr unsigned kBitsPerLane = 4;
+  static Vec splat(char c) {
+    return vdupq_n_u8(static_cast<uint8_t>(c));
+  }
+  static Vec eq(const char *p, Vec c) {
+    return vceqq_u8(vld1q_u8(reinterpret_cast<const uint8_t *>(p)), c);
+  }
+  static Vec both(Vec a, Vec b) {
+    return vandq_u8(a, b);
+  }
+  static uint64_t mask(Vec v) {
+    return neonMask(v);
+  }
+};
+
+template <>
+struct Block<char16_t> {
+  using Vec = uint16x8_t;
+  static constexpr size_t kLanes = 8;
+  static constexpr unsigned kBitsPerLane = 8;
+  static Vec splat(char16_t c) {
+    return vdupq_n_u16(c);
+  }
+  static Vec eq(const char16_t *p, Vec c) {
+    return vceqq_u16(vld1q_u16(reinterpret_cast<const uint16_t *>(p)), c);
+  }
+  static Vec both(Vec a, Vec b) {
+    return vandq_u16(a, b);
+  }
+  static uint64_t mask(Vec v) {
+    return neonMask(vreinterpretq_u8_u16(v));
+  }
+};
+
+#endif
+#endif
+
+/// Search for a needle of length \p nLen, with 0 < nLen <= hLen, by only
+/// comparing the whole needle at positions where its first and last code
+/// units match.
+template <typename T>
+llvh::Optional<size_t>
+searchPairs(const T *h, size_t hLen, const T *n, size_t nLen) {
+  const size_t last = nLen - 1;
+  // The number of positions at which the needle could start.
+  const size_t numStarts = hLen - last;
+  const T first = n[0];
+  const T lastUnit = n[last];
+  size_t i = 0;
+#ifdef HERMES_STRINGSEARCH_SIMD
+  using B = Block<T>;
+  const auto firstSplat = B::splat(first);
+  const auto lastSplat = B::splat(lastUnit);
+  constexpr uint64_t kLaneMask = (uint64_t(1) << B::kBitsPerLane) - 1;
+  for (; i + B::kLanes <= numStarts; i += B::kLanes) {
+    uint64_t mask = B::mask(
+        B::both(B::eq(h + i, firstSplat), B::eq(h + i + last, lastSplat)));
+    while (mask) {
+      const unsigned lane = llvh::countTrailingZeros(mask) / B::kBitsPerLane;
+      if (std::memcmp(h + i + lane, n, nLen * sizeof(T)) == 0)
+        return i + lane;
+      mask &= ~(kLaneMask << (lane * B::kBitsPerLane));
+    }
+  }
+#endif
+  for (; i < numStarts; ++i) {
+    if (h[i] == first && h[i + last] == lastUnit &&
+        std::memcmp(h + i, n, nLen * sizeof(T)) == 0)
+      return i;
+  }
+  return llvh::None;
+}
+
+/// Search for a needle of length \p nLen, with 0 < nLen <= hLen, with
+/// Boyer-Moore-Horspool. The skip table is indexed by the low byte of the code
+/// unit, which is exact for ASCII and conservative for UTF-16.
+template <typename T>
+llvh::Optional<size_t>
+searchHorspool(const T *h, size_t hLen, const T *n, size_t nLen) {
+  const size_t last = nLen - 1;
+  size_t skip[256];
+  std::fill(std::begin(skip), std::end(skip), nLen);
+  for (size_t j = 0; j < last; ++j)
+    skip[static_cast<uint8_t>(n[j])] = last - j;
+
+  const T lastUnit = n[last];
+  for (size_t i = 0; i <= hLen - nLen;) {
+    const T unit = h[i + last];
+    if (unit == lastUnit && std::memcmp(h + i, n, last * sizeof(T)) == 0)
+      return i;
+    i += skip[static_cast<uint8_t>(unit)];
+  }
+  return llvh::None;
+}
+
+template <typename T>
+llvh::Optional<size_t> searchSame(
+    llvh::ArrayRef<T> haystack,
+    llvh::ArrayRef<T> needle) {
+  if (needle.empty())
+    return 0;
+  if (needle.size() > haystack.size())
+    return llvh::None;
+  if (needle.size() >= kLongNeedleLength) {
+    return searchHorspool(
+        haystack.data(), haystack.size(), needle.data(), needle.size());
+  }
+  return searchPairs(
+      haystack.data(), haystack.size(), needle.data(), needle.size());
+}
+
+} // namespace
+
+llvh::Optional<size_t> searchString(
+    llvh::ArrayRef<char> haystack,
+    llvh::ArrayRef<char> needle) {
+  if (needle.size() == 1 && !haystack.empty()) {
+    const void *found =
+        std::memchr(haystack.data(), needle[0], haystack.size());
+    if (!found)
+      return llvh::None;
+    return static_cast<const char *>(found) - haystack.data();
+  }
+  return searchSame(haystack, needle);
+}
+
+llvh::Optional<size_t> searchString(
+    llvh::ArrayRef<char> haystack,
+    llvh::ArrayRef<char16_t> needle) {
+  // An ASCII haystack cannot contain non-ASCII code units, and an ASCII needle
+  // can be searched for byte by byte.
+  llvh::SmallVector<char, kLongNeedleLength> narrow;
+  narrow.reserve(needle.size());
+  for (char16_t c : needle) {
+    if (c > 0x7f)
+      return llvh::None;
+    narrow.push_back(static_cast<char>(c));
+  }
+  return searchString(haystack, llvh::ArrayRef<char>(narrow));
+}
+
+llvh::Optional<size_t> searchString(
+    llvh::ArrayRef<char16_t> haystack,
+    llvh::ArrayRef<char> needle) {
+  llvh::SmallVector<char16_t, kLongNeedleLength> wide(
+      needle.begin(), needle.end());
+  return searchSame(haystack, llvh::ArrayRef<char16_t>(wide));
+}
+
+llvh::Optional<size_t> searchString(
+    llvh::ArrayRef<char16_t> haystack,
+    llvh::ArrayRef<char16_t> needle) {
+  return searchSame(haystack, needle);
+}
+
+} // namespace hermes
@@ -8,6 +8,7 @@
 #include "hermes/Support/UTF16Stream.h"
 
 #include <cstdlib>
+#include <cstring>
 
 #include "llvh/ADT/ArrayRef.h"
 #include "llvh/Support/ConvertUTF.h"
@@ -38,10 +39,20 @@ bool UTF16Stream::refill() {
   end_ = storage_.end();
   auto out = storage_.begin();
 
-  // Fast case for any ASCII prefix...
+  // Fast case for any ASCII prefix, checked a word at a time...
   {
     int len = std::min(end_ - cur_, utf8End_ - utf8Begin_);
     int index = 0;
+    constexpr int kWordSize = sizeof(uint64_t);
+    while (index + kWordSize <= len) {
+      uint64_t word;
+      std::memcpy(&word, utf8Begin_ + index, kWordSize);
+      if (word & 0x8080808080808080ull)
+        break;
+      for (int i = 0; i < kWordSize; ++i)
+        out[index + i] = utf8Begin_[index + i];
+      index += kWordSize;
+    }
     while (index < len && utf8Begin_[index] < 128) {
       out[index] = utf8Begin_[index];
       ++index;
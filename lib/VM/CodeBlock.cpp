@@ -351,6 +351,55 @@ void CodeBlock::lazyCompileImpl(Runtime &runtime) {
 }
 #endif // HERMESVM_LEAN
 
+PrototypeCacheEntry *CodeBlock::getOrCreateProtoCacheEntry(
+    const PropertyCacheEntry *entry) {
+  if (!protoPropertyCache_)
+    protoPropertyCache_.reset(new PrototypeCacheEntry[propertyCacheSize_]);
+  return getProtoCacheEntry(entry);
+}
+
+PropertyCacheState CodeBlock::getPropertyCacheState(
+    const PropertyCacheEntry *entry) {
+  if (auto *poly = getPolyCacheEntry(entry)) {
+    if (poly->megamorphic)
+      return PropertyCacheState::Megamorphic;
+    for (const PropertyCacheEntry &secondary : poly->entries) {
+      if (secondary.clazz)
+        return PropertyCacheState::Polymorphic;
+    }
+  }
+  return entry->clazz ? PropertyCacheState::Monomorphic
+                      : PropertyCacheState::Uninitialized;
+}
+
+PropertyCacheState CodeBlock::addPropertyCacheEntry(
+    PropertyCacheEntry *entry,
+    CompressedPointer clazz,
+    SlotIndex slot) {
+  if (!entry->clazz) {
+    entry->clazz = clazz;
+    entry->slot = slot;
+    return getPropertyCacheState(entry);
+  }
+  auto *poly = getPolyCacheEntry(entry);
+  if (!poly) {
+    polyPropertyCache_.reset(
+        new PolymorphicPropertyCacheEntry[propertyCacheSize_]);
+    poly = getPolyCacheEntry(entry);
+  }
+  if (poly->megamorphic)
+    return PropertyCacheState::Megamorphic;
+  for (PropertyCacheEntry &secondary : poly->entries) {
+    if (!secondary.clazz) {
+      secondary.clazz = clazz;
+      secondary.slot = slot;
+      return PropertyCacheState::Polymorphic;
+    }
+  }
+  poly->megamorphic = true;
+  return PropertyCacheState::Megamorphic;
+}
+
 void CodeBlock::markCachedHiddenClasses(
     Runtime &runtime,
     WeakRootAcceptor &acceptor) {
@@ -360,6 +409,32 @@ void CodeBlock::markCachedHiddenClasses(
       acceptor.acceptWeak(prop.clazz);
     }
   }
+  if (polyPropertyCache_) {
+    for (auto &poly : llvh::makeMutableArrayRef(
+             polyPropertyCache_.get(), propertyCacheSize_)) {
+      for (auto &prop : poly.entries) {
+        if (prop.clazz) {
+          acceptor.acceptWeak(prop.clazz);
+        }
+      }
+    }
+  }
+  if (protoPropertyCache_) {
+    for (auto &proto : llvh::makeMutableArrayRef(
+             protoPropertyCache_.get(), propertyCacheSize_)) {
+      if (proto.receiverClazz) {
+        acceptor.acceptWeak(proto.receiverClazz);
+      }
+      for (auto &link : proto.chain) {
+        if (link.object) {
+          acceptor.acceptWeak(link.object);
+        }
+        if (link.clazz) {
+          acceptor.acceptWeak(link.clazz);
+        }
+      }
+    }
+  }
 }
 
 uint32_t CodeBlock::getVirtualOffset() const {
@@ -719,6 +719,36 @@ void GCBase::DebugHeapInfo::assertInvariants() const {
 void GCBase::dump(llvh::raw_ostream &, bool) { /* nop */
 }
 
+/// Labels for the buckets of CumulativeHeapStats::gcPauseHistogram.
+static constexpr const char *kPauseBucketNames[] = {
+    "<0.25ms",
+    "<0.5ms",
+    "<1ms",
+    "<2ms",
+    "<4ms",
+    "<8ms",
+    "<16ms",
+    "<32ms",
+    "<64ms",
+    "<128ms",
+    ">=128ms"};
+static_assert(
+    sizeof(kPauseBucketNames) / sizeof(kPauseBucketNames[0]) ==
+        GCBase::CumulativeHeapStats::kNumPauseBuckets,
+    "Every pause bucket needs a label");
+
+/// \return the index of the gcPauseHistogram bucket for a pause of \p secs.
+static unsigned pauseBucket(double secs) {
+  double bound = 0.25e-3;
+  unsigned bucket = 0;
+  while (bucket + 1 < GCBase::CumulativeHeapStats::kNumPauseBuckets &&
+         secs >= bound) {
+    bound *= 2;
+    ++bucket;
+  }
+  return bucket;
+}
+
 void GCBase::printStats(JSONEmitter &json) {
   json.emitKeyValue("type", "hermes");
   json.emitKeyValue("version", 0);
@@ -787,6 +817,11 @@ void GCBase::printStats(JSONEmitter &json) {
       "avgGCCPUPause", formatSecs(cumStats_.gcCPUTime.average()).secs);
   json.emitKeyValue(
       "maxGCCPUPause", formatSecs(cumStats_.gcCPUTime.max()).secs);
+  json.emitKey("gcPauseHistogram");
+  json.openDict();
+  for (unsigned i = 0; i < CumulativeHeapStats::kNumPauseBuckets; ++i)
+    json.emitKeyValue(kPauseBucketNames[i], cumStats_.gcPauseHistogram[i]);
+  json.closeDict();
   json.emitKeyValue("finalHeapSize", formatSize(cumStats_.finalHeapSize).bytes);
   json.emitKeyValue(
       "peakAllocatedBytes", formatSize(getPeakAllocatedBytes()).bytes);
@@ -829,9 +864,12 @@ void GCBase::recordGCStats(
     bool onMutator) {
   // Hades OG collections do not block the mutator, and so do not contribute to
   // the max pause time or the total execution time.
-  if (onMutator)
-    stats->gcWallTime.record(
-        std::chrono::duration<double>(event.duration).count());
+  if (onMutator) {
+    const double pauseSecs =
+        std::chrono::duration<double>(event.duration).count();
+    stats->gcWallTime.record(pauseSecs);
+    stats->gcPauseHistogram[pauseBucket(pauseSecs)]++;
+  }
   stats->gcCPUTime.record(
       std::chrono::duration<double>(event.cpuDuration).count());
   stats->finalHeapSize = event.size.after;
@@ -1812,9 +1850,12 @@ void GCBase::sizeDiagnosticCensus(size_t allocatedBytes) {
     // We include ExternalStringPrimitives because we're including external
     // memory in the overall heap size. We do not include
     // BufferedStringPrimitives because they just store a pointer to an
-    // ExternalStringPrimitive (which is already tracked).
+    // ExternalStringPrimitive (which is already tracked), nor ropes that are
+    // still only a pair of pointers to other strings, nor slices, whose
+    // characters are counted in the string they are a slice of.
     auto *strprim = dyn_vmcast<StringPrimitive>(cell);
-    if (strprim && !isBufferedStringPrimitive(cell)) {
+    if (strprim && !isBufferedStringPrimitive(cell) &&
+        !isSlicedStringPrimitive(cell) && strprim->isFlat()) {
       auto &stat = strprim->isASCII()
           ? acceptor.diagnostic.stats.breakdown["StringPrimitive (ASCII)"]
           : acceptor.diagnostic.stats.breakdown["StringPrimitive (UTF-16)"];
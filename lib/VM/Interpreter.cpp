@@ -50,9 +50,18 @@ HERMES_SLOW_STATISTIC(
 HERMES_SLOW_STATISTIC(
     NumGetByIdProtoHits,
     "NumGetByIdProtoHits: Number of property 'read by id' cache hits for the prototype");
+HERMES_SLOW_STATISTIC(
+    NumGetByIdProtoFastPaths,
+    "NumGetByIdProtoFastPaths: Number of property 'read by id' fast paths for the prototype");
+HERMES_SLOW_STATISTIC(
+    NumGetByIdPolyHits,
+    "NumGetByIdPolyHits: Number of property 'read by id' polymorphic cache hits");
+HERMES_SLOW_STATISTIC(
+    NumGetByIdMegaHits,
+    "NumGetByIdMegaHits: Number of property 'read by id' megamorphic cache hits");
 HERMES_SLOW_STATISTIC(
     NumGetByIdCacheEvicts,
-    "NumGetByIdCacheEvicts: Number of property 'read by id' cache evictions");
+    "NumGetByIdCacheEvicts: Number of property 'read by id' cache evictions and insertions dropped by megamorphic sites");
 HERMES_SLOW_STATISTIC(
     NumGetByIdFastPaths,
     "NumGetByIdFastPaths: Number of property 'read by id' fast paths");
@@ -81,9 +90,15 @@ HERMES_SLOW_STATISTIC(
 HERMES_SLOW_STATISTIC(
     NumPutByIdCacheHits,
     "NumPutByIdCacheHits: Number of property 'write by id' cache hits");
+HERMES_SLOW_STATISTIC(
+    NumPutByIdPolyHits,
+    "NumPutByIdPolyHits: Number of property 'write by id' polymorphic cache hits");
+HERMES_SLOW_STATISTIC(
+    NumPutByIdMegaHits,
+    "NumPutByIdMegaHits: Number of property 'write by id' megamorphic cache hits");
 HERMES_SLOW_STATISTIC(
     NumPutByIdCacheEvicts,
-    "NumPutByIdCacheEvicts: Number of property 'write by id' cache evictions");
+    "NumPutByIdCacheEvicts: Number of property 'write by id' cache evictions and insertions dropped by megamorphic sites");
 HERMES_SLOW_STATISTIC(
     NumPutByIdFastPaths,
     "NumPutByIdFastPaths: Number of property 'write by id' fast paths");
@@ -91,6 +106,26 @@ HERMES_SLOW_STATISTIC(
     NumPutByIdTransient,
     "NumPutByIdTransient: Number of property 'write by id' to non-objects");
 
+HERMES_SLOW_STATISTIC(
+    NumSuperInstFastPaths,
+    "NumSuperInstFastPaths: "
+    "Number of superinstructions executed with a single dispatch");
+
+HERMES_SLOW_STATISTIC(
+    NumGetByValArrayFastPaths,
+    "NumGetByValArrayFastPaths: Number of 'read by value' array fast paths");
+HERMES_SLOW_STATISTIC(
+    NumPutByValArrayFastPaths,
+    "NumPutByValArrayFastPaths: Number of 'write by value' array fast paths");
+HERMES_SLOW_STATISTIC(
+    NumGetByValTypedArrayFastPaths,
+    "NumGetByValTypedArrayFastPaths: "
+    "Number of 'read by value' typed array fast paths");
+HERMES_SLOW_STATISTIC(
+    NumPutByValTypedArrayFastPaths,
+    "NumPutByValTypedArrayFastPaths: "
+    "Number of 'write by value' typed array fast paths");
+
 HERMES_SLOW_STATISTIC(
     NumNativeFunctionCalls,
     "NumNativeFunctionCalls: Number of native function calls");
@@ -122,6 +157,113 @@ typedef CallResult<HermesValue> (*WrapperFunc)(Runtime &, CodeBlock *);
 static const WrapperFunc interpWrappers[] = {PROFILER_SYMBOLS(LIST_ITEM)};
 #endif
 
+/// \return the holder of the property cached in \p entry if the entry is
+/// valid for the receiver \p obj, whose class is \p clazzPtr, or nullptr
+/// otherwise.
+static inline JSObject *findPrototypeCacheHolder(
+    Runtime &runtime,
+    const PrototypeCacheEntry &entry,
+    JSObject *obj,
+    CompressedPointer clazzPtr) {
+  if (entry.receiverClazz != clazzPtr)
+    return nullptr;
+  // Lazy, Proxy and host objects may share a class with ordinary objects, but
+  // their properties are not described by it.
+  if (LLVM_UNLIKELY(
+          obj->isLazy() || obj->isProxyObject() || obj->isHostObject()))
+    return nullptr;
+  JSObject *cur = obj;
+  for (unsigned i = 0; i < entry.depth; ++i) {
+    // cur is either obj or an object of the cached chain, which was checked
+    // to be neither a Proxy nor a host object when it was cached.
+    cur = cur->getParent(runtime);
+    if (!cur ||
+        entry.chain[i].object != CompressedPointer::encodeNonNull(cur, runtime) ||
+        entry.chain[i].clazz != cur->getClassGCPtr())
+      return nullptr;
+  }
+  return cur;
+}
+
+/// Look for the property \p id on the prototype chain of \p obj, which is
+/// known not to have it as an own property, following at most
+/// PrototypeCacheEntry::kMaxDepth parents and without allocating.
+/// If the property is found as a data property, populate \p desc, record the
+/// chain in \p entry (if not null) when the chain can be cached, and
+/// \return the object holding it. \return nullptr if the property was not
+/// found that way, in which case the full lookup must be performed.
+static JSObject *lookupPrototypeChainFast(
+    Runtime &runtime,
+    JSObject *obj,
+    SymbolID id,
+    NamedPropertyDescriptor &desc,
+    PrototypeCacheEntry *entry) {
+  constexpr unsigned kMaxDepth = PrototypeCacheEntry::kMaxDepth;
+  // Objects on the chain are only recorded if they are not in the young
+  // generation, since cache entries are long-lived weak roots which are not
+  // updated when young objects are moved.
+  GC &heap = runtime.getHeap();
+  bool cacheable = entry && !obj->getClass(runtime)->isDictionary();
+  JSObject *chain[kMaxDepth];
+  JSObject *cur = obj;
+  for (unsigned depth = 1; depth <= kMaxDepth; ++depth) {
+    cur = cur->getParent(runtime);
+    if (!cur ||
+        LLVM_UNLIKELY(
+            cur->isLazy() || cur->isProxyObject() || cur->isHostObject()))
+      return nullptr;
+    OptValue<bool> found =
+        JSObject::tryGetOwnNamedDescriptorFast(cur, runtime, id, desc);
+    if (!found.hasValue())
+      return nullptr;
+    HiddenClass *clazz = cur->getClass(runtime);
+    chain[depth - 1] = cur;
+    cacheable = cacheable && !heap.inYoungGen(cur);
+    if (!*found) {
+      // Adding the property to a dictionary does not change its class, so
+      // the absence of the property can't be cached.
+      cacheable = cacheable && !clazz->isDictionary();
+      continue;
+    }
+    if (desc.flags.accessor || desc.flags.hostObject || desc.flags.proxyObject)
+      return nullptr;
+    if (cacheable && !clazz->isDictionaryNoCache()) {
+      entry->receiverClazz = obj->getClassGCPtr();
+      entry->slot = desc.slot;
+      entry->depth = depth;
+      for (unsigned i = 0; i < depth; ++i) {
+        entry->chain[i].object.set(runtime, chain[i]);
+        entry->chain[i].clazz = chain[i]->getClassGCPtr();
+      }
+    }
+    return cur;
+  }
+  return nullptr;
+}
+
+#ifdef HERMESVM_PROFILER_BB
+/// \return the hidden class of \p obj if any entry of the property cache site
+/// whose primary entry is \p cacheEntry matches it (consulting \p megaCache
+/// for megamorphic sites), otherwise the class in the primary entry.
+static HiddenClass *findCachedHiddenClass(
+    Runtime &runtime,
+    CodeBlock *codeBlock,
+    PropertyCacheEntry *cacheEntry,
+    const MegamorphicPropertyCache &megaCache,
+    JSObject *obj,
+    SymbolID id) {
+  CompressedPointer clazzPtr{obj->getClassGCPtr()};
+  if (auto *polyEntry = codeBlock->getPolyCacheEntry(cacheEntry)) {
+    if (polyEntry->find(clazzPtr) ||
+        (polyEntry->megamorphic && megaCache.find(clazzPtr, id))) {
+      return obj->getClass(runtime);
+    }
+  }
+  return vmcast_or_null<HiddenClass>(static_cast<GCCell *>(
+      cacheEntry->clazz.get(runtime, runtime.getHeap())));
+}
+#endif
+
 /// Initialize the state of some internal variables based on the current
 /// code block.
 #define INIT_STATE_FOR_CODEBLOCK(codeBlock)                      \
@@ -1090,6 +1232,22 @@ tailCall:
 
   INIT_STATE_FOR_CODEBLOCK(curCodeBlock);
 
+#ifdef HERMESVM_JIT
+  // Run the function natively if it has been compiled. The compiled code
+  // stops at the first Ret or exception, which are then handled below as if
+  // the whole function had been interpreted.
+  if (!SingleStep) {
+    if (JITCompiledFunctionPtr jitFn =
+            runtime.getJITContext().compile(runtime, curCodeBlock)) {
+      const Inst *jitIP;
+      ExecutionStatus jitStatus = jitFn(&runtime, frameRegs, &jitIP);
+      ip = jitIP;
+      if (LLVM_UNLIKELY(jitStatus == ExecutionStatus::EXCEPTION))
+        goto exception;
+    }
+  }
+#endif
+
 #define BEFORE_OP_CODE                                                       \
   {                                                                          \
     UPDATE_OPCODE_TIME_SPENT;                                                \
@@ -1126,6 +1284,11 @@ tailCall:
     return HermesValue::encodeUndefinedValue(); \
   }                                             \
   goto *opcodeDispatch[(unsigned)ip->opCode]
+// Continue with the instruction \p name, which ip is known to point to,
+// without an indirect jump.
+#define DISPATCH_TO(name) \
+  BEFORE_OP_CODE;         \
+  goto case_##name
 
 #else // HERMESVM_INDIRECT_THREADING
 
@@ -1138,6 +1301,7 @@ tailCall:
     return HermesValue::encodeUndefinedValue(); \
   }                                             \
   continue
+#define DISPATCH_TO(name) DISPATCH
 
 #endif // HERMESVM_INDIRECT_THREADING
 
@@ -2247,6 +2411,45 @@ tailCall:
         DISPATCH;
       }
 
+/// Implement the superinstruction \p name, which is the GetById variant
+/// \p first followed by the instruction \p second. If the property is found
+/// in the primary cache entry, \p second is executed without a separate
+/// dispatch; otherwise this is executed like \p first. This is never done when
+/// single stepping, or when a breakpoint has replaced the opcode of \p second.
+#define GET_BY_ID_THEN(name, first, second, isTry)                             \
+  CASE(name) {                                                                 \
+    nextIP = NEXTINST(first);                                                  \
+    if (!SingleStep && LLVM_LIKELY(nextIP->opCode == OpCode::second) &&        \
+        LLVM_LIKELY(O2REG(first).isObject())) {                                \
+      auto *obj = vmcast<JSObject>(O2REG(first));                              \
+      auto *cacheEntry = curCodeBlock->getReadCacheEntry(ip->i##first.op3);    \
+      if (LLVM_LIKELY(                                                         \
+              cacheEntry->clazz == CompressedPointer{obj->getClassGCPtr()})) { \
+        ++NumGetById;                                                          \
+        ++NumGetByIdCacheHits;                                                 \
+        ++NumSuperInstFastPaths;                                               \
+        CAPTURE_IP(                                                            \
+            O1REG(first) =                                                     \
+                JSObject::getNamedSlotValueUnsafe<PropStorage::Inline::Yes>(   \
+                    obj, runtime, cacheEntry->slot)                            \
+                    .unboxToHV(runtime));                                      \
+        ip = nextIP;                                                           \
+        DISPATCH_TO(second);                                                   \
+      }                                                                        \
+    }                                                                          \
+    tryProp = isTry;                                                           \
+    idVal = ip->i##first.op4;                                                  \
+    goto getById;                                                              \
+  }
+
+      GET_BY_ID_THEN(TryGetByIdThenGetByIdShort, TryGetById, GetByIdShort, true)
+      GET_BY_ID_THEN(
+          GetByIdShortThenGetByIdShort, GetByIdShort, GetByIdShort, false)
+      GET_BY_ID_THEN(GetByIdShortThenCall1, GetByIdShort, Call1, false)
+      GET_BY_ID_THEN(GetByIdShortThenCall2, GetByIdShort, Call2, false)
+      GET_BY_ID_THEN(GetByIdShortThenCall3, GetByIdShort, Call3, false)
+#undef GET_BY_ID_THEN
+
       CASE(TryGetByIdLong) {
         tryProp = true;
         idVal = ip->iTryGetByIdLong.op4;
@@ -2293,8 +2496,13 @@ tailCall:
               gcScope.getHandleCountDbg() == KEEP_HANDLES &&
               "unaccounted handles were created");
           auto objHandle = runtime.makeHandle(obj);
-          auto cacheHCPtr = vmcast_or_null<HiddenClass>(static_cast<GCCell *>(
-              cacheEntry->clazz.get(runtime, runtime.getHeap())));
+          auto cacheHCPtr = findCachedHiddenClass(
+              runtime,
+              curCodeBlock,
+              cacheEntry,
+              runtime.megamorphicReadCache_,
+              obj,
+              ID(idVal));
           CAPTURE_IP(runtime.recordHiddenClass(
               curCodeBlock, ip, ID(idVal), obj->getClass(runtime), cacheHCPtr));
           // obj may be moved by GC due to recordHiddenClass
@@ -2323,6 +2531,41 @@ tailCall:
           DISPATCH;
         }
         auto id = ID(idVal);
+        // On a primary miss, try the secondary entries of a polymorphic site,
+        // and the shared cache if the site is megamorphic.
+        if (auto *polyEntry = curCodeBlock->getPolyCacheEntry(cacheEntry)) {
+          const PropertyCacheEntry *hit = polyEntry->find(clazzPtr);
+          if (hit) {
+            ++NumGetByIdPolyHits;
+          } else if (polyEntry->megamorphic) {
+            hit = runtime.megamorphicReadCache_.find(clazzPtr, id);
+            if (hit)
+              ++NumGetByIdMegaHits;
+          }
+          if (LLVM_LIKELY(hit != nullptr)) {
+            CAPTURE_IP(
+                O1REG(GetById) =
+                    JSObject::getNamedSlotValueUnsafe<PropStorage::Inline::Yes>(
+                        obj, runtime, hit->slot)
+                        .unboxToHV(runtime));
+            ip = nextIP;
+            DISPATCH;
+          }
+        }
+        // A receiver whose class matches the prototype entry doesn't have the
+        // property, so it can be read from the holder without any lookup.
+        if (auto *protoEntry = curCodeBlock->getProtoCacheEntry(cacheEntry)) {
+          if (JSObject *holder = findPrototypeCacheHolder(
+                  runtime, *protoEntry, obj, clazzPtr)) {
+            ++NumGetByIdProtoHits;
+            CAPTURE_IP(
+                O1REG(GetById) = JSObject::getNamedSlotValueUnsafe(
+                                     holder, runtime, protoEntry->slot)
+                                     .unboxToHV(runtime));
+            ip = nextIP;
+            DISPATCH;
+          }
+        }
         NamedPropertyDescriptor desc;
         CAPTURE_IP_ASSIGN(
             OptValue<bool> fastPathResult,
@@ -2338,15 +2581,16 @@ tailCall:
               vmcast<HiddenClass>(clazzPtr.getNonNull(runtime));
           if (LLVM_LIKELY(!clazz->isDictionaryNoCache()) &&
               LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
-#ifdef HERMES_SLOW_DEBUG
-            if (cacheEntry->clazz && cacheEntry->clazz != clazzPtr)
+            // Cache the class and property slot.
+            PropertyCacheState state = curCodeBlock->addPropertyCacheEntry(
+                cacheEntry, clazzPtr, desc.slot);
+            if (state == PropertyCacheState::Megamorphic) {
               ++NumGetByIdCacheEvicts;
-#else
-            (void)NumGetByIdCacheEvicts;
+              runtime.megamorphicReadCache_.insert(clazzPtr, id, desc.slot);
+            }
+#ifdef HERMESVM_PROFILER_BB
+            runtime.recordPropertyCacheState(curCodeBlock, ip, state);
 #endif
-            // Cache the class, id and property slot.
-            cacheEntry->clazz = clazzPtr;
-            cacheEntry->slot = desc.slot;
           }
 
           assert(
@@ -2360,24 +2604,30 @@ tailCall:
           DISPATCH;
         }
 
-        // The cache may also be populated via the prototype of the object.
-        // This value is only reliable if the fast path was a definite
-        // not-found.
+        // The property may be found on the prototype chain of the object,
+        // which also populates the prototype entry of the cache. This is only
+        // reliable if the fast path was a definite not-found.
+        // TODO: This isLazy check is because a lazy object is reported as
+        // having no properties and therefore cannot contain the property.
+        // This check does not belong here, it should be merged into
+        // tryGetOwnNamedDescriptorFast().
         if (fastPathResult.hasValue() && !fastPathResult.getValue() &&
-            LLVM_LIKELY(!obj->isProxyObject())) {
-          CAPTURE_IP_ASSIGN(JSObject * parent, obj->getParent(runtime));
-          // TODO: This isLazy check is because a lazy object is reported as
-          // having no properties and therefore cannot contain the property.
-          // This check does not belong here, it should be merged into
-          // tryGetOwnNamedDescriptorFast().
-          if (parent && cacheEntry->clazz == parent->getClassGCPtr() &&
-              LLVM_LIKELY(!obj->isLazy())) {
-            ++NumGetByIdProtoHits;
-            // We've already checked that this isn't a Proxy.
+            LLVM_LIKELY(!obj->isProxyObject()) &&
+            LLVM_LIKELY(!obj->isHostObject()) && LLVM_LIKELY(!obj->isLazy())) {
+          JSObject *holder = lookupPrototypeChainFast(
+              runtime,
+              obj,
+              id,
+              desc,
+              cacheIdx != hbc::PROPERTY_CACHING_DISABLED
+                  ? curCodeBlock->getOrCreateProtoCacheEntry(cacheEntry)
+                  : nullptr);
+          if (holder) {
+            ++NumGetByIdProtoFastPaths;
             CAPTURE_IP(
-                O1REG(GetById) = JSObject::getNamedSlotValueUnsafe(
-                                     parent, runtime, cacheEntry->slot)
-                                     .unboxToHV(runtime));
+                O1REG(GetById) =
+                    JSObject::getNamedSlotValueUnsafe(holder, runtime, desc)
+                        .unboxToHV(runtime));
             ip = nextIP;
             DISPATCH;
           }
@@ -2484,8 +2734,13 @@ tailCall:
               "unaccounted handles were created");
           auto shvHandle = runtime.makeHandle(shv.toHV(runtime));
           auto objHandle = runtime.makeHandle(obj);
-          auto cacheHCPtr = vmcast_or_null<HiddenClass>(static_cast<GCCell *>(
-              cacheEntry->clazz.get(runtime, runtime.getHeap())));
+          auto cacheHCPtr = findCachedHiddenClass(
+              runtime,
+              curCodeBlock,
+              cacheEntry,
+              runtime.megamorphicWriteCache_,
+              obj,
+              ID(idVal));
           CAPTURE_IP(runtime.recordHiddenClass(
               curCodeBlock, ip, ID(idVal), obj->getClass(runtime), cacheHCPtr));
           // shv/obj may be invalidated by recordHiddenClass
@@ -2508,6 +2763,25 @@ tailCall:
           DISPATCH;
         }
         auto id = ID(idVal);
+        // On a primary miss, try the secondary entries of a polymorphic site,
+        // and the shared cache if the site is megamorphic.
+        if (auto *polyEntry = curCodeBlock->getPolyCacheEntry(cacheEntry)) {
+          const PropertyCacheEntry *hit = polyEntry->find(clazzPtr);
+          if (hit) {
+            ++NumPutByIdPolyHits;
+          } else if (polyEntry->megamorphic) {
+            hit = runtime.megamorphicWriteCache_.find(clazzPtr, id);
+            if (hit)
+              ++NumPutByIdMegaHits;
+          }
+          if (LLVM_LIKELY(hit != nullptr)) {
+            CAPTURE_IP(
+                JSObject::setNamedSlotValueUnsafe<PropStorage::Inline::Yes>(
+                    obj, runtime, hit->slot, shv));
+            ip = nextIP;
+            DISPATCH;
+          }
+        }
         NamedPropertyDescriptor desc;
         CAPTURE_IP_ASSIGN(
             OptValue<bool> hasOwnProp,
@@ -2523,15 +2797,16 @@ tailCall:
               vmcast<HiddenClass>(clazzPtr.getNonNull(runtime));
           if (LLVM_LIKELY(!clazz->isDictionary()) &&
               LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
-#ifdef HERMES_SLOW_DEBUG
-            if (cacheEntry->clazz && cacheEntry->clazz != clazzPtr)
+            // Cache the class and property slot.
+            PropertyCacheState state = curCodeBlock->addPropertyCacheEntry(
+                cacheEntry, clazzPtr, desc.slot);
+            if (state == PropertyCacheState::Megamorphic) {
               ++NumPutByIdCacheEvicts;
-#else
-            (void)NumPutByIdCacheEvicts;
+              runtime.megamorphicWriteCache_.insert(clazzPtr, id, desc.slot);
+            }
+#ifdef HERMESVM_PROFILER_BB
+            runtime.recordPropertyCacheState(curCodeBlock, ip, state);
 #endif
-            // Cache the class and property slot.
-            cacheEntry->clazz = clazzPtr;
-            cacheEntry->slot = desc.slot;
           }
 
           // This must be valid because an own property was already found.
@@ -2576,6 +2851,31 @@ tailCall:
       CASE(GetByVal) {
         CallResult<HermesValue> propRes{ExecutionStatus::EXCEPTION};
         if (LLVM_LIKELY(O2REG(GetByVal).isObject())) {
+          // Fast path: an element of a dense array. Holes fall through, since
+          // they require a lookup along the prototype chain.
+          if (auto *arr = dyn_vmcast<JSArray>(O2REG(GetByVal))) {
+            if (LLVM_LIKELY(arr->hasFastIndexProperties())) {
+              if (auto idx = toArrayIndexFastPath(O3REG(GetByVal))) {
+                SmallHermesValue elem = arr->at(runtime, *idx);
+                if (LLVM_LIKELY(!elem.isEmpty())) {
+                  ++NumGetByValArrayFastPaths;
+                  O1REG(GetByVal) = elem.unboxToHV(runtime);
+                  ip = NEXTINST(GetByVal);
+                  DISPATCH;
+                }
+              }
+            }
+          } else if (auto *ta = dyn_vmcast<JSTypedArrayBase>(O2REG(GetByVal))) {
+            // Fast path: an in-bounds element of an attached typed array.
+            if (auto idx = toArrayIndexFastPath(O3REG(GetByVal))) {
+              if (auto elem = ta->getElementFast(runtime, *idx)) {
+                ++NumGetByValTypedArrayFastPaths;
+                O1REG(GetByVal) = *elem;
+                ip = NEXTINST(GetByVal);
+                DISPATCH;
+              }
+            }
+          }
           CAPTURE_IP(
               resPH = JSObject::getComputed_RJS(
                   Handle<JSObject>::vmcast(&O2REG(GetByVal)),
@@ -2603,6 +2903,40 @@ tailCall:
 
       CASE(PutByVal) {
         if (LLVM_LIKELY(O1REG(PutByVal).isObject())) {
+          // Fast path: overwriting an element of a dense array, or appending
+          // to it.
+          if (auto *arr = dyn_vmcast<JSArray>(O1REG(PutByVal))) {
+            if (LLVM_LIKELY(arr->hasFastIndexProperties())) {
+              if (auto idx = toArrayIndexFastPath(O2REG(PutByVal))) {
+                CAPTURE_IP_ASSIGN(
+                    bool stored,
+                    JSArray::tryPutIndexedFast(
+                        Handle<JSArray>::vmcast(&O1REG(PutByVal)),
+                        runtime,
+                        *idx,
+                        Handle<>(&O3REG(PutByVal))));
+                if (LLVM_LIKELY(stored)) {
+                  ++NumPutByValArrayFastPaths;
+                  ip = NEXTINST(PutByVal);
+                  DISPATCH;
+                }
+              }
+            }
+          } else if (auto *ta = dyn_vmcast<JSTypedArrayBase>(O1REG(PutByVal))) {
+            // Fast path: storing a number into an in-bounds element of an
+            // attached typed array. Other values need ToNumber, which may run
+            // arbitrary code.
+            if (LLVM_LIKELY(O3REG(PutByVal).isNumber())) {
+              if (auto idx = toArrayIndexFastPath(O2REG(PutByVal))) {
+                if (LLVM_LIKELY(ta->putElementFast(
+                        runtime, *idx, O3REG(PutByVal).getNumber()))) {
+                  ++NumPutByValTypedArrayFastPaths;
+                  ip = NEXTINST(PutByVal);
+                  DISPATCH;
+                }
+              }
+            }
+          }
           CAPTURE_IP_ASSIGN(
               auto putRes,
               JSObject::putComputed_RJS(
@@ -0,0 +1,1181 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define DEBUG_TYPE "jit"
+#include "JITHelpers.h"
+
+#ifdef HERMESVM_JIT
+
+#include "hermes/Support/Conversions.h"
+#include "hermes/VM/Callable.h"
+#include "hermes/VM/Casting.h"
+#include "hermes/VM/Interpreter.h"
+#include "hermes/VM/JSArray.h"
+#include "hermes/VM/JSTypedArray.h"
+#include "hermes/VM/Operations.h"
+#include "hermes/VM/Runtime-inline.h"
+#include "hermes/VM/RuntimeModule-inline.h"
+#include "hermes/VM/StackFrame-inline.h"
+#include "hermes/VM/StringPrimitive.h"
+
+#include "../Interpreter-internal.h"
+
+#include <cmath>
+
+using namespace hermes::inst;
+
+namespace hermes {
+namespace vm {
+
+/// Start a helper: save the IP for stack traces and exceptions, and release
+/// the handles created by the helper when it returns.
+#define JIT_HELPER_PROLOGUE()  \
+  runtime.setCurrentIP(ip);    \
+  GCScopeMarkerRAII marker {   \
+    runtime                    \
+  }
+
+#define JIT_INST_HELPER_DEF(name)     \
+  ExecutionStatus JITHelpers::name(   \
+      Runtime &runtime,               \
+      PinnedHermesValue *frameRegs,   \
+      const Inst *ip,                 \
+      CodeBlock *curCodeBlock)
+
+#define JIT_COND_HELPER_DEF(name)     \
+  int32_t JITHelpers::name(           \
+      Runtime &runtime,               \
+      PinnedHermesValue *lhs,         \
+      PinnedHermesValue *rhs,         \
+      const Inst *ip)
+
+/// \return the quotient of x divided by y. See doDiv() in the interpreter.
+static double doDiv(double x, double y)
+    LLVM_NO_SANITIZE("float-divide-by-zero");
+static inline double doDiv(double x, double y) {
+  return x / y;
+}
+
+/// Slow path of a binary arithmetic instruction, when an operand is not a
+/// number.
+#define JIT_BINOP(helper, name, oper)                                         \
+  JIT_INST_HELPER_DEF(helper) {                                               \
+    JIT_HELPER_PROLOGUE();                                                    \
+    auto res = toNumber_RJS(runtime, Handle<>(&O2REG(name)));                 \
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))                     \
+      return ExecutionStatus::EXCEPTION;                                      \
+    double left = res->getDouble();                                           \
+    res = toNumber_RJS(runtime, Handle<>(&O3REG(name)));                      \
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))                     \
+      return ExecutionStatus::EXCEPTION;                                      \
+    O1REG(name) =                                                             \
+        HermesValue::encodeDoubleValue(oper(left, res->getDouble()));         \
+    return ExecutionStatus::RETURNED;                                         \
+  }
+
+static inline double doSub(double x, double y) {
+  return x - y;
+}
+static inline double doMult(double x, double y) {
+  return x * y;
+}
+static inline double doMod(double x, double y) {
+  return std::fmod(x, y);
+}
+
+JIT_BINOP(sub, Sub, doSub)
+JIT_BINOP(mul, Mul, doMult)
+JIT_BINOP(div, Div, doDiv)
+JIT_BINOP(mod, Mod, doMod)
+
+JIT_INST_HELPER_DEF(add) {
+  JIT_HELPER_PROLOGUE();
+  auto res =
+      addOp_RJS(runtime, Handle<>(&O2REG(Add)), Handle<>(&O3REG(Add)));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(Add) = *res;
+  return ExecutionStatus::RETURNED;
+}
+
+/// A comparison instruction, which is only called when an operand is not a
+/// number.
+#define JIT_CONDOP(helper, name, operFuncName)                            \
+  JIT_INST_HELPER_DEF(helper) {                                           \
+    JIT_HELPER_PROLOGUE();                                                \
+    auto boolRes = operFuncName(                                          \
+        runtime, Handle<>(&O2REG(name)), Handle<>(&O3REG(name)));         \
+    if (LLVM_UNLIKELY(boolRes == ExecutionStatus::EXCEPTION))             \
+      return ExecutionStatus::EXCEPTION;                                  \
+    O1REG(name) = HermesValue::encodeBoolValue(*boolRes);                 \
+    return ExecutionStatus::RETURNED;                                     \
+  }
+
+JIT_CONDOP(less, Less, lessOp_RJS)
+JIT_CONDOP(lessEq, LessEq, lessEqualOp_RJS)
+JIT_CONDOP(greater, Greater, greaterOp_RJS)
+JIT_CONDOP(greaterEq, GreaterEq, greaterEqualOp_RJS)
+
+/// The condition of a conditional jump, which is only called when an operand
+/// is not a number.
+#define JIT_JCOND(helper, operFuncName)                                       \
+  JIT_COND_HELPER_DEF(helper) {                                               \
+    JIT_HELPER_PROLOGUE();                                                    \
+    auto boolRes = operFuncName(runtime, Handle<>(lhs), Handle<>(rhs));       \
+    if (LLVM_UNLIKELY(boolRes == ExecutionStatus::EXCEPTION))                 \
+      return -1;                                                              \
+    return *boolRes;                                                          \
+  }
+
+JIT_JCOND(condLess, lessOp_RJS)
+JIT_JCOND(condLessEq, lessEqualOp_RJS)
+JIT_JCOND(condGreater, greaterOp_RJS)
+JIT_JCOND(condGreaterEq, greaterEqualOp_RJS)
+JIT_JCOND(condEqual, abstractEqualityTest_RJS)
+
+JIT_COND_HELPER_DEF(condStrictEqual) {
+  return strictEqualityTest(*lhs, *rhs);
+}
+
+JIT_COND_HELPER_DEF(condToBoolean) {
+  return toBoolean(*lhs);
+}
+
+/// A binary bitwise instruction.
+#define JIT_BITWISEBINOP(helper, name, oper)                                 \
+  JIT_INST_HELPER_DEF(helper) {                                              \
+    if (LLVM_LIKELY(O2REG(name).isNumber() && O3REG(name).isNumber())) {     \
+      O1REG(name) = HermesValue::encodeDoubleValue(                          \
+          hermes::truncateToInt32(O2REG(name).getNumber())                   \
+              oper hermes::truncateToInt32(O3REG(name).getNumber()));        \
+      return ExecutionStatus::RETURNED;                                      \
+    }                                                                        \
+    JIT_HELPER_PROLOGUE();                                                   \
+    auto res = toInt32_RJS(runtime, Handle<>(&O2REG(name)));                 \
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))                    \
+      return ExecutionStatus::EXCEPTION;                                     \
+    int32_t left = res->getNumberAs<int32_t>();                              \
+    res = toInt32_RJS(runtime, Handle<>(&O3REG(name)));                      \
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))                    \
+      return ExecutionStatus::EXCEPTION;                                     \
+    O1REG(name) =                                                            \
+        HermesValue::encodeNumberValue(left oper res->getNumberAs<int32_t>()); \
+    return ExecutionStatus::RETURNED;                                        \
+  }
+
+JIT_BITWISEBINOP(bitAnd, BitAnd, &)
+JIT_BITWISEBINOP(bitOr, BitOr, |)
+JIT_BITWISEBINOP(bitXor, BitXor, ^)
+
+/// A shift instruction.
+#define JIT_SHIFTOP(helper, name, oper, lConv, lType, returnType)          \
+  JIT_INST_HELPER_DEF(helper) {                                            \
+    if (LLVM_LIKELY(O2REG(name).isNumber() && O3REG(name).isNumber())) {   \
+      auto lnum = static_cast<lType>(                                      \
+          hermes::truncateToInt32(O2REG(name).getNumber()));               \
+      auto rnum = static_cast<uint32_t>(                                   \
+                      hermes::truncateToInt32(O3REG(name).getNumber())) &  \
+          0x1f;                                                            \
+      O1REG(name) = HermesValue::encodeDoubleValue(                        \
+          static_cast<returnType>(lnum oper rnum));                        \
+      return ExecutionStatus::RETURNED;                                    \
+    }                                                                      \
+    JIT_HELPER_PROLOGUE();                                                 \
+    auto res = lConv(runtime, Handle<>(&O2REG(name)));                     \
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))                  \
+      return ExecutionStatus::EXCEPTION;                                   \
+    auto lnum = static_cast<lType>(res->getNumber());                      \
+    res = toUInt32_RJS(runtime, Handle<>(&O3REG(name)));                   \
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))                  \
+      return ExecutionStatus::EXCEPTION;                                   \
+    auto rnum = static_cast<uint32_t>(res->getNumber()) & 0x1f;            \
+    O1REG(name) = HermesValue::encodeDoubleValue(                          \
+        static_cast<returnType>(lnum oper rnum));                          \
+    return ExecutionStatus::RETURNED;                                      \
+  }
+
+JIT_SHIFTOP(lShift, LShift, <<, toUInt32_RJS, uint32_t, int32_t)
+JIT_SHIFTOP(rShift, RShift, >>, toInt32_RJS, int32_t, int32_t)
+JIT_SHIFTOP(urShift, URshift, >>, toUInt32_RJS, uint32_t, uint32_t)
+
+JIT_INST_HELPER_DEF(bitNot) {
+  JIT_HELPER_PROLOGUE();
+  auto res = toInt32_RJS(runtime, Handle<>(&O2REG(BitNot)));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(BitNot) =
+      HermesValue::encodeDoubleValue(~static_cast<int32_t>(res->getNumber()));
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(negate) {
+  JIT_HELPER_PROLOGUE();
+  auto res = toNumber_RJS(runtime, Handle<>(&O2REG(Negate)));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(Negate) = HermesValue::encodeDoubleValue(-res->getNumber());
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(eq) {
+  JIT_HELPER_PROLOGUE();
+  auto eqRes = abstractEqualityTest_RJS(
+      runtime, Handle<>(&O2REG(Eq)), Handle<>(&O3REG(Eq)));
+  if (LLVM_UNLIKELY(eqRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(Eq) = HermesValue::encodeBoolValue(*eqRes);
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(neq) {
+  JIT_HELPER_PROLOGUE();
+  auto eqRes = abstractEqualityTest_RJS(
+      runtime, Handle<>(&O2REG(Neq)), Handle<>(&O3REG(Neq)));
+  if (LLVM_UNLIKELY(eqRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(Neq) = HermesValue::encodeBoolValue(!*eqRes);
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(strictEq) {
+  O1REG(StrictEq) = HermesValue::encodeBoolValue(
+      strictEqualityTest(O2REG(StrictEq), O3REG(StrictEq)));
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(strictNeq) {
+  O1REG(StrictNeq) = HermesValue::encodeBoolValue(
+      !strictEqualityTest(O2REG(StrictNeq), O3REG(StrictNeq)));
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(notOp) {
+  O1REG(Not) = HermesValue::encodeBoolValue(!toBoolean(O2REG(Not)));
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(typeOf) {
+  JIT_HELPER_PROLOGUE();
+  O1REG(TypeOf) = vm::typeOf(runtime, Handle<>(&O2REG(TypeOf)));
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(toNumber) {
+  if (LLVM_LIKELY(O2REG(ToNumber).isNumber())) {
+    O1REG(ToNumber) = O2REG(ToNumber);
+    return ExecutionStatus::RETURNED;
+  }
+  JIT_HELPER_PROLOGUE();
+  auto res = toNumber_RJS(runtime, Handle<>(&O2REG(ToNumber)));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(ToNumber) = *res;
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(toInt32) {
+  JIT_HELPER_PROLOGUE();
+  auto res = toInt32_RJS(runtime, Handle<>(&O2REG(ToInt32)));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(ToInt32) = *res;
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(addEmptyString) {
+  if (LLVM_LIKELY(O2REG(AddEmptyString).isString())) {
+    O1REG(AddEmptyString) = O2REG(AddEmptyString);
+    return ExecutionStatus::RETURNED;
+  }
+  JIT_HELPER_PROLOGUE();
+  auto res = toPrimitive_RJS(
+      runtime, Handle<>(&O2REG(AddEmptyString)), PreferredType::NONE);
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto strRes = toString_RJS(runtime, runtime.makeHandle(*res));
+  if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(AddEmptyString) = strRes->getHermesValue();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(loadConstString) {
+  JIT_HELPER_PROLOGUE();
+  O1REG(LoadConstString) = HermesValue::encodeStringValue(
+      curCodeBlock->getRuntimeModule()->getStringPrimFromStringIDMayAllocate(
+          ip->opCode == OpCode::LoadConstString
+              ? ip->iLoadConstString.op2
+              : ip->iLoadConstStringLongIndex.op2));
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(loadParam) {
+  uint32_t index = ip->opCode == OpCode::LoadParam ? ip->iLoadParam.op2
+                                                   : ip->iLoadParamLong.op2;
+  // index 0 must load 'this'. Index 1 the first argument, etc.
+  O1REG(LoadParam) = LLVM_LIKELY(index <= FRAME.getArgCount())
+      ? FRAME.getArgRef((int32_t)index - 1)
+      : HermesValue::encodeUndefinedValue();
+  return ExecutionStatus::RETURNED;
+}
+
+/// Coerce \p value to an object as a non-strict 'this' and store it in
+/// \p result.
+static ExecutionStatus coerceThis(
+    Runtime &runtime,
+    PinnedHermesValue *result,
+    Handle<> value) {
+  if (LLVM_LIKELY(value->isObject())) {
+    *result = *value;
+  } else if (value->isNull() || value->isUndefined()) {
+    *result = runtime.getGlobal().getHermesValue();
+  } else {
+    auto res = toObject(runtime, value);
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    *result = *res;
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(loadThisNS) {
+  JIT_HELPER_PROLOGUE();
+  return coerceThis(
+      runtime, &O1REG(LoadThisNS), Handle<>(&FRAME.getThisArgRef()));
+}
+
+JIT_INST_HELPER_DEF(coerceThisNS) {
+  JIT_HELPER_PROLOGUE();
+  return coerceThis(
+      runtime, &O1REG(CoerceThisNS), Handle<>(&O2REG(CoerceThisNS)));
+}
+
+JIT_INST_HELPER_DEF(getGlobalObject) {
+  O1REG(GetGlobalObject) = runtime.getGlobal().getHermesValue();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(declareGlobalVar) {
+  JIT_HELPER_PROLOGUE();
+  DefinePropertyFlags dpf = DefinePropertyFlags::getDefaultNewPropertyFlags();
+  dpf.configurable = 0;
+  // Do not overwrite existing globals with undefined.
+  dpf.setValue = 0;
+  auto res = JSObject::defineOwnProperty(
+      runtime.getGlobal(),
+      runtime,
+      ID(ip->iDeclareGlobalVar.op1),
+      dpf,
+      Runtime::getUndefinedValue(),
+      PropOpFlags().plusThrowOnError());
+  if (res == ExecutionStatus::EXCEPTION) {
+    // As in the interpreter, an existing non-configurable property is not an
+    // error.
+    NamedPropertyDescriptor desc;
+    if (!JSObject::getOwnNamedDescriptor(
+            runtime.getGlobal(),
+            runtime,
+            ID(ip->iDeclareGlobalVar.op1),
+            desc))
+      return ExecutionStatus::EXCEPTION;
+    runtime.clearThrownValue();
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(getEnvironment) {
+  Environment *curEnv =
+      FRAME.getCalleeClosureUnsafe()->getEnvironment(runtime);
+  for (unsigned level = ip->iGetEnvironment.op2; level; --level) {
+    assert(curEnv && "invalid environment relative level");
+    curEnv = curEnv->getParentEnvironment(runtime);
+  }
+  O1REG(GetEnvironment) = HermesValue::encodeObjectValue(curEnv);
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(createEnvironment) {
+  JIT_HELPER_PROLOGUE();
+  auto parent = runtime.makeHandle(
+      FRAME.getCalleeClosureUnsafe()->getEnvironment(runtime));
+  auto res =
+      Environment::create(runtime, parent, curCodeBlock->getEnvironmentSize());
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(CreateEnvironment) = *res;
+#ifdef HERMES_ENABLE_DEBUGGER
+  FRAME.getDebugEnvironmentRef() = *res;
+#endif
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(loadFromEnvironment) {
+  if (ip->opCode == OpCode::LoadFromEnvironment) {
+    O1REG(LoadFromEnvironment) =
+        vmcast<Environment>(O2REG(LoadFromEnvironment))
+            ->slot(ip->iLoadFromEnvironment.op3);
+  } else {
+    O1REG(LoadFromEnvironmentL) =
+        vmcast<Environment>(O2REG(LoadFromEnvironmentL))
+            ->slot(ip->iLoadFromEnvironmentL.op3);
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(storeToEnvironment) {
+  if (ip->opCode == OpCode::StoreToEnvironment) {
+    vmcast<Environment>(O1REG(StoreToEnvironment))
+        ->slot(ip->iStoreToEnvironment.op2)
+        .set(O3REG(StoreToEnvironment), runtime.getHeap());
+  } else {
+    vmcast<Environment>(O1REG(StoreToEnvironmentL))
+        ->slot(ip->iStoreToEnvironmentL.op2)
+        .set(O3REG(StoreToEnvironmentL), runtime.getHeap());
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(storeNPToEnvironment) {
+  if (ip->opCode == OpCode::StoreNPToEnvironment) {
+    vmcast<Environment>(O1REG(StoreNPToEnvironment))
+        ->slot(ip->iStoreNPToEnvironment.op2)
+        .setNonPtr(O3REG(StoreNPToEnvironment), runtime.getHeap());
+  } else {
+    vmcast<Environment>(O1REG(StoreNPToEnvironmentL))
+        ->slot(ip->iStoreNPToEnvironmentL.op2)
+        .setNonPtr(O3REG(StoreNPToEnvironmentL), runtime.getHeap());
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(createClosure) {
+  JIT_HELPER_PROLOGUE();
+  auto *runtimeModule = curCodeBlock->getRuntimeModule();
+  uint32_t idVal = ip->opCode == OpCode::CreateClosure
+      ? ip->iCreateClosure.op3
+      : ip->iCreateClosureLongIndex.op3;
+  O1REG(CreateClosure) =
+      JSFunction::create(
+          runtime,
+          runtimeModule->getDomain(runtime),
+          Handle<JSObject>::vmcast(&runtime.functionPrototype),
+          Handle<Environment>::vmcast(&O2REG(CreateClosure)),
+          runtimeModule->getCodeBlockMayAllocate(idVal))
+          .getHermesValue();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(newObject) {
+  JIT_HELPER_PROLOGUE();
+  O1REG(NewObject) = JSObject::create(runtime).getHermesValue();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(newArray) {
+  JIT_HELPER_PROLOGUE();
+  auto createRes =
+      JSArray::create(runtime, ip->iNewArray.op2, ip->iNewArray.op2);
+  if (LLVM_UNLIKELY(createRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(NewArray) = createRes->getHermesValue();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(newObjectWithBuffer) {
+  JIT_HELPER_PROLOGUE();
+  auto resPH = ip->opCode == OpCode::NewObjectWithBuffer
+      ? Interpreter::createObjectFromBuffer(
+            runtime,
+            curCodeBlock,
+            ip->iNewObjectWithBuffer.op3,
+            ip->iNewObjectWithBuffer.op4,
+            ip->iNewObjectWithBuffer.op5)
+      : Interpreter::createObjectFromBuffer(
+            runtime,
+            curCodeBlock,
+            ip->iNewObjectWithBufferLong.op3,
+            ip->iNewObjectWithBufferLong.op4,
+            ip->iNewObjectWithBufferLong.op5);
+  if (LLVM_UNLIKELY(resPH == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(NewObjectWithBuffer) = resPH->get();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(newArrayWithBuffer) {
+  JIT_HELPER_PROLOGUE();
+  auto resPH = ip->opCode == OpCode::NewArrayWithBuffer
+      ? Interpreter::createArrayFromBuffer(
+            runtime,
+            curCodeBlock,
+            ip->iNewArrayWithBuffer.op2,
+            ip->iNewArrayWithBuffer.op3,
+            ip->iNewArrayWithBuffer.op4)
+      : Interpreter::createArrayFromBuffer(
+            runtime,
+            curCodeBlock,
+            ip->iNewArrayWithBufferLong.op2,
+            ip->iNewArrayWithBufferLong.op3,
+            ip->iNewArrayWithBufferLong.op4);
+  if (LLVM_UNLIKELY(resPH == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(NewArrayWithBuffer) = resPH->get();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(createThis) {
+  JIT_HELPER_PROLOGUE();
+  // Registers: output, prototype, closure.
+  if (LLVM_UNLIKELY(!vmisa<Callable>(O3REG(CreateThis))))
+    return runtime.raiseTypeError("constructor is not callable");
+  auto res = Callable::newObject(
+      Handle<Callable>::vmcast(&O3REG(CreateThis)),
+      runtime,
+      Handle<JSObject>::vmcast(
+          O2REG(CreateThis).isObject() ? &O2REG(CreateThis)
+                                       : &runtime.objectPrototype));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(CreateThis) = res->getHermesValue();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(selectObject) {
+  // Registers: output, thisObject, constructorReturnValue.
+  O1REG(SelectObject) = O3REG(SelectObject).isObject() ? O3REG(SelectObject)
+                                                       : O2REG(SelectObject);
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(getById) {
+  // All variants have the same layout, except for the width of the
+  // identifier.
+  uint32_t idVal;
+  bool tryProp = false;
+  switch (ip->opCode) {
+    case OpCode::GetByIdShort:
+    case OpCode::GetByIdShortThenGetByIdShort:
+    case OpCode::GetByIdShortThenCall1:
+    case OpCode::GetByIdShortThenCall2:
+    case OpCode::GetByIdShortThenCall3:
+      idVal = ip->iGetByIdShort.op4;
+      break;
+    case OpCode::GetById:
+      idVal = ip->iGetById.op4;
+      break;
+    case OpCode::GetByIdLong:
+      idVal = ip->iGetByIdLong.op4;
+      break;
+    case OpCode::TryGetById:
+    case OpCode::TryGetByIdThenGetByIdShort:
+      idVal = ip->iTryGetById.op4;
+      tryProp = true;
+      break;
+    case OpCode::TryGetByIdLong:
+      idVal = ip->iTryGetByIdLong.op4;
+      tryProp = true;
+      break;
+    default:
+      llvm_unreachable("not a GetById instruction");
+  }
+
+  if (LLVM_LIKELY(O2REG(GetById).isObject())) {
+    auto *obj = vmcast<JSObject>(O2REG(GetById));
+    auto cacheIdx = ip->iGetById.op3;
+    auto *cacheEntry = curCodeBlock->getReadCacheEntry(cacheIdx);
+    CompressedPointer clazzPtr{obj->getClassGCPtr()};
+
+    // The monomorphic case first, then the secondary entries of a polymorphic
+    // site and the shared cache if it is megamorphic.
+    const PropertyCacheEntry *hit =
+        cacheEntry->clazz == clazzPtr ? cacheEntry : nullptr;
+    if (!hit) {
+      if (auto *polyEntry = curCodeBlock->getPolyCacheEntry(cacheEntry)) {
+        hit = polyEntry->find(clazzPtr);
+        if (!hit && polyEntry->megamorphic)
+          hit = runtime.megamorphicReadCache_.find(clazzPtr, ID(idVal));
+      }
+    }
+    if (LLVM_LIKELY(hit != nullptr)) {
+      O1REG(GetById) =
+          JSObject::getNamedSlotValueUnsafe<PropStorage::Inline::Yes>(
+              obj, runtime, hit->slot)
+              .unboxToHV(runtime);
+      return ExecutionStatus::RETURNED;
+    }
+
+    JIT_HELPER_PROLOGUE();
+    auto id = ID(idVal);
+    NamedPropertyDescriptor desc;
+    OptValue<bool> fastPathResult =
+        JSObject::tryGetOwnNamedDescriptorFast(obj, runtime, id, desc);
+    if (LLVM_LIKELY(fastPathResult.hasValue() && fastPathResult.getValue()) &&
+        !desc.flags.accessor) {
+      HiddenClass *clazz = vmcast<HiddenClass>(clazzPtr.getNonNull(runtime));
+      if (LLVM_LIKELY(!clazz->isDictionaryNoCache()) &&
+          LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
+        if (curCodeBlock->addPropertyCacheEntry(
+                cacheEntry, clazzPtr, desc.slot) ==
+            PropertyCacheState::Megamorphic) {
+          runtime.megamorphicReadCache_.insert(clazzPtr, id, desc.slot);
+        }
+      }
+      O1REG(GetById) = JSObject::getNamedSlotValueUnsafe(obj, runtime, desc)
+                           .unboxToHV(runtime);
+      return ExecutionStatus::RETURNED;
+    }
+
+    auto resPH = JSObject::getNamed_RJS(
+        Handle<JSObject>::vmcast(&O2REG(GetById)),
+        runtime,
+        id,
+        !tryProp ? DEFAULT_PROP_OP_FLAGS(curCodeBlock->isStrictMode())
+                 : DEFAULT_PROP_OP_FLAGS(curCodeBlock->isStrictMode())
+                       .plusMustExist(),
+        cacheIdx != hbc::PROPERTY_CACHING_DISABLED ? cacheEntry : nullptr);
+    if (LLVM_UNLIKELY(resPH == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    O1REG(GetById) = resPH->get();
+    return ExecutionStatus::RETURNED;
+  }
+
+  JIT_HELPER_PROLOGUE();
+  assert(!tryProp && "TryGetById can only be used on the global object");
+  auto resPH = Interpreter::getByIdTransient_RJS(
+      runtime, Handle<>(&O2REG(GetById)), ID(idVal));
+  if (LLVM_UNLIKELY(resPH == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(GetById) = resPH->get();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(putById) {
+  uint32_t idVal;
+  bool tryProp = false;
+  switch (ip->opCode) {
+    case OpCode::PutById:
+      idVal = ip->iPutById.op4;
+      break;
+    case OpCode::PutByIdLong:
+      idVal = ip->iPutByIdLong.op4;
+      break;
+    case OpCode::TryPutById:
+      idVal = ip->iTryPutById.op4;
+      tryProp = true;
+      break;
+    case OpCode::TryPutByIdLong:
+      idVal = ip->iTryPutByIdLong.op4;
+      tryProp = true;
+      break;
+    default:
+      llvm_unreachable("not a PutById instruction");
+  }
+
+  JIT_HELPER_PROLOGUE();
+  bool strictMode = curCodeBlock->isStrictMode();
+  if (LLVM_LIKELY(O1REG(PutById).isObject())) {
+    SmallHermesValue shv =
+        SmallHermesValue::encodeHermesValue(O2REG(PutById), runtime);
+    auto *obj = vmcast<JSObject>(O1REG(PutById));
+    auto cacheIdx = ip->iPutById.op3;
+    auto *cacheEntry = curCodeBlock->getWriteCacheEntry(cacheIdx);
+    CompressedPointer clazzPtr{obj->getClassGCPtr()};
+
+    const PropertyCacheEntry *hit =
+        cacheEntry->clazz == clazzPtr ? cacheEntry : nullptr;
+    if (!hit) {
+      if (auto *polyEntry = curCodeBlock->getPolyCacheEntry(cacheEntry)) {
+        hit = polyEntry->find(clazzPtr);
+        if (!hit && polyEntry->megamorphic)
+          hit = runtime.megamorphicWriteCache_.find(clazzPtr, ID(idVal));
+      }
+    }
+    if (LLVM_LIKELY(hit != nullptr)) {
+      JSObject::setNamedSlotValueUnsafe<PropStorage::Inline::Yes>(
+          obj, runtime, hit->slot, shv);
+      return ExecutionStatus::RETURNED;
+    }
+
+    auto id = ID(idVal);
+    NamedPropertyDescriptor desc;
+    OptValue<bool> hasOwnProp =
+        JSObject::tryGetOwnNamedDescriptorFast(obj, runtime, id, desc);
+    if (LLVM_LIKELY(hasOwnProp.hasValue() && hasOwnProp.getValue()) &&
+        !desc.flags.accessor && desc.flags.writable &&
+        !desc.flags.internalSetter) {
+      HiddenClass *clazz = vmcast<HiddenClass>(clazzPtr.getNonNull(runtime));
+      if (LLVM_LIKELY(!clazz->isDictionary()) &&
+          LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
+        if (curCodeBlock->addPropertyCacheEntry(
+                cacheEntry, clazzPtr, desc.slot) ==
+            PropertyCacheState::Megamorphic) {
+          runtime.megamorphicWriteCache_.insert(clazzPtr, id, desc.slot);
+        }
+      }
+      JSObject::setNamedSlotValueUnsafe(obj, runtime, desc.slot, shv);
+      return ExecutionStatus::RETURNED;
+    }
+
+    auto putRes = JSObject::putNamed_RJS(
+        Handle<JSObject>::vmcast(&O1REG(PutById)),
+        runtime,
+        id,
+        Handle<>(&O2REG(PutById)),
+        !tryProp ? DEFAULT_PROP_OP_FLAGS(strictMode)
+                 : DEFAULT_PROP_OP_FLAGS(strictMode).plusMustExist());
+    if (LLVM_UNLIKELY(putRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    return ExecutionStatus::RETURNED;
+  }
+
+  assert(!tryProp && "TryPutById can only be used on the global object");
+  return Interpreter::putByIdTransient_RJS(
+      runtime,
+      Handle<>(&O1REG(PutById)),
+      ID(idVal),
+      Handle<>(&O2REG(PutById)),
+      strictMode);
+}
+
+JIT_INST_HELPER_DEF(putNewOwnById) {
+  uint32_t idVal;
+  switch (ip->opCode) {
+    case OpCode::PutNewOwnByIdShort:
+      idVal = ip->iPutNewOwnByIdShort.op3;
+      break;
+    case OpCode::PutNewOwnById:
+    case OpCode::PutNewOwnNEById:
+      idVal = ip->iPutNewOwnById.op3;
+      break;
+    case OpCode::PutNewOwnByIdLong:
+    case OpCode::PutNewOwnNEByIdLong:
+      idVal = ip->iPutNewOwnByIdLong.op3;
+      break;
+    default:
+      llvm_unreachable("not a PutNewOwnById instruction");
+  }
+  JIT_HELPER_PROLOGUE();
+  assert(
+      O1REG(PutNewOwnById).isObject() &&
+      "Object argument of PutNewOwnById must be an object");
+  return JSObject::defineNewOwnProperty(
+      Handle<JSObject>::vmcast(&O1REG(PutNewOwnById)),
+      runtime,
+      ID(idVal),
+      ip->opCode <= OpCode::PutNewOwnByIdLong
+          ? PropertyFlags::defaultNewNamedPropertyFlags()
+          : PropertyFlags::nonEnumerablePropertyFlags(),
+      Handle<>(&O2REG(PutNewOwnById)));
+}
+
+JIT_INST_HELPER_DEF(getByVal) {
+  if (LLVM_LIKELY(O2REG(GetByVal).isObject())) {
+    if (auto *arr = dyn_vmcast<JSArray>(O2REG(GetByVal))) {
+      if (LLVM_LIKELY(arr->hasFastIndexProperties())) {
+        if (auto idx = toArrayIndexFastPath(O3REG(GetByVal))) {
+          SmallHermesValue elem = arr->at(runtime, *idx);
+          if (LLVM_LIKELY(!elem.isEmpty())) {
+            O1REG(GetByVal) = elem.unboxToHV(runtime);
+            return ExecutionStatus::RETURNED;
+          }
+        }
+      }
+    } else if (auto *ta = dyn_vmcast<JSTypedArrayBase>(O2REG(GetByVal))) {
+      if (auto idx = toArrayIndexFastPath(O3REG(GetByVal))) {
+        if (auto elem = ta->getElementFast(runtime, *idx)) {
+          O1REG(GetByVal) = *elem;
+          return ExecutionStatus::RETURNED;
+        }
+      }
+    }
+  }
+
+  JIT_HELPER_PROLOGUE();
+  CallResult<PseudoHandle<>> resPH = O2REG(GetByVal).isObject()
+      ? JSObject::getComputed_RJS(
+            Handle<JSObject>::vmcast(&O2REG(GetByVal)),
+            runtime,
+            Handle<>(&O3REG(GetByVal)))
+      : Interpreter::getByValTransient_RJS(
+            runtime, Handle<>(&O2REG(GetByVal)), Handle<>(&O3REG(GetByVal)));
+  if (LLVM_UNLIKELY(resPH == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  O1REG(GetByVal) = resPH->get();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(putByVal) {
+  JIT_HELPER_PROLOGUE();
+  if (LLVM_LIKELY(O1REG(PutByVal).isObject())) {
+    if (auto *arr = dyn_vmcast<JSArray>(O1REG(PutByVal))) {
+      if (LLVM_LIKELY(arr->hasFastIndexProperties())) {
+        if (auto idx = toArrayIndexFastPath(O2REG(PutByVal))) {
+          if (LLVM_LIKELY(JSArray::tryPutIndexedFast(
+                  Handle<JSArray>::vmcast(&O1REG(PutByVal)),
+                  runtime,
+                  *idx,
+                  Handle<>(&O3REG(PutByVal)))))
+            return ExecutionStatus::RETURNED;
+        }
+      }
+    } else if (auto *ta = dyn_vmcast<JSTypedArrayBase>(O1REG(PutByVal))) {
+      if (LLVM_LIKELY(O3REG(PutByVal).isNumber())) {
+        if (auto idx = toArrayIndexFastPath(O2REG(PutByVal))) {
+          if (LLVM_LIKELY(ta->putElementFast(
+                  runtime, *idx, O3REG(PutByVal).getNumber())))
+            return ExecutionStatus::RETURNED;
+        }
+      }
+    }
+    auto putRes = JSObject::putComputed_RJS(
+        Handle<JSObject>::vmcast(&O1REG(PutByVal)),
+        runtime,
+        Handle<>(&O2REG(PutByVal)),
+        Handle<>(&O3REG(PutByVal)),
+        DEFAULT_PROP_OP_FLAGS(curCodeBlock->isStrictMode()));
+    if (LLVM_UNLIKELY(putRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    return ExecutionStatus::RETURNED;
+  }
+  return Interpreter::putByValTransient_RJS(
+      runtime,
+      Handle<>(&O1REG(PutByVal)),
+      Handle<>(&O2REG(PutByVal)),
+      Handle<>(&O3REG(PutByVal)),
+      curCodeBlock->isStrictMode());
+}
+
+/// Call the function in the frame that has been set up at the top of the
+/// stack, and store the result in \p result.
+/// The frame has no saved CodeBlock, like frames set up by native code, so
+/// that the callee returns here instead of continuing in the caller.
+static ExecutionStatus callFrame(
+    Runtime &runtime,
+    PinnedHermesValue *callee,
+    PinnedHermesValue *result) {
+  if (auto *func = dyn_vmcast<JSFunction>(*callee)) {
+    auto res = runtime.interpretFunction(func->getCodeBlock());
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    *result = *res;
+    return ExecutionStatus::RETURNED;
+  }
+  if (auto *calleeBlock = callee->isNativeValue()
+          ? callee->getNativePointer<CodeBlock>()
+          : nullptr) {
+    auto res = runtime.interpretFunction(calleeBlock);
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    *result = *res;
+    return ExecutionStatus::RETURNED;
+  }
+  auto resPH = Interpreter::handleCallSlowPath(runtime, callee);
+  if (LLVM_UNLIKELY(resPH == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  *result = resPH->get();
+  return ExecutionStatus::RETURNED;
+}
+
+JIT_INST_HELPER_DEF(call) {
+  JIT_HELPER_PROLOGUE();
+  // Note in Call1 through Call4, the first argument is 'this' which has
+  // argument index -1.
+  StackFramePtr fr{runtime.getStackPointer()};
+  uint32_t argCount;
+  bool construct = false;
+  switch (ip->opCode) {
+    case OpCode::Call:
+      argCount = ip->iCall.op3;
+      break;
+    case OpCode::CallLong:
+      argCount = ip->iCallLong.op3;
+      break;
+    case OpCode::Construct:
+      argCount = ip->iConstruct.op3;
+      construct = true;
+      break;
+    case OpCode::ConstructLong:
+      argCount = ip->iConstructLong.op3;
+      construct = true;
+      break;
+    case OpCode::Call1:
+      argCount = 1;
+      fr.getArgRefUnsafe(-1) = O3REG(Call1);
+      break;
+    case OpCode::Call2:
+      argCount = 2;
+      fr.getArgRefUnsafe(-1) = O3REG(Call2);
+      fr.getArgRefUnsafe(0) = O4REG(Call2);
+      break;
+    case OpCode::Call3:
+      argCount = 3;
+      fr.getArgRefUnsafe(-1) = O3REG(Call3);
+      fr.getArgRefUnsafe(0) = O4REG(Call3);
+      fr.getArgRefUnsafe(1) = O5REG(Call3);
+      break;
+    case OpCode::Call4:
+      argCount = 4;
+      fr.getArgRefUnsafe(-1) = O3REG(Call4);
+      fr.getArgRefUnsafe(0) = O4REG(Call4);
+      fr.getArgRefUnsafe(1) = O5REG(Call4);
+      fr.getArgRefUnsafe(2) = O6REG(Call4);
+      break;
+    default:
+      llvm_unreachable("not a call instruction");
+  }
+
+  // Subtract 1 from argCount as 'this' is considered an argument in the
+  // instruction, but not in the frame.
+  StackFramePtr::initFrame(
+      runtime.getStackPointer(),
+      FRAME,
+      ip,
+      nullptr,
+      argCount - 1,
+      O2REG(Call),
+      // The callee is its own new.target.
+      construct ? O2REG(Call) : HermesValue::encodeUndefinedValue());
+  return callFrame(runtime, &O2REG(Call), &O1REG(Call));
+}
+
+JIT_INST_HELPER_DEF(callDirect) {
+  JIT_HELPER_PROLOGUE();
+  CodeBlock *calleeBlock = ip->opCode == OpCode::CallDirect
+      ? curCodeBlock->getRuntimeModule()->getCodeBlockMayAllocate(
+            ip->iCallDirect.op3)
+      : curCodeBlock->getRuntimeModule()->getCodeBlockMayAllocate(
+            ip->iCallDirectLongIndex.op3);
+  auto newFrame = StackFramePtr::initFrame(
+      runtime.getStackPointer(),
+      FRAME,
+      ip,
+      nullptr,
+      (uint32_t)ip->iCallDirect.op2 - 1,
+      HermesValue::encodeNativePointer(calleeBlock),
+      HermesValue::encodeUndefinedValue());
+  return callFrame(
+      runtime, &newFrame.getCalleeClosureOrCBRef(), &O1REG(CallDirect));
+}
+
+JIT_INST_HELPER_DEF(throwOp) {
+  runtime.setCurrentIP(ip);
+  return runtime.setThrownValue(O1REG(Throw));
+}
+
+JIT_INST_HELPER_DEF(asyncBreakCheck) {
+  JIT_HELPER_PROLOGUE();
+  // A debugger request is left pending, to be served by the next
+  // AsyncBreakCheck executed by the interpreter.
+  if (runtime.testAndClearTimeoutAsyncBreakRequest())
+    return runtime.notifyTimeout();
+  return ExecutionStatus::RETURNED;
+}
+
+/// Adapt the interpreter's out-of-line implementation of an instruction to the
+/// helper signature.
+#define JIT_OUTOFLINE(helper, name)                         \
+  JIT_INST_HELPER_DEF(helper) {                             \
+    JIT_HELPER_PROLOGUE();                                  \
+    return Interpreter::case##name(runtime, frameRegs, ip); \
+  }
+
+JIT_OUTOFLINE(getPNameList, GetPNameList)
+JIT_OUTOFLINE(iteratorBegin, IteratorBegin)
+JIT_OUTOFLINE(iteratorNext, IteratorNext)
+JIT_OUTOFLINE(putOwnByVal, PutOwnByVal)
+
+JITHelpers::InstHelper JITHelpers::getInstHelper(OpCode opCode) {
+  switch (opCode) {
+    case OpCode::Add:
+      return add;
+    case OpCode::Sub:
+      return sub;
+    case OpCode::Mul:
+      return mul;
+    case OpCode::Div:
+      return div;
+    case OpCode::Less:
+      return less;
+    case OpCode::LessEq:
+      return lessEq;
+    case OpCode::Greater:
+      return greater;
+    case OpCode::GreaterEq:
+      return greaterEq;
+    case OpCode::Negate:
+      return negate;
+    case OpCode::Mod:
+      return mod;
+    case OpCode::BitAnd:
+      return bitAnd;
+    case OpCode::BitOr:
+      return bitOr;
+    case OpCode::BitXor:
+      return bitXor;
+    case OpCode::BitNot:
+      return bitNot;
+    case OpCode::LShift:
+      return lShift;
+    case OpCode::RShift:
+      return rShift;
+    case OpCode::URshift:
+      return urShift;
+    case OpCode::Eq:
+      return eq;
+    case OpCode::Neq:
+      return neq;
+    case OpCode::StrictEq:
+      return strictEq;
+    case OpCode::StrictNeq:
+      return strictNeq;
+    case OpCode::Not:
+      return notOp;
+    case OpCode::TypeOf:
+      return typeOf;
+    case OpCode::ToNumber:
+      return toNumber;
+    case OpCode::ToInt32:
+      return toInt32;
+    case OpCode::AddEmptyString:
+      return addEmptyString;
+    case OpCode::LoadConstString:
+    case OpCode::LoadConstStringLongIndex:
+      return loadConstString;
+    case OpCode::LoadParam:
+    case OpCode::LoadParamLong:
+      return loadParam;
+    case OpCode::LoadThisNS:
+      return loadThisNS;
+    case OpCode::CoerceThisNS:
+      return coerceThisNS;
+    case OpCode::GetGlobalObject:
+      return getGlobalObject;
+    case OpCode::DeclareGlobalVar:
+      return declareGlobalVar;
+    case OpCode::GetEnvironment:
+      return getEnvironment;
+    case OpCode::CreateEnvironment:
+      return createEnvironment;
+    case OpCode::LoadFromEnvironment:
+    case OpCode::LoadFromEnvironmentL:
+      return loadFromEnvironment;
+    case OpCode::StoreToEnvironment:
+    case OpCode::StoreToEnvironmentL:
+      return storeToEnvironment;
+    case OpCode::StoreNPToEnvironment:
+    case OpCode::StoreNPToEnvironmentL:
+      return storeNPToEnvironment;
+    case OpCode::CreateClosure:
+    case OpCode::CreateClosureLongIndex:
+      return createClosure;
+    case OpCode::NewObject:
+      return newObject;
+    case OpCode::NewArray:
+      return newArray;
+    case OpCode::NewObjectWithBuffer:
+    case OpCode::NewObjectWithBufferLong:
+      return newObjectWithBuffer;
+    case OpCode::NewArrayWithBuffer:
+    case OpCode::NewArrayWithBufferLong:
+      return newArrayWithBuffer;
+    case OpCode::CreateThis:
+      return createThis;
+    case OpCode::SelectObject:
+      return selectObject;
+    case OpCode::GetByIdShort:
+    case OpCode::GetById:
+    case OpCode::GetByIdLong:
+    case OpCode::TryGetById:
+    case OpCode::TryGetByIdLong:
+    // The second instruction of a superinstruction is compiled separately.
+    case OpCode::TryGetByIdThenGetByIdShort:
+    case OpCode::GetByIdShortThenGetByIdShort:
+    case OpCode::GetByIdShortThenCall1:
+    case OpCode::GetByIdShortThenCall2:
+    case OpCode::GetByIdShortThenCall3:
+      return getById;
+    case OpCode::PutById:
+    case OpCode::PutByIdLong:
+    case OpCode::TryPutById:
+    case OpCode::TryPutByIdLong:
+      return putById;
+    case OpCode::PutNewOwnByIdShort:
+    case OpCode::PutNewOwnById:
+    case OpCode::PutNewOwnByIdLong:
+    case OpCode::PutNewOwnNEById:
+    case OpCode::PutNewOwnNEByIdLong:
+      return putNewOwnById;
+    case OpCode::GetByVal:
+      return getByVal;
+    case OpCode::PutByVal:
+      return putByVal;
+    case OpCode::PutOwnByVal:
+      return putOwnByVal;
+    case OpCode::Call:
+    case OpCode::CallLong:
+    case OpCode::Call1:
+    case OpCode::Call2:
+    case OpCode::Call3:
+    case OpCode::Call4:
+    case OpCode::Construct:
+    case OpCode::ConstructLong:
+      return call;
+    case OpCode::CallDirect:
+    case OpCode::CallDirectLongIndex:
+      return callDirect;
+    case OpCode::GetPNameList:
+      return getPNameList;
+    case OpCode::IteratorBegin:
+      return iteratorBegin;
+    case OpCode::IteratorNext:
+      return iteratorNext;
+    case OpCode::Throw:
+      return throwOp;
+    case OpCode::AsyncBreakCheck:
+      return asyncBreakCheck;
+    default:
+      return nullptr;
+  }
+}
+
+JITHelpers::CondHelper JITHelpers::getCondHelper(OpCode opCode) {
+  switch (opCode) {
+    case OpCode::JmpTrue:
+    case OpCode::JmpTrueLong:
+    case OpCode::JmpFalse:
+    case OpCode::JmpFalseLong:
+      return condToBoolean;
+#define JIT_JCOND_HELPER(name, helper) \
+  case OpCode::J##name:                \
+  case OpCode::J##name##Long:          \
+  case OpCode::JNot##name:             \
+  case OpCode::JNot##name##Long:       \
+    return helper;
+      JIT_JCOND_HELPER(Less, condLess)
+      JIT_JCOND_HELPER(LessEqual, condLessEq)
+      JIT_JCOND_HELPER(Greater, condGreater)
+      JIT_JCOND_HELPER(GreaterEqual, condGreaterEq)
+#undef JIT_JCOND_HELPER
+    case OpCode::JEqual:
+    case OpCode::JEqualLong:
+    case OpCode::JNotEqual:
+    case OpCode::JNotEqualLong:
+      return condEqual;
+    case OpCode::JStrictEqual:
+    case OpCode::JStrictEqualLong:
+    case OpCode::JStrictNotEqual:
+    case OpCode::JStrictNotEqualLong:
+      return condStrictEqual;
+    default:
+      return nullptr;
+  }
+}
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMESVM_JIT
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_JIT_JITHELPERS_H
+#define HERMES_VM_JIT_JITHELPERS_H
+
+#include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/JIT/Config.h"
+
+#ifdef HERMESVM_JIT
+
+namespace hermes {
+namespace vm {
+
+/// Out-of-line implementations of instructions, called by JIT-compiled code.
+/// They have the signature of the interpreter's out-of-line instructions, plus
+/// the CodeBlock of the running function, and read and write the frame
+/// registers like the interpreter does. Each of them saves \p ip as the
+/// current IP first, so that stack traces and exceptions point to the right
+/// instruction.
+///
+/// Helpers implementing conditional jumps return 1 if the jump is taken, 0 if
+/// it is not and -1 if an exception was thrown. All others return an
+/// ExecutionStatus.
+class JITHelpers {
+ public:
+  /// Signature of helpers implementing an instruction.
+  using InstHelper = ExecutionStatus (*)(
+      Runtime &runtime,
+      PinnedHermesValue *frameRegs,
+      const inst::Inst *ip,
+      CodeBlock *curCodeBlock);
+
+  /// Signature of helpers implementing the condition of a jump, whose
+  /// operands are \p lhs and \p rhs. The location of the operands in the
+  /// instruction depends on the width of the jump offset, so it is decoded by
+  /// the caller.
+  using CondHelper = int32_t (*)(
+      Runtime &runtime,
+      PinnedHermesValue *lhs,
+      PinnedHermesValue *rhs,
+      const inst::Inst *ip);
+
+  /// \return the helper implementing \p opCode, or nullptr if there isn't
+  /// one.
+  static InstHelper getInstHelper(inst::OpCode opCode);
+
+  /// \return the helper implementing the conditional jump \p opCode, or
+  /// nullptr if there isn't one. The result is the condition of the jump
+  /// before any negation by the JNot variants.
+  static CondHelper getCondHelper(inst::OpCode opCode);
+
+ private:
+#define JIT_INST_HELPER(name)        \
+  static ExecutionStatus name(       \
+      Runtime &runtime,              \
+      PinnedHermesValue *frameRegs,  \
+      const inst::Inst *ip,          \
+      CodeBlock *curCodeBlock);
+#define JIT_COND_HELPER(name)        \
+  static int32_t name(               \
+      Runtime &runtime,              \
+      PinnedHermesValue *lhs,        \
+      PinnedHermesValue *rhs,        \
+      const inst::Inst *ip);
+
+  // Slow paths of the instructions which are inlined for numbers.
+  JIT_INST_HELPER(add)
+  JIT_INST_HELPER(sub)
+  JIT_INST_HELPER(mul)
+  JIT_INST_HELPER(div)
+  JIT_INST_HELPER(less)
+  JIT_INST_HELPER(lessEq)
+  JIT_INST_HELPER(greater)
+  JIT_INST_HELPER(greaterEq)
+  JIT_INST_HELPER(negate)
+  JIT_COND_HELPER(condLess)
+  JIT_COND_HELPER(condLessEq)
+  JIT_COND_HELPER(condGreater)
+  JIT_COND_HELPER(condGreaterEq)
+  JIT_COND_HELPER(condToBoolean)
+
+  JIT_INST_HELPER(mod)
+  JIT_INST_HELPER(bitAnd)
+  JIT_INST_HELPER(bitOr)
+  JIT_INST_HELPER(bitXor)
+  JIT_INST_HELPER(bitNot)
+  JIT_INST_HELPER(lShift)
+  JIT_INST_HELPER(rShift)
+  JIT_INST_HELPER(urShift)
+  JIT_INST_HELPER(eq)
+  JIT_INST_HELPER(neq)
+  JIT_INST_HELPER(strictEq)
+  JIT_INST_HELPER(strictNeq)
+  JIT_INST_HELPER(notOp)
+  JIT_INST_HELPER(typeOf)
+  JIT_INST_HELPER(toNumber)
+  JIT_INST_HELPER(toInt32)
+  JIT_INST_HELPER(addEmptyString)
+  JIT_COND_HELPER(condEqual)
+  JIT_COND_HELPER(condStrictEqual)
+
+  JIT_INST_HELPER(loadConstString)
+  JIT_INST_HELPER(loadParam)
+  JIT_INST_HELPER(loadThisNS)
+  JIT_INST_HELPER(coerceThisNS)
+  JIT_INST_HELPER(getGlobalObject)
+  JIT_INST_HELPER(declareGlobalVar)
+  JIT_INST_HELPER(getEnvironment)
+  JIT_INST_HELPER(createEnvironment)
+  JIT_INST_HELPER(loadFromEnvironment)
+  JIT_INST_HELPER(storeToEnvironment)
+  JIT_INST_HELPER(storeNPToEnvironment)
+  JIT_INST_HELPER(createClosure)
+  JIT_INST_HELPER(newObject)
+  JIT_INST_HELPER(newArray)
+  JIT_INST_HELPER(newObjectWithBuffer)
+  JIT_INST_HELPER(newArrayWithBuffer)
+  JIT_INST_HELPER(createThis)
+  JIT_INST_HELPER(selectObject)
+
+  JIT_INST_HELPER(getById)
+  JIT_INST_HELPER(putById)
+  JIT_INST_HELPER(putNewOwnById)
+  JIT_INST_HELPER(getByVal)
+  JIT_INST_HELPER(putByVal)
+  JIT_INST_HELPER(putOwnByVal)
+  JIT_INST_HELPER(getPNameList)
+  JIT_INST_HELPER(iteratorBegin)
+  JIT_INST_HELPER(iteratorNext)
+
+  JIT_INST_HELPER(call)
+  JIT_INST_HELPER(callDirect)
+  JIT_INST_HELPER(throwOp)
+  JIT_INST_HELPER(asyncBreakCheck)
+
+#undef JIT_INST_HELPER
+#undef JIT_COND_HELPER
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMESVM_JIT
+
+#endif // HERMES_VM_JIT_JITHELPERS_H
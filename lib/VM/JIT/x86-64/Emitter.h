@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_JIT_X86_64_EMITTER_H
+#define HERMES_VM_JIT_X86_64_EMITTER_H
+
+#include "llvh/Support/MathExtras.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace hermes {
+namespace vm {
+namespace x86_64 {
+
+/// General purpose registers, numbered as in their encoding.
+enum class Reg : uint8_t {
+  rax,
+  rcx,
+  rdx,
+  rbx,
+  rsp,
+  rbp,
+  rsi,
+  rdi,
+  r8,
+  r9,
+  r10,
+  r11,
+  r12,
+  r13,
+  r14,
+  r15,
+};
+
+/// SSE registers, numbered as in their encoding.
+enum class XmmReg : uint8_t {
+  xmm0,
+  xmm1,
+  xmm2,
+  xmm3,
+};
+
+/// Condition codes of Jcc, numbered as in their encoding.
+enum class Cond : uint8_t {
+  O = 0x0,
+  NO = 0x1,
+  B = 0x2,
+  AE = 0x3,
+  E = 0x4,
+  NE = 0x5,
+  BE = 0x6,
+  A = 0x7,
+  S = 0x8,
+  NS = 0x9,
+  P = 0xA,
+  NP = 0xB,
+  L = 0xC,
+  GE = 0xD,
+  LE = 0xE,
+  G = 0xF,
+};
+
+/// A minimal x86-64 assembler, supporting only the instructions needed by the
+/// baseline JIT. Memory operands are always [base + disp32]. Branches always
+/// use 32-bit displacements, which are resolved by finish().
+class Emitter {
+ public:
+  /// A branch target. It may be used before it is bound.
+  using Label = uint32_t;
+
+  Label newLabel() {
+    labels_.push_back(kUnbound);
+    return labels_.size() - 1;
+  }
+
+  /// Bind \p label to the current position.
+  void bind(Label label) {
+    assert(labels_[label] == kUnbound && "label bound twice");
+    labels_[label] = code_.size();
+  }
+
+  void push(Reg r) {
+    rexIfNeeded(false, 0, idx(r));
+    byte(0x50 + (idx(r) & 7));
+  }
+  void pop(Reg r) {
+    rexIfNeeded(false, 0, idx(r));
+    byte(0x58 + (idx(r) & 7));
+  }
+  void ret() {
+    byte(0xC3);
+  }
+  /// Raise an invalid opcode exception. Marks code which must not be reached.
+  void ud2() {
+    byte(0x0F);
+    byte(0x0B);
+  }
+
+  /// dst = imm. Uses the shortest encoding.
+  void movImm(Reg dst, uint64_t imm) {
+    if (llvh::isUInt<32>(imm)) {
+      // Writing a 32-bit register zero-extends into the 64-bit register.
+      rexIfNeeded(false, 0, idx(dst));
+      byte(0xB8 + (idx(dst) & 7));
+      imm32(imm);
+    } else {
+      rex(true, 0, idx(dst));
+      byte(0xB8 + (idx(dst) & 7));
+      imm64(imm);
+    }
+  }
+  /// dst = src.
+  void mov(Reg dst, Reg src) {
+    rex(true, idx(src), idx(dst));
+    byte(0x89);
+    modrmReg(idx(src), idx(dst));
+  }
+  /// dst = [base + disp].
+  void load(Reg dst, Reg base, int32_t disp) {
+    rex(true, idx(dst), idx(base));
+    byte(0x8B);
+    modrmMem(idx(dst), base, disp);
+  }
+  /// [base + disp] = src.
+  void store(Reg base, int32_t disp, Reg src) {
+    rex(true, idx(src), idx(base));
+    byte(0x89);
+    modrmMem(idx(src), base, disp);
+  }
+  /// dst = base + disp.
+  void lea(Reg dst, Reg base, int32_t disp) {
+    rex(true, idx(dst), idx(base));
+    byte(0x8D);
+    modrmMem(idx(dst), base, disp);
+  }
+  /// Compare the byte at [base + disp] with imm.
+  void cmpByte(Reg base, int32_t disp, uint8_t imm) {
+    rexIfNeeded(false, 0, idx(base));
+    byte(0x80);
+    modrmMem(7, base, disp);
+    byte(imm);
+  }
+  /// Compare a with b, setting the flags as a - b.
+  void cmp(Reg a, Reg b) {
+    rex(true, idx(b), idx(a));
+    byte(0x39);
+    modrmReg(idx(b), idx(a));
+  }
+  /// dst ^= src.
+  void xor_(Reg dst, Reg src) {
+    rex(true, idx(src), idx(dst));
+    byte(0x31);
+    modrmReg(idx(src), idx(dst));
+  }
+  /// Set the flags from the 32-bit a & b.
+  void test32(Reg a, Reg b) {
+    rexIfNeeded(false, idx(b), idx(a));
+    byte(0x85);
+    modrmReg(idx(b), idx(a));
+  }
+
+  /// dst = bits of src.
+  void movq(XmmReg dst, Reg src) {
+    byte(0x66);
+    rex(true, idx(dst), idx(src));
+    byte(0x0F);
+    byte(0x6E);
+    modrmReg(idx(dst), idx(src));
+  }
+  /// dst = bits of src.
+  void movq(Reg dst, XmmReg src) {
+    byte(0x66);
+    rex(true, idx(src), idx(dst));
+    byte(0x0F);
+    byte(0x7E);
+    modrmReg(idx(src), idx(dst));
+  }
+  void addsd(XmmReg dst, XmmReg src) {
+    sse(0xF2, 0x58, dst, src);
+  }
+  void subsd(XmmReg dst, XmmReg src) {
+    sse(0xF2, 0x5C, dst, src);
+  }
+  void mulsd(XmmReg dst, XmmReg src) {
+    sse(0xF2, 0x59, dst, src);
+  }
+  void divsd(XmmReg dst, XmmReg src) {
+    sse(0xF2, 0x5E, dst, src);
+  }
+  /// Compare a with b, setting ZF, PF and CF. Unordered sets all three.
+  void ucomisd(XmmReg a, XmmReg b) {
+    sse(0x66, 0x2E, a, b);
+  }
+
+  void jcc(Cond cond, Label target) {
+    byte(0x0F);
+    byte(0x80 + (uint8_t)cond);
+    fixup(target);
+  }
+  void jmp(Label target) {
+    byte(0xE9);
+    fixup(target);
+  }
+  /// Call the address in \p r.
+  void call(Reg r) {
+    rexIfNeeded(false, 0, idx(r));
+    byte(0xFF);
+    modrmReg(2, idx(r));
+  }
+
+  /// Resolve all branches. Every label that was used must have been bound.
+  /// \return the generated code.
+  const std::vector<uint8_t> &finish() {
+    for (const auto &fx : fixups_) {
+      assert(labels_[fx.label] != kUnbound && "branch to unbound label");
+      int32_t rel = (int32_t)labels_[fx.label] - (int32_t)(fx.pos + 4);
+      memcpy(&code_[fx.pos], &rel, sizeof(rel));
+    }
+    fixups_.clear();
+    return code_;
+  }
+
+ private:
+  static constexpr uint32_t kUnbound = ~0u;
+
+  /// A 32-bit displacement at \c pos which must point to \c label.
+  struct Fixup {
+    uint32_t pos;
+    Label label;
+  };
+
+  template <typename R>
+  static unsigned idx(R r) {
+    return (unsigned)r;
+  }
+
+  void byte(uint8_t b) {
+    code_.push_back(b);
+  }
+  void imm32(uint32_t v) {
+    for (unsigned i = 0; i < 4; ++i)
+      byte(v >> (8 * i));
+  }
+  void imm64(uint64_t v) {
+    for (unsigned i = 0; i < 8; ++i)
+      byte(v >> (8 * i));
+  }
+
+  /// Emit a REX prefix with the given W bit and the high bits of the ModRM
+  /// reg and r/m (or base) fields.
+  void rex(bool w, unsigned reg, unsigned rm) {
+    byte(0x40 | (w << 3) | ((reg >> 3) << 2) | (rm >> 3));
+  }
+  /// Emit a REX prefix only if one of the registers requires it.
+  void rexIfNeeded(bool w, unsigned reg, unsigned rm) {
+    if (w || reg >= 8 || rm >= 8)
+      rex(w, reg, rm);
+  }
+
+  void modrmReg(unsigned reg, unsigned rm) {
+    byte(0xC0 | ((reg & 7) << 3) | (rm & 7));
+  }
+  /// Encode [base + disp32]. rsp and r12 as a base require a SIB byte.
+  void modrmMem(unsigned reg, Reg base, int32_t disp) {
+    byte(0x80 | ((reg & 7) << 3) | (idx(base) & 7));
+    if ((idx(base) & 7) == 4)
+      byte(0x24);
+    imm32(disp);
+  }
+
+  /// Emit a scalar double SSE instruction between two registers.
+  void sse(uint8_t prefix, uint8_t opcode, XmmReg dst, XmmReg src) {
+    byte(prefix);
+    rexIfNeeded(false, idx(dst), idx(src));
+    byte(0x0F);
+    byte(opcode);
+    modrmReg(idx(dst), idx(src));
+  }
+
+  void fixup(Label target) {
+    fixups_.push_back({(uint32_t)code_.size(), target});
+    imm32(0);
+  }
+
+  std::vector<uint8_t> code_;
+  /// Position of each label, or kUnbound.
+  std::vector<uint32_t> labels_;
+  std::vector<Fixup> fixups_;
+};
+
+} // namespace x86_64
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_JIT_X86_64_EMITTER_H
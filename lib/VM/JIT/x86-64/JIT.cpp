@@ -0,0 +1,800 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define DEBUG_TYPE "jit"
+#include "hermes/VM/JIT/JIT.h"
+
+#ifdef HERMESVM_JIT
+
+#include "../JITHelpers.h"
+#include "Emitter.h"
+
+#include "hermes/Inst/InstDecode.h"
+#include "hermes/Support/ErrorHandling.h"
+#include "hermes/Support/OSCompat.h"
+#include "hermes/Support/Statistic.h"
+#include "hermes/VM/Runtime.h"
+
+#include "llvh/ADT/DenseMap.h"
+#include "llvh/ADT/Optional.h"
+#include "llvh/Support/Debug.h"
+
+#include <functional>
+
+#include <sys/mman.h>
+
+using namespace hermes::inst;
+using llvh::dbgs;
+
+HERMES_SLOW_STATISTIC(NumJITCompiled, "Number of functions compiled");
+HERMES_SLOW_STATISTIC(NumJITRejected, "Number of functions not compiled");
+
+namespace hermes {
+namespace vm {
+
+/// Executable memory holding the code generated by the JIT. Code is never
+/// freed individually, all of it is released with the heap.
+class ExecHeap {
+ public:
+  ExecHeap() = default;
+  ExecHeap(const ExecHeap &) = delete;
+  ExecHeap &operator=(const ExecHeap &) = delete;
+
+  ~ExecHeap() {
+    for (const Chunk &chunk : chunks_)
+      munmap(chunk.start, chunk.size);
+  }
+
+  /// Copy \p code to executable memory.
+  /// \return the address of the copy, or nullptr if memory ran out.
+  void *add(llvh::ArrayRef<uint8_t> code) {
+    size_t size = llvh::alignTo(code.size(), kAlignment);
+    if (chunks_.empty() || chunks_.back().size - chunks_.back().used < size) {
+      size_t chunkSize =
+          llvh::alignTo(std::max(size, kChunkSize), oscompat::page_size());
+      void *mem = mmap(
+          nullptr,
+          chunkSize,
+          PROT_READ | PROT_EXEC,
+          MAP_PRIVATE | MAP_ANONYMOUS,
+          -1,
+          0);
+      if (mem == MAP_FAILED)
+        return nullptr;
+      chunks_.push_back({static_cast<uint8_t *>(mem), chunkSize, 0});
+    }
+
+    // Memory is never writable and executable at the same time.
+    Chunk &chunk = chunks_.back();
+    if (mprotect(chunk.start, chunk.size, PROT_READ | PROT_WRITE) != 0)
+      return nullptr;
+    uint8_t *dest = chunk.start + chunk.used;
+    memcpy(dest, code.data(), code.size());
+    chunk.used += size;
+    if (mprotect(chunk.start, chunk.size, PROT_READ | PROT_EXEC) != 0)
+      hermes_fatal("JIT: failed to make code executable");
+    return dest;
+  }
+
+ private:
+  /// Size of the chunks of memory requested from the OS, unless a single
+  /// function needs more.
+  static constexpr size_t kChunkSize = 256 * 1024;
+
+  /// Alignment of the start of each function.
+  static constexpr size_t kAlignment = 16;
+
+  struct Chunk {
+    uint8_t *start;
+    size_t size;
+    size_t used;
+  };
+
+  std::vector<Chunk> chunks_;
+};
+
+namespace {
+
+using namespace x86_64;
+using Label = Emitter::Label;
+
+/// Raw value of the first HermesValue which is not a number. Every smaller raw
+/// value encodes a double.
+constexpr uint64_t kFirstNonNumber = (uint64_t)HermesValue::Tag::First
+    << HermesValue::kNumDataBits;
+
+// Registers holding the same value for the whole function. They are
+// callee-saved, so they survive calls to helpers.
+constexpr Reg kRuntimeReg = Reg::rbx;
+constexpr Reg kFrameRegsReg = Reg::r12;
+constexpr Reg kIPOutReg = Reg::r13;
+constexpr Reg kFirstNonNumberReg = Reg::r14;
+
+/// \return the instruction following \p ip.
+const Inst *nextInst(const Inst *ip) {
+  return reinterpret_cast<const Inst *>(
+      reinterpret_cast<const uint8_t *>(ip) + getInstSize(ip->opCode));
+}
+
+/// \return the offset of the target of the jump \p ip, relative to \p ip, or
+/// None if it is not a jump.
+llvh::Optional<int32_t> getJumpOffset(const Inst *ip) {
+#define DEFINE_JUMP_LONG_VARIANT(name, nameLong) \
+  case OpCode::name:                             \
+    return ip->i##name.op1;                      \
+  case OpCode::nameLong:                         \
+    return ip->i##nameLong.op1;
+
+  switch (ip->opCode) {
+#include "hermes/BCGen/HBC/BytecodeList.def"
+    default:
+      return llvh::None;
+  }
+#undef DEFINE_JUMP_LONG_VARIANT
+}
+
+/// \return true if \p codeBlock contains a loop.
+bool hasBackwardJump(CodeBlock *codeBlock) {
+  const auto *end = reinterpret_cast<const Inst *>(codeBlock->end());
+  for (const auto *ip = reinterpret_cast<const Inst *>(codeBlock->begin());
+       ip < end;
+       ip = nextInst(ip)) {
+    // SwitchImm is followed by its jump table, which can't be decoded.
+    if (ip->opCode == OpCode::SwitchImm)
+      break;
+    auto offset = getJumpOffset(ip);
+    if (offset && *offset <= 0)
+      return true;
+  }
+  return false;
+}
+
+/// Translates the bytecode of one function into machine code.
+class Compiler {
+ public:
+  /// \param asyncBreakFlag the flag polled by AsyncBreakCheck.
+  Compiler(CodeBlock *codeBlock, const void *asyncBreakFlag)
+      : codeBlock_(codeBlock), asyncBreakFlag_(asyncBreakFlag) {}
+
+  /// Generate the code of the whole function.
+  /// \return false if it contains an instruction which is not supported.
+  bool compile();
+
+  /// \return the generated code, after a successful compile().
+  llvh::ArrayRef<uint8_t> finish() {
+    return em_.finish();
+  }
+
+ private:
+  /// Pointer to a SSE instruction of the emitter.
+  using SSEOp = void (Emitter::*)(XmmReg, XmmReg);
+
+  /// \return the displacement of register \p reg from the frame registers.
+  static int32_t regDisp(uint32_t reg) {
+    return reg * sizeof(PinnedHermesValue);
+  }
+
+  /// \return the label of the instruction at \p offset from \p ip.
+  Label labelAt(const Inst *ip, int32_t offset) {
+    uint32_t target = codeBlock_->getOffsetOf(ip) + offset;
+    auto it = instLabels_.find(target);
+    assert(it != instLabels_.end() && "jump into the middle of an instruction");
+    return it->second;
+  }
+
+  /// Emit the code of \p ip.
+  /// \return false if the instruction is not supported.
+  bool emitInst(const Inst *ip);
+
+  /// Leave the function, telling the interpreter to resume at \p ip with
+  /// \p status.
+  void emitExit(const Inst *ip, ExecutionStatus status) {
+    em_.movImm(Reg::rax, reinterpret_cast<uint64_t>(ip));
+    em_.store(kIPOutReg, 0, Reg::rax);
+    em_.movImm(Reg::rax, (uint64_t)status);
+    em_.jmp(epilogue_);
+  }
+
+  /// \return a label leaving the function because \p ip threw.
+  Label exceptionExit(const Inst *ip) {
+    Label label = em_.newLabel();
+    slowPaths_.push_back([this, label, ip]() {
+      em_.bind(label);
+      emitExit(ip, ExecutionStatus::EXCEPTION);
+    });
+    return label;
+  }
+
+  /// Jump to \p slow if the value in \p reg is not a number.
+  void emitNumberCheck(Reg reg, Label slow) {
+    em_.cmp(reg, kFirstNonNumberReg);
+    em_.jcc(Cond::AE, slow);
+  }
+
+  /// Call \p helper to execute \p ip, and leave the function if it threw.
+  void emitCallHelper(const Inst *ip, JITHelpers::InstHelper helper);
+
+  /// Call \p helper to evaluate the condition of the jump \p ip on the
+  /// registers \p lhs and \p rhs, and jump to \p taken or \p notTaken.
+  void emitCallCondHelper(
+      const Inst *ip,
+      JITHelpers::CondHelper helper,
+      uint32_t lhs,
+      uint32_t rhs,
+      Label taken,
+      Label notTaken);
+
+  /// Emit the arithmetic instruction \p ip computing \p dst = \p lhs op
+  /// \p rhs, with the operation done by \p sseOp if both operands are
+  /// numbers. If \p slowHelper is null, the operands are known to be numbers.
+  void emitArith(
+      const Inst *ip,
+      uint32_t dst,
+      uint32_t lhs,
+      uint32_t rhs,
+      SSEOp sseOp,
+      JITHelpers::InstHelper slowHelper);
+
+  /// Emit the comparison \p ip storing in \p dst whether \p cond holds after
+  /// comparing \p lhs with \p rhs, or \p rhs with \p lhs if \p reversed.
+  void emitCompare(
+      const Inst *ip,
+      uint32_t dst,
+      uint32_t lhs,
+      uint32_t rhs,
+      Cond cond,
+      bool reversed);
+
+  /// Emit the conditional jump \p ip to \p offset, taken if \p cond holds
+  /// after comparing \p lhs with \p rhs (or the reverse), negated if
+  /// \p negate. If \p checked is false, the operands are known to be numbers.
+  void emitCompareJump(
+      const Inst *ip,
+      int32_t offset,
+      uint32_t lhs,
+      uint32_t rhs,
+      Cond cond,
+      bool reversed,
+      bool negate,
+      bool checked);
+
+  /// Emit JmpTrue (or JmpFalse if \p negate) to \p offset on \p reg.
+  void emitBoolJump(const Inst *ip, int32_t offset, uint32_t reg, bool negate);
+
+  /// Emit Inc or Dec, which the compiler only emits for numbers.
+  void emitIncDec(const Inst *ip, uint32_t dst, uint32_t src, SSEOp sseOp);
+
+  void emitStoreConst(uint32_t dst, HermesValue value) {
+    em_.movImm(Reg::rax, value.getRaw());
+    em_.store(kFrameRegsReg, regDisp(dst), Reg::rax);
+  }
+
+  void emitMov(uint32_t dst, uint32_t src) {
+    em_.load(Reg::rax, kFrameRegsReg, regDisp(src));
+    em_.store(kFrameRegsReg, regDisp(dst), Reg::rax);
+  }
+
+  CodeBlock *const codeBlock_;
+  const void *const asyncBreakFlag_;
+
+  Emitter em_{};
+
+  /// Label of the start of every instruction, by offset.
+  llvh::DenseMap<uint32_t, Label> instLabels_{};
+
+  /// Common exit of the function, restoring the callee-saved registers.
+  Label epilogue_{};
+
+  /// Generators of code which is rarely executed, emitted after the body of
+  /// the function to keep the fast paths compact.
+  std::vector<std::function<void()>> slowPaths_{};
+};
+
+bool Compiler::compile() {
+  const auto *begin = reinterpret_cast<const Inst *>(codeBlock_->begin());
+  const auto *end = reinterpret_cast<const Inst *>(codeBlock_->end());
+
+  for (const Inst *ip = begin; ip < end; ip = nextInst(ip)) {
+    // The jump table following SwitchImm can't be decoded as instructions.
+    if (ip->opCode == OpCode::SwitchImm || ip->opCode >= OpCode::_last) {
+      LLVM_DEBUG(
+          dbgs() << "JIT: function " << codeBlock_->getFunctionID()
+                 << " contains SwitchImm\n");
+      return false;
+    }
+    instLabels_[codeBlock_->getOffsetOf(ip)] = em_.newLabel();
+  }
+  epilogue_ = em_.newLabel();
+
+  // Prologue. Five pushes keep the stack 16-byte aligned at calls.
+  em_.push(Reg::rbp);
+  em_.mov(Reg::rbp, Reg::rsp);
+  em_.push(kRuntimeReg);
+  em_.push(kFrameRegsReg);
+  em_.push(kIPOutReg);
+  em_.push(kFirstNonNumberReg);
+  em_.mov(kRuntimeReg, Reg::rdi);
+  em_.mov(kFrameRegsReg, Reg::rsi);
+  em_.mov(kIPOutReg, Reg::rdx);
+  em_.movImm(kFirstNonNumberReg, kFirstNonNumber);
+
+  for (const Inst *ip = begin; ip < end; ip = nextInst(ip)) {
+    em_.bind(instLabels_[codeBlock_->getOffsetOf(ip)]);
+    if (!emitInst(ip)) {
+      LLVM_DEBUG(
+          dbgs() << "JIT: function " << codeBlock_->getFunctionID()
+                 << " contains unsupported " << getOpCodeString(ip->opCode)
+                 << "\n");
+      return false;
+    }
+  }
+  // Bytecode never falls off the end of the function.
+  em_.ud2();
+
+  // Slow paths can add more slow paths, such as exception exits, so the
+  // vector may grow while iterating.
+  for (size_t i = 0; i < slowPaths_.size(); ++i) {
+    auto slowPath = std::move(slowPaths_[i]);
+    slowPath();
+  }
+
+  em_.bind(epilogue_);
+  em_.pop(kFirstNonNumberReg);
+  em_.pop(kIPOutReg);
+  em_.pop(kFrameRegsReg);
+  em_.pop(kRuntimeReg);
+  em_.pop(Reg::rbp);
+  em_.ret();
+  return true;
+}
+
+void Compiler::emitCallHelper(const Inst *ip, JITHelpers::InstHelper helper) {
+  em_.mov(Reg::rdi, kRuntimeReg);
+  em_.mov(Reg::rsi, kFrameRegsReg);
+  em_.movImm(Reg::rdx, reinterpret_cast<uint64_t>(ip));
+  em_.movImm(Reg::rcx, reinterpret_cast<uint64_t>(codeBlock_));
+  em_.movImm(Reg::rax, reinterpret_cast<uint64_t>(helper));
+  em_.call(Reg::rax);
+  static_assert(
+      (uint32_t)ExecutionStatus::EXCEPTION == 0, "EXCEPTION must be zero");
+  em_.test32(Reg::rax, Reg::rax);
+  em_.jcc(Cond::E, exceptionExit(ip));
+}
+
+void Compiler::emitCallCondHelper(
+    const Inst *ip,
+    JITHelpers::CondHelper helper,
+    uint32_t lhs,
+    uint32_t rhs,
+    Label taken,
+    Label notTaken) {
+  em_.mov(Reg::rdi, kRuntimeReg);
+  em_.lea(Reg::rsi, kFrameRegsReg, regDisp(lhs));
+  em_.lea(Reg::rdx, kFrameRegsReg, regDisp(rhs));
+  em_.movImm(Reg::rcx, reinterpret_cast<uint64_t>(ip));
+  em_.movImm(Reg::rax, reinterpret_cast<uint64_t>(helper));
+  em_.call(Reg::rax);
+  em_.test32(Reg::rax, Reg::rax);
+  em_.jcc(Cond::S, exceptionExit(ip));
+  em_.jcc(Cond::NE, taken);
+  em_.jmp(notTaken);
+}
+
+void Compiler::emitArith(
+    const Inst *ip,
+    uint32_t dst,
+    uint32_t lhs,
+    uint32_t rhs,
+    SSEOp sseOp,
+    JITHelpers::InstHelper slowHelper) {
+  Label slow = em_.newLabel();
+  Label done = em_.newLabel();
+  em_.load(Reg::rax, kFrameRegsReg, regDisp(lhs));
+  em_.load(Reg::rcx, kFrameRegsReg, regDisp(rhs));
+  if (slowHelper) {
+    emitNumberCheck(Reg::rax, slow);
+    emitNumberCheck(Reg::rcx, slow);
+  }
+  em_.movq(XmmReg::xmm0, Reg::rax);
+  em_.movq(XmmReg::xmm1, Reg::rcx);
+  (em_.*sseOp)(XmmReg::xmm0, XmmReg::xmm1);
+  em_.movq(Reg::rax, XmmReg::xmm0);
+  em_.store(kFrameRegsReg, regDisp(dst), Reg::rax);
+  em_.bind(done);
+
+  if (slowHelper) {
+    slowPaths_.push_back([this, ip, slow, done, slowHelper]() {
+      em_.bind(slow);
+      emitCallHelper(ip, slowHelper);
+      em_.jmp(done);
+    });
+  } else {
+    em_.bind(slow);
+  }
+}
+
+void Compiler::emitCompare(
+    const Inst *ip,
+    uint32_t dst,
+    uint32_t lhs,
+    uint32_t rhs,
+    Cond cond,
+    bool reversed) {
+  Label slow = em_.newLabel();
+  Label isTrue = em_.newLabel();
+  Label store = em_.newLabel();
+  Label done = em_.newLabel();
+  em_.load(Reg::rax, kFrameRegsReg, regDisp(lhs));
+  em_.load(Reg::rcx, kFrameRegsReg, regDisp(rhs));
+  emitNumberCheck(Reg::rax, slow);
+  emitNumberCheck(Reg::rcx, slow);
+  em_.movq(XmmReg::xmm0, Reg::rax);
+  em_.movq(XmmReg::xmm1, Reg::rcx);
+  if (reversed)
+    em_.ucomisd(XmmReg::xmm1, XmmReg::xmm0);
+  else
+    em_.ucomisd(XmmReg::xmm0, XmmReg::xmm1);
+  em_.jcc(cond, isTrue);
+  em_.movImm(Reg::rax, HermesValue::encodeBoolValue(false).getRaw());
+  em_.jmp(store);
+  em_.bind(isTrue);
+  em_.movImm(Reg::rax, HermesValue::encodeBoolValue(true).getRaw());
+  em_.bind(store);
+  em_.store(kFrameRegsReg, regDisp(dst), Reg::rax);
+  em_.bind(done);
+
+  JITHelpers::InstHelper helper = JITHelpers::getInstHelper(ip->opCode);
+  slowPaths_.push_back([this, ip, slow, done, helper]() {
+    em_.bind(slow);
+    emitCallHelper(ip, helper);
+    em_.jmp(done);
+  });
+}
+
+void Compiler::emitCompareJump(
+    const Inst *ip,
+    int32_t offset,
+    uint32_t lhs,
+    uint32_t rhs,
+    Cond cond,
+    bool reversed,
+    bool negate,
+    bool checked) {
+  Label target = labelAt(ip, offset);
+  Label next = labelAt(ip, getInstSize(ip->opCode));
+  Label taken = negate ? next : target;
+  Label notTaken = negate ? target : next;
+  Label slow = em_.newLabel();
+
+  em_.load(Reg::rax, kFrameRegsReg, regDisp(lhs));
+  em_.load(Reg::rcx, kFrameRegsReg, regDisp(rhs));
+  if (checked) {
+    emitNumberCheck(Reg::rax, slow);
+    emitNumberCheck(Reg::rcx, slow);
+  }
+  em_.movq(XmmReg::xmm0, Reg::rax);
+  em_.movq(XmmReg::xmm1, Reg::rcx);
+  if (reversed)
+    em_.ucomisd(XmmReg::xmm1, XmmReg::xmm0);
+  else
+    em_.ucomisd(XmmReg::xmm0, XmmReg::xmm1);
+  em_.jcc(cond, taken);
+  em_.jmp(notTaken);
+
+  if (checked) {
+    JITHelpers::CondHelper helper = JITHelpers::getCondHelper(ip->opCode);
+    slowPaths_.push_back(
+        [this, ip, slow, helper, lhs, rhs, taken, notTaken]() {
+          em_.bind(slow);
+          emitCallCondHelper(ip, helper, lhs, rhs, taken, notTaken);
+        });
+  } else {
+    em_.bind(slow);
+  }
+}
+
+void Compiler::emitBoolJump(
+    const Inst *ip,
+    int32_t offset,
+    uint32_t reg,
+    bool negate) {
+  Label target = labelAt(ip, offset);
+  Label next = labelAt(ip, getInstSize(ip->opCode));
+  Label taken = negate ? next : target;
+  Label notTaken = negate ? target : next;
+
+  // Booleans are checked inline, other values are converted by the helper.
+  em_.load(Reg::rax, kFrameRegsReg, regDisp(reg));
+  em_.movImm(Reg::rcx, HermesValue::encodeBoolValue(true).getRaw());
+  em_.cmp(Reg::rax, Reg::rcx);
+  em_.jcc(Cond::E, taken);
+  em_.movImm(Reg::rcx, HermesValue::encodeBoolValue(false).getRaw());
+  em_.cmp(Reg::rax, Reg::rcx);
+  em_.jcc(Cond::E, notTaken);
+  emitCallCondHelper(
+      ip,
+      JITHelpers::getCondHelper(ip->opCode),
+      reg,
+      reg,
+      taken,
+      notTaken);
+}
+
+void Compiler::emitIncDec(
+    const Inst *ip,
+    uint32_t dst,
+    uint32_t src,
+    SSEOp sseOp) {
+  em_.load(Reg::rax, kFrameRegsReg, regDisp(src));
+  em_.movImm(Reg::rcx, HermesValue::encodeDoubleValue(1).getRaw());
+  em_.movq(XmmReg::xmm0, Reg::rax);
+  em_.movq(XmmReg::xmm1, Reg::rcx);
+  (em_.*sseOp)(XmmReg::xmm0, XmmReg::xmm1);
+  em_.movq(Reg::rax, XmmReg::xmm0);
+  em_.store(kFrameRegsReg, regDisp(dst), Reg::rax);
+}
+
+bool Compiler::emitInst(const Inst *ip) {
+#define JIT_ARITH(name, sseOp)                                     \
+  case OpCode::name:                                               \
+    emitArith(                                                     \
+        ip,                                                        \
+        ip->i##name.op1,                                           \
+        ip->i##name.op2,                                           \
+        ip->i##name.op3,                                           \
+        &Emitter::sseOp,                                           \
+        JITHelpers::getInstHelper(OpCode::name));                  \
+    return true;                                                   \
+  case OpCode::name##N:                                            \
+    emitArith(                                                     \
+        ip,                                                        \
+        ip->i##name##N.op1,                                        \
+        ip->i##name##N.op2,                                        \
+        ip->i##name##N.op3,                                        \
+        &Emitter::sseOp,                                           \
+        nullptr);                                                  \
+    return true;
+
+#define JIT_COMPARE(name, cond, reversed) \
+  case OpCode::name:                      \
+    emitCompare(                          \
+        ip,                               \
+        ip->i##name.op1,                  \
+        ip->i##name.op2,                  \
+        ip->i##name.op3,                  \
+        cond,                             \
+        reversed);                        \
+    return true;
+
+#define JIT_COMPARE_JUMP_1(name, cond, reversed, negate, checked) \
+  case OpCode::name:                                              \
+    emitCompareJump(                                              \
+        ip,                                                       \
+        ip->i##name.op1,                                          \
+        ip->i##name.op2,                                          \
+        ip->i##name.op3,                                          \
+        cond,                                                     \
+        reversed,                                                 \
+        negate,                                                   \
+        checked);                                                 \
+    return true;
+#define JIT_COMPARE_JUMP(name, cond, reversed)                       \
+  JIT_COMPARE_JUMP_1(J##name, cond, reversed, false, true)           \
+  JIT_COMPARE_JUMP_1(J##name##Long, cond, reversed, false, true)     \
+  JIT_COMPARE_JUMP_1(JNot##name, cond, reversed, true, true)         \
+  JIT_COMPARE_JUMP_1(JNot##name##Long, cond, reversed, true, true)   \
+  JIT_COMPARE_JUMP_1(J##name##N, cond, reversed, false, false)       \
+  JIT_COMPARE_JUMP_1(J##name##NLong, cond, reversed, false, false)   \
+  JIT_COMPARE_JUMP_1(JNot##name##N, cond, reversed, true, false)     \
+  JIT_COMPARE_JUMP_1(JNot##name##NLong, cond, reversed, true, false)
+
+#define JIT_HELPER_JUMP(name, negate)                                    \
+  case OpCode::name:                                                     \
+    emitCallCondHelper(                                                  \
+        ip,                                                              \
+        JITHelpers::getCondHelper(OpCode::name),                         \
+        ip->i##name.op2,                                                 \
+        ip->i##name.op3,                                                 \
+        negate ? labelAt(ip, getInstSize(OpCode::name))                  \
+               : labelAt(ip, ip->i##name.op1),                           \
+        negate ? labelAt(ip, ip->i##name.op1)                            \
+               : labelAt(ip, getInstSize(OpCode::name)));                \
+    return true;
+
+#define JIT_BOOL_JUMP(name, negate)                                     \
+  case OpCode::name:                                                    \
+    emitBoolJump(ip, ip->i##name.op1, ip->i##name.op2, negate);         \
+    return true;
+
+  switch (ip->opCode) {
+    case OpCode::Mov:
+      emitMov(ip->iMov.op1, ip->iMov.op2);
+      return true;
+    case OpCode::MovLong:
+      emitMov(ip->iMovLong.op1, ip->iMovLong.op2);
+      return true;
+
+    case OpCode::LoadConstUndefined:
+      emitStoreConst(
+          ip->iLoadConstUndefined.op1, HermesValue::encodeUndefinedValue());
+      return true;
+    case OpCode::LoadConstNull:
+      emitStoreConst(ip->iLoadConstNull.op1, HermesValue::encodeNullValue());
+      return true;
+    case OpCode::LoadConstTrue:
+      emitStoreConst(
+          ip->iLoadConstTrue.op1, HermesValue::encodeBoolValue(true));
+      return true;
+    case OpCode::LoadConstFalse:
+      emitStoreConst(
+          ip->iLoadConstFalse.op1, HermesValue::encodeBoolValue(false));
+      return true;
+    case OpCode::LoadConstZero:
+      emitStoreConst(
+          ip->iLoadConstZero.op1, HermesValue::encodeDoubleValue(0));
+      return true;
+    case OpCode::LoadConstEmpty:
+      emitStoreConst(ip->iLoadConstEmpty.op1, HermesValue::encodeEmptyValue());
+      return true;
+    case OpCode::LoadConstUInt8:
+      emitStoreConst(
+          ip->iLoadConstUInt8.op1,
+          HermesValue::encodeDoubleValue(ip->iLoadConstUInt8.op2));
+      return true;
+    case OpCode::LoadConstInt:
+      emitStoreConst(
+          ip->iLoadConstInt.op1,
+          HermesValue::encodeDoubleValue(ip->iLoadConstInt.op2));
+      return true;
+    case OpCode::LoadConstDouble:
+      emitStoreConst(
+          ip->iLoadConstDouble.op1,
+          HermesValue::encodeDoubleValue(ip->iLoadConstDouble.op2));
+      return true;
+
+      JIT_ARITH(Add, addsd)
+      JIT_ARITH(Sub, subsd)
+      JIT_ARITH(Mul, mulsd)
+      JIT_ARITH(Div, divsd)
+
+    case OpCode::Inc:
+      emitIncDec(ip, ip->iInc.op1, ip->iInc.op2, &Emitter::addsd);
+      return true;
+    case OpCode::Dec:
+      emitIncDec(ip, ip->iDec.op1, ip->iDec.op2, &Emitter::subsd);
+      return true;
+
+      // ucomisd sets CF on "unordered", so A and AE are false for NaN.
+      JIT_COMPARE(Less, Cond::A, true)
+      JIT_COMPARE(LessEq, Cond::AE, true)
+      JIT_COMPARE(Greater, Cond::A, false)
+      JIT_COMPARE(GreaterEq, Cond::AE, false)
+
+      JIT_COMPARE_JUMP(Less, Cond::A, true)
+      JIT_COMPARE_JUMP(LessEqual, Cond::AE, true)
+      JIT_COMPARE_JUMP(Greater, Cond::A, false)
+      JIT_COMPARE_JUMP(GreaterEqual, Cond::AE, false)
+
+      JIT_HELPER_JUMP(JEqual, false)
+      JIT_HELPER_JUMP(JEqualLong, false)
+      JIT_HELPER_JUMP(JNotEqual, true)
+      JIT_HELPER_JUMP(JNotEqualLong, true)
+      JIT_HELPER_JUMP(JStrictEqual, false)
+      JIT_HELPER_JUMP(JStrictEqualLong, false)
+      JIT_HELPER_JUMP(JStrictNotEqual, true)
+      JIT_HELPER_JUMP(JStrictNotEqualLong, true)
+
+      JIT_BOOL_JUMP(JmpTrue, false)
+      JIT_BOOL_JUMP(JmpTrueLong, false)
+      JIT_BOOL_JUMP(JmpFalse, true)
+      JIT_BOOL_JUMP(JmpFalseLong, true)
+
+    case OpCode::Jmp:
+      em_.jmp(labelAt(ip, ip->iJmp.op1));
+      return true;
+    case OpCode::JmpLong:
+      em_.jmp(labelAt(ip, ip->iJmpLong.op1));
+      return true;
+    case OpCode::JmpUndefined:
+    case OpCode::JmpUndefinedLong: {
+      int32_t offset = ip->opCode == OpCode::JmpUndefined
+          ? ip->iJmpUndefined.op1
+          : ip->iJmpUndefinedLong.op1;
+      uint32_t reg = ip->opCode == OpCode::JmpUndefined
+          ? ip->iJmpUndefined.op2
+          : ip->iJmpUndefinedLong.op2;
+      em_.load(Reg::rax, kFrameRegsReg, regDisp(reg));
+      em_.movImm(Reg::rcx, HermesValue::encodeUndefinedValue().getRaw());
+      em_.cmp(Reg::rax, Reg::rcx);
+      em_.jcc(Cond::E, labelAt(ip, offset));
+      return true;
+    }
+
+    case OpCode::AsyncBreakCheck: {
+      Label slow = em_.newLabel();
+      Label done = em_.newLabel();
+      em_.movImm(Reg::rax, reinterpret_cast<uint64_t>(asyncBreakFlag_));
+      em_.cmpByte(Reg::rax, 0, 0);
+      em_.jcc(Cond::NE, slow);
+      em_.bind(done);
+      slowPaths_.push_back([this, ip, slow, done]() {
+        em_.bind(slow);
+        emitCallHelper(ip, JITHelpers::getInstHelper(OpCode::AsyncBreakCheck));
+        em_.jmp(done);
+      });
+      return true;
+    }
+
+    case OpCode::ProfilePoint:
+#ifdef HERMESVM_PROFILER_BB
+      return false;
+#else
+      return true;
+#endif
+
+    case OpCode::Ret:
+      // Let the interpreter perform the return, so it is observed by the
+      // debugger and the profilers as usual.
+      emitExit(ip, ExecutionStatus::RETURNED);
+      return true;
+
+    default:
+      if (JITHelpers::InstHelper helper =
+              JITHelpers::getInstHelper(ip->opCode)) {
+        emitCallHelper(ip, helper);
+        return true;
+      }
+      return false;
+  }
+
+#undef JIT_ARITH
+#undef JIT_COMPARE
+#undef JIT_COMPARE_JUMP_1
+#undef JIT_COMPARE_JUMP
+#undef JIT_HELPER_JUMP
+#undef JIT_BOOL_JUMP
+}
+
+} // namespace
+
+JITContext::JITContext(bool enable, bool force)
+    : enabled_(enable), force_(force) {}
+
+JITContext::~JITContext() = default;
+
+JITCompiledFunctionPtr JITContext::compileImpl(
+    Runtime &runtime,
+    CodeBlock *codeBlock) {
+  // A function without loops has to be called often enough to be worth it.
+  if (codeBlock->jitCallCount_ == 1 && !force_ && !hasBackwardJump(codeBlock))
+    return nullptr;
+
+  Compiler compiler{codeBlock, &runtime.asyncBreakRequestFlag_};
+  void *code = nullptr;
+  if (compiler.compile()) {
+    if (!heap_)
+      heap_ = std::make_unique<ExecHeap>();
+    code = heap_->add(compiler.finish());
+  }
+  if (!code) {
+    ++NumJITRejected;
+    codeBlock->jitCallCount_ = kNeverCompile;
+    return nullptr;
+  }
+
+  ++NumJITCompiled;
+  LLVM_DEBUG(
+      dbgs() << "JIT: compiled function " << codeBlock->getFunctionID()
+             << " at " << code << "\n");
+  codeBlock->JITCompiled_ = reinterpret_cast<JITCompiledFunctionPtr>(code);
+  return codeBlock->JITCompiled_;
+}
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMESVM_JIT
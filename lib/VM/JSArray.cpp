@@ -116,6 +116,23 @@ HermesValue ArrayImpl::_getOwnIndexedImpl(
   return vmcast<ArrayImpl>(selfObj)->at(runtime, index).unboxToHV(runtime);
 }
 
+bool ArrayImpl::appendWithinCapacity(
+    ArrayImpl *self,
+    Runtime &runtime,
+    size_type index,
+    SmallHermesValue value) {
+  assert(index == self->endIndex_ && "can only append at the end index");
+  auto *const indexedStorage = self->getIndexedStorage(runtime);
+  if (!indexedStorage ||
+      index - self->beginIndex_ >= indexedStorage->capacity())
+    return false;
+  self->endIndex_ = index + 1;
+  StorageType::resizeWithinCapacity(
+      indexedStorage, runtime, index - self->beginIndex_ + 1);
+  indexedStorage->set(runtime, index - self->beginIndex_, value);
+  return true;
+}
+
 ExecutionStatus ArrayImpl::setStorageEndIndex(
     Handle<ArrayImpl> selfHandle,
     Runtime &runtime,
@@ -567,6 +584,73 @@ JSArray::create(Runtime &runtime, size_type capacity, size_type length) {
       length);
 }
 
+bool JSArray::putNewElementFast(
+    Handle<JSArray> selfHandle,
+    Runtime &runtime,
+    uint32_t index,
+    Handle<> valueHandle) {
+  bool inStorage;
+  bool growsLength;
+  {
+    NoAllocScope noAlloc{runtime};
+    JSArray *self = *selfHandle;
+    if (LLVM_UNLIKELY(self->flags_.noExtend))
+      return false;
+    inStorage = index >= self->getBeginIndex() && index < self->getEndIndex();
+    if (!inStorage) {
+      // Only append directly after the last element in storage, and only
+      // within the current capacity.
+      auto *storage = self->getIndexedStorage(runtime);
+      if (index != self->getEndIndex() || !storage ||
+          index - self->getBeginIndex() >= storage->capacity())
+        return false;
+    }
+    uint32_t length = getLength(self, runtime);
+    if (index > length)
+      return false;
+    growsLength = index == length;
+    // The standard array class guarantees that length is writable.
+    if (growsLength &&
+        self->getClass(runtime) != runtime.arrayClass.getObject())
+      return false;
+
+    // A setter or read-only property named index anywhere on the prototype
+    // chain would change the result of the store.
+    for (JSObject *proto = self->getParent(runtime); proto;
+         proto = proto->getParent(runtime)) {
+      if (LLVM_UNLIKELY(
+              proto->isProxyObject() || proto->isHostObject() ||
+              proto->isLazy()))
+        return false;
+      if (proto->getClass(runtime)->getHasIndexLikeProperties())
+        return false;
+      // Other exotic indexed objects, such as typed arrays, are not handled.
+      if (proto->hasIndexedStorage() &&
+          (!vmisa<JSArray>(proto) ||
+           !vmcast<JSArray>(proto)->at(runtime, index).isEmpty()))
+        return false;
+    }
+  }
+
+  // Encoding the values may allocate. Nothing checked above can change as a
+  // result, since the GC doesn't run any JS.
+  if (growsLength) {
+    auto newLength = SmallHermesValue::encodeNumberValue(index + 1, runtime);
+    putLength(*selfHandle, runtime, newLength);
+  }
+  auto shv = SmallHermesValue::encodeHermesValue(*valueHandle, runtime);
+  JSArray *self = *selfHandle;
+  if (inStorage) {
+    self->getIndexedStorage(runtime)->set(
+        runtime, index - self->getBeginIndex(), shv);
+    return true;
+  }
+  bool appended = appendWithinCapacity(self, runtime, index, shv);
+  (void)appended;
+  assert(appended && "storage capacity was checked");
+  return true;
+}
+
 CallResult<bool> JSArray::setLength(
     Handle<JSArray> selfHandle,
     Runtime &runtime,
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 #include "JSLibInternal.h"
 
+#include "hermes/Support/Conversions.h"
 #include "hermes/VM/HandleRootOwner-inline.h"
 #include "hermes/VM/JSLib/Sorting.h"
 #include "hermes/VM/Operations.h"
@@ -20,6 +21,8 @@
 
 #include "llvh/ADT/ScopeExit.h"
 
+#include <numeric>
+
 namespace hermes {
 namespace vm {
 
@@ -921,6 +924,59 @@ arrayPrototypePush(void *, Runtime &runtime, NativeArgs args) {
 }
 
 namespace {
+/// SortCompare of ES2023 23.1.3.30.2, for two values \p a and \p b which are
+/// not empty: undefined is greater than everything, otherwise the order is
+/// given by \p compareFn if it isn't null, or by comparing the values
+/// converted to strings. \p a and \p b are overwritten by the conversion.
+/// \return negative if a < b, positive if a > b, and 0 if they are equal.
+CallResult<int> compareSortValues(
+    Runtime &runtime,
+    Handle<Callable> compareFn,
+    MutableHandle<> &a,
+    MutableHandle<> &b) {
+  assert(!a->isEmpty() && !b->isEmpty() && "cannot compare empty values");
+  if (a->isUndefined()) {
+    // Spec defines undefined as greater than everything.
+    return b->isUndefined() ? 0 : 1;
+  }
+  if (b->isUndefined()) {
+    // Spec defines undefined as greater than everything.
+    return -1;
+  }
+
+  if (compareFn) {
+    // If we have a compareFn, just use that.
+    auto callRes = Callable::executeCall2(
+        compareFn, runtime, Runtime::getUndefinedValue(), a.get(), b.get());
+    if (LLVM_UNLIKELY(callRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    auto intRes =
+        toNumber_RJS(runtime, runtime.makeHandle(std::move(*callRes)));
+    if (LLVM_UNLIKELY(intRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    // Cannot return intRes's value directly because it can be NaN
+    auto res = intRes->getNumber();
+    return (res < 0) ? -1 : (res > 0 ? 1 : 0);
+  }
+
+  // Convert both arguments to strings and compare
+  auto aValueRes = toString_RJS(runtime, a);
+  if (LLVM_UNLIKELY(aValueRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  a = aValueRes->getHermesValue();
+
+  auto bValueRes = toString_RJS(runtime, b);
+  if (LLVM_UNLIKELY(bValueRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  b = bValueRes->getHermesValue();
+
+  return a->getString()->compare(b->getString());
+}
+
 /// General object sorting model used by custom sorting routines.
 /// Provides a model by which to less and swap elements, using the [[Get]],
 /// [[Put]], and [[Delete]] internal methods of a supplied Object. Should be
@@ -930,7 +986,7 @@ namespace {
 /// handles every time we want to compare different elements.
 /// Usage example:
 ///   StandardSortModel sm{runtime, obj, compareFn};
-///   quickSort(sm, 0, length);
+///   timSort(sm, 0, length);
 /// Note that this is generic and does nothing different if passed a JSArray.
 class StandardSortModel : public SortModel {
  private:
@@ -1169,50 +1225,7 @@ class StandardSortModel : public SortModel {
     bValue_ = std::move(*propRes);
     assert(!bValue_->isEmpty());
 
-    if (aValue_->isUndefined()) {
-      // Spec defines undefined as greater than everything.
-      return 1;
-    }
-    if (bValue_->isUndefined()) {
-      // Spec defines undefined as greater than everything.
-      return -1;
-    }
-
-    if (compareFn_) {
-      // If we have a compareFn, just use that.
-      auto callRes = Callable::executeCall2(
-          compareFn_,
-          runtime_,
-          Runtime::getUndefinedValue(),
-          aValue_.get(),
-          bValue_.get());
-      if (LLVM_UNLIKELY(callRes == ExecutionStatus::EXCEPTION)) {
-        return ExecutionStatus::EXCEPTION;
-      }
-      auto intRes =
-          toNumber_RJS(runtime_, runtime_.makeHandle(std::move(*callRes)));
-      if (LLVM_UNLIKELY(intRes == ExecutionStatus::EXCEPTION)) {
-        return ExecutionStatus::EXCEPTION;
-      }
-      // Cannot return intRes's value directly because it can be NaN
-      auto res = intRes->getNumber();
-      return (res < 0) ? -1 : (res > 0 ? 1 : 0);
-    } else {
-      // Convert both arguments to strings and compare
-      auto aValueRes = toString_RJS(runtime_, aValue_);
-      if (LLVM_UNLIKELY(aValueRes == ExecutionStatus::EXCEPTION)) {
-        return ExecutionStatus::EXCEPTION;
-      }
-      aValue_ = aValueRes->getHermesValue();
-
-      auto bValueRes = toString_RJS(runtime_, bValue_);
-      if (LLVM_UNLIKELY(bValueRes == ExecutionStatus::EXCEPTION)) {
-        return ExecutionStatus::EXCEPTION;
-      }
-      bValue_ = bValueRes->getHermesValue();
-
-      return aValue_->getString()->compare(bValue_->getString());
-    }
+    return compareSortValues(runtime_, compareFn_, aValue_, bValue_);
   }
 };
 
@@ -1303,7 +1316,7 @@ CallResult<HermesValue> sortSparse(
   {
     StandardSortModel sm(runtime, array, compareFn);
     if (LLVM_UNLIKELY(
-            quickSort(&sm, 0u, numProps) == ExecutionStatus::EXCEPTION))
+            timSort(&sm, 0u, numProps) == ExecutionStatus::EXCEPTION))
       return ExecutionStatus::EXCEPTION;
   }
 
@@ -1328,6 +1341,199 @@ CallResult<HermesValue> sortSparse(
 
   return O.getHermesValue();
 }
+
+/// \return true if \p x is ordered before \p y when both are converted to
+/// strings, without converting them.
+bool lessInt32AsStrings(int32_t x, int32_t y) {
+  if (x == y)
+    return false;
+  // '-' is ordered before the digits.
+  if ((x < 0) != (y < 0))
+    return x < 0;
+  // Compare the digits of the absolute values, by padding the shorter one
+  // with zeros so that both have the same number of digits.
+  uint64_t ax = x < 0 ? -(int64_t)x : x;
+  uint64_t ay = y < 0 ? -(int64_t)y : y;
+  uint64_t px = ax, py = ay;
+  for (uint64_t t = ax; t >= 10; t /= 10)
+    py *= 10;
+  for (uint64_t t = ay; t >= 10; t /= 10)
+    px *= 10;
+  // If the padded values are equal, one is a prefix of the other, and the
+  // shorter one comes first.
+  return px != py ? px < py : ax < ay;
+}
+
+/// Sort \p values, which are numbers, in the order of their string
+/// conversions, like the default comparison of Array.prototype.sort, but
+/// without allocating the strings.
+/// \return the positions of the values in sorted order.
+std::vector<uint32_t> sortNumbersAsStrings(
+    Runtime &runtime,
+    const std::vector<SmallHermesValue> &values) {
+  uint32_t n = values.size();
+  std::vector<uint32_t> order(n);
+
+  // Integers can be compared directly.
+  std::vector<std::pair<int32_t, uint32_t>> ints;
+  ints.reserve(n);
+  for (uint32_t i = 0; i != n; ++i) {
+    double d = values[i].getNumber(runtime);
+    if (!(d >= INT32_MIN && d <= INT32_MAX) || static_cast<int32_t>(d) != d)
+      break;
+    ints.emplace_back(static_cast<int32_t>(d), i);
+  }
+  if (ints.size() == n) {
+    auto less = [](std::pair<int32_t, uint32_t> a,
+                   std::pair<int32_t, uint32_t> b) -> CallResult<bool> {
+      return lessInt32AsStrings(a.first, b.first);
+    };
+    (void)timSort(ints.data(), ints.data() + n, less);
+    for (uint32_t i = 0; i != n; ++i)
+      order[i] = ints[i].second;
+    return order;
+  }
+
+  // Otherwise convert each number to a string once, in native memory.
+  std::vector<char> buf(n * NUMBER_TO_STRING_BUF_SIZE);
+  std::vector<llvh::StringRef> keys(n);
+  for (uint32_t i = 0; i != n; ++i) {
+    char *key = &buf[i * NUMBER_TO_STRING_BUF_SIZE];
+    size_t len = numberToString(
+        values[i].getNumber(runtime), key, NUMBER_TO_STRING_BUF_SIZE);
+    keys[i] = llvh::StringRef(key, len);
+  }
+  std::iota(order.begin(), order.end(), 0);
+  auto less = [&keys](uint32_t a, uint32_t b) -> CallResult<bool> {
+    return keys[a] < keys[b];
+  };
+  (void)timSort(order.data(), order.data() + n, less);
+  return order;
+}
+
+/// Sort the elements [0, len) of \p arr, if they are all present in its
+/// indexed storage. Following ES2023 23.1.3.30, the values are read first,
+/// sorted with TimSort, and then written back in order, followed by the
+/// undefined values. Arrays of numbers or of strings sorted with the default
+/// comparison are sorted without calling into JS or allocating.
+/// \return false without doing anything if the array has holes, in which
+///   case it must be sorted by the generic path.
+CallResult<bool> sortDenseArray(
+    Runtime &runtime,
+    Handle<JSArray> arr,
+    Handle<Callable> compareFn,
+    uint32_t len) {
+  GCScope gcScope{runtime};
+
+  if (arr->getBeginIndex() != 0 || arr->getEndIndex() < len)
+    return false;
+  uint32_t numUndefined = 0;
+  bool allNumbers = true, allStrings = true;
+  for (uint32_t i = 0; i != len; ++i) {
+    SmallHermesValue v = arr->at(runtime, i);
+    if (v.isEmpty())
+      return false;
+    if (v.isUndefined()) {
+      ++numUndefined;
+      continue;
+    }
+    allNumbers = allNumbers && v.isNumber();
+    allStrings = allStrings && v.isString();
+  }
+  uint32_t n = len - numUndefined;
+
+  if (!compareFn && (allNumbers || allStrings) && arr->isExtensible()) {
+    // No JS runs and nothing is allocated until the values are written back,
+    // so they can be kept in native memory.
+    NoAllocScope noAlloc{runtime};
+    std::vector<SmallHermesValue> values;
+    values.reserve(n);
+    for (uint32_t i = 0; i != len; ++i) {
+      SmallHermesValue v = arr->at(runtime, i);
+      if (!v.isUndefined())
+        values.push_back(v);
+    }
+    std::vector<uint32_t> order;
+    if (allNumbers) {
+      order = sortNumbersAsStrings(runtime, values);
+    } else {
+      order.resize(n);
+      std::iota(order.begin(), order.end(), 0);
+      auto less = [&runtime, &values](uint32_t a, uint32_t b)
+          -> CallResult<bool> {
+        return values[a].getString(runtime)->compare(
+                   values[b].getString(runtime)) < 0;
+      };
+      (void)timSort(order.data(), order.data() + n, less);
+    }
+    for (uint32_t i = 0; i != n; ++i)
+      JSArray::unsafeSetExistingElementAt(*arr, runtime, i, values[order[i]]);
+    for (uint32_t i = n; i != len; ++i) {
+      JSArray::unsafeSetExistingElementAt(
+          *arr, runtime, i, SmallHermesValue::encodeUndefinedValue());
+    }
+    return true;
+  }
+
+  // Copy the values to a new array, so the compare function can neither
+  // observe nor change them while they are sorted.
+  auto crWork = JSArray::create(runtime, n, n);
+  if (LLVM_UNLIKELY(crWork == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto work = *crWork;
+  if (LLVM_UNLIKELY(
+          JSArray::setStorageEndIndex(work, runtime, n) ==
+          ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  for (uint32_t i = 0, j = 0; i != len; ++i) {
+    SmallHermesValue v = arr->at(runtime, i);
+    if (!v.isUndefined())
+      JSArray::unsafeSetExistingElementAt(*work, runtime, j++, v);
+  }
+
+  // Sort the positions in the copy.
+  std::vector<uint32_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  MutableHandle<> aValue{runtime};
+  MutableHandle<> bValue{runtime};
+  MutableHandle<> propName{runtime};
+  auto marker = gcScope.createMarker();
+  auto less = [&](uint32_t a, uint32_t b) -> CallResult<bool> {
+    gcScope.flushToMarker(marker);
+    aValue = work->at(runtime, a).unboxToHV(runtime);
+    bValue = work->at(runtime, b).unboxToHV(runtime);
+    auto res = compareSortValues(runtime, compareFn, aValue, bValue);
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    return *res < 0;
+  };
+  if (LLVM_UNLIKELY(
+          timSort(order.data(), order.data() + n, less) ==
+          ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+
+  // Write the values back. The compare function may have changed the array
+  // in any way, so only overwrite the existing elements directly.
+  for (uint32_t i = 0; i != len; ++i) {
+    gcScope.flushToMarker(marker);
+    aValue = i < n ? work->at(runtime, order[i]).unboxToHV(runtime)
+                   : HermesValue::encodeUndefinedValue();
+    if (LLVM_LIKELY(arr->hasFastIndexProperties()) &&
+        JSArray::tryPutIndexedFast(arr, runtime, i, aValue))
+      continue;
+    propName = HermesValue::encodeNumberValue(i);
+    if (LLVM_UNLIKELY(
+            JSObject::putComputed_RJS(
+                arr,
+                runtime,
+                propName,
+                aValue,
+                PropOpFlags().plusThrowOnError()) ==
+            ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+  return true;
+}
 } // anonymous namespace
 
 /// ES5.1 15.4.4.11.
@@ -1362,13 +1568,22 @@ arrayPrototypeSort(void *, Runtime &runtime, NativeArgs args) {
   if (!O->isProxyObject() && !O->isHostObject() && !O->hasFastIndexProperties())
     return sortSparse(runtime, O, compareFn, len);
 
+  // Arrays without holes are sorted as a list of values.
+  if (auto arr = Handle<JSArray>::dyn_vmcast(O)) {
+    auto sortRes = sortDenseArray(runtime, arr, compareFn, len);
+    if (LLVM_UNLIKELY(sortRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    if (*sortRes)
+      return O.getHermesValue();
+  }
+
   // This is the "fast" path. We are sorting an array with indexed storage.
   StandardSortModel sm(runtime, O, compareFn);
 
   // Use our custom sort routine. We can't use std::sort because it performs
   // optimizations that allow it to bypass calls to std::swap, but our swap
   // function is special, since it needs to use the internal Object functions.
-  if (LLVM_UNLIKELY(quickSort(&sm, 0u, len) == ExecutionStatus::EXCEPTION))
+  if (LLVM_UNLIKELY(timSort(&sm, 0u, len) == ExecutionStatus::EXCEPTION))
     return ExecutionStatus::EXCEPTION;
 
   return O.getHermesValue();
@@ -256,6 +256,9 @@ hermesInternalGetInstrumentedStats(void *, Runtime &runtime, NativeArgs args) {
     SET_PROP_NEW("js_markStackOverflows", info.numMarkStackOverflows);
   }
 
+  SET_PROP_NEW("js_regExpCacheHits", stats.regExpCacheHits);
+  SET_PROP_NEW("js_regExpCacheMisses", stats.regExpCacheMisses);
+
   if (stats.shouldSample) {
     SET_PROP_NEW(
         "js_hermesVolCtxSwitches",
@@ -11,6 +11,16 @@
 
 #include "dtoa/dtoa.h"
 
+#include "llvh/Support/MathExtras.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HERMES_JSONLEXER_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define HERMES_JSONLEXER_NEON
+#endif
+
 namespace hermes {
 namespace vm {
 
@@ -23,10 +33,129 @@ static bool isJSONWhiteSpace(char16_t ch) {
   return (ch == u'\t' || ch == u'\r' || ch == u'\n' || ch == u' ');
 }
 
+/// \return whether \p ch ends the run of characters in a JSON string which
+/// are copied as is: it is a quote, a backslash or a control character.
+static bool isJSONStringSpecial(char16_t ch) {
+  return ch == u'"' || ch == u'\\' || ch <= u'\u001F';
+}
+
+#if defined(HERMES_JSONLEXER_SSE2)
+
+/// Number of code units compared at a time.
+static constexpr size_t kLanes = 8;
+
+/// \return a mask with two bits set for each of the kLanes code units at \p p
+/// which are JSON whitespace, starting with the lowest bits.
+static uint32_t whiteSpaceMask(const char16_t *p) {
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  __m128i ws = _mm_or_si128(
+      _mm_or_si128(
+          _mm_cmpeq_epi16(v, _mm_set1_epi16(u' ')),
+          _mm_cmpeq_epi16(v, _mm_set1_epi16(u'\n'))),
+      _mm_or_si128(
+          _mm_cmpeq_epi16(v, _mm_set1_epi16(u'\r')),
+          _mm_cmpeq_epi16(v, _mm_set1_epi16(u'\t'))));
+  return _mm_movemask_epi8(ws);
+}
+
+/// \return a mask with two bits set for each of the kLanes code units at \p p
+/// for which isJSONStringSpecial() is true, starting with the lowest bits.
+static uint32_t stringSpecialMask(const char16_t *p) {
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  // Saturating subtraction leaves zero exactly for the control characters.
+  __m128i control = _mm_cmpeq_epi16(
+      _mm_subs_epu16(v, _mm_set1_epi16(0x1F)), _mm_setzero_si128());
+  __m128i special = _mm_or_si128(
+      _mm_or_si128(
+          _mm_cmpeq_epi16(v, _mm_set1_epi16(u'"')),
+          _mm_cmpeq_epi16(v, _mm_set1_epi16(u'\\'))),
+      control);
+  return _mm_movemask_epi8(special);
+}
+
+/// Number of mask bits for each code unit.
+static constexpr unsigned kBitsPerLane = 2;
+
+/// The mask with all lanes set.
+static constexpr uint64_t kAllLanes = 0xFFFF;
+
+#elif defined(HERMES_JSONLEXER_NEON)
+
+static constexpr size_t kLanes = 8;
+
+/// Narrow the all-ones or all-zeros lanes of \p v to a 64 bit mask with four
+/// bits for each lane.
+static uint64_t laneMask(uint16x8_t v) {
+  return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(v, 4)), 0);
+}
+
+static uint64_t whiteSpaceMask(const char16_t *p) {
+  uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t *>(p));
+  uint16x8_t ws = vorrq_u16(
+      vorrq_u16(
+          vceqq_u16(v, vdupq_n_u16(u' ')), vceqq_u16(v, vdupq_n_u16(u'\n'))),
+      vorrq_u16(
+          vceqq_u16(v, vdupq_n_u16(u'\r')), vceqq_u16(v, vdupq_n_u16(u'\t'))));
+  return laneMask(ws);
+}
+
+static uint64_t stringSpecialMask(const char16_t *p) {
+  uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t *>(p));
+  uint16x8_t special = vorrq_u16(
+      vorrq_u16(
+          vceqq_u16(v, vdupq_n_u16(u'"')), vceqq_u16(v, vdupq_n_u16(u'\\'))),
+      vcltq_u16(v, vdupq_n_u16(0x20)));
+  return laneMask(special);
+}
+
+static constexpr unsigned kBitsPerLane = 4;
+static constexpr uint64_t kAllLanes = ~uint64_t(0);
+
+#endif
+
+/// \return the number of JSON whitespace code units at the start of \p chars.
+static size_t whiteSpacePrefixLength(llvh::ArrayRef<char16_t> chars) {
+  // Most runs of whitespace are short, so check the first one on its own.
+  if (!isJSONWhiteSpace(chars.front()))
+    return 0;
+  size_t i = 1;
+#if defined(HERMES_JSONLEXER_SSE2) || defined(HERMES_JSONLEXER_NEON)
+  for (; i + kLanes <= chars.size(); i += kLanes) {
+    uint64_t other = whiteSpaceMask(chars.data() + i) ^ kAllLanes;
+    if (other)
+      return i + llvh::countTrailingZeros(other) / kBitsPerLane;
+  }
+#endif
+  while (i < chars.size() && isJSONWhiteSpace(chars[i]))
+    ++i;
+  return i;
+}
+
+/// \return the number of code units at the start of \p chars which are copied
+/// as is into a JSON string, up to the first quote, backslash or control
+/// character.
+static size_t plainStringPrefixLength(llvh::ArrayRef<char16_t> chars) {
+  size_t i = 0;
+#if defined(HERMES_JSONLEXER_SSE2) || defined(HERMES_JSONLEXER_NEON)
+  for (; i + kLanes <= chars.size(); i += kLanes) {
+    uint64_t special = stringSpecialMask(chars.data() + i);
+    if (special)
+      return i + llvh::countTrailingZeros(special) / kBitsPerLane;
+  }
+#endif
+  while (i < chars.size() && !isJSONStringSpecial(chars[i]))
+    ++i;
+  return i;
+}
+
 ExecutionStatus JSONLexer::advance() {
   // Skip whitespaces.
-  while (curCharPtr_.hasChar() && isJSONWhiteSpace(*curCharPtr_)) {
-    ++curCharPtr_;
+  while (curCharPtr_.hasChar()) {
+    llvh::ArrayRef<char16_t> chars = curCharPtr_.available();
+    size_t count = whiteSpacePrefixLength(chars);
+    curCharPtr_.skip(count);
+    if (count < chars.size())
+      break;
   }
 
   // End of buffer.
@@ -94,7 +223,61 @@ CallResult<char16_t> JSONLexer::consumeUnicode() {
   return static_cast<char16_t>(val);
 }
 
+bool JSONLexer::scanSimpleNumber() {
+  // Powers of ten which are exactly representable as doubles.
+  static constexpr double kPowersOf10[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+      1e13, 1e14, 1e15};
+  // Numbers with at most this many digits fit exactly in a double.
+  constexpr size_t kMaxDigits = 15;
+
+  llvh::ArrayRef<char16_t> chars = curCharPtr_.available();
+  const char16_t *p = chars.begin();
+  const char16_t *end = chars.end();
+  auto isDigit = [](char16_t ch) { return ch >= u'0' && ch <= u'9'; };
+
+  bool negative = *p == u'-';
+  if (negative)
+    ++p;
+  // Stop accumulating after one digit too many, so that the mantissa can't
+  // overflow.
+  const char16_t *intStart = p;
+  uint64_t mantissa = 0;
+  size_t numDigits = 0;
+  for (; p != end && isDigit(*p) && numDigits <= kMaxDigits; ++p, ++numDigits)
+    mantissa = mantissa * 10 + (*p - u'0');
+  // Leave malformed numbers to the general path, which reports the error.
+  if (numDigits == 0 || (numDigits > 1 && *intStart == u'0'))
+    return false;
+
+  size_t fracDigits = 0;
+  if (p != end && *p == u'.') {
+    ++p;
+    for (; p != end && isDigit(*p) && numDigits <= kMaxDigits;
+         ++p, ++numDigits, ++fracDigits)
+      mantissa = mantissa * 10 + (*p - u'0');
+    if (fracDigits == 0)
+      return false;
+  }
+
+  // Too many digits, an exponent, a malformed number, or a number which
+  // continues past the converted input.
+  if (numDigits > kMaxDigits || p == end || isDigit(*p) ||
+      *p == u'.' || (*p | 32) == u'e' || *p == u'-' || *p == u'+')
+    return false;
+
+  // Both the mantissa and the power of ten are exact, so a single division is
+  // correctly rounded.
+  double value = static_cast<double>(mantissa) / kPowersOf10[fracDigits];
+  token_.setNumber(negative ? -value : value);
+  curCharPtr_.skip(p - chars.begin());
+  return true;
+}
+
 ExecutionStatus JSONLexer::scanNumber() {
+  if (scanSimpleNumber())
+    return ExecutionStatus::RETURNED;
+
   llvh::SmallVector<char, 32> str8;
   while (curCharPtr_.hasChar()) {
     auto ch = *curCharPtr_;
@@ -130,6 +313,14 @@ ExecutionStatus JSONLexer::scanString() {
   SmallU16String<32> tmpStorage;
 
   while (curCharPtr_.hasChar()) {
+    // Copy the characters which need no processing in bulk.
+    llvh::ArrayRef<char16_t> chars = curCharPtr_.available();
+    size_t count = plainStringPrefixLength(chars);
+    tmpStorage.append(chars.begin(), chars.begin() + count);
+    curCharPtr_.skip(count);
+    if (count == chars.size())
+      continue;
+
     if (*curCharPtr_ == '"') {
       // End of string.
       ++curCharPtr_;
@@ -142,6 +142,12 @@ class JSONLexer {
   /// Parse a JSONNumber.
   LLVM_NODISCARD ExecutionStatus scanNumber();
 
+  /// Parse a JSONNumber without an exponent and with at most 15 digits, which
+  /// can be converted exactly without strtod, if it is entirely available in
+  /// curCharPtr_.
+  /// \return whether the number was parsed. If not, nothing was consumed.
+  bool scanSimpleNumber();
+
   /// Parse a JSONString.
   LLVM_NODISCARD ExecutionStatus scanString();
 
@@ -187,7 +187,10 @@ mapPrototypeClear(void *, Runtime &runtime, NativeArgs args) {
     return runtime.raiseTypeError(
         "Non-Map object called on Map.prototype.clear");
   }
-  JSMap::clear(selfHandle, runtime);
+  if (LLVM_UNLIKELY(
+          JSMap::clear(selfHandle, runtime) == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
   return HermesValue::encodeUndefinedValue();
 }
 
@@ -280,7 +283,11 @@ mapPrototypeSet(void *, Runtime &runtime, NativeArgs args) {
   auto key = keyHandle->isNumber() && keyHandle->getNumber() == 0
       ? HandleRootOwner::getZeroValue()
       : keyHandle;
-  JSMap::addValue(selfHandle, runtime, key, args.getArgHandle(1));
+  if (LLVM_UNLIKELY(
+          JSMap::addValue(selfHandle, runtime, key, args.getArgHandle(1)) ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
   return selfHandle.getHermesValue();
 }
 
@@ -412,13 +412,14 @@ static CallResult<Handle<JSRegExp>> regExpConstructorFastCopy(
   return Handle<JSRegExp>::vmcast(*newRegexpRes);
 }
 
-// ES6 21.2.5.2.2
-CallResult<Handle<JSArray>> directRegExpExec(
+/// The part of ES6 21.2.5.2.2 which runs the match and updates lastIndex,
+/// for callers which do not need the match array.
+/// \return the match, which is empty if there was none.
+static CallResult<RegExpMatch> regExpBuiltinMatch(
     Handle<JSRegExp> regexp,
     Runtime &runtime,
     Handle<StringPrimitive> S) {
-  MutableHandle<JSArray> A{runtime};
-  GCScope gcScope{runtime};
+  GCScopeMarkerRAII marker{runtime};
 
   // Let length be the number of code units in S.
   const uint32_t length = S->getStringLength();
@@ -486,7 +487,7 @@ CallResult<Handle<JSArray>> directRegExpExec(
         return ExecutionStatus::EXCEPTION;
       }
     }
-    return Runtime::makeNullHandle<JSArray>();
+    return RegExpMatch{};
   }
 
   // We have a match!
@@ -517,6 +518,24 @@ CallResult<Handle<JSArray>> directRegExpExec(
       return ExecutionStatus::EXCEPTION;
     }
   }
+  return matchResult;
+}
+
+// ES6 21.2.5.2.2
+CallResult<Handle<JSArray>> directRegExpExec(
+    Handle<JSRegExp> regexp,
+    Runtime &runtime,
+    Handle<StringPrimitive> S) {
+  MutableHandle<JSArray> A{runtime};
+  GCScope gcScope{runtime};
+
+  CallResult<RegExpMatch> matchResult =
+      regExpBuiltinMatch(regexp, runtime, S);
+  if (LLVM_UNLIKELY(matchResult == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  const RegExpMatch &match = *matchResult;
+  if (match.empty())
+    return Runtime::makeNullHandle<JSArray>();
 
   const auto dpf = DefinePropertyFlags::getDefaultNewPropertyFlags();
 
@@ -602,17 +621,19 @@ advanceStringIndex(const StringPrimitive *S, uint64_t index, bool unicode) {
   return index + 1;
 }
 
-/// ES6.0 21.2.5.2.1 Runtime Semantics: RegExpExec ( R, S )
-CallResult<HermesValue>
-regExpExec(Runtime &runtime, Handle<JSObject> R, Handle<StringPrimitive> S) {
-  // 3. Let exec be Get(R, "exec").
-  // 4. ReturnIfAbrupt(exec).
-  auto propRes = JSObject::getNamed_RJS(
-      R, runtime, Predefined::getSymbolID(Predefined::exec));
-  if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
-    return ExecutionStatus::EXCEPTION;
-  }
-  auto exec = runtime.makeHandle(std::move(propRes.getValue()));
+/// \return whether \p exec is the built-in RegExp.prototype.exec.
+static bool isBuiltinExec(HermesValue exec) {
+  auto *nf = dyn_vmcast<NativeFunction>(exec);
+  return nf && nf->getFunctionPtr() == regExpPrototypeExec;
+}
+
+/// Steps 5 to 7 of ES6.0 21.2.5.2.1 RegExpExec ( R, S ), where \p exec is the
+/// value of R.exec.
+static CallResult<HermesValue> regExpExecWith(
+    Runtime &runtime,
+    Handle<JSObject> R,
+    Handle<StringPrimitive> S,
+    Handle<> exec) {
   // 5. If IsCallable(exec) is true, then
   if (auto execCallable = Handle<Callable>::dyn_vmcast(exec)) {
     // a. Let result be Call(exec, R, «S»).
@@ -644,6 +665,20 @@ regExpExec(Runtime &runtime, Handle<JSObject> R, Handle<StringPrimitive> S) {
   return regExpBuiltinExec(runtime, regExpObj, S);
 }
 
+/// ES6.0 21.2.5.2.1 Runtime Semantics: RegExpExec ( R, S )
+CallResult<HermesValue>
+regExpExec(Runtime &runtime, Handle<JSObject> R, Handle<StringPrimitive> S) {
+  // 3. Let exec be Get(R, "exec").
+  // 4. ReturnIfAbrupt(exec).
+  auto propRes = JSObject::getNamed_RJS(
+      R, runtime, Predefined::getSymbolID(Predefined::exec));
+  if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto exec = runtime.makeHandle(std::move(propRes.getValue()));
+  return regExpExecWith(runtime, R, S, exec);
+}
+
 /// Implementation of RegExp.prototype.exec
 /// Returns an Array if a match is found, null if no match is found
 CallResult<HermesValue>
@@ -674,16 +709,24 @@ regExpPrototypeExec(void *, Runtime &runtime, NativeArgs args) {
 
 /// Implementation of RegExp.prototype.test
 /// Returns true if a match is found, false otherwise
-/// TODO optimization: avoid constructing the submatch array. Instead simply
-/// check for a match.
 CallResult<HermesValue>
-regExpPrototypeTest(void *context, Runtime &runtime, NativeArgs args) {
-  CallResult<HermesValue> res = regExpPrototypeExec(context, runtime, args);
-  if (res == ExecutionStatus::EXCEPTION)
-    return ExecutionStatus::EXCEPTION;
+regExpPrototypeTest(void *, Runtime &runtime, NativeArgs args) {
+  Handle<JSRegExp> regexp = args.dyncastThis<JSRegExp>();
+  if (!regexp) {
+    return runtime.raiseTypeError(
+        "RegExp function called on non-RegExp object");
+  }
 
-  return HermesValue::encodeBoolValue(
-      !runtime.makeHandle(res.getValue())->isNull());
+  auto strRes = toString_RJS(runtime, args.getArgHandle(0));
+  if (strRes == ExecutionStatus::EXCEPTION) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  Handle<StringPrimitive> S = runtime.makeHandle(std::move(*strRes));
+  // Only whether there is a match matters, so don't build the match array.
+  CallResult<RegExpMatch> matchRes = regExpBuiltinMatch(regexp, runtime, S);
+  if (LLVM_UNLIKELY(matchRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return HermesValue::encodeBoolValue(!matchRes->empty());
 }
 
 /// Return the ith capture group in the most recent succesful RegExp search.
@@ -1303,7 +1346,33 @@ regExpPrototypeSymbolSearch(void *, Runtime &runtime, NativeArgs args) {
   }
   // 9. Let result be RegExpExec(rx, S).
   // 10. ReturnIfAbrupt(result).
-  auto execRes = regExpExec(runtime, rx, S);
+  auto execPropRes = JSObject::getNamed_RJS(
+      rx, runtime, Predefined::getSymbolID(Predefined::exec));
+  if (LLVM_UNLIKELY(execPropRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto exec = runtime.makeHandle(std::move(*execPropRes));
+  auto regexp = Handle<JSRegExp>::dyn_vmcast(rx);
+  if (regexp && isBuiltinExec(*exec)) {
+    // The built-in exec is used, and only the index of the match is needed,
+    // so don't build the match array.
+    CallResult<RegExpMatch> matchRes = regExpBuiltinMatch(regexp, runtime, S);
+    if (LLVM_UNLIKELY(matchRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    auto previousLastIndexSHV =
+        SmallHermesValue::encodeHermesValue(*previousLastIndex, runtime);
+    if (LLVM_UNLIKELY(
+            setLastIndex(rx, runtime, previousLastIndexSHV) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    if (matchRes->empty()) {
+      return HermesValue::encodeNumberValue(-1);
+    }
+    return HermesValue::encodeNumberValue(matchRes->front()->location);
+  }
+  auto execRes = regExpExecWith(runtime, rx, S, exec);
   if (LLVM_UNLIKELY(execRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
@@ -10,6 +10,7 @@
 #include "Object.h"
 
 #include "hermes/Support/Compiler.h"
+#include "hermes/Support/Conversions.h"
 #include "hermes/Support/JSON.h"
 #include "hermes/Support/UTF16Stream.h"
 #include "hermes/VM/ArrayLike.h"
@@ -63,6 +64,36 @@ class RuntimeJSONParser {
   /// If it drops below 0 while parsing, raise a stack overflow.
   int32_t remainingDepth_{MAX_RECURSION_DEPTH};
 
+  /// Index of "no template" in templates_.
+  static constexpr uint32_t kNoTemplate = UINT32_MAX;
+
+  /// Maximum number of templates, to bound the memory used for documents
+  /// without repeated structure.
+  static constexpr uint32_t kMaxTemplates = 1024;
+
+  /// JSON documents often contain many objects with the same keys in the same
+  /// order, such as the elements of an array of records. A template remembers
+  /// the hidden class of the last object parsed at some position in the
+  /// document: the elements of an array, or the values of the i-th property of
+  /// the objects of another template. The next object parsed there is created
+  /// with that class, and its values are stored directly in their slots for as
+  /// long as its keys match, instead of looking up a class transition for every
+  /// property.
+  struct ObjectTemplate {
+    /// The keys of the hidden class, by slot. Empty if there is no class.
+    std::vector<SymbolID> keys;
+
+    /// The templates of the property values, by slot, or kNoTemplate.
+    std::vector<uint32_t> children;
+  };
+
+  /// All the templates. The root value is parsed with the first one.
+  std::vector<ObjectTemplate> templates_;
+
+  /// The hidden class of each template, at the same index as in templates_,
+  /// or undefined if there is none.
+  MutableHandle<ArrayStorage> templateClasses_;
+
  public:
   explicit RuntimeJSONParser(
       Runtime &runtime,
@@ -71,7 +102,8 @@ class RuntimeJSONParser {
       : runtime_(runtime),
         lexer_(runtime, std::move(jsonString)),
         reviver_(reviver),
-        tmpHandle_(runtime) {}
+        tmpHandle_(runtime),
+        templateClasses_(runtime) {}
 
   /// Parse JSON string through lexer_, create objects using runtime_.
   /// If errors occur, this function will return undefined, and the error
@@ -82,15 +114,41 @@ class RuntimeJSONParser {
   /// Parse a JSON value, starting from the current token.
   /// When this function is finished, the current token will be set
   /// to the next token after the current parsed value.
-  CallResult<HermesValue> parseValue();
+  /// Objects in the value are parsed with the template \p tmpl.
+  CallResult<HermesValue> parseValue(uint32_t tmpl);
 
   /// Parse a JSON array, starting from the "[" token.
   /// When this function is finished, the current token must be "]".
-  CallResult<HermesValue> parseArray();
+  /// Objects in the elements are parsed with the template \p tmpl.
+  CallResult<HermesValue> parseArray(uint32_t tmpl);
 
   /// Parse a JSON object, starting from the "{" token.
   /// When this function is finished, the current token must be "}".
-  CallResult<HermesValue> parseObject();
+  /// The object is parsed with the template \p tmpl, which is then updated
+  /// with its hidden class.
+  CallResult<HermesValue> parseObject(uint32_t tmpl);
+
+  /// Create a new template.
+  /// \return its index, or kNoTemplate if there are too many templates.
+  CallResult<uint32_t> newTemplate();
+
+  /// \return the template of the values of the property in slot \p slot of
+  /// the objects of template \p tmpl, creating it if needed.
+  CallResult<uint32_t> getChildTemplate(uint32_t tmpl, uint32_t slot);
+
+  /// Replace \p object, which was created with the hidden class of template
+  /// \p tmpl and has its first \p numProps slots set, with an equivalent
+  /// object with only those properties. This is needed when the keys of
+  /// \p object turn out not to match the template.
+  ExecutionStatus leaveTemplate(
+      MutableHandle<JSObject> &object,
+      uint32_t tmpl,
+      uint32_t numProps);
+
+  /// Make the hidden class of \p object, which has \p numProps properties,
+  /// the hidden class of template \p tmpl, if it can be reused.
+  void
+  updateTemplate(uint32_t tmpl, Handle<JSObject> object, uint32_t numProps);
 
   /// Use reviver to filter the result.
   CallResult<HermesValue> revive(Handle<> value);
@@ -167,6 +225,27 @@ class JSONStringifyer {
   /// The output buffer. The serialization process will append into it.
   llvh::SmallVector<char16_t, 32> output_{};
 
+  /// The result of serializing a value on the fast path.
+  enum class FastResult {
+    /// The value was serialized.
+    Done,
+    /// The value serializes to undefined, and nothing was written.
+    Undefined,
+    /// The value may run JS code, such as a toJSON method or a getter, or
+    /// it has a layout the fast path does not handle.
+    Bail,
+    /// The value contains non-ASCII characters, which 8-bit output cannot
+    /// hold.
+    NonASCII,
+    /// An exception was raised.
+    Exception,
+  };
+
+  /// The enumerable properties of the objects being serialized on the fast
+  /// path, as (name, slot) pairs. Used as a stack: each object pushes its
+  /// properties and pops them once they are serialized.
+  std::vector<std::pair<SymbolID, SlotIndex>> fastProps_{};
+
  public:
   explicit JSONStringifyer(Runtime &runtime)
       : runtime_(runtime),
@@ -236,6 +315,33 @@ class JSONStringifyer {
   /// It serializes an object.
   ExecutionStatus operationJO();
 
+  /// \return whether stringify can take the fast path: there is no replacer
+  /// and no gap, and neither Object.prototype nor Array.prototype has a
+  /// toJSON property.
+  bool canUseFastPath();
+
+  /// Serialize \p value without the generic spec machinery, reading the
+  /// slots of plain objects and the elements of arrays directly, and without
+  /// running any JS code. Only used when canUseFastPath() holds.
+  /// \return the serialized string, undefined, or empty if \p value has to go
+  /// through the generic path.
+  CallResult<HermesValue> tryFastStringify(Handle<> value);
+
+  /// Append the serialization of \p value to \p out. If \p CharT is char,
+  /// fail with NonASCII on the first non-ASCII character.
+  template <typename CharT>
+  FastResult fastStr(HermesValue value, std::basic_string<CharT> &out);
+
+  /// Append the serialization of the plain object which is the current last
+  /// element in stackValue_ to \p out.
+  template <typename CharT>
+  FastResult fastJO(std::basic_string<CharT> &out);
+
+  /// Append the serialization of the array which is the current last element
+  /// in stackValue_ to \p out.
+  template <typename CharT>
+  FastResult fastJA(std::basic_string<CharT> &out);
+
   /// Append '\n' and indent to output_.
   /// The indent is constructed according to depthCount_.
   void indent();
@@ -262,7 +368,17 @@ CallResult<HermesValue> RuntimeJSONParser::parse() {
   if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto parRes = parseValue();
+  // Only objects use templates, so don't bother creating any for primitives.
+  uint32_t rootTemplate = kNoTemplate;
+  if (lexer_.getCurToken()->getKind() == JSONTokenKind::LBrace ||
+      lexer_.getCurToken()->getKind() == JSONTokenKind::LSquare) {
+    auto tmplRes = newTemplate();
+    if (LLVM_UNLIKELY(tmplRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    rootTemplate = *tmplRes;
+  }
+  auto parRes = parseValue(rootTemplate);
   if (LLVM_UNLIKELY(parRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
@@ -281,7 +397,7 @@ CallResult<HermesValue> RuntimeJSONParser::parse() {
   return parRes;
 }
 
-CallResult<HermesValue> RuntimeJSONParser::parseValue() {
+CallResult<HermesValue> RuntimeJSONParser::parseValue(uint32_t tmpl) {
   llvh::SaveAndRestore<decltype(remainingDepth_)> oldDepth{
       remainingDepth_, remainingDepth_ - 1};
   if (remainingDepth_ <= 0) {
@@ -298,7 +414,7 @@ CallResult<HermesValue> RuntimeJSONParser::parseValue() {
           HermesValue::encodeDoubleValue(lexer_.getCurToken()->getNumber());
       break;
     case JSONTokenKind::LBrace: {
-      auto parRes = parseObject();
+      auto parRes = parseObject(tmpl);
       if (LLVM_UNLIKELY(parRes == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
@@ -306,7 +422,7 @@ CallResult<HermesValue> RuntimeJSONParser::parseValue() {
       break;
     }
     case JSONTokenKind::LSquare: {
-      auto parRes = parseArray();
+      auto parRes = parseArray(tmpl);
       if (LLVM_UNLIKELY(parRes == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
@@ -338,7 +454,7 @@ CallResult<HermesValue> RuntimeJSONParser::parseValue() {
   return returnValue.getHermesValue();
 }
 
-CallResult<HermesValue> RuntimeJSONParser::parseArray() {
+CallResult<HermesValue> RuntimeJSONParser::parseArray(uint32_t tmpl) {
   assert(
       lexer_.getCurToken()->getKind() == JSONTokenKind::LSquare &&
       "Wrong entrance to parseArray");
@@ -359,7 +475,7 @@ CallResult<HermesValue> RuntimeJSONParser::parseArray() {
     for (uint32_t index = 0;; ++index) {
       gcScope.flushToMarker(marker);
 
-      auto parRes = parseValue();
+      auto parRes = parseValue(tmpl);
       if (LLVM_UNLIKELY(parRes == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
@@ -391,11 +507,26 @@ CallResult<HermesValue> RuntimeJSONParser::parseArray() {
   return array.getHermesValue();
 }
 
-CallResult<HermesValue> RuntimeJSONParser::parseObject() {
+CallResult<HermesValue> RuntimeJSONParser::parseObject(uint32_t tmpl) {
   assert(
       lexer_.getCurToken()->getKind() == JSONTokenKind::LBrace &&
       "Wrong entrance to parseObject");
-  auto object = runtime_.makeHandle(JSObject::create(runtime_));
+  // If the template has a hidden class, create the object with it, and store
+  // the values directly in their slots for as long as the keys match.
+  MutableHandle<JSObject> object{runtime_};
+  uint32_t numTemplateKeys = 0;
+  if (tmpl != kNoTemplate && !templates_[tmpl].keys.empty()) {
+    numTemplateKeys = templates_[tmpl].keys.size();
+    object = JSObject::create(
+                 runtime_,
+                 runtime_.makeHandle(
+                     vmcast<HiddenClass>(templateClasses_->at(tmpl))))
+                 .get();
+  } else {
+    object = JSObject::create(runtime_).get();
+  }
+  bool matchesTemplate = numTemplateKeys != 0;
+  uint32_t numProps = 0;
 
   if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
@@ -404,7 +535,7 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
     MutableHandle<StringPrimitive> key{runtime_};
     GCScope gcScope{runtime_};
     auto marker = gcScope.createMarker();
-    for (;;) {
+    for (;; ++numProps) {
       gcScope.flushToMarker(marker);
 
       if (LLVM_UNLIKELY(
@@ -425,17 +556,45 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
         return ExecutionStatus::EXCEPTION;
       }
 
-      auto parRes = parseValue();
+      if (matchesTemplate) {
+        // The lexer returns the string of the identifier when there is one,
+        // so a matching key is the very same string as the template key.
+        if (numProps >= numTemplateKeys ||
+            runtime_.getIdentifierTable().getStringPrim(
+                runtime_, templates_[tmpl].keys[numProps]) != key.get()) {
+          if (LLVM_UNLIKELY(
+                  leaveTemplate(object, tmpl, numProps) ==
+                  ExecutionStatus::EXCEPTION)) {
+            return ExecutionStatus::EXCEPTION;
+          }
+          matchesTemplate = false;
+        }
+      }
+
+      auto childRes = getChildTemplate(tmpl, numProps);
+      if (LLVM_UNLIKELY(childRes == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      auto parRes = parseValue(*childRes);
       if (LLVM_UNLIKELY(parRes == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
 
-      (void)JSObject::defineOwnComputedPrimitive(
-          object,
-          runtime_,
-          key,
-          DefinePropertyFlags::getDefaultNewPropertyFlags(),
-          runtime_.makeHandle(*parRes));
+      if (matchesTemplate) {
+        // Encode the value before reading object, since encoding may
+        // allocate.
+        auto shv = SmallHermesValue::encodeHermesValue(*parRes, runtime_);
+        // We made this object, it's not a Proxy.
+        JSObject::setNamedSlotValueUnsafe(
+            object.get(), runtime_, numProps, shv);
+      } else {
+        (void)JSObject::defineOwnComputedPrimitive(
+            object,
+            runtime_,
+            key,
+            DefinePropertyFlags::getDefaultNewPropertyFlags(),
+            runtime_.makeHandle(*parRes));
+      }
 
       if (lexer_.getCurToken()->getKind() == JSONTokenKind::Comma) {
         if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
@@ -443,6 +602,7 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
         }
         continue;
       } else if (lexer_.getCurToken()->getKind() == JSONTokenKind::RBrace) {
+        ++numProps;
         break;
       } else {
         return lexer_.error("Expect '}'");
@@ -453,9 +613,114 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
         "Unexpected stop for object parse");
   }
 
+  if (matchesTemplate && numProps != numTemplateKeys) {
+    // The object has fewer keys than the template.
+    if (LLVM_UNLIKELY(
+            leaveTemplate(object, tmpl, numProps) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    matchesTemplate = false;
+  }
+  if (!matchesTemplate && tmpl != kNoTemplate) {
+    updateTemplate(tmpl, object, numProps);
+  }
+
   return object.getHermesValue();
 }
 
+CallResult<uint32_t> RuntimeJSONParser::newTemplate() {
+  if (templates_.size() >= kMaxTemplates) {
+    return kNoTemplate;
+  }
+  if (!templateClasses_) {
+    auto arrRes = ArrayStorage::create(runtime_, 8);
+    if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    templateClasses_ = vmcast<ArrayStorage>(*arrRes);
+  }
+  if (LLVM_UNLIKELY(
+          ArrayStorage::push_back(
+              templateClasses_, runtime_, Runtime::getUndefinedValue()) ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  templates_.emplace_back();
+  return templates_.size() - 1;
+}
+
+CallResult<uint32_t> RuntimeJSONParser::getChildTemplate(
+    uint32_t tmpl,
+    uint32_t slot) {
+  if (tmpl == kNoTemplate) {
+    return kNoTemplate;
+  }
+  if (slot < templates_[tmpl].children.size() &&
+      templates_[tmpl].children[slot] != kNoTemplate) {
+    return templates_[tmpl].children[slot];
+  }
+  auto childRes = newTemplate();
+  if (LLVM_UNLIKELY(childRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  // newTemplate() may have reallocated templates_.
+  auto &children = templates_[tmpl].children;
+  if (slot >= children.size()) {
+    children.resize(slot + 1, kNoTemplate);
+  }
+  children[slot] = *childRes;
+  return *childRes;
+}
+
+ExecutionStatus RuntimeJSONParser::leaveTemplate(
+    MutableHandle<JSObject> &object,
+    uint32_t tmpl,
+    uint32_t numProps) {
+  auto newObject = runtime_.makeHandle(JSObject::create(runtime_));
+  MutableHandle<> value{runtime_};
+  GCScope gcScope{runtime_};
+  auto marker = gcScope.createMarker();
+  for (uint32_t slot = 0; slot < numProps; ++slot) {
+    gcScope.flushToMarker(marker);
+    value = JSObject::getNamedSlotValueUnsafe(object.get(), runtime_, slot)
+                .unboxToHV(runtime_);
+    if (LLVM_UNLIKELY(
+            JSObject::defineNewOwnProperty(
+                newObject,
+                runtime_,
+                templates_[tmpl].keys[slot],
+                PropertyFlags::defaultNewNamedPropertyFlags(),
+                value) == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+  }
+  object = newObject.get();
+  return ExecutionStatus::RETURNED;
+}
+
+void RuntimeJSONParser::updateTemplate(
+    uint32_t tmpl,
+    Handle<JSObject> object,
+    uint32_t numProps) {
+  HiddenClass *clazz = object->getClass(runtime_);
+  // Dictionary classes are not shared between objects, and with duplicate keys
+  // the object has fewer properties than keys.
+  if (clazz->isDictionary() || clazz->getNumProperties() != numProps ||
+      numProps == 0) {
+    return;
+  }
+  auto &keys = templates_[tmpl].keys;
+  keys.assign(numProps, SymbolID{});
+  HiddenClass::forEachPropertyNoAlloc(
+      clazz, runtime_, [&keys](SymbolID id, NamedPropertyDescriptor desc) {
+        assert(desc.slot < keys.size() && "Unexpected slot in JSON object");
+        keys[desc.slot] = id;
+      });
+  templateClasses_->set(
+      tmpl, HermesValue::encodeObjectValue(clazz), runtime_.getHeap());
+}
+
 CallResult<HermesValue> RuntimeJSONParser::revive(Handle<> value) {
   auto root = runtime_.makeHandle(JSObject::create(runtime_));
   auto status = JSObject::defineOwnProperty(
@@ -572,19 +837,37 @@ CallResult<HermesValue> runtimeJSONParse(
     Runtime &runtime,
     Handle<StringPrimitive> jsonString,
     Handle<Callable> reviver) {
-  // Our parser requires UTF16 data that does not move during GCs, so
-  // in most cases we'll need to copy, except for external 16-bit strings.
-  UTF16Ref ref;
-  SmallU16String<32> storage;
-  if (LLVM_UNLIKELY(jsonString->isExternal() && !jsonString->isASCII())) {
-    ref = jsonString->getStringRef<char16_t>();
-  } else {
-    StringPrimitive::createStringView(runtime, jsonString)
-        .appendUTF16String(storage);
-    ref = storage;
+  // Our parser requires data that does not move during GCs, so in most cases
+  // we'll need to copy, except for external strings.
+  // ASCII is valid UTF8, so long ASCII strings are copied as they are, and the
+  // stream converts them to UTF16 a chunk at a time. That takes half the memory
+  // of converting them upfront, and each chunk is still in cache when lexed.
+  if (LLVM_UNLIKELY(jsonString->isExternal())) {
+    if (jsonString->isASCII()) {
+      ASCIIRef ref = jsonString->getStringRef<char>();
+      RuntimeJSONParser parser{
+          runtime,
+          UTF16Stream(llvh::ArrayRef<uint8_t>(
+              reinterpret_cast<const uint8_t *>(ref.data()), ref.size())),
+          reviver};
+      return parser.parse();
+    }
+    RuntimeJSONParser parser{
+        runtime, UTF16Stream(jsonString->getStringRef<char16_t>()), reviver};
+    return parser.parse();
   }
 
-  RuntimeJSONParser parser{runtime, UTF16Stream(ref), reviver};
+  auto view = StringPrimitive::createStringView(runtime, jsonString);
+  constexpr uint32_t kMinChunkedLength = 4096;
+  if (view.isASCII() && view.length() >= kMinChunkedLength) {
+    std::vector<uint8_t> storage(
+        view.castToCharPtr(), view.castToCharPtr() + view.length());
+    RuntimeJSONParser parser{runtime, UTF16Stream(storage), reviver};
+    return parser.parse();
+  }
+  SmallU16String<32> storage;
+  view.appendUTF16String(storage);
+  RuntimeJSONParser parser{runtime, UTF16Stream(storage.arrayRef()), reviver};
   return parser.parse();
 }
 
@@ -1079,6 +1362,317 @@ ExecutionStatus JSONStringifyer::operationJO() {
   return ExecutionStatus::RETURNED;
 }
 
+/// Append the string \p str, quoted as by operationQuote, to \p out. Runs of
+/// characters which need no escaping are appended in bulk.
+/// \return false, leaving \p out partially written, if \p OutT is char and
+///   \p str has a non-ASCII character.
+template <typename OutT, typename InT>
+static bool appendQuotedForJSON(
+    std::basic_string<OutT> &out,
+    llvh::ArrayRef<InT> str) {
+  // 8-bit strings are ASCII, so only UTF-16 strings can fail to fit in 8-bit
+  // output.
+  constexpr bool checkASCII = sizeof(OutT) < sizeof(InT);
+  out.push_back('"');
+  const InT *cur = str.begin();
+  const InT *end = str.end();
+  while (cur != end) {
+    const InT *run = cur;
+    while (cur != end && !needsEscapeForJSON(*cur) &&
+           (!checkASCII || *cur < 0x80)) {
+      ++cur;
+    }
+    out.append(run, cur);
+    if (cur == end)
+      break;
+    if (checkASCII && *cur >= 0x80)
+      return false;
+    escapeCharForJSON(out, *cur++);
+  }
+  out.push_back('"');
+  return true;
+}
+
+/// Append the ASCII string literal \p lit to \p out.
+template <typename CharT, size_t N>
+static void appendLiteral(std::basic_string<CharT> &out, const char (&lit)[N]) {
+  out.append(lit, lit + N - 1);
+}
+
+/// Append ToString(\p num) of the finite number \p num to \p out.
+template <typename CharT>
+static void appendNumberForJSON(std::basic_string<CharT> &out, double num) {
+  char buf[NUMBER_TO_STRING_BUF_SIZE];
+  char *end = buf + sizeof(buf);
+  // Integers are the common case, and don't need dtoa. -0 prints as "0", as
+  // ToString requires.
+  if (num >= INT32_MIN && num <= INT32_MAX && num == (int32_t)num) {
+    int32_t ival = (int32_t)num;
+    uint32_t uval = ival < 0 ? 0u - (uint32_t)ival : (uint32_t)ival;
+    char *begin = end;
+    do {
+      *--begin = '0' + uval % 10;
+      uval /= 10;
+    } while (uval);
+    if (ival < 0)
+      *--begin = '-';
+    out.append(begin, end);
+    return;
+  }
+  size_t len = numberToString(num, buf, sizeof(buf));
+  out.append(buf, buf + len);
+}
+
+/// \return a first estimate of the length of the serialization of \p value,
+/// used to size the output buffer of the fast path.
+static size_t estimateJSONLength(Runtime &runtime, HermesValue value) {
+  // Past this, the buffer grows as it is written.
+  constexpr size_t kMaxEstimate = 1 << 20;
+  size_t estimate = 16;
+  if (value.isString()) {
+    estimate = value.getString()->getStringLength() + 2;
+  } else if (auto *arr = dyn_vmcast<JSArray>(value)) {
+    estimate = (size_t)JSArray::getLength(arr, runtime) * 8 + 2;
+  } else if (auto *obj = dyn_vmcast<JSObject>(value)) {
+    estimate = (size_t)obj->getClass(runtime)->getNumProperties() * 16 + 2;
+  }
+  return std::min(estimate, kMaxEstimate);
+}
+
+bool JSONStringifyer::canUseFastPath() {
+  if (replacerFunction_ || propertyList_ || gap_.get()) {
+    return false;
+  }
+  // The fast path only accepts objects and arrays inheriting directly from
+  // these prototypes, so they are the only places an inherited toJSON can
+  // come from.
+  NamedPropertyDescriptor desc;
+  return !JSObject::getNamedDescriptorPredefined(
+             Handle<JSObject>::vmcast(&runtime_.objectPrototype),
+             runtime_,
+             Predefined::toJSON,
+             desc) &&
+      !JSObject::getNamedDescriptorPredefined(
+             Handle<JSObject>::vmcast(&runtime_.arrayPrototype),
+             runtime_,
+             Predefined::toJSON,
+             desc);
+}
+
+CallResult<HermesValue> JSONStringifyer::tryFastStringify(Handle<> value) {
+  // Most output is ASCII, so first try writing an 8-bit string, which is also
+  // half the size.
+  std::string ascii;
+  ascii.reserve(estimateJSONLength(runtime_, *value));
+  FastResult res = fastStr(*value, ascii);
+  if (res == FastResult::NonASCII) {
+    std::u16string utf16;
+    // The 8-bit attempt stopped at the first non-ASCII character, so its
+    // capacity is a better estimate than the first one.
+    utf16.reserve(ascii.capacity());
+    ascii = std::string();
+    res = fastStr(*value, utf16);
+    if (res == FastResult::Done) {
+      return StringPrimitive::createEfficient(runtime_, std::move(utf16));
+    }
+  }
+  switch (res) {
+    case FastResult::Done:
+      return StringPrimitive::createEfficient(runtime_, std::move(ascii));
+    case FastResult::Undefined:
+      return HermesValue::encodeUndefinedValue();
+    case FastResult::Exception:
+      return ExecutionStatus::EXCEPTION;
+    case FastResult::Bail:
+    case FastResult::NonASCII:
+      break;
+  }
+  return HermesValue::encodeEmptyValue();
+}
+
+template <typename CharT>
+JSONStringifyer::FastResult JSONStringifyer::fastStr(
+    HermesValue value,
+    std::basic_string<CharT> &out) {
+  if (value.isString()) {
+    // Reading the characters of a rope flattens it without allocating.
+    const StringPrimitive *str = value.getString();
+    bool fits = str->isASCII()
+        ? appendQuotedForJSON(out, str->getStringRef<char>())
+        : appendQuotedForJSON(out, str->getStringRef<char16_t>());
+    return fits ? FastResult::Done : FastResult::NonASCII;
+  }
+  if (value.isNumber()) {
+    if (std::isfinite(value.getNumber())) {
+      appendNumberForJSON(out, value.getNumber());
+    } else {
+      appendLiteral(out, "null");
+    }
+    return FastResult::Done;
+  }
+  if (value.isBool()) {
+    if (value.getBool()) {
+      appendLiteral(out, "true");
+    } else {
+      appendLiteral(out, "false");
+    }
+    return FastResult::Done;
+  }
+  if (value.isNull()) {
+    appendLiteral(out, "null");
+    return FastResult::Done;
+  }
+  if (value.isUndefined() || value.isSymbol()) {
+    return FastResult::Undefined;
+  }
+  // Only arrays and ordinary objects: functions may inherit a toJSON from
+  // Function.prototype, primitive wrappers are unboxed, and proxies and host
+  // objects run code on every access.
+  bool isArr = vmisa<JSArray>(value);
+  if (!isArr &&
+      !(vmisa<JSObject>(value) &&
+        vmcast<JSObject>(value)->getKind() == CellKind::JSObjectKind)) {
+    return FastResult::Bail;
+  }
+  // Cyclic structures end up here too, and the generic path reports them.
+  if (depthCount_ + 1 >= MAX_RECURSION_DEPTH) {
+    return FastResult::Bail;
+  }
+  // As in operationStr, keep the objects being serialized in stackValue_,
+  // so that no handles are held across the recursion.
+  tmpHandle_ = value;
+  if (LLVM_UNLIKELY(
+          PropStorage::push_back(stackValue_, runtime_, tmpHandle_) ==
+          ExecutionStatus::EXCEPTION)) {
+    return FastResult::Exception;
+  }
+  llvh::SaveAndRestore<uint32_t> depth{depthCount_, depthCount_ + 1};
+  FastResult res = isArr ? fastJA(out) : fastJO(out);
+  popValueFromStack();
+  return res;
+}
+
+template <typename CharT>
+JSONStringifyer::FastResult JSONStringifyer::fastJO(
+    std::basic_string<CharT> &out) {
+  GCScopeMarkerRAII marker{runtime_};
+  auto getObj = [this]() {
+    return vmcast<JSObject>(
+        stackValue_->at(stackValue_->size() - 1).getObject(runtime_));
+  };
+  JSObject *parent = getObj()->getParent(runtime_);
+  if (parent && parent != vmcast<JSObject>(runtime_.objectPrototype)) {
+    return FastResult::Bail;
+  }
+  // Index-like names are enumerated first, in numeric order.
+  if (getObj()->getClass(runtime_)->getHasIndexLikeProperties()) {
+    return FastResult::Bail;
+  }
+
+  // Collect the properties before serializing any value, since that may
+  // allocate and change the property map of this class.
+  const SymbolID toJSON = Predefined::getSymbolID(Predefined::toJSON);
+  const size_t begin = fastProps_.size();
+  bool plain = HiddenClass::forEachPropertyWhile(
+      runtime_.makeHandle(getObj()->getClass(runtime_)),
+      runtime_,
+      [this, toJSON](Runtime &, SymbolID id, NamedPropertyDescriptor desc) {
+        if (id == toJSON) {
+          return false;
+        }
+        if (!isPropertyNamePrimitive(id) || !desc.flags.enumerable) {
+          return true;
+        }
+        if (desc.flags.accessor || desc.flags.hostObject ||
+            desc.flags.proxyObject) {
+          return false;
+        }
+        fastProps_.emplace_back(id, desc.slot);
+        return true;
+      });
+  marker.flush();
+
+  FastResult res = plain ? FastResult::Done : FastResult::Bail;
+  bool hasElement = false;
+  out.push_back('{');
+  for (size_t i = begin, e = fastProps_.size();
+       res == FastResult::Done && i < e;
+       ++i) {
+    // As in operationJO, roll back properties serializing to undefined.
+    size_t savedSize = out.size();
+    if (hasElement) {
+      out.push_back(',');
+    }
+    StringView name = runtime_.getIdentifierTable().getStringView(
+        runtime_, fastProps_[i].first);
+    bool fits = name.isASCII()
+        ? appendQuotedForJSON(
+              out, llvh::makeArrayRef(name.castToCharPtr(), name.length()))
+        : appendQuotedForJSON(
+              out, llvh::makeArrayRef(name.castToChar16Ptr(), name.length()));
+    if (!fits) {
+      res = FastResult::NonASCII;
+      break;
+    }
+    out.push_back(':');
+    // Flush just before the recursion.
+    marker.flush();
+    res = fastStr(
+        JSObject::getNamedSlotValueUnsafe(
+            getObj(), runtime_, fastProps_[i].second)
+            .unboxToHV(runtime_),
+        out);
+    if (res == FastResult::Undefined) {
+      out.resize(savedSize);
+      res = FastResult::Done;
+    } else if (res == FastResult::Done) {
+      hasElement = true;
+    }
+  }
+  fastProps_.resize(begin);
+  out.push_back('}');
+  return res;
+}
+
+template <typename CharT>
+JSONStringifyer::FastResult JSONStringifyer::fastJA(
+    std::basic_string<CharT> &out) {
+  auto getArr = [this]() {
+    return vmcast<JSArray>(
+        stackValue_->at(stackValue_->size() - 1).getObject(runtime_));
+  };
+  // Arrays with the initial class have no named properties besides length,
+  // and so no own toJSON.
+  if (getArr()->getClass(runtime_) !=
+          vmcast<HiddenClass>(runtime_.arrayClass) ||
+      getArr()->getParent(runtime_) !=
+          vmcast<JSObject>(runtime_.arrayPrototype) ||
+      !getArr()->hasFastIndexProperties()) {
+    return FastResult::Bail;
+  }
+
+  out.push_back('[');
+  for (uint32_t i = 0, len = JSArray::getLength(getArr(), runtime_); i < len;
+       ++i) {
+    if (i > 0) {
+      out.push_back(',');
+    }
+    SmallHermesValue elem = getArr()->at(runtime_, i);
+    // Holes are looked up on the prototype chain.
+    if (elem.isEmpty()) {
+      return FastResult::Bail;
+    }
+    FastResult res = fastStr(elem.unboxToHV(runtime_), out);
+    if (res == FastResult::Undefined) {
+      appendLiteral(out, "null");
+    } else if (res != FastResult::Done) {
+      return res;
+    }
+  }
+  out.push_back(']');
+  return FastResult::Done;
+}
+
 void JSONStringifyer::indent() {
   if (gap_.get()) {
     output_.push_back(u'\n');
@@ -1120,6 +1714,16 @@ void JSONStringifyer::appendToOutput(const StringPrimitive *str) {
 
 CallResult<HermesValue> JSONStringifyer::stringify(Handle<> value) {
   // All previous steps have been covered by the constructor.
+  if (canUseFastPath()) {
+    auto fastRes = tryFastStringify(value);
+    if (LLVM_UNLIKELY(fastRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    if (!fastRes->isEmpty()) {
+      return fastRes;
+    }
+  }
+
   // Clear the output buffer.
   output_.clear();
 
@@ -215,7 +215,11 @@ setPrototypeAdd(void *, Runtime &runtime, NativeArgs args) {
   auto value = valueHandle->isNumber() && valueHandle->getNumber() == 0
       ? HandleRootOwner::getZeroValue()
       : valueHandle;
-  JSSet::addValue(selfHandle, runtime, value, value);
+  if (LLVM_UNLIKELY(
+          JSSet::addValue(selfHandle, runtime, value, value) ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
   return selfHandle.getHermesValue();
 }
 
@@ -226,7 +230,10 @@ setPrototypeClear(void *, Runtime &runtime, NativeArgs args) {
     return runtime.raiseTypeError(
         "Non-Set object called on Set.prototype.clear");
   }
-  JSSet::clear(selfHandle, runtime);
+  if (LLVM_UNLIKELY(
+          JSSet::clear(selfHandle, runtime) == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
   return HermesValue::encodeUndefinedValue();
 }
 
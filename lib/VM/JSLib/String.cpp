@@ -1450,8 +1450,6 @@ static CallResult<HermesValue> stringDirectedIndexOf(
   // Let start be min(max(pos, 0), len).
   uint32_t start = static_cast<uint32_t>(std::min(std::max(pos, 0.), len));
 
-  // TODO: good candidate for Boyer-Moore on large needles/haystacks
-  // TODO: good candidate for memchr on length-1 needles
   auto SView = StringPrimitive::createStringView(runtime, S);
   auto searchStrView = StringPrimitive::createStringView(runtime, searchStr);
   double ret = -1;
@@ -1469,13 +1467,8 @@ static CallResult<HermesValue> stringDirectedIndexOf(
     }
   } else {
     // indexOf
-    auto foundIter = std::search(
-        SView.begin() + start,
-        SView.end(),
-        searchStrView.begin(),
-        searchStrView.end());
-    if (foundIter != SView.end() || searchStrView.empty()) {
-      ret = foundIter - SView.begin();
+    if (auto found = SView.find(searchStrView, start)) {
+      ret = *found;
     }
   }
   return HermesValue::encodeDoubleValue(ret);
@@ -1953,11 +1946,10 @@ stringPrototypeReplace(void *, Runtime &runtime, NativeArgs args) {
   auto strView = StringPrimitive::createStringView(runtime, string);
   if (!strView.empty()) {
     auto searchView = StringPrimitive::createStringView(runtime, searchString);
-    auto searchResult = std::search(
-        strView.begin(), strView.end(), searchView.begin(), searchView.end());
+    auto searchResult = strView.find(searchView);
 
-    if (searchResult != strView.end()) {
-      pos = searchResult - strView.begin();
+    if (searchResult) {
+      pos = *searchResult;
     } else {
       return string.getHermesValue();
     }
@@ -2254,12 +2246,10 @@ static OptValue<uint32_t> splitMatch(
   auto SStr = StringPrimitive::createStringView(runtime, S);
   auto RStr = StringPrimitive::createStringView(runtime, R);
 
-  auto sliced = SStr.slice(q);
-  auto searchResult =
-      std::search(sliced.begin(), sliced.end(), RStr.begin(), RStr.end());
+  auto searchResult = SStr.find(RStr, q);
 
-  if (searchResult != sliced.end()) {
-    return q + (searchResult - sliced.begin()) + r;
+  if (searchResult) {
+    return *searchResult + r;
   }
   return llvh::None;
 }
@@ -2565,15 +2555,8 @@ CallResult<HermesValue> stringPrototypeIncludesOrStartsWith(
   // k, return false.
   auto SView = StringPrimitive::createStringView(runtime, S);
   auto searchStrView = StringPrimitive::createStringView(runtime, searchStr);
-  auto foundIter = std::search(
-      SView.begin() + start,
-      SView.end(),
-      searchStrView.begin(),
-      searchStrView.end());
-  // Note: searchStrView.empty check is needed in the special case that S is
-  // empty, searchStr is empty, and start = 0
   return HermesValue::encodeBoolValue(
-      foundIter != SView.end() || searchStrView.empty());
+      SView.find(searchStrView, static_cast<uint32_t>(start)).hasValue());
 }
 
 CallResult<HermesValue>
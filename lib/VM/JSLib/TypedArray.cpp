@@ -334,10 +334,9 @@ CallResult<HermesValue> mapFilterLoop(
   return HermesValue::encodeNumberValue(insert);
 }
 
-/// This is the sort model for use with TypedArray.prototype.sort.
-/// template param \p WithCompareFn should be true if the compare function is
-/// a valid callback to call, and false if it is null or undefined.
-template <bool WithCompareFn>
+/// This is the sort model for use with TypedArray.prototype.sort when a
+/// compare function is passed. Without one, the elements are sorted natively
+/// by sortTypedArrayData().
 class TypedArraySortModel : public SortModel {
  protected:
   /// Runtime to sort in.
@@ -347,7 +346,6 @@ class TypedArraySortModel : public SortModel {
   GCScope gcScope_;
 
   /// JS comparison function, return -1 for less, 0 for equal, 1 for greater.
-  /// If null, then use the built in < operator.
   Handle<Callable> compareFn_;
 
   /// Object to sort.
@@ -371,7 +369,9 @@ class TypedArraySortModel : public SortModel {
         self_(obj),
         aHandle_(runtime),
         bHandle_(runtime),
-        gcMarker_(gcScope_.createMarker()) {}
+        gcMarker_(gcScope_.createMarker()) {
+    assert(compareFn_ && "Cannot use this model if the compareFn is null");
+  }
 
   // Swap elements at indices a and b.
   virtual ExecutionStatus swap(uint32_t a, uint32_t b) override {
@@ -393,17 +393,6 @@ class TypedArraySortModel : public SortModel {
     GCScopeMarkerRAII gcMarker{gcScope_, gcMarker_};
     HermesValue aVal = JSObject::getOwnIndexed(*self_, runtime_, a);
     HermesValue bVal = JSObject::getOwnIndexed(*self_, runtime_, b);
-    if (!WithCompareFn) {
-      double a = aVal.getNumber();
-      double b = bVal.getNumber();
-      if (LLVM_UNLIKELY(a == 0) && LLVM_UNLIKELY(b == 0) &&
-          LLVM_UNLIKELY(std::signbit(a)) && LLVM_UNLIKELY(!std::signbit(b))) {
-        // -0 < +0, according to the spec.
-        return -1;
-      }
-      return (a < b) ? -1 : (a > b ? 1 : 0);
-    }
-    assert(compareFn_ && "Cannot use this version if the compareFn is null");
     // ES7 22.2.3.26 2a.
     // Let v be toNumber_RJS(Call(comparefn, undefined, x, y)).
     auto callRes = Callable::executeCall2(
@@ -427,6 +416,58 @@ class TypedArraySortModel : public SortModel {
   }
 };
 
+/// Sort the elements of a typed array in [begin, end) in ascending numeric
+/// order, as done by TypedArray.prototype.sort without a compare function.
+/// Equal integers can't be told apart, so the sort doesn't need to be stable.
+/// 8-bit and 16-bit elements are sorted by counting them.
+template <typename T>
+void sortTypedArrayData(T *begin, T *end) {
+  static_assert(std::is_integral<T>::value, "floats are sorted separately");
+  size_t len = end - begin;
+  if (sizeof(T) > 2 || (sizeof(T) == 2 && len < (1u << 12))) {
+    std::sort(begin, end);
+    return;
+  }
+  using Unsigned = typename std::make_unsigned<T>::type;
+  constexpr size_t kNumValues = size_t(1) << (8 * sizeof(T));
+  // Offset the values so that the buckets are in ascending order of T.
+  constexpr Unsigned kBias = std::is_signed<T>::value ? kNumValues / 2 : 0;
+  std::vector<uint32_t> counts(kNumValues);
+  for (T *p = begin; p != end; ++p)
+    ++counts[static_cast<Unsigned>(static_cast<Unsigned>(*p) + kBias)];
+  T *dest = begin;
+  for (size_t bucket = 0; bucket != kNumValues; ++bucket) {
+    T value = static_cast<T>(static_cast<Unsigned>(bucket - kBias));
+    dest = std::fill_n(dest, counts[bucket], value);
+  }
+}
+
+/// Floating point elements are ordered numerically, with -0 before +0 and NaN
+/// after everything else (ES2023 23.2.4.7 CompareTypedArrayElements).
+template <typename T>
+void sortTypedArrayFloatData(T *begin, T *end) {
+  // Move the NaNs to the end, and sort the rest with the numeric order, in
+  // which -0 and +0 are equivalent.
+  T *numEnd = std::partition(begin, end, [](T x) { return !std::isnan(x); });
+  std::sort(begin, numEnd);
+  // All the zeros are now contiguous: put the negative ones first.
+  auto zeros = std::equal_range(begin, numEnd, T(0));
+  auto numNegative = std::count_if(
+      zeros.first, zeros.second, [](T x) { return std::signbit(x); });
+  std::fill(zeros.first, zeros.first + numNegative, T(-0.0));
+  std::fill(zeros.first + numNegative, zeros.second, T(0));
+}
+
+template <>
+void sortTypedArrayData<float>(float *begin, float *end) {
+  sortTypedArrayFloatData(begin, end);
+}
+
+template <>
+void sortTypedArrayData<double>(double *begin, double *end) {
+  sortTypedArrayFloatData(begin, end);
+}
+
 // ES7 22.2.3.23.1
 CallResult<HermesValue> typedArrayPrototypeSetObject(
     Runtime &runtime,
@@ -1382,18 +1423,28 @@ typedArrayPrototypeSort(void *, Runtime &runtime, NativeArgs args) {
     return runtime.raiseTypeError("TypedArray sort argument must be callable");
   }
 
-  // Use our custom sort routine. We can't use std::sort because it performs
-  // optimizations that allow it to bypass calls to std::swap, but our swap
-  // function is special, since it needs to use the internal Object functions.
-  if (compareFn) {
-    TypedArraySortModel<true> sm(runtime, self, compareFn);
-    if (LLVM_UNLIKELY(quickSort(&sm, 0, len) == ExecutionStatus::EXCEPTION))
-      return ExecutionStatus::EXCEPTION;
-  } else {
-    TypedArraySortModel<false> sm(runtime, self, compareFn);
-    if (LLVM_UNLIKELY(quickSort(&sm, 0, len) == ExecutionStatus::EXCEPTION))
-      return ExecutionStatus::EXCEPTION;
+  if (!compareFn) {
+    // Without a compare function, JS can't observe how the elements are
+    // sorted, so sort the underlying data directly.
+    switch (self->getKind()) {
+#define TYPED_ARRAY(name, type)                                               \
+  case CellKind::name##ArrayKind: {                                           \
+    auto *arr = vmcast<JSTypedArray<type, CellKind::name##ArrayKind>>(*self); \
+    sortTypedArrayData<type>(arr->begin(runtime), arr->end(runtime));         \
+    break;                                                                    \
+  }
+#include "hermes/VM/TypedArrays.def"
+      default:
+        llvm_unreachable("Invalid TypedArray kind");
+    }
+    return self.getHermesValue();
   }
+
+  // The compare function can run arbitrary code, so the elements are read and
+  // written through the model, which checks that the array is still attached.
+  TypedArraySortModel sm(runtime, self, compareFn);
+  if (LLVM_UNLIKELY(timSort(&sm, 0, len) == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
   return self.getHermesValue();
 }
 
@@ -1033,8 +1033,10 @@ CallResult<PseudoHandle<>> JSObject::getNamedWithReceiver_RJS(
   if (LLVM_LIKELY(
           !desc.flags.accessor && !desc.flags.hostObject &&
           !desc.flags.proxyObject)) {
-    // Populate the cache if requested.
-    if (cacheEntry && !propObj->getClass(runtime)->isDictionaryNoCache()) {
+    // Populate the cache if requested. Properties found on the prototype
+    // chain are cached separately by the interpreter.
+    if (cacheEntry && propObj == *selfHandle &&
+        !propObj->getClass(runtime)->isDictionaryNoCache()) {
       cacheEntry->clazz = propObj->getClassGCPtr();
       cacheEntry->slot = desc.slot;
     }
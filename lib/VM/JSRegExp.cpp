@@ -65,15 +65,10 @@ PseudoHandle<JSRegExp> JSRegExp::create(
   return JSObjectInit::initToPseudoHandle(runtime, cell);
 }
 
-void JSRegExp::initialize(
+void JSRegExp::initializeProperties(
     Handle<JSRegExp> selfHandle,
     Runtime &runtime,
-    Handle<StringPrimitive> pattern,
-    Handle<StringPrimitive> flags,
-    llvh::ArrayRef<uint8_t> bytecode) {
-  assert(
-      pattern && flags &&
-      "Null pattern and/or flags passed to JSRegExp::initialize");
+    Handle<StringPrimitive> pattern) {
   selfHandle->pattern_.set(runtime, *pattern, runtime.getHeap());
 
   DefinePropertyFlags dpf = DefinePropertyFlags::getDefaultNewPropertyFlags();
@@ -90,8 +85,38 @@ void JSRegExp::initialize(
   assert(
       res != ExecutionStatus::EXCEPTION && *res &&
       "defineOwnProperty() failed");
+}
+
+void JSRegExp::initialize(
+    Handle<JSRegExp> selfHandle,
+    Runtime &runtime,
+    Handle<StringPrimitive> pattern,
+    Handle<StringPrimitive> flags,
+    llvh::ArrayRef<uint8_t> bytecode) {
+  assert(
+      pattern && flags &&
+      "Null pattern and/or flags passed to JSRegExp::initialize");
+  llvh::SmallVector<char16_t, 16> patternText16;
+  pattern->appendUTF16String(patternText16);
+  auto header =
+      reinterpret_cast<const regex::RegexBytecodeHeader *>(bytecode.data());
+
+  // Share the bytecode of earlier RegExps with the same pattern and flags,
+  // instead of making another copy of it.
+  RegExpCache &cache = runtime.getRegExpCache();
+  auto &stats = runtime.getRuntimeStats();
+  SharedRegExpBytecode shared =
+      cache.lookup(patternText16, header->syntaxFlags);
+  if (shared) {
+    stats.regExpCacheHits++;
+  } else {
+    stats.regExpCacheMisses++;
+    shared = cache.create(bytecode);
+    cache.insert(patternText16, header->syntaxFlags, shared);
+  }
 
-  selfHandle->initializeBytecode(bytecode);
+  initializeProperties(selfHandle, runtime, pattern);
+  selfHandle->initializeBytecode(std::move(shared));
 }
 
 ExecutionStatus JSRegExp::initialize(
@@ -112,12 +137,8 @@ ExecutionStatus JSRegExp::initialize(
   // Fast path to avoid recompiling the RegExp if the flags match
   if (LLVM_LIKELY(
           sflags->toByte() == getSyntaxFlags(otherHandle.get()).toByte())) {
-    initialize(
-        selfHandle,
-        runtime,
-        pattern,
-        flags,
-        {otherHandle->bytecode_, otherHandle->bytecodeSize_});
+    initializeProperties(selfHandle, runtime, pattern);
+    selfHandle->initializeBytecode(otherHandle->bytecode_);
     return ExecutionStatus::RETURNED;
   }
   return initialize(selfHandle, runtime, pattern, flags);
@@ -138,6 +159,21 @@ ExecutionStatus JSRegExp::initialize(
   llvh::SmallVector<char16_t, 16> patternText16;
   pattern->appendUTF16String(patternText16);
 
+  // Reuse the bytecode of an earlier RegExp with the same pattern and flags.
+  // Invalid flags are never cached, and are reported by the parser below.
+  RegExpCache &cache = runtime.getRegExpCache();
+  auto &stats = runtime.getRuntimeStats();
+  auto sflags = regex::SyntaxFlags::fromString(flagsText16);
+  if (sflags) {
+    if (SharedRegExpBytecode shared =
+            cache.lookup(patternText16, sflags->toByte())) {
+      stats.regExpCacheHits++;
+      initializeProperties(selfHandle, runtime, pattern);
+      selfHandle->initializeBytecode(std::move(shared));
+      return ExecutionStatus::RETURNED;
+    }
+  }
+
   // Build the regex.
   regex::Regex<regex::UTF16RegexTraits> regex(patternText16, flagsText16);
 
@@ -146,23 +182,23 @@ ExecutionStatus JSRegExp::initialize(
         TwineChar16("Invalid RegExp: ") +
         regex::constants::messageForError(regex.getError()));
   }
-  // The regex is valid. Compile and store its bytecode.
-  auto bytecode = regex.compile();
-  initialize(selfHandle, runtime, pattern, flags, bytecode);
+  // The regex is valid. Compile, cache and store its bytecode.
+  stats.regExpCacheMisses++;
+  SharedRegExpBytecode shared = cache.create(regex.compile());
+  cache.insert(patternText16, sflags->toByte(), shared);
+  initializeProperties(selfHandle, runtime, pattern);
+  selfHandle->initializeBytecode(std::move(shared));
   return ExecutionStatus::RETURNED;
 }
 
-void JSRegExp::initializeBytecode(llvh::ArrayRef<uint8_t> bytecode) {
-  size_t sz = bytecode.size();
+void JSRegExp::initializeBytecode(SharedRegExpBytecode bytecode) {
   assert(
-      sz <= std::numeric_limits<uint32_t>::max() &&
+      bytecode->bytes().size() <= std::numeric_limits<uint32_t>::max() &&
       "Bytecode size cannot exceed 32 bits");
-  auto header =
-      reinterpret_cast<const regex::RegexBytecodeHeader *>(bytecode.data());
+  auto header = reinterpret_cast<const regex::RegexBytecodeHeader *>(
+      bytecode->bytes().data());
   syntaxFlags_ = regex::SyntaxFlags::fromByte(header->syntaxFlags);
-  bytecodeSize_ = sz;
-  bytecode_ = (uint8_t *)checkedMalloc(sz);
-  memcpy(bytecode_, bytecode.data(), sz);
+  bytecode_ = std::move(bytecode);
 }
 
 PseudoHandle<StringPrimitive> JSRegExp::getPattern(
@@ -233,12 +269,18 @@ CallResult<RegExpMatch> JSRegExp::search(
     matchFlags |= regex::constants::matchOnlyAtStart;
   }
 
+  if (!runtime.enableRegexAutomaton()) {
+    matchFlags |= regex::constants::matchNoAutomaton;
+  } else if (runtime.forceRegexAutomaton()) {
+    matchFlags |= regex::constants::matchForceAutomaton;
+  }
+
   CallResult<RegExpMatch> matchResult = RegExpMatch{};
   if (input.isASCII()) {
     matchFlags |= regex::constants::matchInputAllAscii;
     matchResult = performSearch<char, regex::ASCIIRegexTraits>(
         runtime,
-        llvh::makeArrayRef(selfHandle->bytecode_, selfHandle->bytecodeSize_),
+        selfHandle->getBytecode(),
         input.castToCharPtr(),
         input.length(),
         searchStartOffset,
@@ -246,7 +288,7 @@ CallResult<RegExpMatch> JSRegExp::search(
   } else {
     matchResult = performSearch<char16_t, regex::UTF16RegexTraits>(
         runtime,
-        llvh::makeArrayRef(selfHandle->bytecode_, selfHandle->bytecodeSize_),
+        selfHandle->getBytecode(),
         input.castToChar16Ptr(),
         input.length(),
         searchStartOffset,
@@ -264,21 +306,20 @@ CallResult<RegExpMatch> JSRegExp::search(
   return matchResult;
 }
 
-JSRegExp::~JSRegExp() {
-  free(bytecode_);
-}
+JSRegExp::~JSRegExp() = default;
 
 void JSRegExp::_finalizeImpl(GCCell *cell, GC &gc) {
+  // The native ID of the bytecode is released by the RegExpCache when the
+  // last reference to it goes away.
   JSRegExp *self = vmcast<JSRegExp>(cell);
-  if (self->bytecode_) {
-    gc.getIDTracker().untrackNative(self->bytecode_);
-  }
   self->~JSRegExp();
 }
 
 size_t JSRegExp::_mallocSizeImpl(GCCell *cell) {
+  // Shared bytecode is counted once for every RegExp that holds it, since
+  // each of them keeps it alive.
   auto *self = vmcast<JSRegExp>(cell);
-  return self->bytecodeSize_;
+  return self->bytecode_ ? self->bytecode_->bytes().size() : 0;
 }
 
 std::string JSRegExp::_snapshotNameImpl(GCCell *cell, GC &gc) {
@@ -294,21 +335,21 @@ void JSRegExp::_snapshotAddEdgesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap) {
     snap.addNamedEdge(
         HeapSnapshot::EdgeType::Internal,
         "bytecode",
-        gc.getNativeID(self->bytecode_));
+        gc.getNativeID(self->bytecode_.get()));
   }
 }
 
 void JSRegExp::_snapshotAddNodesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap) {
   auto *const self = vmcast<JSRegExp>(cell);
-  if (self->bytecode_) {
-    // Add a native node for regex bytecode, to account for native size
-    // directly owned by the regex.
+  // Add a native node for regex bytecode, to account for native size owned by
+  // the regex. Bytecode shared with other regexes only gets one node.
+  if (self->bytecode_ && !snap.hasNode(gc.getNativeID(self->bytecode_.get()))) {
     snap.beginNode();
     snap.endNode(
         HeapSnapshot::NodeType::Native,
         "RegExpBytecode",
-        gc.getNativeID(self->bytecode_),
-        self->bytecodeSize_,
+        gc.getNativeID(self->bytecode_.get()),
+        self->bytecode_->bytes().size(),
         0);
   }
 }
@@ -12,188 +12,160 @@
 #include "hermes/VM/GCPointer-inline.h"
 #include "hermes/VM/Operations.h"
 
+#include <algorithm>
+
 namespace hermes {
 namespace vm {
-//===----------------------------------------------------------------------===//
-// class HashMapEntry
-
-const VTable HashMapEntry::vt{
-    CellKind::HashMapEntryKind,
-    cellSize<HashMapEntry>()};
-
-void HashMapEntryBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
-  const auto *self = static_cast<const HashMapEntry *>(cell);
-  mb.setVTable(&HashMapEntry::vt);
-  mb.addField("key", &self->key);
-  mb.addField("value", &self->value);
-  mb.addField("prevIterationEntry", &self->prevIterationEntry);
-  mb.addField("nextIterationEntry", &self->nextIterationEntry);
-  mb.addField("nextEntryInBucket", &self->nextEntryInBucket);
-}
-
-CallResult<PseudoHandle<HashMapEntry>> HashMapEntry::create(Runtime &runtime) {
-  return createPseudoHandle(runtime.makeAFixed<HashMapEntry>());
-}
-
 //===----------------------------------------------------------------------===//
 // class OrderedHashMap
 
 const VTable OrderedHashMap::vt{
     CellKind::OrderedHashMapKind,
-    cellSize<OrderedHashMap>()};
+    cellSize<OrderedHashMap>(),
+    _finalizeImpl,
+    nullptr,
+    _mallocSizeImpl};
 
 void OrderedHashMapBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
   const auto *self = static_cast<const OrderedHashMap *>(cell);
   mb.setVTable(&OrderedHashMap::vt);
-  mb.addField("hashTable", &self->hashTable_);
-  mb.addField("firstIterationEntry", &self->firstIterationEntry_);
-  mb.addField("lastIterationEntry", &self->lastIterationEntry_);
+  mb.addField("entries", &self->entries_);
 }
 
 OrderedHashMap::OrderedHashMap(
     Runtime &runtime,
-    Handle<ArrayStorageSmall> hashTableStorage)
-    : hashTable_(runtime, hashTableStorage.get(), runtime.getHeap()) {}
+    Handle<SegmentedArray> entries)
+    : entries_(runtime, entries.get(), runtime.getHeap()),
+      index_(new uint32_t[INITIAL_CAPACITY * 2]),
+      indexSize_(INITIAL_CAPACITY * 2),
+      capacity_(INITIAL_CAPACITY) {
+  std::fill_n(index_.get(), indexSize_, kEmptySlot);
+}
 
 CallResult<PseudoHandle<OrderedHashMap>> OrderedHashMap::create(
     Runtime &runtime) {
   auto arrRes =
-      ArrayStorageSmall::create(runtime, INITIAL_CAPACITY, INITIAL_CAPACITY);
+      SegmentedArray::create(runtime, keySlot(INITIAL_CAPACITY), keySlot(0));
   if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto hashTableStorage = runtime.makeHandle<ArrayStorageSmall>(*arrRes);
+  auto entries = runtime.makeHandle<SegmentedArray>(std::move(*arrRes));
 
-  return createPseudoHandle(
-      runtime.makeAFixed<OrderedHashMap>(runtime, hashTableStorage));
+  auto *cell =
+      runtime.makeAFixed<OrderedHashMap, HasFinalizer::Yes>(runtime, entries);
+  runtime.getHeap().creditExternalMemory(cell, indexBytes(cell->indexSize_));
+  return createPseudoHandle(cell);
 }
 
-void OrderedHashMap::removeLinkedListNode(
-    Runtime &runtime,
-    HashMapEntry *entry,
-    GC &gc) {
-  assert(
-      entry != lastIterationEntry_.get(runtime) &&
-      "Cannot remove the last entry");
-  if (entry->prevIterationEntry) {
-    entry->prevIterationEntry.getNonNull(runtime)->nextIterationEntry.set(
-        runtime, entry->nextIterationEntry, gc);
-  }
-  if (entry->nextIterationEntry) {
-    entry->nextIterationEntry.getNonNull(runtime)->prevIterationEntry.set(
-        runtime, entry->prevIterationEntry, gc);
-  }
-  if (entry == firstIterationEntry_.get(runtime)) {
-    firstIterationEntry_.set(runtime, entry->nextIterationEntry, gc);
-  }
-  entry->prevIterationEntry.setNull(runtime.getHeap());
+void OrderedHashMap::_finalizeImpl(GCCell *cell, GC &gc) {
+  auto *self = vmcast<OrderedHashMap>(cell);
+  gc.debitExternalMemory(self, indexBytes(self->indexSize_));
+  self->~OrderedHashMap();
 }
 
-static HashMapEntry *castToMapEntry(SmallHermesValue shv, PointerBase &base) {
-  if (shv.isEmpty())
-    return nullptr;
-  return vmcast<HashMapEntry>(shv.getObject(base));
+size_t OrderedHashMap::_mallocSizeImpl(GCCell *cell) {
+  return indexBytes(vmcast<OrderedHashMap>(cell)->indexSize_);
 }
 
-HashMapEntry *OrderedHashMap::lookupInBucket(
-    Runtime &runtime,
-    uint32_t bucket,
-    HermesValue key) {
-  assert(
-      hashTable_.getNonNull(runtime)->size() == capacity_ &&
-      "Inconsistent capacity");
-  auto *entry =
-      castToMapEntry(hashTable_.getNonNull(runtime)->at(bucket), runtime);
-  while (entry && !isSameValueZero(entry->key, key)) {
-    entry = entry->nextEntryInBucket.get(runtime);
-  }
-  return entry;
+/// \return the capacity of an entry table which has room for \p size live
+/// entries and is at least half free, so that rehashing stays amortized.
+static uint32_t capacityForSize(
+    uint32_t size,
+    uint32_t initialCapacity,
+    uint32_t maxCapacity) {
+  uint32_t capacity = initialCapacity;
+  while (capacity < size * 2 && capacity < maxCapacity)
+    capacity *= 2;
+  return capacity;
 }
 
-ExecutionStatus OrderedHashMap::rehashIfNecessary(
-    Handle<OrderedHashMap> self,
-    Runtime &runtime) {
-  uint32_t newCapacity = self->capacity_;
-  // NOTE: we have ensured that self->capacity_ * 4 never overflows uint32_t by
-  // setting MAX_CAPACITY to the appropriate value. self->size_ is always <=
-  // self->capacity_, so this applies to self->size_ as well.
-  static_assert(
-      MAX_CAPACITY < UINT32_MAX / 4,
-      "Avoid overflow checks on multiplying capacity by 4");
-  if (self->size_ * 4 > self->capacity_ * 3) {
-    // Load factor is more than 0.75, need to increase the capacity.
-    newCapacity = self->capacity_ * 2;
-    if (LLVM_UNLIKELY(newCapacity > MAX_CAPACITY)) {
-      // We maintain the invariant that the capacity_ is a power of two.
-      // Therefore, if doubling would exceed the max, we revert to the
-      // previous value.  (Assert the invariant to make it clear.)
-      assert(
-          (self->capacity_ & (self->capacity_ - 1)) == 0 &&
-          "capacity_ must be power of 2");
-      newCapacity = self->capacity_;
+uint32_t OrderedHashMap::findSlot(
+    PointerBase &base,
+    HermesValue key,
+    uint32_t hash) const {
+  const SegmentedArray *table = entries_.getNonNull(base);
+  const uint32_t mask = indexSize_ - 1;
+  uint32_t freeSlot = kEmptySlot;
+  // Quadratic probing visits every slot of an index whose size is a power of
+  // 2. The probing always ends, since at most half of the slots hold entries
+  // or tombstones.
+  for (uint32_t slot = hash & mask, step = 1;; slot = (slot + step++) & mask) {
+    uint32_t pos = index_[slot];
+    if (pos == kEmptySlot) {
+      // Reuse the first tombstone of the sequence if there is one.
+      return freeSlot != kEmptySlot ? freeSlot : slot;
+    }
+    if (pos == kDeletedSlot) {
+      if (freeSlot == kEmptySlot)
+        freeSlot = slot;
+    } else if (isSameValueZero(table->at(base, keySlot(pos)), key)) {
+      return slot;
     }
-  } else if (
-      self->size_ * 4 < self->capacity_ && self->capacity_ > INITIAL_CAPACITY) {
-    // Load factor is less than 0.25, and we are not at initial cap.
-    newCapacity = self->capacity_ / 2;
-  }
-  if (newCapacity == self->capacity_) {
-    // No need to rehash.
-    return ExecutionStatus::RETURNED;
   }
-  assert(
-      self->size_ && self->firstIterationEntry_ && self->lastIterationEntry_ &&
-      "We should never be rehashing when there are no elements");
-
-  // Set new capacity first to update the hash function.
-  self->capacity_ = newCapacity;
+}
 
-  // Create a new hash table.
-  auto arrRes = ArrayStorageSmall::create(runtime, newCapacity, newCapacity);
+ExecutionStatus OrderedHashMap::rehash(
+    Handle<OrderedHashMap> self,
+    Runtime &runtime,
+    uint32_t newCapacity,
+    bool dropEntries) {
+  assert(
+      (newCapacity & (newCapacity - 1)) == 0 && newCapacity <= MAX_CAPACITY &&
+      "newCapacity must be a power of 2 within MAX_CAPACITY");
+  const uint32_t newSize = dropEntries ? 0 : self->size_;
+  assert(newSize <= newCapacity && "The live entries do not fit");
+
+  const uint32_t newIndexSize = newCapacity * 2;
+  if (LLVM_UNLIKELY(!runtime.getHeap().canAllocExternalMemory(
+          indexBytes(newIndexSize)))) {
+    return runtime.raiseRangeError("Cannot allocate the index of a Map or Set");
+  }
+  auto arrRes = SegmentedArray::create(
+      runtime, keySlot(newCapacity), keySlot(newSize));
   if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto newHashTable = runtime.makeHandle<ArrayStorageSmall>(*arrRes);
+  auto newTable = runtime.makeHandle<SegmentedArray>(std::move(*arrRes));
+  std::unique_ptr<uint32_t[]> newIndex{new uint32_t[newIndexSize]};
+  std::fill_n(newIndex.get(), newIndexSize, kEmptySlot);
 
-  // Now re-add all entries to the hash table.
-  MutableHandle<HashMapEntry> entry{runtime};
-  MutableHandle<HashMapEntry> oldNextInBucket{runtime};
+  // Copy the live entries in insertion order, and record them in the new
+  // index. Nothing here allocates, so raw pointers are safe to use.
+  auto oldTable = runtime.makeHandle(self->entries_.getNonNull(runtime));
   MutableHandle<> keyHandle{runtime};
-  GCScopeMarkerRAII marker{runtime};
-  for (unsigned i = 0, len = self->hashTable_.getNonNull(runtime)->size();
-       i < len;
-       ++i) {
-    entry =
-        castToMapEntry(self->hashTable_.getNonNull(runtime)->at(i), runtime);
-    while (entry) {
-      marker.flush();
-      keyHandle = entry->key;
-      uint32_t bucket = hashToBucket(self, runtime, keyHandle);
-      oldNextInBucket = entry->nextEntryInBucket.get(runtime);
-      if (newHashTable->at(bucket).isEmpty()) {
-        // Empty bucket.
-        entry->nextEntryInBucket.setNull(runtime.getHeap());
-      } else {
-        // There are already a bucket head.
-        entry->nextEntryInBucket.set(
-            runtime,
-            vmcast<HashMapEntry>(newHashTable->at(bucket).getObject(runtime)),
-            runtime.getHeap());
-      }
-      // Update bucket head to the new entry.
-      newHashTable->set(
-          bucket,
-          SmallHermesValue::encodeObjectValue(*entry, runtime),
-          runtime.getHeap());
-
-      entry = *oldNextInBucket;
+  const uint32_t mask = newIndexSize - 1;
+  for (uint32_t pos = 0, newPos = 0; newPos < newSize; ++pos) {
+    keyHandle = oldTable->at(runtime, keySlot(pos));
+    if (keyHandle->isEmpty())
+      continue;
+    newTable->set(runtime, keySlot(newPos), *keyHandle);
+    newTable->set(
+        runtime, valueSlot(newPos), oldTable->at(runtime, valueSlot(pos)));
+    // The new index has no tombstones and no duplicate keys, so the entry goes
+    // in the first empty slot.
+    uint32_t slot = hashKey(runtime, keyHandle) & mask;
+    for (uint32_t step = 1; newIndex[slot] != kEmptySlot;
+         slot = (slot + step++) & mask) {
     }
+    newIndex[slot] = newPos++;
   }
 
-  self->hashTable_.setNonNull(runtime, newHashTable.get(), runtime.getHeap());
-  assert(
-      self->hashTable_.getNonNull(runtime)->size() == self->capacity_ &&
-      "Inconsistent capacity");
+  if (dropEntries) {
+    // Iterators on the old table will not visit any of its entries, so they
+    // need not be kept alive.
+    SegmentedArray::resizeWithinCapacity(*oldTable, runtime, keySlot(0));
+  }
+  // Let iterators on the old table find their way to the new one.
+  oldTable->set(runtime, kNextTableSlot, newTable.getHermesValue());
+
+  GC &gc = runtime.getHeap();
+  gc.debitExternalMemory(*self, indexBytes(self->indexSize_));
+  gc.creditExternalMemory(*self, indexBytes(newIndexSize));
+  self->index_ = std::move(newIndex);
+  self->indexSize_ = newIndexSize;
+  self->capacity_ = newCapacity;
+  self->size_ = newSize;
+  self->entries_.setNonNull(runtime, *newTable, gc);
   return ExecutionStatus::RETURNED;
 }
 
@@ -201,27 +173,20 @@ bool OrderedHashMap::has(
     Handle<OrderedHashMap> self,
     Runtime &runtime,
     Handle<> key) {
-  auto bucket = hashToBucket(self, runtime, key);
-  return self->lookupInBucket(runtime, bucket, key.getHermesValue());
-}
-
-HashMapEntry *OrderedHashMap::find(
-    Handle<OrderedHashMap> self,
-    Runtime &runtime,
-    Handle<> key) {
-  auto bucket = hashToBucket(self, runtime, key);
-  return self->lookupInBucket(runtime, bucket, key.getHermesValue());
+  uint32_t slot = self->findSlot(runtime, *key, hashKey(runtime, key));
+  return self->index_[slot] < kDeletedSlot;
 }
 
 HermesValue OrderedHashMap::get(
     Handle<OrderedHashMap> self,
     Runtime &runtime,
     Handle<> key) {
-  auto *entry = find(self, runtime, key);
-  if (!entry) {
+  uint32_t slot = self->findSlot(runtime, *key, hashKey(runtime, key));
+  uint32_t pos = self->index_[slot];
+  if (pos >= kDeletedSlot) {
     return HermesValue::encodeUndefinedValue();
   }
-  return entry->value;
+  return self->valueAt(runtime, pos);
 }
 
 ExecutionStatus OrderedHashMap::insert(
@@ -229,162 +194,139 @@ ExecutionStatus OrderedHashMap::insert(
     Runtime &runtime,
     Handle<> key,
     Handle<> value) {
-  uint32_t bucket = hashToBucket(self, runtime, key);
-  if (auto *entry =
-          self->lookupInBucket(runtime, bucket, key.getHermesValue())) {
+  const uint32_t hash = hashKey(runtime, key);
+  uint32_t slot = self->findSlot(runtime, *key, hash);
+  uint32_t pos = self->index_[slot];
+  if (pos < kDeletedSlot) {
     // Element already exists, update value and return.
-    entry->value.set(value.get(), runtime.getHeap());
+    self->entries_.getNonNull(runtime)->set(runtime, valueSlot(pos), *value);
     return ExecutionStatus::RETURNED;
   }
-  // Create a new entry, set the key and value.
-  auto crtRes = HashMapEntry::create(runtime);
-  if (LLVM_UNLIKELY(crtRes == ExecutionStatus::EXCEPTION)) {
-    return ExecutionStatus::EXCEPTION;
-  }
-  auto newMapEntry = runtime.makeHandle(std::move(*crtRes));
-  newMapEntry->key.set(key.get(), runtime.getHeap());
-  newMapEntry->value.set(value.get(), runtime.getHeap());
-  auto *curBucketFront =
-      castToMapEntry(self->hashTable_.getNonNull(runtime)->at(bucket), runtime);
-  if (curBucketFront) {
-    // If the bucket we are inserting to is not empty, we maintain the
-    // linked list properly.
-    newMapEntry->nextEntryInBucket.set(
-        runtime, curBucketFront, runtime.getHeap());
-  }
-  // Set the newly inserted entry as the front of this bucket chain.
-  self->hashTable_.getNonNull(runtime)->set(
-      bucket,
-      SmallHermesValue::encodeObjectValue(*newMapEntry, runtime),
-      runtime.getHeap());
-
-  if (!self->firstIterationEntry_) {
-    // If we are inserting the first ever element, update
-    // first iteration entry pointer.
-    self->firstIterationEntry_.set(
-        runtime, newMapEntry.get(), runtime.getHeap());
-    self->lastIterationEntry_.set(
-        runtime, newMapEntry.get(), runtime.getHeap());
-  } else {
-    // Connect the new entry with the last entry.
-    self->lastIterationEntry_.getNonNull(runtime)->nextIterationEntry.set(
-        runtime, newMapEntry.get(), runtime.getHeap());
-    newMapEntry->prevIterationEntry.set(
-        runtime, self->lastIterationEntry_, runtime.getHeap());
-
-    HashMapEntry *previousLastEntry = self->lastIterationEntry_.get(runtime);
-    self->lastIterationEntry_.set(
-        runtime, newMapEntry.get(), runtime.getHeap());
-
-    if (previousLastEntry && previousLastEntry->isDeleted()) {
-      // If the last entry was a deleted entry, we no longer need to keep it.
-      self->removeLinkedListNode(runtime, previousLastEntry, runtime.getHeap());
+
+  pos = numEntries(runtime, self->entries_.getNonNull(runtime));
+  if (pos == self->capacity_) {
+    // The entry table is full: move the live entries to a new table, which
+    // drops the erased ones.
+    if (LLVM_UNLIKELY(self->size_ == MAX_CAPACITY)) {
+      return runtime.raiseRangeError("Map/Set size exceeds the maximum");
     }
+    if (LLVM_UNLIKELY(
+            rehash(
+                self,
+                runtime,
+                capacityForSize(self->size_, INITIAL_CAPACITY, MAX_CAPACITY),
+                false) == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    slot = self->findSlot(runtime, *key, hash);
+    pos = self->size_;
   }
 
+  MutableHandle<SegmentedArray> table{
+      runtime, self->entries_.getNonNull(runtime)};
+  if (LLVM_UNLIKELY(
+          SegmentedArray::resize(table, runtime, keySlot(pos + 1)) ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (LLVM_UNLIKELY(table.get() != self->entries_.getNonNull(runtime))) {
+    // The GC trims the unused capacity of a table when it moves it, so the
+    // table may have been reallocated to grow. The entries keep their
+    // positions in the new table.
+    SegmentedArray *oldTable = self->entries_.getNonNull(runtime);
+    oldTable->set(runtime, kNextTableSlot, table.getHermesValue());
+    oldTable->setNonPtr(
+        runtime, kSamePositionsSlot, HermesValue::encodeBoolValue(true));
+    self->entries_.setNonNull(runtime, *table, runtime.getHeap());
+  }
+  table->set(runtime, keySlot(pos), *key);
+  table->set(runtime, valueSlot(pos), *value);
+  self->index_[slot] = pos;
   self->size_++;
-  return self->rehashIfNecessary(self, runtime);
+  return ExecutionStatus::RETURNED;
 }
 
 bool OrderedHashMap::erase(
     Handle<OrderedHashMap> self,
     Runtime &runtime,
     Handle<> key) {
-  uint32_t bucket = hashToBucket(self, runtime, key);
-  HashMapEntry *prevEntry = nullptr;
-  auto *entry =
-      castToMapEntry(self->hashTable_.getNonNull(runtime)->at(bucket), runtime);
-  while (entry && !isSameValueZero(entry->key, key.getHermesValue())) {
-    prevEntry = entry;
-    entry = entry->nextEntryInBucket.get(runtime);
-  }
-  if (!entry) {
+  uint32_t slot = self->findSlot(runtime, *key, hashKey(runtime, key));
+  uint32_t pos = self->index_[slot];
+  if (pos >= kDeletedSlot) {
     // Element does not exist.
     return false;
   }
 
-  if (prevEntry) {
-    // The entry we are deleting has a previous entry, update the link.
-    prevEntry->nextEntryInBucket.set(
-        runtime, entry->nextEntryInBucket, runtime.getHeap());
-  } else {
-    // The entry we are erasing is the front entry in the bucket, we need
-    // to update the bucket head to the next entry in the bucket, if not
-    // any, set to empty value.
-    self->hashTable_.getNonNull(runtime)->set(
-        bucket,
-        entry->nextEntryInBucket
-            ? SmallHermesValue::encodeObjectValue(entry->nextEntryInBucket)
-            : SmallHermesValue::encodeEmptyValue(),
-        runtime.getHeap());
-  }
-
-  entry->markDeleted(runtime);
+  // Leave a tombstone, so that probing goes on past this slot, and a hole in
+  // the entry table, so that iterators skip the entry.
+  self->index_[slot] = kDeletedSlot;
+  SegmentedArray *table = self->entries_.getNonNull(runtime);
+  table->setNonPtr(runtime, keySlot(pos), HermesValue::encodeEmptyValue());
+  table->setNonPtr(runtime, valueSlot(pos), HermesValue::encodeEmptyValue());
   self->size_--;
 
-  // Now delete the entry from the iteration linked list.
-  // If we are deleting the last entry, don't remove it from the list yet.
-  // This will ensure that if any iterator out there is currently pointing to
-  // this entry, it will be able to follow on if we add new entries in the
-  // future.
-  if (entry != self->lastIterationEntry_.get(runtime)) {
-    self->removeLinkedListNode(runtime, entry, runtime.getHeap());
+  if (self->size_ * 4 < self->capacity_ &&
+      self->capacity_ > INITIAL_CAPACITY) {
+    // Shrink the storage when most of it is unused. This is only an
+    // optimization, so a failure to allocate the smaller table is ignored.
+    if (LLVM_UNLIKELY(
+            rehash(
+                self,
+                runtime,
+                capacityForSize(self->size_, INITIAL_CAPACITY, MAX_CAPACITY),
+                false) == ExecutionStatus::EXCEPTION)) {
+      runtime.clearThrownValue();
+    }
   }
 
-  self->rehashIfNecessary(self, runtime);
-
   return true;
 }
 
-HashMapEntry *OrderedHashMap::iteratorNext(
+bool OrderedHashMap::iteratorNext(
     Runtime &runtime,
-    HashMapEntry *entry) const {
-  if (entry == nullptr) {
+    SegmentedArray *&table,
+    uint32_t &pos) const {
+  SegmentedArray *current = entries_.getNonNull(runtime);
+  if (!table) {
     // Starting a new iteration from the first entry.
-    entry = firstIterationEntry_.get(runtime);
-  } else {
-    // Advance to the next entry.
-    entry = entry->nextIterationEntry.get(runtime);
+    table = current;
+    pos = 0;
   }
 
-  // Make sure the entry we returned (if not nullptr) must not be deleted.
-  while (entry && entry->isDeleted()) {
-    entry = entry->nextIterationEntry.get(runtime);
+  // Follow the tables which replaced the cursor's table. Unless the entries
+  // kept their positions, the live entries before the cursor are the first
+  // ones in the replacement.
+  while (table != current) {
+    if (!table->at(runtime, kSamePositionsSlot).isBool()) {
+      uint32_t end = std::min(pos, numEntries(runtime, table));
+      uint32_t newPos = 0;
+      for (uint32_t i = 0; i < end; ++i) {
+        if (!table->at(runtime, keySlot(i)).isEmpty())
+          ++newPos;
+      }
+      pos = newPos;
+    }
+    table = vmcast<SegmentedArray>(table->at(runtime, kNextTableSlot));
   }
-  return entry;
-}
 
-void OrderedHashMap::clear(Runtime &runtime) {
-  if (!firstIterationEntry_) {
-    // Empty set.
-    return;
+  // Skip the erased entries.
+  for (uint32_t end = numEntries(runtime, table); pos < end; ++pos) {
+    if (!table->at(runtime, keySlot(pos)).isEmpty())
+      return true;
   }
+  return false;
+}
 
-  // Clear the hash table.
-  for (unsigned i = 0; i < capacity_; ++i) {
-    auto entry = castToMapEntry(hashTable_.getNonNull(runtime)->at(i), runtime);
-    // Delete every element reachable from the hash table.
-    while (entry) {
-      entry->markDeleted(runtime);
-      entry = entry->nextEntryInBucket.get(runtime);
-    }
-    // Clear every element in the hash table.
-    hashTable_.getNonNull(runtime)->setNonPtr(
-        i, SmallHermesValue::encodeEmptyValue(), runtime.getHeap());
+ExecutionStatus OrderedHashMap::clear(
+    Handle<OrderedHashMap> self,
+    Runtime &runtime) {
+  if (numEntries(runtime, self->entries_.getNonNull(runtime)) == 0) {
+    // Nothing was inserted in the current table.
+    return ExecutionStatus::RETURNED;
   }
-  // Resize the hash table to the initial size.
-  ArrayStorageSmall::resizeWithinCapacity(
-      hashTable_.getNonNull(runtime), runtime, INITIAL_CAPACITY);
-  capacity_ = INITIAL_CAPACITY;
-
-  // After clearing, we will still keep the last deleted entry
-  // in case there is an iterator out there
-  // pointing to the middle of the iteration chain. We need it to be
-  // able to merge back eventually.
-  firstIterationEntry_.set(runtime, lastIterationEntry_, runtime.getHeap());
-  firstIterationEntry_.getNonNull(runtime)->prevIterationEntry.setNull(
-      runtime.getHeap());
-  size_ = 0;
+  // Iterators that are currently active must see the entries inserted after
+  // clearing, which a new table puts right at their cursor.
+  return rehash(self, runtime, INITIAL_CAPACITY, true);
 }
 
 } // namespace vm
@@ -68,6 +68,14 @@ bool InlineCacheProfiler::insertICHit(
   return true;
 }
 
+bool InlineCacheProfiler::insertICStateChange(
+    CodeBlock *codeblock,
+    uint32_t instOffset,
+    PropertyCacheState state) {
+  getICMissBySourceLocation(codeblock, instOffset).recordState(state);
+  return true;
+}
+
 JSArray *&InlineCacheProfiler::getHiddenClassArray() {
   return cachedHiddenClassesRawPtr_;
 }
@@ -177,6 +185,19 @@ void InlineCacheProfiler::dumpInfoOfSourceLocation(
     std::string missRatio = stream.str();
     ostream << "total access: " << icMiss.missCount + icMiss.hitCount
             << ", miss ratio: " << missRatio << "\n";
+
+    // output how the state of the cache evolved, with the access count at
+    // which each state was entered
+    if (!icMiss.stateChanges.empty()) {
+      ostream << "\tcache states:";
+      const char *sep = " ";
+      for (auto &change : icMiss.stateChanges) {
+        ostream << sep << propertyCacheStateName(change.second) << "@"
+                << change.first;
+        sep = " -> ";
+      }
+      ostream << "\n";
+    }
   } else {
     ostream << "[No Loc]\n";
   }
@@ -189,6 +210,7 @@ void InlineCacheProfiler::dumpInfoOfSourceLocation(
 ///
 /// An example of output for a specific source location is as follows:
 /// [filename:line:column] total access: 2661, miss ratio: 0.3
+///  cache states: monomorphic@0 -> polymorphic@12 -> megamorphic@530
 ///  property: children, inline cache misses: 427
 ///    <type, domNamespace, children, childIndex, context, footer>
 ///    <domNamespace, type, children, childIndex, context, footer>
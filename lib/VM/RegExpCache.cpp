@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/VM/RegExpCache.h"
+
+#include "hermes/VM/GC.h"
+
+#include <cstring>
+
+namespace hermes {
+namespace vm {
+
+RegExpBytecodeBuffer::~RegExpBytecodeBuffer() {
+  gc_.getIDTracker().untrackNative(this);
+}
+
+void RegExpCache::makeKey(
+    llvh::ArrayRef<char16_t> pattern,
+    uint8_t flags,
+    Key &key) {
+  key.resize(1 + pattern.size() * sizeof(char16_t));
+  key[0] = static_cast<char>(flags);
+  std::memcpy(
+      key.data() + 1, pattern.data(), pattern.size() * sizeof(char16_t));
+}
+
+SharedRegExpBytecode RegExpCache::lookup(
+    llvh::ArrayRef<char16_t> pattern,
+    uint8_t flags) {
+  if (pattern.size() > kMaxPatternLength)
+    return nullptr;
+  Key key;
+  makeKey(pattern, flags, key);
+  auto it = entries_.find(llvh::StringRef(key.data(), key.size()));
+  if (it == entries_.end())
+    return nullptr;
+  it->second.lastUse = ++useCount_;
+  return it->second.bytecode;
+}
+
+void RegExpCache::insert(
+    llvh::ArrayRef<char16_t> pattern,
+    uint8_t flags,
+    SharedRegExpBytecode bytecode) {
+  if (pattern.size() > kMaxPatternLength)
+    return;
+  if (entries_.size() >= kCapacity) {
+    // The cache is small, and a miss costs a compilation anyway, so a linear
+    // scan for the least recently used entry is cheap enough.
+    auto victim = entries_.begin();
+    for (auto it = entries_.begin(), e = entries_.end(); it != e; ++it) {
+      if (it->second.lastUse < victim->second.lastUse)
+        victim = it;
+    }
+    entries_.erase(victim);
+  }
+  Key key;
+  makeKey(pattern, flags, key);
+  entries_[llvh::StringRef(key.data(), key.size())] =
+      Entry{std::move(bytecode), ++useCount_};
+}
+
+} // namespace vm
+} // namespace hermes
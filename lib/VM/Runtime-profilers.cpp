@@ -22,6 +22,24 @@ namespace hermes {
 namespace vm {
 
 #ifdef HERMESVM_PROFILER_OPCODE
+void Runtime::recordOpcodeSequence(const inst::Inst *ip) {
+  unsigned opCode = (unsigned)ip->opCode;
+  const uint8_t *inst = reinterpret_cast<const uint8_t *>(ip);
+  // Only count sequences of adjacent instructions: those are the ones which
+  // could be fused into superinstructions.
+  bool follows = inst == lastInstEnd_;
+  if (follows) {
+    ++opcodePairFrequency[lastOpcodes_[0]][opCode];
+    if (lastInstFollowed_)
+      ++opcodeTripleFrequency
+          [(lastOpcodes_[1] << 16) | (lastOpcodes_[0] << 8) | opCode];
+  }
+  lastInstFollowed_ = follows;
+  lastOpcodes_[1] = lastOpcodes_[0];
+  lastOpcodes_[0] = opCode;
+  lastInstEnd_ = inst + inst::getInstSize(ip->opCode);
+}
+
 void Runtime::dumpOpcodeStats(llvh::raw_ostream &os) const {
   std::ostringstream stream;
   // Get all non-zero occurrence opcodes.
@@ -67,6 +85,52 @@ void Runtime::dumpOpcodeStats(llvh::raw_ostream &os) const {
            << inst::getOpCodeString(static_cast<inst::OpCode>(op)).data()
            << std::setw(22) << t[op] << std::setw(11) << f[op] << "\n";
   }
+
+  // The most frequent sequences, with the opcodes packed as in
+  // opcodeTripleFrequency.
+  static constexpr size_t kNumSequences = 30;
+  auto opName = [](uint32_t packed, unsigned shift) {
+    return inst::getOpCodeString(static_cast<inst::OpCode>(packed >> shift))
+        .data();
+  };
+  std::vector<std::pair<uint32_t, uint32_t>> pairs;
+  for (uint32_t i = 0; i < 256; ++i) {
+    for (uint32_t j = 0; j < 256; ++j) {
+      if (opcodePairFrequency[i][j])
+        pairs.push_back({(i << 8) | j, opcodePairFrequency[i][j]});
+    }
+  }
+  std::vector<std::pair<uint32_t, uint32_t>> triples(
+      opcodeTripleFrequency.begin(), opcodeTripleFrequency.end());
+  auto byFrequency = [](const std::pair<uint32_t, uint32_t> &a,
+                        const std::pair<uint32_t, uint32_t> &b) {
+    return a.second > b.second;
+  };
+  sort(pairs.begin(), pairs.end(), byFrequency);
+  sort(triples.begin(), triples.end(), byFrequency);
+
+  stream << "\nAdjacent opcode pairs sorted by frequency:\n"
+         << std::left << std::setfill(' ') << std::setw(50)
+         << "==Opcodes==" << std::setw(11) << "==Frequency=="
+         << "\n";
+  for (size_t i = 0; i < pairs.size() && i < kNumSequences; ++i) {
+    uint32_t seq = pairs[i].first;
+    stream << std::left << std::setfill(' ') << std::setw(25)
+           << opName(seq & 0xff00, 8) << std::setw(25) << opName(seq & 0xff, 0)
+           << std::setw(11) << pairs[i].second << "\n";
+  }
+
+  stream << "\nAdjacent opcode triples sorted by frequency:\n"
+         << std::left << std::setfill(' ') << std::setw(75)
+         << "==Opcodes==" << std::setw(11) << "==Frequency=="
+         << "\n";
+  for (size_t i = 0; i < triples.size() && i < kNumSequences; ++i) {
+    uint32_t seq = triples[i].first;
+    stream << std::left << std::setfill(' ') << std::setw(25)
+           << opName(seq & 0xff0000, 16) << std::setw(25)
+           << opName(seq & 0xff00, 8) << std::setw(25) << opName(seq & 0xff, 0)
+           << std::setw(11) << triples[i].second << "\n";
+  }
   os << stream.str();
 }
 #endif
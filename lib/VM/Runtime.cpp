@@ -224,11 +224,17 @@ Runtime::Runtime(
       hasES6Promise_(runtimeConfig.getES6Promise()),
       hasES6Proxy_(runtimeConfig.getES6Proxy()),
       hasIntl_(runtimeConfig.getIntl()),
+      enableRegexAutomaton_(runtimeConfig.getEnableRegexAutomaton()),
+      forceRegexAutomaton_(runtimeConfig.getForceRegexAutomaton()),
       shouldRandomizeMemoryLayout_(runtimeConfig.getRandomizeMemoryLayout()),
       bytecodeWarmupPercent_(runtimeConfig.getBytecodeWarmupPercent()),
       trackIO_(runtimeConfig.getTrackIO()),
       vmExperimentFlags_(runtimeConfig.getVMExperimentFlags()),
+#ifdef HERMESVM_JIT
+      jitContext_(runtimeConfig.getEnableJIT(), runtimeConfig.getForceJIT()),
+#endif
       runtimeStats_(runtimeConfig.getEnableSampledStats()),
+      regExpCache_(getHeap()),
       commonStorage_(
           createRuntimeCommonStorage(runtimeConfig.getTraceEnabled())),
       stackPointer_(),
@@ -603,6 +609,8 @@ void Runtime::markWeakRoots(WeakRootAcceptor &acceptor, bool markLongLived) {
     for (auto &entry : fixedPropCache_) {
       acceptor.acceptWeak(entry.clazz);
     }
+    megamorphicReadCache_.markWeakRoots(acceptor);
+    megamorphicWriteCache_.markWeakRoots(acceptor);
     for (auto &rm : runtimeModuleList_)
       rm.markLongLivedWeakRoots(acceptor);
   }
@@ -2014,6 +2022,14 @@ void Runtime::recordHiddenClass(
       codeBlock, offset, symbolID, objectHiddenClassId, cachedHiddenClassId);
 }
 
+void Runtime::recordPropertyCacheState(
+    CodeBlock *codeBlock,
+    const Inst *cacheInst,
+    PropertyCacheState state) {
+  inlineCacheProfiler_.insertICStateChange(
+      codeBlock, codeBlock->getOffsetOf(cacheInst), state);
+}
+
 void Runtime::getInlineCacheProfilerInfo(llvh::raw_ostream &ostream) {
   inlineCacheProfiler_.dumpRankedInlineCachingMisses(*this, ostream);
 }
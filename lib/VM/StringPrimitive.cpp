@@ -304,6 +304,28 @@ CallResult<HermesValue> StringPrimitive::slice(
   assert(
       start + length <= str->getStringLength() && "Invalid length for slice");
 
+  if (length >= SLICED_STRING_MIN_SIZE) {
+    ensureFlat(runtime, str);
+    // Slice the string that actually holds the characters.
+    Handle<StringPrimitive> parent = str;
+    if (auto *sliced = dyn_vmcast<SlicedASCIIStringPrimitive>(*str)) {
+      start += sliced->getOffset();
+      parent = runtime.makeHandle(sliced->getParent());
+    } else if (auto *sliced = dyn_vmcast<SlicedUTF16StringPrimitive>(*str)) {
+      start += sliced->getOffset();
+      parent = runtime.makeHandle(sliced->getParent());
+    }
+    const uint32_t parentLen = parent->getStringLength();
+    if (parentLen < SLICED_STRING_HUGE_PARENT_SIZE ||
+        length >= parentLen / SLICED_STRING_MAX_PARENT_RATIO) {
+      return (parent->isASCII() ? SlicedASCIIStringPrimitive::create(
+                                      runtime, parent, start, length)
+                                : SlicedUTF16StringPrimitive::create(
+                                      runtime, parent, start, length))
+          .getHermesValue();
+    }
+  }
+
   SafeUInt32 safeLen(length);
 
   auto builder =
@@ -354,6 +376,30 @@ StringView StringPrimitive::createStringViewMustBeFlat(
   return StringView(self);
 }
 
+template <typename F>
+void StringPrimitive::forEachFlatPiece(const StringPrimitive *str, F callback) {
+  // Ropes built by repeated concatenation can be deep, so walk them with an
+  // explicit stack.
+  llvh::SmallVector<const StringPrimitive *, 16> stack{str};
+  while (!stack.empty()) {
+    const StringPrimitive *cur = stack.pop_back_val();
+    if (auto *rope = dyn_vmcast<RopeASCIIStringPrimitive>(cur)) {
+      if (!rope->isFlattened()) {
+        stack.push_back(vmcast<StringPrimitive>(rope->rightHV_));
+        stack.push_back(vmcast<StringPrimitive>(rope->leftHV_));
+        continue;
+      }
+    } else if (auto *rope = dyn_vmcast<RopeUTF16StringPrimitive>(cur)) {
+      if (!rope->isFlattened()) {
+        stack.push_back(vmcast<StringPrimitive>(rope->rightHV_));
+        stack.push_back(vmcast<StringPrimitive>(rope->leftHV_));
+        continue;
+      }
+    }
+    callback(cur);
+  }
+}
+
 std::string StringPrimitive::_snapshotNameImpl(GCCell *cell, GC &gc) {
   auto *const self = vmcast<StringPrimitive>(cell);
   // Only convert up to EXTERNAL_STRING_THRESHOLD characters, because large
@@ -600,20 +646,25 @@ template <>
 void BufferedStringPrimitive<char>::appendToCopyableString(
     CopyableBasicString<char> &res,
     const StringPrimitive *str) {
-  auto it = str->castToASCIIPointer();
-  res.append(it, it + str->getStringLength());
+  // Copy ropes piece by piece rather than flattening them first.
+  forEachFlatPiece(str, [&res](const StringPrimitive *piece) {
+    auto it = piece->castToASCIIPointer();
+    res.append(it, it + piece->getStringLength());
+  });
 }
 template <>
 void BufferedStringPrimitive<char16_t>::appendToCopyableString(
     CopyableBasicString<char16_t> &res,
     const StringPrimitive *str) {
-  if (str->isASCII()) {
-    auto it = (const uint8_t *)str->castToASCIIPointer();
-    res.append(it, it + str->getStringLength());
-  } else {
-    auto it = str->castToUTF16Pointer();
-    res.append(it, it + str->getStringLength());
-  }
+  forEachFlatPiece(str, [&res](const StringPrimitive *piece) {
+    if (piece->isASCII()) {
+      auto it = (const uint8_t *)piece->castToASCIIPointer();
+      res.append(it, it + piece->getStringLength());
+    } else {
+      auto it = piece->castToUTF16Pointer();
+      res.append(it, it + piece->getStringLength());
+    }
+  });
 }
 
 template <typename T>
@@ -675,6 +726,25 @@ PseudoHandle<StringPrimitive> BufferedStringPrimitive<T>::append(
       runtime, storage->contents_.size(), runtime.makeHandle(storage));
 }
 
+/// \return whether concatenating \p left and \p right, when \p left cannot
+/// be appended to in place, should create a rope rather than copy both into a
+/// new concatenation buffer.
+static bool shouldCreateRope(
+    const StringPrimitive *left,
+    const StringPrimitive *right) {
+  // Copying a long right string is what makes prepending or wrapping
+  // quadratic.
+  if (right->getStringLength() >= StringPrimitive::CONCAT_STRING_MIN_SIZE)
+    return true;
+  // Copying only a short right string into a new buffer is cheap, and the
+  // buffer can be appended to in place afterwards, unless the left string is
+  // a rope that would have to be copied first. Keep extending that rope, but
+  // not indefinitely: after MAX_ROPE_DEPTH short strings, fall back to a
+  // buffer that further appends can reuse.
+  const uint32_t leftDepth = RopeASCIIStringPrimitive::depthOf(left);
+  return leftDepth && leftDepth < RopeASCIIStringPrimitive::MAX_ROPE_DEPTH;
+}
+
 PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
     Runtime &runtime,
     Handle<StringPrimitive> leftHnd,
@@ -693,6 +763,8 @@ PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
             runtime,
             rightHnd);
     }
+    if (shouldCreateRope(left, right))
+      return RopeASCIIStringPrimitive::create(runtime, leftHnd, rightHnd);
     return BufferedASCIIStringPrimitive::create(runtime, leftHnd, rightHnd);
   } else {
     if (auto *bufLeft = dyn_vmcast<BufferedUTF16StringPrimitive>(left)) {
@@ -704,6 +776,8 @@ PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
             rightHnd);
       }
     }
+    if (shouldCreateRope(left, right))
+      return RopeUTF16StringPrimitive::create(runtime, leftHnd, rightHnd);
     return BufferedUTF16StringPrimitive::create(runtime, leftHnd, rightHnd);
   }
 }
@@ -722,5 +796,194 @@ void BufferedStringPrimitive<T>::_snapshotAddNodesImpl(
 
 template class BufferedStringPrimitive<char16_t>;
 template class BufferedStringPrimitive<char>;
+
+//===----------------------------------------------------------------------===//
+// RopeStringPrimitive<T>
+
+void RopeASCIIStringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const RopeASCIIStringPrimitive *>(cell);
+  mb.setVTable(&RopeASCIIStringPrimitive::vt);
+  mb.addField("left", &self->leftHV_);
+  mb.addField("right", &self->rightHV_);
+}
+void RopeUTF16StringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const RopeUTF16StringPrimitive *>(cell);
+  mb.setVTable(&RopeUTF16StringPrimitive::vt);
+  mb.addField("left", &self->leftHV_);
+  mb.addField("right", &self->rightHV_);
+}
+
+template <typename T>
+uint32_t RopeStringPrimitive<T>::depthOf(const StringPrimitive *str) {
+  if (auto *rope = dyn_vmcast<RopeASCIIStringPrimitive>(str))
+    return rope->isFlattened() ? 0 : rope->depth_;
+  if (auto *rope = dyn_vmcast<RopeUTF16StringPrimitive>(str))
+    return rope->isFlattened() ? 0 : rope->depth_;
+  return 0;
+}
+
+template <typename T>
+PseudoHandle<StringPrimitive> RopeStringPrimitive<T>::create(
+    Runtime &runtime,
+    Handle<StringPrimitive> leftHnd,
+    Handle<StringPrimitive> rightHnd) {
+  assertValidLength(leftHnd.get(), rightHnd.get());
+  assert(
+      (std::is_same<T, char16_t>::value ||
+       (leftHnd->isASCII() && rightHnd->isASCII())) &&
+      "cannot append UTF16 to ASCII");
+  // We have to use a variable sized alloc here even though the size is already
+  // known, because RopeStringPrimitive is derived from VariableSizeRuntimeCell.
+  auto *cell =
+      runtime.makeAVariable<RopeStringPrimitive<T>, HasFinalizer::Yes>(
+          sizeof(RopeStringPrimitive<T>), runtime, leftHnd, rightHnd);
+  return createPseudoHandle<StringPrimitive>(cell);
+}
+
+template <typename T>
+void RopeStringPrimitive<T>::flattenContents() const {
+  assert(!isFlattened() && "rope is already flattened");
+  T *const flat = static_cast<T *>(
+      checkedMalloc2(getStringLength(), sizeof(T)));
+  T *out = flat;
+  forEachFlatPiece(this, [&out](const StringPrimitive *piece) {
+    const uint32_t len = piece->getStringLength();
+    if (piece->isASCII()) {
+      const char *src = piece->castToASCIIPointer();
+      out = std::copy(src, src + len, out);
+    } else {
+      assert(
+          (std::is_same<T, char16_t>::value) && "ASCII rope has UTF16 piece");
+      const char16_t *src = piece->castToUTF16Pointer();
+      out = std::copy(src, src + len, out);
+    }
+  });
+  assert(out == flat + getStringLength() && "rope length mismatch");
+  flat_ = flat;
+}
+
+template <typename T>
+void RopeStringPrimitive<T>::flatten(GC &gc) {
+  if (!isFlattened())
+    flattenContents();
+  if (!hasChildren())
+    return;
+  // The children are only dropped once the flat buffer is charged to this
+  // cell, so that the finalizer knows what to debit. If the heap cannot take
+  // it now, try again next time.
+  const size_t sz = calcExternalMemorySize();
+  if (!gc.canAllocExternalMemory(sz))
+    return;
+  gc.creditExternalMemory(this, sz);
+  leftHV_.setNonPtr(HermesValue::encodeEmptyValue(), gc);
+  rightHV_.setNonPtr(HermesValue::encodeEmptyValue(), gc);
+}
+
+template <typename T>
+void RopeStringPrimitive<T>::_finalizeImpl(GCCell *cell, GC &gc) {
+  auto *self = vmcast<RopeStringPrimitive<T>>(cell);
+  if (self->isFlattened()) {
+    gc.getIDTracker().untrackNative(self->flat_);
+    if (!self->hasChildren())
+      gc.debitExternalMemory(self, self->calcExternalMemorySize());
+    free(self->flat_);
+  }
+  self->~RopeStringPrimitive<T>();
+}
+
+template <typename T>
+size_t RopeStringPrimitive<T>::_mallocSizeImpl(GCCell *cell) {
+  return vmcast<RopeStringPrimitive<T>>(cell)->calcExternalMemorySize();
+}
+
+template <typename T>
+std::string RopeStringPrimitive<T>::_snapshotNameImpl(GCCell *cell, GC &gc) {
+  // Taking a snapshot should not flatten every rope in the heap.
+  if (!vmcast<RopeStringPrimitive<T>>(cell)->isFlattened())
+    return "(concatenated string)";
+  return StringPrimitive::_snapshotNameImpl(cell, gc);
+}
+
+template <typename T>
+void RopeStringPrimitive<T>::_snapshotAddEdgesImpl(
+    GCCell *cell,
+    GC &gc,
+    HeapSnapshot &snap) {
+  auto *const self = vmcast<RopeStringPrimitive<T>>(cell);
+  if (!self->isFlattened())
+    return;
+  snap.addNamedEdge(
+      HeapSnapshot::EdgeType::Internal,
+      "flatString",
+      gc.getNativeID(self->flat_));
+}
+
+template <typename T>
+void RopeStringPrimitive<T>::_snapshotAddNodesImpl(
+    GCCell *cell,
+    GC &gc,
+    HeapSnapshot &snap) {
+  auto *const self = vmcast<RopeStringPrimitive<T>>(cell);
+  if (!self->isFlattened())
+    return;
+  snap.beginNode();
+  snap.endNode(
+      HeapSnapshot::NodeType::Native,
+      "RopeStringPrimitive",
+      gc.getNativeID(self->flat_),
+      self->calcExternalMemorySize(),
+      0);
+}
+
+template class RopeStringPrimitive<char16_t>;
+template class RopeStringPrimitive<char>;
+
+//===----------------------------------------------------------------------===//
+// SlicedStringPrimitive<T>
+
+void SlicedASCIIStringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const SlicedASCIIStringPrimitive *>(cell);
+  mb.setVTable(&SlicedASCIIStringPrimitive::vt);
+  mb.addField("parent", &self->parentHV_);
+}
+void SlicedUTF16StringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const SlicedUTF16StringPrimitive *>(cell);
+  mb.setVTable(&SlicedUTF16StringPrimitive::vt);
+  mb.addField("parent", &self->parentHV_);
+}
+
+template <typename T>
+PseudoHandle<StringPrimitive> SlicedStringPrimitive<T>::create(
+    Runtime &runtime,
+    Handle<StringPrimitive> parent,
+    uint32_t offset,
+    uint32_t length) {
+  assert(parent->isFlat() && "cannot slice a rope");
+  assert(
+      !isSlicedStringPrimitive(*parent) &&
+      "slice the parent of a slice instead");
+  assert(
+      parent->isASCII() == (std::is_same<T, char>::value) &&
+      "parent has a different character type");
+  assert(
+      offset + length <= parent->getStringLength() && "Invalid slice range");
+  // We have to use a variable sized alloc here even though the size is already
+  // known, because SlicedStringPrimitive is derived from
+  // VariableSizeRuntimeCell.
+  auto *cell = runtime.makeAVariable<SlicedStringPrimitive<T>>(
+      sizeof(SlicedStringPrimitive<T>), runtime, parent, offset, length);
+  return createPseudoHandle<StringPrimitive>(cell);
+}
+
+template class SlicedStringPrimitive<char16_t>;
+template class SlicedStringPrimitive<char>;
 } // namespace vm
 } // namespace hermes
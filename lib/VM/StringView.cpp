@@ -7,6 +7,8 @@
 
 #include "hermes/VM/StringView.h"
 
+#include "hermes/Support/StringSearch.h"
+
 namespace hermes {
 namespace vm {
 
@@ -28,6 +30,27 @@ UTF16Ref StringView::getUTF16Ref(
   return UTF16Ref(ptr, length());
 }
 
+OptValue<uint32_t> StringView::find(const StringView &needle, uint32_t start)
+    const {
+  assert(start <= length() && "Out of bound search");
+  StringView haystack = slice(start);
+  llvh::Optional<size_t> found;
+  if (haystack.isASCII()) {
+    ASCIIRef h(haystack.castToCharPtr(), haystack.length());
+    found = needle.isASCII()
+        ? searchString(h, ASCIIRef(needle.castToCharPtr(), needle.length()))
+        : searchString(h, UTF16Ref(needle.castToChar16Ptr(), needle.length()));
+  } else {
+    UTF16Ref h(haystack.castToChar16Ptr(), haystack.length());
+    found = needle.isASCII()
+        ? searchString(h, ASCIIRef(needle.castToCharPtr(), needle.length()))
+        : searchString(h, UTF16Ref(needle.castToChar16Ptr(), needle.length()));
+  }
+  if (!found)
+    return llvh::None;
+  return start + static_cast<uint32_t>(*found);
+}
+
 llvh::raw_ostream &operator<<(llvh::raw_ostream &os, const StringView &sv) {
   if (sv.isASCII()) {
     return os << llvh::StringRef(sv.castToCharPtr(), sv.length());
@@ -18,8 +18,12 @@
 #include "hermes/VM/RootAndSlotAcceptorDefault.h"
 
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <functional>
-#include <stack>
+#include <mutex>
+#include <thread>
+#include <tuple>
 
 namespace hermes {
 namespace vm {
@@ -32,6 +36,28 @@ static const char *kCompacteeNameForCrashMgr = "COMPACT";
 // We have a target max pause time of 50ms.
 static constexpr size_t kTargetMaxPauseMs = 50;
 
+/// Size of the buffers that parallel YG evacuation copies small cells into.
+static constexpr uint32_t kEvacBufferSize = 32 * 1024;
+
+/// Smallest buffer that parallel YG evacuation takes from the free list before
+/// growing the heap instead.
+static constexpr uint32_t kMinEvacBufferSize = 8 * 1024;
+
+/// Cells larger than this are evacuated into their own OG allocation rather
+/// than into a buffer.
+static constexpr uint32_t kMaxBufferedCellSize = kMinEvacBufferSize / 2;
+
+/// YG collections that are expected to evacuate fewer bytes than this are not
+/// worth sharing between threads.
+static constexpr uint64_t kMinParallelEvacBytes = 256 * 1024;
+
+/// Workers in a parallel phase of a collection keep at least this many cells
+/// to themselves before sharing any with idle workers.
+static constexpr size_t kMinSharedCells = 64;
+
+/// Number of cells on dirty cards that a worker claims at once.
+static constexpr size_t kDirtyCellBatchSize = 128;
+
 // A free list cell is always variable-sized.
 const VTable HadesGC::OldGen::FreelistCell::vt{
     CellKind::FreelistKind,
@@ -97,7 +123,8 @@ void HadesGC::OldGen::addCellToFreelist(FreelistCell *cell, size_t segmentIdx) {
 void HadesGC::OldGen::addCellToFreelistFromSweep(
     char *freeRangeStart,
     char *freeRangeEnd,
-    bool setHead) {
+    bool setHead,
+    size_t segmentIdx) {
   assert(
       gc_.concurrentPhase_ == Phase::Sweep &&
       "addCellToFreelistFromSweep should only be called during sweeping.");
@@ -111,8 +138,8 @@ void HadesGC::OldGen::addCellToFreelistFromSweep(
   // Get the size bucket for the cell being added;
   const uint32_t bucket = getFreelistBucket(newCellSize);
   // Push onto the size-specific free list for this bucket and segment.
-  newCell->next_ = freelistSegmentsBuckets_[sweepIterator_.segNumber][bucket];
-  freelistSegmentsBuckets_[sweepIterator_.segNumber][bucket] =
+  newCell->next_ = freelistSegmentsBuckets_[segmentIdx][bucket];
+  freelistSegmentsBuckets_[segmentIdx][bucket] =
       CompressedPointer::encodeNonNull(newCell, gc_.getPointerBase());
   __asan_poison_memory_region(newCell + 1, newCellSize - sizeof(FreelistCell));
 }
@@ -377,6 +404,334 @@ class HadesGC::CollectionStats final {
 #endif
 };
 
+/// A fixed set of helper threads that the holder of gcMutex_ wakes up to share
+/// the work of a phase of a collection.
+class HadesGC::WorkerPool {
+ public:
+  explicit WorkerPool(unsigned numHelpers) {
+    helpers_.reserve(numHelpers);
+    for (unsigned i = 0; i < numHelpers; ++i)
+      helpers_.emplace_back([this, i] { worker(i + 1); });
+  }
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      shutdown_ = true;
+      cv_.notify_all();
+    }
+    for (std::thread &helper : helpers_)
+      helper.join();
+  }
+
+  /// \return the number of threads that run each task, including the caller.
+  unsigned numThreads() const {
+    return helpers_.size() + 1;
+  }
+
+  /// Run \p task on the calling thread and on enough helpers to use
+  /// \p numThreads threads in total, and block until all of them have
+  /// returned. Each thread passes a distinct index in [0, numThreads) to
+  /// \p task, where 0 is the calling thread.
+  void run(unsigned numThreads, const std::function<void(unsigned)> &task) {
+    assert(
+        numThreads && numThreads <= this->numThreads() &&
+        "Not enough helper threads");
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      task_ = &task;
+      numActive_ = numThreads;
+      pending_ = numThreads - 1;
+      ++generation_;
+      cv_.notify_all();
+    }
+    task(0);
+    std::unique_lock<std::mutex> lk(mtx_);
+    doneCV_.wait(lk, [this] { return pending_ == 0; });
+    task_ = nullptr;
+  }
+
+ private:
+  void worker(unsigned idx) {
+    oscompat::set_thread_name("hades-worker");
+    std::unique_lock<std::mutex> lk(mtx_);
+    uint64_t lastGeneration = 0;
+    while (true) {
+      cv_.wait(lk, [this, lastGeneration]() {
+        return shutdown_ || generation_ != lastGeneration;
+      });
+      if (shutdown_)
+        return;
+      lastGeneration = generation_;
+      if (idx >= numActive_)
+        continue;
+      const std::function<void(unsigned)> &task = *task_;
+      lk.unlock();
+      task(idx);
+      lk.lock();
+      if (--pending_ == 0)
+        doneCV_.notify_one();
+    }
+  }
+
+  std::mutex mtx_;
+  /// Signalled when a new task is available, or on shutdown.
+  std::condition_variable cv_;
+  /// Signalled when the last helper finishes the current task.
+  std::condition_variable doneCV_;
+  const std::function<void(unsigned)> *task_{nullptr};
+  /// Number of threads that run the current task.
+  unsigned numActive_{0};
+  /// Incremented for every task, so helpers run each one exactly once.
+  uint64_t generation_{0};
+  /// Number of helpers that have not finished the current task.
+  size_t pending_{0};
+  bool shutdown_{false};
+  std::vector<std::thread> helpers_;
+};
+
+/// Lets the threads of a parallel phase of a collection share their work.
+/// Each thread processes cells from a stack of its own, and hands half of it
+/// over when another thread runs out of work. The phase ends once every thread
+/// is out of work, or as soon as one of them calls stop().
+class SharedWorklist final {
+ public:
+  explicit SharedWorklist(unsigned numWorkers) : numWorkers_{numWorkers} {}
+
+  /// \return true if some worker is waiting for work to be shared.
+  bool hasIdleWorkers() const {
+    return numIdle_.load(std::memory_order_relaxed) != 0;
+  }
+
+  /// Hand half of \p stack over to idle workers.
+  void share(std::vector<GCCell *> &stack) {
+    const auto half = stack.begin() + stack.size() / 2;
+    std::vector<GCCell *> packet(stack.begin(), half);
+    stack.erase(stack.begin(), half);
+    std::lock_guard<std::mutex> lk{mtx_};
+    packets_.push_back(std::move(packet));
+    cv_.notify_one();
+  }
+
+  /// Wait until another worker shares some work, and move it into \p stack.
+  /// \return false if the phase ended, either because every worker ran out of
+  ///   work, or because of a call to stop().
+  bool steal(std::vector<GCCell *> &stack) {
+    std::unique_lock<std::mutex> lk{mtx_};
+    if (done_)
+      return false;
+    if (packets_.empty()) {
+      if (numIdle_.fetch_add(1, std::memory_order_relaxed) + 1 ==
+          numWorkers_) {
+        done_ = true;
+        cv_.notify_all();
+        return false;
+      }
+      cv_.wait(lk, [this] { return done_ || !packets_.empty(); });
+      if (done_)
+        return false;
+      numIdle_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    stack = std::move(packets_.back());
+    packets_.pop_back();
+    return true;
+  }
+
+  /// End the phase early. Workers should check stopped() regularly, and stop
+  /// processing their stacks once it returns true.
+  void stop() {
+    std::lock_guard<std::mutex> lk{mtx_};
+    stopped_.store(true, std::memory_order_relaxed);
+    done_ = true;
+    cv_.notify_all();
+  }
+
+  /// \return true if a worker called stop().
+  bool stopped() const {
+    return stopped_.load(std::memory_order_relaxed);
+  }
+
+  /// Move any work that was shared but not stolen before a call to stop()
+  /// onto \p stack. Must only be called once all workers are done.
+  void takeUnstolen(std::vector<GCCell *> &stack) {
+    for (const auto &packet : packets_)
+      stack.insert(stack.end(), packet.begin(), packet.end());
+    packets_.clear();
+  }
+
+ private:
+  const unsigned numWorkers_;
+  /// Protects packets_ and done_.
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  /// Work shared by busy workers, waiting to be stolen.
+  std::vector<std::vector<GCCell *>> packets_;
+  /// Number of workers waiting in steal().
+  std::atomic<unsigned> numIdle_{0};
+  /// Set by stop().
+  std::atomic<bool> stopped_{false};
+  /// Set once the phase ended.
+  bool done_{false};
+};
+
+/// Shared state of a parallel YG evacuation. Each thread taking part owns one
+/// Worker, and only accesses the state of others under a lock.
+class HadesGC::ParallelEvacuation final {
+ public:
+  /// An OG cell found on a run of dirty cards. If begin is null, all of its
+  /// slots need to be visited, otherwise only those in [begin, end).
+  struct DirtyCell {
+    GCCell *cell;
+    const char *begin;
+    const char *end;
+  };
+
+  /// A region of the OG that a single worker copies evacuated cells into. The
+  /// copies occupy [start, level), and [level, end) is still free.
+  struct EvacBuffer {
+    char *start;
+    char *level;
+    char *end;
+  };
+
+  struct Worker {
+    /// Evacuated cells, at their new location, whose slots have not been
+    /// visited yet.
+    std::vector<GCCell *> stack;
+    /// Cells on dirty cards found by this worker.
+    std::vector<DirtyCell> dirtyCells;
+    /// The buffer small cells are currently copied into.
+    EvacBuffer buffer{};
+    /// Buffers that have been filled up.
+    std::vector<EvacBuffer> retiredBuffers;
+    uint64_t evacuatedBytes{0};
+  };
+
+  ParallelEvacuation(HadesGC &gc, unsigned numWorkers)
+      : work{numWorkers}, gc_{gc}, workers_(numWorkers) {}
+
+  Worker &worker(unsigned idx) {
+    return workers_[idx];
+  }
+
+  /// Allocate \p sz bytes in the OG for \p worker to copy a cell into. Small
+  /// cells are carved out of the worker's buffer without synchronisation, and
+  /// get their cell head and mark bit in finish(). Large cells are allocated
+  /// directly, under a lock.
+  /// \param[out] inBuffer Whether the cell was carved out of the buffer.
+  GCCell *alloc(Worker &worker, uint32_t sz, bool &inBuffer) {
+    inBuffer = sz <= kMaxBufferedCellSize;
+    if (LLVM_UNLIKELY(!inBuffer)) {
+      std::lock_guard<std::mutex> lk{allocMutex_};
+      return gc_.oldGen_.alloc(sz);
+    }
+    EvacBuffer &buf = worker.buffer;
+    const size_t avail = buf.end - buf.level;
+    // The remainder of the buffer must be able to hold a free list cell.
+    if (LLVM_UNLIKELY(sz != avail && sz + minAllocationSize() > avail))
+      refill(worker);
+    GCCell *const cell = reinterpret_cast<GCCell *>(buf.level);
+    buf.level += sz;
+    return cell;
+  }
+
+  /// Give back a cell from alloc() after another thread won the race to
+  /// evacuate the same object.
+  void undoAlloc(Worker &worker, GCCell *cell, uint32_t sz, bool inBuffer) {
+    if (inBuffer) {
+      assert(
+          worker.buffer.level - sz == reinterpret_cast<char *>(cell) &&
+          "Can only undo the latest allocation");
+      worker.buffer.level -= sz;
+      return;
+    }
+    // The cell is already marked, so it cannot go back on the free list
+    // before the next OG collection. Turn it into a filler, which that
+    // collection will sweep like any other dead object.
+    constructCell<FillerCell>(cell, sz);
+  }
+
+  /// Make the cells copied into buffers parseable and marked, and return the
+  /// unused ends of the buffers to the free list. Must be called on the
+  /// mutator once all workers are done.
+  /// \return the total number of bytes evacuated by all workers.
+  uint64_t finish() {
+    assert(gc_.gcMutex_ && "Buffers must be released under gcMutex_");
+    // Map each segment to its index in the OG, for free list bookkeeping.
+    llvh::DenseMap<const void *, size_t> segmentIndices;
+    for (size_t i = 0, e = gc_.oldGen_.numSegments(); i < e; ++i)
+      segmentIndices[gc_.oldGen_[i].lowLim()] = i;
+    uint64_t evacuatedBytes = 0;
+    for (Worker &worker : workers_) {
+      retire(worker);
+      for (const EvacBuffer &buf : worker.retiredBuffers) {
+        for (char *p = buf.start; p < buf.level;) {
+          GCCell *const cell = reinterpret_cast<GCCell *>(p);
+          const uint32_t sz = cell->getAllocatedSize();
+          HeapSegment::setCellHead(cell, sz);
+          HeapSegment::setCellMarkBit(cell);
+          p += sz;
+        }
+        if (const uint32_t unused = buf.end - buf.level) {
+          const size_t segIdx =
+              segmentIndices[AlignedStorage::start(buf.start)];
+          gc_.oldGen_.addCellToFreelist(buf.level, unused, segIdx);
+          gc_.oldGen_.incrementAllocatedBytes(
+              -static_cast<int32_t>(unused), segIdx);
+        }
+      }
+      evacuatedBytes += worker.evacuatedBytes;
+    }
+    return evacuatedBytes;
+  }
+
+  /// Evacuated cells that workers share with each other.
+  SharedWorklist work;
+
+  /// OG segments whose dirty cards need to be scanned, claimed by workers in
+  /// order through nextSegment.
+  std::vector<HeapSegment *> segments;
+  std::atomic<size_t> nextSegment{0};
+
+  /// Cells on dirty cards found by all workers, claimed in batches through
+  /// nextDirtyCell.
+  std::vector<DirtyCell> dirtyCells;
+  std::atomic<size_t> nextDirtyCell{0};
+
+ private:
+  /// Move the current buffer of \p worker to its retired list, if it has one.
+  static void retire(Worker &worker) {
+    if (worker.buffer.start)
+      worker.retiredBuffers.push_back(worker.buffer);
+    worker.buffer = {};
+  }
+
+  /// Replace the buffer of \p worker by a new one. Prefers any free cell large
+  /// enough over growing the heap, to avoid fragmenting it further.
+  void refill(Worker &worker) {
+    retire(worker);
+    std::lock_guard<std::mutex> lk{allocMutex_};
+    uint32_t sz = kEvacBufferSize;
+    GCCell *buf = gc_.oldGen_.allocFromFreelist(sz);
+    while (!buf && sz > kMinEvacBufferSize) {
+      sz /= 2;
+      buf = gc_.oldGen_.allocFromFreelist(sz);
+    }
+    if (!buf) {
+      sz = kEvacBufferSize;
+      buf = gc_.oldGen_.alloc(sz);
+    }
+    char *const start = reinterpret_cast<char *>(buf);
+    worker.buffer = {start, start, start + sz};
+  }
+
+  HadesGC &gc_;
+  std::vector<Worker> workers_;
+
+  /// Serialises allocations into the OG between workers.
+  std::mutex allocMutex_;
+
+};
+
 template <typename T>
 static T convertPtr(PointerBase &, CompressedPointer cp) {
   return cp;
@@ -404,6 +759,20 @@ class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
         copyListHead_{nullptr},
         isTrackingIDs_{gc.isTrackingIDs()} {}
 
+  /// Construct an acceptor for one of the threads of a parallel evacuation.
+  EvacAcceptor(
+      HadesGC &gc,
+      ParallelEvacuation &evac,
+      ParallelEvacuation::Worker &worker)
+      : gc{gc},
+        pointerBase_{gc.getPointerBase()},
+        copyListHead_{nullptr},
+        isTrackingIDs_{gc.isTrackingIDs()},
+        evac_{&evac},
+        worker_{&worker} {
+    assert(!isTrackingIDs_ && "Cannot report moves from multiple threads");
+  }
+
   ~EvacAcceptor() {}
 
   // TODO: Implement a purely CompressedPointer version of this. That will let
@@ -460,6 +829,8 @@ class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
   LLVM_NODISCARD T forwardCell(GCCell *const cell) {
     assert(
         HeapSegment::getCellMarkBit(cell) && "Cannot forward unmarked object");
+    if (evac_)
+      return forwardCellParallel<T>(cell);
     if (cell->hasMarkedForwardingPointer()) {
       // Get the forwarding pointer from the header of the object.
       CompressedPointer forwardedCell = cell->getMarkedForwardingPointer();
@@ -493,6 +864,35 @@ class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
     return convertPtr<T>(pointerBase_, newCell);
   }
 
+  /// Version of forwardCell for parallel evacuation. Every thread that finds
+  /// an unforwarded cell copies it speculatively, and the first to install
+  /// its forwarding pointer wins. The losers discard their copy.
+  template <typename T>
+  LLVM_NODISCARD T forwardCellParallel(GCCell *const cell) {
+    AssignableCompressedPointer forwardedCell;
+    const uint32_t cellSize =
+        cell->getAllocatedSizeIfNotForwarded(forwardedCell);
+    if (!cellSize)
+      return convertPtr<T>(pointerBase_, forwardedCell);
+    bool inBuffer;
+    GCCell *const newCell = evac_->alloc(*worker_, cellSize, inBuffer);
+    // If another thread forwards the cell during the copy, the header of the
+    // copy may be a forwarding pointer. The copy is discarded below in that
+    // case, since the update of the header then fails.
+    std::memcpy(newCell, cell, cellSize);
+    const CompressedPointer newCellCP =
+        CompressedPointer::encodeNonNull(newCell, pointerBase_);
+    forwardedCell = cell->trySetMarkedForwardingPointer(newCellCP);
+    if (LLVM_UNLIKELY(forwardedCell != newCellCP)) {
+      evac_->undoAlloc(*worker_, newCell, cellSize, inBuffer);
+      return convertPtr<T>(pointerBase_, forwardedCell);
+    }
+    assert(newCell->isValid() && "Cell was copied incorrectly");
+    worker_->evacuatedBytes += cellSize;
+    worker_->stack.push_back(newCell);
+    return convertPtr<T>(pointerBase_, newCell);
+  }
+
   void accept(GCCell *&ptr) override {
     ptr = acceptRoot(ptr);
   }
@@ -575,6 +975,10 @@ class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
   AssignableCompressedPointer copyListHead_;
   const bool isTrackingIDs_;
   uint64_t evacuatedBytes_{0};
+  /// Shared state and the state of this thread, if this acceptor is used for
+  /// a parallel evacuation.
+  ParallelEvacuation *const evac_{nullptr};
+  ParallelEvacuation::Worker *const worker_{nullptr};
 
   void push(CopyListCell *cell) {
     cell->next_ = copyListHead_;
@@ -697,7 +1101,12 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
       : gc{gc},
         pointerBase_{gc.getPointerBase()},
         markedSymbols_{gc.gcCallbacks_.getSymbolsEnd()},
-        writeBarrierMarkedSymbols_{gc.gcCallbacks_.getSymbolsEnd()} {}
+        writeBarrierMarkedSymbols_{gc.gcCallbacks_.getSymbolsEnd()} {
+    if (kConcurrentGC) {
+      for (unsigned i = 1; i < gc.numConcurrentThreads_; ++i)
+        helpers_.emplace_back(new MarkAcceptor{gc, *this});
+    }
+  }
 
   void acceptHeap(GCCell *cell, const void *heapLoc) {
     assert(cell && "Cannot pass null pointer to acceptHeap");
@@ -831,7 +1240,11 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
     // This should only be called from the mutator. This means no write barriers
     // should occur, and there's no need to check the global worklist more than
     // once.
-    drainSomeWork(std::numeric_limits<size_t>::max());
+    constexpr size_t kNoLimit = std::numeric_limits<size_t>::max();
+    pullGlobalWorklist();
+    if (shouldDrainInParallel())
+      drainInParallel(kNoLimit, /*yieldToMutator*/ false);
+    drainSomeWork(kNoLimit);
     assert(localWorklist_.empty() && "Some work left that wasn't completed");
   }
 
@@ -842,7 +1255,16 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
     // See the comment in setDrainRate for why the drain rate isn't used for
     // concurrent collections.
     constexpr size_t kConcurrentMarkLimit = 8192;
-    return drainSomeWork(kConcurrentGC ? kConcurrentMarkLimit : byteDrainRate_);
+    // Each thread of a parallel step marks more than that, to make up for the
+    // cost of waking up the helpers. The step still ends as soon as the
+    // mutator asks for gcMutex_.
+    constexpr size_t kParallelMarkLimit = 32 * kConcurrentMarkLimit;
+    if (!kConcurrentGC)
+      return drainSomeWork(byteDrainRate_);
+    pullGlobalWorklist();
+    if (shouldDrainInParallel())
+      return drainInParallel(kParallelMarkLimit, /*yieldToMutator*/ true);
+    return drainSomeWork(kConcurrentMarkLimit);
   }
 
   /// Drain some of the work to be done for marking.
@@ -855,27 +1277,13 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
   /// \return true if there is any remaining work in the local worklist.
   bool drainSomeWork(const size_t markLimit) {
     assert(gc.gcMutex_ && "Must hold the GC lock while accessing mark bits.");
-    // Pull any new items off the global worklist.
-    auto cells = globalWorklist_.drain();
-    for (GCCell *cell : cells) {
-      assert(
-          cell->isValid() && "Invalid cell received off the global worklist");
-      assert(
-          !gc.inYoungGen(cell) &&
-          "Shouldn't ever traverse a YG object in this loop");
-      HERMES_SLOW_ASSERT(
-          gc.dbgContains(cell) && "Non-heap cell found in global worklist");
-      if (!HeapSegment::getCellMarkBit(cell)) {
-        // Cell has not yet been marked.
-        push(cell);
-      }
-    }
+    pullGlobalWorklist();
 
     size_t numMarkedBytes = 0;
     assert(markLimit && "markLimit must be non-zero!");
     while (!localWorklist_.empty() && numMarkedBytes < markLimit) {
-      GCCell *const cell = localWorklist_.top();
-      localWorklist_.pop();
+      GCCell *const cell = localWorklist_.back();
+      localWorklist_.pop_back();
       assert(cell->isValid() && "Invalid cell in marking");
       assert(HeapSegment::getCellMarkBit(cell) && "Discovered unmarked object");
       assert(
@@ -891,6 +1299,42 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
     return !localWorklist_.empty();
   }
 
+  /// Share the marking of the local worklist between this thread and the
+  /// helpers, until the work runs out or one of the threads has marked
+  /// \p markLimit bytes.
+  /// \param yieldToMutator Whether to also stop as soon as the mutator asks
+  ///   for gcMutex_.
+  /// \return true if there is any remaining work in the local worklist.
+  bool drainInParallel(size_t markLimit, bool yieldToMutator) {
+    assert(gc.gcMutex_ && "Must hold the GC lock while accessing mark bits.");
+    ++gc.numParallelMarkSteps_;
+    const unsigned numThreads = helpers_.size() + 1;
+    SharedWorklist work{numThreads};
+    gc.runOnWorkers(
+        numThreads, [this, &work, markLimit, yieldToMutator](unsigned idx) {
+          MarkAcceptor &acceptor = idx ? *helpers_[idx - 1] : *this;
+          acceptor.drainShared(work, markLimit, yieldToMutator);
+        });
+    // Take back whatever the helpers did not get to, so that they start empty
+    // in the next step.
+    work.takeUnstolen(localWorklist_);
+    for (auto &helper : helpers_) {
+      localWorklist_.insert(
+          localWorklist_.end(),
+          helper->localWorklist_.begin(),
+          helper->localWorklist_.end());
+      helper->localWorklist_.clear();
+      reachableWeakMaps_.insert(
+          reachableWeakMaps_.end(),
+          helper->reachableWeakMaps_.begin(),
+          helper->reachableWeakMaps_.end());
+      helper->reachableWeakMaps_.clear();
+      markedBytes_ += helper->markedBytes_;
+      helper->markedBytes_ = 0;
+    }
+    return !localWorklist_.empty();
+  }
+
   MarkWorklist &globalWorklist() {
     return globalWorklist_;
   }
@@ -907,6 +1351,8 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
   llvh::BitVector &markedSymbols() {
     assert(gc.gcMutex_ && "Cannot call markedSymbols without a lock");
     markedSymbols_ |= writeBarrierMarkedSymbols_;
+    for (auto &helper : helpers_)
+      markedSymbols_ |= helper->markedSymbols_;
     // No need to clear writeBarrierMarkedSymbols_, or'ing it again won't change
     // the bit vector.
     return markedSymbols_;
@@ -919,7 +1365,12 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
   /// A worklist local to the marking thread, that is only pushed onto by the
   /// marking thread. If this is empty, the global worklist must be consulted
   /// to ensure that pointers modified in write barriers are handled.
-  std::stack<GCCell *, std::vector<GCCell *>> localWorklist_;
+  std::vector<GCCell *> localWorklist_;
+
+  /// Acceptors for the helper threads of parallel marking steps. They keep
+  /// their own marked symbols for the whole collection, and hand everything
+  /// else back to this acceptor at the end of each step.
+  std::vector<std::unique_ptr<MarkAcceptor>> helpers_;
 
   /// A worklist that other threads may add to as objects to be marked and
   /// considered alive. These objects will *not* have their mark bits set,
@@ -951,14 +1402,78 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
   /// The number of bytes that have been marked so far.
   uint64_t markedBytes_{0};
 
+  /// Construct an acceptor for a helper thread of \p main.
+  MarkAcceptor(HadesGC &gc, const MarkAcceptor &main)
+      : gc{gc},
+        pointerBase_{gc.getPointerBase()},
+        markedSymbols_(main.markedSymbols_.size()) {}
+
+  /// Pull any new items off the global worklist onto the local one.
+  void pullGlobalWorklist() {
+    auto cells = globalWorklist_.drain();
+    for (GCCell *cell : cells) {
+      assert(
+          cell->isValid() && "Invalid cell received off the global worklist");
+      assert(
+          !gc.inYoungGen(cell) &&
+          "Shouldn't ever traverse a YG object in this loop");
+      HERMES_SLOW_ASSERT(
+          gc.dbgContains(cell) && "Non-heap cell found in global worklist");
+      if (!HeapSegment::getCellMarkBit(cell)) {
+        // Cell has not yet been marked.
+        push(cell);
+      }
+    }
+  }
+
+  /// \return true if the local worklist holds enough cells to be worth
+  /// sharing with the helpers.
+  bool shouldDrainInParallel() const {
+    return !helpers_.empty() && localWorklist_.size() >= kMinSharedCells;
+  }
+
+  /// Mark cells from the local worklist on one of the threads of a parallel
+  /// step, sharing them with other threads through \p work. See
+  /// drainInParallel.
+  void
+  drainShared(SharedWorklist &work, size_t markLimit, bool yieldToMutator) {
+    size_t numMarkedBytes = 0;
+    do {
+      while (!localWorklist_.empty()) {
+        if (work.stopped())
+          break;
+        if (numMarkedBytes >= markLimit ||
+            (yieldToMutator && gc.ogPaused_.load(std::memory_order_relaxed))) {
+          work.stop();
+          break;
+        }
+        GCCell *const cell = localWorklist_.back();
+        localWorklist_.pop_back();
+        assert(cell->isValid() && "Invalid cell in marking");
+        assert(
+            HeapSegment::getCellMarkBit(cell) && "Discovered unmarked object");
+        HERMES_SLOW_ASSERT(
+            gc.dbgContains(cell) &&
+            "Non-heap object discovered during marking");
+        numMarkedBytes += cell->getAllocatedSize();
+        gc.markCell(cell, *this);
+        if (LLVM_UNLIKELY(
+                localWorklist_.size() >= kMinSharedCells &&
+                work.hasIdleWorkers()))
+          work.share(localWorklist_);
+      }
+    } while (!work.stopped() && work.steal(localWorklist_));
+    markedBytes_ += numMarkedBytes;
+  }
+
   void push(GCCell *cell) {
-    assert(
-        !HeapSegment::getCellMarkBit(cell) &&
-        "A marked object should never be pushed onto a worklist");
     assert(
         !gc.inYoungGen(cell) &&
         "Shouldn't ever push a YG object onto the worklist");
-    HeapSegment::setCellMarkBit(cell);
+    // During a parallel step, several threads may find the same unmarked cell.
+    // Only the one that actually sets the mark bit gets to push it.
+    if (!HeapSegment::atomicSetCellMarkBit(cell))
+      return;
     // There could be a race here: however, the mutator will never change a
     // cell's kind after initialization. The GC thread might to a free cell, but
     // only during sweeping, not concurrently with this operation. Therefore
@@ -966,7 +1481,7 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
     if (vmisa<JSWeakMap>(cell)) {
       reachableWeakMaps_.push_back(vmcast<JSWeakMap>(cell));
     } else {
-      localWorklist_.push(cell);
+      localWorklist_.push_back(cell);
     }
   }
 
@@ -1106,9 +1621,43 @@ bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
     return false;
   assert(gc_.gcMutex_ && "gcMutex_ must be held while sweeping.");
 
-  sweepIterator_.segNumber--;
+  // Freed objects have to be reported to the ID tracker one at a time, and
+  // only the background thread can sweep without trimming cells.
+  const size_t numParallelSegments = std::min<size_t>(
+      gc_.numConcurrentThreads_, sweepIterator_.segNumber);
+  if (kConcurrentGC && backgroundThread && numParallelSegments > 1 &&
+      !gc_.isTrackingIDs()) {
+    sweepSegmentsInParallel(numParallelSegments);
+  } else {
+    sweepIterator_.segNumber--;
+    sweepSegment(sweepIterator_.segNumber, backgroundThread);
+  }
 
-  gc_.oldGen_.updatePeakAllocatedBytes(sweepIterator_.segNumber);
+  // There are more iterations to go.
+  if (sweepIterator_.segNumber)
+    return true;
+
+  // This was the last sweep iteration, finish the collection.
+  auto &stats = *gc_.ogCollectionStats_;
+  stats.setSweptBytes(sweepIterator_.sweptBytes);
+  stats.setSweptExternalBytes(sweepIterator_.sweptExternalBytes);
+  const uint64_t targetSizeBytes =
+      (stats.afterAllocatedBytes() + stats.afterExternalBytes()) /
+      gc_.occupancyTarget_;
+
+  // In a very large heap, use the configured max heap size as a backstop to
+  // prevent the target size crossing it (which would delay collection and cause
+  // an OOM). This is just an approximation, a precise accounting would subtract
+  // segment metadata and YG memory.
+  uint64_t clampedSizeBytes = std::min(targetSizeBytes, gc_.maxHeapSize_);
+  targetSizeBytes_.update(clampedSizeBytes);
+  sizeClassUsage_ = sweepIterator_.sizeClassUsage;
+  sweepIterator_ = {};
+  return false;
+}
+
+void HadesGC::OldGen::sweepSegment(size_t segmentIdx, bool backgroundThread) {
+  gc_.oldGen_.updatePeakAllocatedBytes(segmentIdx);
   const bool isTracking = gc_.isTrackingIDs();
   // Re-evaluate this start point each time, as releasing the gcMutex_ allows
   // allocations into the old gen, which might boost the credited memory.
@@ -1118,21 +1667,25 @@ bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
   // freelist bits will be updated after the segment is swept. The bits will
   // be inconsistent with the actual freelist for the duration of sweeping,
   // but this is fine because gcMutex_ is during the entire period.
-  for (auto &head : freelistSegmentsBuckets_[sweepIterator_.segNumber])
+  for (auto &head : freelistSegmentsBuckets_[segmentIdx])
     head = nullptr;
+  dropSizeClassPages(segmentIdx);
 
+  SizeClassUsage &usage = sweepIterator_.sizeClassUsage;
   char *freeRangeStart = nullptr, *freeRangeEnd = nullptr;
   size_t mergedCells = 0;
   int32_t segmentSweptBytes = 0;
-  for (GCCell *cell : segments_[sweepIterator_.segNumber].cells()) {
+  for (GCCell *cell : segments_[segmentIdx].cells()) {
     assert(cell->isValid() && "Invalid cell in sweeping");
     if (HeapSegment::getCellMarkBit(cell)) {
+      const uint32_t cellSize = cell->getAllocatedSize();
       // Cannot concurrently trim storage. Technically just checking
       // backgroundThread would suffice, but the kConcurrentGC lets us compile
       // away this check in incremental mode.
-      if (kConcurrentGC && backgroundThread)
+      if (kConcurrentGC && backgroundThread) {
+        usage.addLive(cellSize);
         continue;
-      const uint32_t cellSize = cell->getAllocatedSize();
+      }
       const uint32_t trimmedSize =
           cell->getVT()->getTrimmedSize(cell, cellSize);
       assert(cellSize >= trimmedSize && "Growing objects is not supported.");
@@ -1156,6 +1709,7 @@ bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
             "Trimmed space cannot be marked");
         HeapSegment::setCellHead(newCell, trimmableBytes);
       }
+      usage.addLive(cell->getAllocatedSize());
       continue;
     }
 
@@ -1167,9 +1721,11 @@ bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
           freeRangeEnd < cellCharPtr &&
           "Should not overshoot the start of an object");
       // We are starting a new free range, flush the previous one.
-      if (LLVM_LIKELY(freeRangeStart))
+      if (LLVM_LIKELY(freeRangeStart)) {
         addCellToFreelistFromSweep(
-            freeRangeStart, freeRangeEnd, mergedCells > 1);
+            freeRangeStart, freeRangeEnd, mergedCells > 1, segmentIdx);
+        usage.addFree(freeRangeEnd - freeRangeStart);
+      }
 
       mergedCells = 0;
       freeRangeEnd = freeRangeStart = cellCharPtr;
@@ -1190,49 +1746,127 @@ bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
   }
 
   // Flush any free range that was left over.
-  if (freeRangeStart)
-    addCellToFreelistFromSweep(freeRangeStart, freeRangeEnd, mergedCells > 1);
+  if (freeRangeStart) {
+    addCellToFreelistFromSweep(
+        freeRangeStart, freeRangeEnd, mergedCells > 1, segmentIdx);
+    usage.addFree(freeRangeEnd - freeRangeStart);
+  }
 
-  // Update the freelist bit arrays to match the newly set freelist heads.
+  updateFreelistBitsAfterSweep(segmentIdx);
+
+  // Correct the allocated byte count.
+  incrementAllocatedBytes(-segmentSweptBytes, segmentIdx);
+  sweepIterator_.sweptBytes += segmentSweptBytes;
+  sweepIterator_.sweptExternalBytes += externalBytesBefore - externalBytes();
+}
+
+void HadesGC::OldGen::sweepSegmentsInParallel(size_t numSegments) {
+  assert(
+      kConcurrentGC && gc_.calledByBackgroundThread() &&
+      "Parallel sweeping cannot trim cells, so it only runs in the background");
+  ++gc_.numParallelSweepSteps_;
+  sweepIterator_.segNumber -= numSegments;
+  const size_t firstSegmentIdx = sweepIterator_.segNumber;
+  const uint64_t externalBytesBefore = externalBytes();
+
+  /// What one thread found while sweeping one segment.
+  struct SegmentSweep {
+    /// Dead cells with a finalizer.
+    std::vector<GCCell *> finalizable;
+    /// Runs of dead cells to turn into free list cells, and whether each of
+    /// them spans several cells.
+    std::vector<std::tuple<char *, char *, bool>> freeRanges;
+    int32_t sweptBytes{0};
+    SizeClassUsage sizeClassUsage;
+  };
+  std::vector<SegmentSweep> sweeps(numSegments);
+  for (size_t i = 0; i < numSegments; ++i) {
+    updatePeakAllocatedBytes(firstSegmentIdx + i);
+    // See sweepSegment.
+    for (auto &head : freelistSegmentsBuckets_[firstSegmentIdx + i])
+      head = nullptr;
+    dropSizeClassPages(firstSegmentIdx + i);
+  }
+
+  // First find the dead cells without modifying the segments, so that they
+  // are still intact when their finalizers run.
+  gc_.runOnWorkers(numSegments, [this, firstSegmentIdx, &sweeps](unsigned idx) {
+    SegmentSweep &sweep = sweeps[idx];
+    char *freeRangeStart = nullptr, *freeRangeEnd = nullptr;
+    size_t mergedCells = 0;
+    for (GCCell *cell : segments_[firstSegmentIdx + idx].cells()) {
+      assert(cell->isValid() && "Invalid cell in sweeping");
+      const auto sz = cell->getAllocatedSize();
+      if (HeapSegment::getCellMarkBit(cell)) {
+        sweep.sizeClassUsage.addLive(sz);
+        continue;
+      }
+      char *const cellCharPtr = reinterpret_cast<char *>(cell);
+      if (freeRangeEnd != cellCharPtr) {
+        if (LLVM_LIKELY(freeRangeStart)) {
+          sweep.freeRanges.emplace_back(
+              freeRangeStart, freeRangeEnd, mergedCells > 1);
+          sweep.sizeClassUsage.addFree(freeRangeEnd - freeRangeStart);
+        }
+        mergedCells = 0;
+        freeRangeEnd = freeRangeStart = cellCharPtr;
+      }
+      freeRangeEnd += sz;
+      mergedCells++;
+      if (vmisa<FreelistCell>(cell))
+        continue;
+      sweep.sweptBytes += sz;
+      if (cell->getVT()->finalize_)
+        sweep.finalizable.push_back(cell);
+    }
+    if (freeRangeStart) {
+      sweep.freeRanges.emplace_back(
+          freeRangeStart, freeRangeEnd, mergedCells > 1);
+      sweep.sizeClassUsage.addFree(freeRangeEnd - freeRangeStart);
+    }
+  });
+
+  // Finalizers may update state shared with the rest of the runtime, such as
+  // the external memory counters, so run them on this thread alone.
+  for (const SegmentSweep &sweep : sweeps) {
+    for (GCCell *cell : sweep.finalizable)
+      cell->getVT()->finalize_(cell, gc_);
+  }
+
+  // The dead cells can now be overwritten by free list cells.
+  gc_.runOnWorkers(numSegments, [this, firstSegmentIdx, &sweeps](unsigned idx) {
+    for (const auto &range : sweeps[idx].freeRanges) {
+      addCellToFreelistFromSweep(
+          std::get<0>(range),
+          std::get<1>(range),
+          std::get<2>(range),
+          firstSegmentIdx + idx);
+    }
+  });
+
+  for (size_t i = 0; i < numSegments; ++i) {
+    updateFreelistBitsAfterSweep(firstSegmentIdx + i);
+    incrementAllocatedBytes(-sweeps[i].sweptBytes, firstSegmentIdx + i);
+    sweepIterator_.sweptBytes += sweeps[i].sweptBytes;
+    sweepIterator_.sizeClassUsage.add(sweeps[i].sizeClassUsage);
+  }
+  sweepIterator_.sweptExternalBytes += externalBytesBefore - externalBytes();
+}
+
+void HadesGC::OldGen::updateFreelistBitsAfterSweep(size_t segmentIdx) {
   for (size_t bucket = 0; bucket < kNumFreelistBuckets; ++bucket) {
     // For each bucket, set the bit for the current segment based on whether
     // it has a non-null freelist head for that bucket.
-    if (freelistSegmentsBuckets_[sweepIterator_.segNumber][bucket])
-      freelistBucketSegmentBitArray_[bucket].set(sweepIterator_.segNumber);
+    if (freelistSegmentsBuckets_[segmentIdx][bucket])
+      freelistBucketSegmentBitArray_[bucket].set(segmentIdx);
     else
-      freelistBucketSegmentBitArray_[bucket].reset(sweepIterator_.segNumber);
+      freelistBucketSegmentBitArray_[bucket].reset(segmentIdx);
 
     // In case the change above has changed the availability of a bucket
     // across all segments, update the overall bit array.
     freelistBucketBitArray_.set(
         bucket, !freelistBucketSegmentBitArray_[bucket].empty());
   }
-
-  // Correct the allocated byte count.
-  incrementAllocatedBytes(-segmentSweptBytes, sweepIterator_.segNumber);
-  sweepIterator_.sweptBytes += segmentSweptBytes;
-  sweepIterator_.sweptExternalBytes += externalBytesBefore - externalBytes();
-
-  // There are more iterations to go.
-  if (sweepIterator_.segNumber)
-    return true;
-
-  // This was the last sweep iteration, finish the collection.
-  auto &stats = *gc_.ogCollectionStats_;
-  stats.setSweptBytes(sweepIterator_.sweptBytes);
-  stats.setSweptExternalBytes(sweepIterator_.sweptExternalBytes);
-  const uint64_t targetSizeBytes =
-      (stats.afterAllocatedBytes() + stats.afterExternalBytes()) /
-      gc_.occupancyTarget_;
-
-  // In a very large heap, use the configured max heap size as a backstop to
-  // prevent the target size crossing it (which would delay collection and cause
-  // an OOM). This is just an approximation, a precise accounting would subtract
-  // segment metadata and YG memory.
-  uint64_t clampedSizeBytes = std::min(targetSizeBytes, gc_.maxHeapSize_);
-  targetSizeBytes_.update(clampedSizeBytes);
-  sweepIterator_ = {};
-  return false;
 }
 
 void HadesGC::OldGen::initializeSweep() {
@@ -1258,11 +1892,62 @@ size_t HadesGC::OldGen::getMemorySize() const {
   return memorySize;
 }
 
+void HadesGC::OldGen::printSizeClassStats(JSONEmitter &json) const {
+  json.emitKey("sizeClasses");
+  json.openArray();
+  for (size_t i = 0; i < kNumSizeClasses; ++i) {
+    const uint64_t liveBytes = sizeClassUsage_.liveBytes[i];
+    const uint64_t usedBytes = liveBytes + sizeClassUsage_.freeBytes[i];
+    if (!sizeClasses_[i].numPages && !usedBytes)
+      continue;
+    json.openDict();
+    json.emitKeyValue("cellSize", i << LogHeapAlign);
+    json.emitKeyValue("numPages", sizeClasses_[i].numPages);
+    json.emitKeyValue("liveBytes", liveBytes);
+    // The fraction of the memory in cells of this size that was live at the
+    // end of the last sweep.
+    json.emitKeyValue(
+        "occupancy",
+        usedBytes ? static_cast<double>(liveBytes) / usedBytes : 0);
+    json.closeDict();
+  }
+  json.closeArray();
+}
+
 // Assume about 30% of the YG will survive initially.
 constexpr double kYGInitialSurvivalRatio = 0.3;
 
 HadesGC::OldGen::OldGen(HadesGC &gc) : gc_(gc) {}
 
+/// The most threads that share a phase of a collection by default. The speedup
+/// of parallel evacuation and marking flattens out after a few threads, and
+/// the rest of the process needs cores too.
+static constexpr unsigned kMaxDefaultGCThreads = 4;
+
+/// \return the number of threads that should share stop-the-world GC work,
+/// given the \p configured count.
+static unsigned numGCThreadsFor(unsigned configured) {
+  if (!kConcurrentGC)
+    return 1;
+  if (configured)
+    return configured;
+  return std::max(
+      1u, std::min(std::thread::hardware_concurrency(), kMaxDefaultGCThreads));
+}
+
+/// \return the number of threads that should collect the OG concurrently,
+/// given the \p configured count. They run alongside the mutator, so by
+/// default they take at most half of the cores.
+static unsigned numConcurrentThreadsFor(unsigned configured) {
+  if (!kConcurrentGC)
+    return 1;
+  if (configured)
+    return configured;
+  return std::max(
+      1u,
+      std::min(std::thread::hardware_concurrency() / 2, kMaxDefaultGCThreads));
+}
+
 HadesGC::HadesGC(
     GCCallbacks &gcCallbacks,
     PointerBase &pointerBase,
@@ -1284,6 +1969,9 @@ HadesGC::HadesGC(
       oldGen_{*this},
       backgroundExecutor_{
           kConcurrentGC ? std::make_unique<Executor>() : nullptr},
+      numGCThreads_{numGCThreadsFor(gcConfig.getParallelGCThreads())},
+      numConcurrentThreads_{
+          numConcurrentThreadsFor(gcConfig.getConcurrentGCThreads())},
       promoteYGToOG_{!gcConfig.getAllocInYoung()},
       revertToYGAtTTI_{gcConfig.getRevertToYGAtTTI()},
       occupancyTarget_(gcConfig.getOccupancyTarget()),
@@ -1442,6 +2130,16 @@ void HadesGC::printStats(JSONEmitter &json) {
   json.emitKeyValue("collector", getKindAsStr());
   json.emitKey("stats");
   json.openDict();
+  json.emitKeyValue("numGCThreads", numGCThreads_);
+  json.emitKeyValue("numParallelYGCollections", numParallelYGCollections_);
+  json.emitKeyValue("numConcurrentThreads", numConcurrentThreads_);
+  json.emitKeyValue("numParallelMarkSteps", numParallelMarkSteps_);
+  json.emitKeyValue("numParallelSweepSteps", numParallelSweepSteps_);
+  json.emitKeyValue("totalSweepTime", ogSweepTime_.sum());
+  json.emitKeyValue("maxSweepTime", ogSweepTime_.max());
+  json.emitKeyValue(
+      "peakHeapSize", std::max(peakSegmentFootprint_, segmentFootprint()));
+  oldGen_.printSizeClassStats(json);
   json.closeDict();
   json.closeDict();
 }
@@ -1680,6 +2378,7 @@ void HadesGC::incrementalCollect(bool backgroundThread) {
           ygCollectionStats_->addCollectionType("complete marking");
         completeMarking();
         concurrentPhase_ = Phase::Sweep;
+        sweepBeginTime_ = std::chrono::steady_clock::now();
       }
       break;
     case Phase::Sweep:
@@ -1690,6 +2389,10 @@ void HadesGC::incrementalCollect(bool backgroundThread) {
         // Finish any collection bookkeeping.
         ogCollectionStats_->setEndTime();
         ogCollectionStats_->setAfterSize(segmentFootprint());
+        ogSweepTime_.record(std::chrono::duration<double>(
+                                std::chrono::steady_clock::now() -
+                                sweepBeginTime_)
+                                .count());
         compacteeHandleForSweep_.reset();
         concurrentPhase_ = Phase::None;
         if (!backgroundThread)
@@ -2224,7 +2927,13 @@ GCCell *HadesGC::OldGen::alloc(uint32_t sz) {
       "Should be aligned before entering this function");
   assert(sz >= minAllocationSize() && "Allocating too small of an object");
   assert(sz <= maxAllocationSize() && "Allocating too large of an object");
-  assert(gc_.gcMutex_ && "gcMutex_ must be held before calling oldGenAlloc");
+  assert(
+      (gc_.gcMutex_ || gc_.gcWorkersActive_) &&
+      "gcMutex_ must be held before calling oldGenAlloc");
+  if (sz < kMaxSizeClassCellSize) {
+    if (GCCell *cell = allocFromSizeClass(sz))
+      return cell;
+  }
   if (GCCell *cell = search(sz)) {
     return cell;
   }
@@ -2285,21 +2994,68 @@ uint32_t HadesGC::OldGen::getFreelistBucket(uint32_t size) {
   return bucket;
 }
 
+GCCell *HadesGC::OldGen::allocFromSizeClass(uint32_t sz) {
+  assert(sz < kMaxSizeClassCellSize && "Size has no size class");
+  // Cells of exactly this size that the sweeper freed are reused first, so
+  // that they do not go to waste.
+  if (freelistBucketBitArray_.at(getFreelistBucket(sz)))
+    return search(sz);
+
+  SizeClass &sizeClass = sizeClasses_[sz >> LogHeapAlign];
+  if (sizeClass.level == sizeClass.end) {
+    const uint32_t pageSize = kSizeClassPageSize - kSizeClassPageSize % sz;
+    size_t segmentIdx;
+    GCCell *page = searchFreelists(pageSize, segmentIdx);
+    if (!page)
+      return nullptr;
+    // Split the whole page into cells up front, so that allocating from it
+    // only has to move the level.
+    char *const start = reinterpret_cast<char *>(page);
+    for (char *cur = start; cur < start + pageSize; cur += sz) {
+      constructCell<FreelistCell>(cur, sz);
+      HeapSegment::setCellHead(reinterpret_cast<GCCell *>(cur), sz);
+    }
+    sizeClass.level = start;
+    sizeClass.end = start + pageSize;
+    sizeClass.segmentIdx = segmentIdx;
+    sizeClass.numPages++;
+  }
+  GCCell *cell = reinterpret_cast<GCCell *>(sizeClass.level);
+  sizeClass.level += sz;
+  return finishAlloc(cell, sz, sizeClass.segmentIdx);
+}
+
+void HadesGC::OldGen::dropSizeClassPages(size_t segmentIdx) {
+  for (SizeClass &sizeClass : sizeClasses_) {
+    if (sizeClass.level != sizeClass.end &&
+        sizeClass.segmentIdx == segmentIdx)
+      sizeClass.level = sizeClass.end = nullptr;
+  }
+}
+
 GCCell *HadesGC::OldGen::search(uint32_t sz) {
+  size_t segmentIdx;
+  if (GCCell *cell = searchFreelists(sz, segmentIdx))
+    return finishAlloc(cell, sz, segmentIdx);
+  return nullptr;
+}
+
+GCCell *HadesGC::OldGen::searchFreelists(uint32_t sz, size_t &segmentIdx) {
   size_t bucket = getFreelistBucket(sz);
   if (bucket < kNumSmallFreelistBuckets) {
     // Fast path: There already exists a size bucket for this alloc. Check if
     // there's a free cell to take and exit.
     if (freelistBucketBitArray_.at(bucket)) {
-      int segmentIdx = freelistBucketSegmentBitArray_[bucket].find_first();
+      int firstSegmentIdx = freelistBucketSegmentBitArray_[bucket].find_first();
       assert(
-          segmentIdx >= 0 &&
+          firstSegmentIdx >= 0 &&
           "Set bit in freelistBucketBitArray_ must correspond to segment index.");
+      segmentIdx = firstSegmentIdx;
       FreelistCell *cell = removeCellFromFreelist(bucket, segmentIdx);
       assert(
           cell->getAllocatedSize() == sz &&
           "Size bucket should be an exact match");
-      return finishAlloc(cell, sz, segmentIdx);
+      return cell;
     }
     // Make sure we start searching at the smallest possible size that could fit
     bucket = getFreelistBucket(sz + minAllocationSize());
@@ -2309,7 +3065,8 @@ GCCell *HadesGC::OldGen::search(uint32_t sz) {
   bucket = freelistBucketBitArray_.findNextSetBitFrom(bucket);
   for (; bucket < kNumFreelistBuckets;
        bucket = freelistBucketBitArray_.findNextSetBitFrom(bucket + 1)) {
-    for (size_t segmentIdx : freelistBucketSegmentBitArray_[bucket]) {
+    for (size_t curSegmentIdx : freelistBucketSegmentBitArray_[bucket]) {
+      segmentIdx = curSegmentIdx;
       assert(
           freelistSegmentsBuckets_[segmentIdx][bucket] &&
           "Empty bucket should not have bit set!");
@@ -2349,11 +3106,11 @@ GCCell *HadesGC::OldGen::search(uint32_t sz) {
           // freelist, newCell is still poisoned (regardless of whether the
           // conditional above executed). Unpoison it.
           __asan_unpoison_memory_region(newCell, sz);
-          return finishAlloc(newCell, sz, segmentIdx);
+          return newCell;
         } else if (cellSize == sz) {
           // Exact match, take it.
           removeCellFromFreelist(prevLoc, bucket, segmentIdx);
-          return finishAlloc(cell, sz, segmentIdx);
+          return cell;
         }
         // Non-exact matches, or anything just barely too small to fit, will
         // need to find another block.
@@ -2444,7 +3201,12 @@ void HadesGC::youngGenCollection(
   } else {
     auto &yg = youngGen();
 
-    if (compactee_.segment) {
+    if (shouldEvacuateInParallel(doCompaction)) {
+      ygCollectionStats_->addCollectionType("parallel");
+      heapBytes.after = compactee_.segment
+          ? youngGenEvacuateParallel<true>(doCompaction)
+          : youngGenEvacuateParallel<false>(false);
+    } else if (compactee_.segment) {
       EvacAcceptor<true> acceptor{*this};
       youngGenEvacuateImpl(acceptor, doCompaction);
       // The remaining bytes after the collection is just the number of bytes
@@ -2679,10 +3441,12 @@ void HadesGC::updateYoungGenSizeFactor() {
     ygSizeFactor_ = std::max(ygSizeFactor_ * 0.9, 0.25);
 }
 
-template <bool CompactionEnabled>
-void HadesGC::scanDirtyCardsForSegment(
-    SlotVisitor<EvacAcceptor<CompactionEnabled>> &visitor,
-    HeapSegment &seg) {
+template <typename RangeCallback, typename CellCallback>
+void HadesGC::forEachDirtyCardCell(
+    HeapSegment &seg,
+    bool visitUnmarked,
+    RangeCallback visitRange,
+    CellCallback visitCell) {
   const auto &cardTable = seg.cardTable();
   // Use level instead of end in case the OG segment is still in bump alloc
   // mode.
@@ -2690,13 +3454,6 @@ void HadesGC::scanDirtyCardsForSegment(
   size_t from = cardTable.addressToIndex(seg.start());
   const size_t to = cardTable.addressToIndex(origSegLevel - 1) + 1;
 
-  // If a compaction is taking place during sweeping, we may scan cards that
-  // contain dead objects which in turn point to dead objects in the compactee.
-  // In order to avoid promoting these dead objects, we should skip unmarked
-  // objects altogether when compaction and sweeping happen at the same time.
-  const bool visitUnmarked =
-      !CompactionEnabled || concurrentPhase_ != Phase::Sweep;
-
   while (const auto oiBegin = cardTable.findNextDirtyCard(from, to)) {
     const auto iBegin = *oiBegin;
 
@@ -2719,18 +3476,10 @@ void HadesGC::scanDirtyCardsForSegment(
     // of the object.
     GCCell *const firstObj = seg.getFirstCellHead(iBegin);
     GCCell *obj = firstObj;
-    // Throughout this loop, objects are being marked which could promote
-    // other objects into the OG. Such objects might be promoted onto a dirty
-    // card, and be visited a second time. This is only a problem if the
-    // acceptor isn't idempotent. Luckily, EvacAcceptor happens to be
-    // idempotent, and so there's no correctness issue with visiting an object
-    // multiple times. If EvacAcceptor wasn't idempotent, we'd have to be able
-    // to identify objects promoted from YG in this loop, which would be
-    // expensive.
 
     // Mark the first object with respect to the dirty card boundaries.
     if (visitUnmarked || HeapSegment::getCellMarkBit(obj))
-      markCellWithinRange(visitor, obj, obj->getKind(), begin, end);
+      visitRange(obj, begin, end);
 
     obj = obj->nextCell();
     // If there are additional objects in this card, scan them.
@@ -2742,7 +3491,7 @@ void HadesGC::scanDirtyCardsForSegment(
       for (GCCell *next = obj->nextCell(); next < boundary;
            next = next->nextCell()) {
         if (visitUnmarked || HeapSegment::getCellMarkBit(obj))
-          markCell(visitor, obj, obj->getKind());
+          visitCell(obj);
         obj = next;
       }
 
@@ -2752,13 +3501,42 @@ void HadesGC::scanDirtyCardsForSegment(
           obj < boundary && obj->nextCell() >= boundary &&
           "Last object in card must touch or cross cross the card boundary");
       if (visitUnmarked || HeapSegment::getCellMarkBit(obj))
-        markCellWithinRange(visitor, obj, obj->getKind(), begin, end);
+        visitRange(obj, begin, end);
     }
 
     from = iEnd;
   }
 }
 
+template <bool CompactionEnabled>
+void HadesGC::scanDirtyCardsForSegment(
+    SlotVisitor<EvacAcceptor<CompactionEnabled>> &visitor,
+    HeapSegment &seg) {
+  // If a compaction is taking place during sweeping, we may scan cards that
+  // contain dead objects which in turn point to dead objects in the compactee.
+  // In order to avoid promoting these dead objects, we should skip unmarked
+  // objects altogether when compaction and sweeping happen at the same time.
+  const bool visitUnmarked =
+      !CompactionEnabled || concurrentPhase_ != Phase::Sweep;
+
+  // Throughout this walk, objects are being marked which could promote other
+  // objects into the OG. Such objects might be promoted onto a dirty card, and
+  // be visited a second time. This is only a problem if the acceptor isn't
+  // idempotent. Luckily, EvacAcceptor happens to be idempotent, and so there's
+  // no correctness issue with visiting an object multiple times. If
+  // EvacAcceptor wasn't idempotent, we'd have to be able to identify objects
+  // promoted from YG in this loop, which would be expensive.
+  forEachDirtyCardCell(
+      seg,
+      visitUnmarked,
+      [this, &visitor](GCCell *obj, const char *begin, const char *end) {
+        markCellWithinRange(visitor, obj, obj->getKind(), begin, end);
+      },
+      [this, &visitor](GCCell *obj) {
+        markCell(visitor, obj, obj->getKind());
+      });
+}
+
 template <bool CompactionEnabled>
 void HadesGC::scanDirtyCards(EvacAcceptor<CompactionEnabled> &acceptor) {
   SlotVisitor<EvacAcceptor<CompactionEnabled>> visitor{acceptor};
@@ -2789,6 +3567,145 @@ void HadesGC::scanDirtyCards(EvacAcceptor<CompactionEnabled> &acceptor) {
     scanDirtyCardsForSegment(visitor, *compactee_.segment);
 }
 
+void HadesGC::runOnWorkers(
+    unsigned numThreads,
+    const std::function<void(unsigned)> &task) {
+  assert(gcMutex_ && "The worker pool is protected by gcMutex_");
+  if (!workerPool_)
+    workerPool_ = std::make_unique<WorkerPool>(
+        std::max(numGCThreads_, numConcurrentThreads_) - 1);
+  gcWorkersActive_ = true;
+  workerPool_->run(numThreads, task);
+  gcWorkersActive_ = false;
+}
+
+bool HadesGC::shouldEvacuateInParallel(bool doCompaction) {
+  // Moved objects have to be reported to the ID tracker one at a time.
+  if (numGCThreads_ < 2 || isTrackingIDs())
+    return false;
+  // Waking up the workers costs more than evacuating a small YG alone.
+  if (ygAverageSurvivalBytes_ < kMinParallelEvacBytes)
+    return false;
+  // Workers cannot report an OOM, so only use them if the heap can grow to
+  // fit everything that might survive, even if half of the space in their
+  // buffers goes unused.
+  if (sanitizeRate_)
+    return true;
+  const uint64_t maxSurvivorBytes =
+      youngGen().used() + (doCompaction ? compactee_.allocatedBytes : 0);
+  const uint64_t footprint = heapFootprint();
+  const uint64_t headroom =
+      maxHeapSize_ > footprint ? maxHeapSize_ - footprint : 0;
+  return headroom >=
+      2 * maxSurvivorBytes + uint64_t(numGCThreads_) * kEvacBufferSize;
+}
+
+template <bool CompactionEnabled>
+uint64_t HadesGC::youngGenEvacuateParallel(bool doCompaction) {
+  ++numParallelYGCollections_;
+  ParallelEvacuation evac{*this, numGCThreads_};
+
+  // First find all cells on dirty cards, one segment at a time. Nothing is
+  // evacuated yet, so the heap stays parseable while the workers walk it.
+  const bool preparingCompaction =
+      CompactionEnabled && !compactee_.evacActive();
+  for (HeapSegment &seg : oldGen_)
+    evac.segments.push_back(&seg);
+  // No need to search dirty cards in the compactee segment if it is
+  // currently being evacuated, since it will be scanned fully.
+  if (preparingCompaction)
+    evac.segments.push_back(compactee_.segment.get());
+  // See scanDirtyCardsForSegment.
+  const bool visitUnmarked =
+      !CompactionEnabled || concurrentPhase_ != Phase::Sweep;
+  runOnWorkers(
+      numGCThreads_,
+      [this, &evac, preparingCompaction, visitUnmarked](unsigned idx) {
+        auto &dirtyCells = evac.worker(idx).dirtyCells;
+        for (size_t i;
+             (i = evac.nextSegment.fetch_add(1, std::memory_order_relaxed)) <
+             evac.segments.size();) {
+          HeapSegment &seg = *evac.segments[i];
+          forEachDirtyCardCell(
+              seg,
+              visitUnmarked,
+              [&dirtyCells](GCCell *obj, const char *begin, const char *end) {
+                dirtyCells.push_back({obj, begin, end});
+              },
+              [&dirtyCells](GCCell *obj) {
+                // Free list cells have no pointers to visit.
+                if (!vmisa<OldGen::FreelistCell>(obj))
+                  dirtyCells.push_back({obj, nullptr, nullptr});
+              });
+          // Do not clear the card table if the OG thread is currently marking
+          // to prepare for a compaction.
+          if (!preparingCompaction)
+            seg.cardTable().clear();
+        }
+      });
+  for (unsigned i = 0; i < numGCThreads_; ++i) {
+    auto &dirtyCells = evac.worker(i).dirtyCells;
+    evac.dirtyCells.insert(
+        evac.dirtyCells.end(), dirtyCells.begin(), dirtyCells.end());
+    dirtyCells = {};
+  }
+
+  // Then evacuate everything reachable from the roots and the dirty cards.
+  // The mutator marks the roots, while the other workers start on the dirty
+  // cards. Cells that are evacuated are pushed on the stack of the worker
+  // that copied them, and shared with workers that run out of work.
+  runOnWorkers(numGCThreads_, [this, &evac, doCompaction](unsigned idx) {
+    auto &worker = evac.worker(idx);
+    EvacAcceptor<CompactionEnabled> acceptor{*this, evac, worker};
+    SlotVisitor<EvacAcceptor<CompactionEnabled>> visitor{acceptor};
+    if (idx == 0) {
+      DroppingAcceptor<EvacAcceptor<CompactionEnabled>> nameAcceptor{acceptor};
+      markRoots(nameAcceptor, /*markLongLived*/ doCompaction);
+    }
+    while (true) {
+      while (!worker.stack.empty()) {
+        GCCell *const cell = worker.stack.back();
+        worker.stack.pop_back();
+        markCell(visitor, cell, cell->getKind());
+        if (LLVM_UNLIKELY(
+                worker.stack.size() >= kMinSharedCells &&
+                evac.work.hasIdleWorkers()))
+          evac.work.share(worker.stack);
+      }
+      const size_t first = evac.nextDirtyCell.fetch_add(
+          kDirtyCellBatchSize, std::memory_order_relaxed);
+      if (first < evac.dirtyCells.size()) {
+        const size_t last =
+            std::min(first + kDirtyCellBatchSize, evac.dirtyCells.size());
+        for (size_t i = first; i < last; ++i) {
+          const auto &dirty = evac.dirtyCells[i];
+          if (dirty.begin)
+            markCellWithinRange(
+                visitor,
+                dirty.cell,
+                dirty.cell->getKind(),
+                dirty.begin,
+                dirty.end);
+          else
+            markCell(visitor, dirty.cell, dirty.cell->getKind());
+        }
+        continue;
+      }
+      if (!evac.work.steal(worker.stack))
+        break;
+    }
+  });
+
+  // Weak roots only need the forwarding pointers, so update them on the
+  // mutator. We only need to update the long lived weak roots if we are
+  // evacuating part of the OG.
+  {
+    EvacAcceptor<CompactionEnabled> acceptor{*this, evac, evac.worker(0)};
+    markWeakRoots(acceptor, /*markLongLived*/ doCompaction);
+  }
+  return evac.finish();
+}
+
 void HadesGC::finalizeYoungGenObjects() {
   for (GCCell *cell : youngGenFinalizables_) {
     if (!cell->hasMarkedForwardingPointer()) {
@@ -2895,7 +3812,11 @@ void HadesGC::OldGen::updatePeakAllocatedBytes(uint16_t segmentIdx) {
 }
 
 uint64_t HadesGC::OldGen::externalBytes() const {
-  assert(gc_.gcMutex_ && "OG external bytes must be accessed under gcMutex_.");
+  // Parallel evacuation workers read this when growing the heap on behalf of
+  // the mutator.
+  assert(
+      (gc_.gcMutex_ || gc_.gcWorkersActive_) &&
+      "OG external bytes must be accessed under gcMutex_.");
   return externalBytes_;
 }
 
@@ -3013,10 +3934,17 @@ void HadesGC::OldGen::addSegment(HeapSegment seg) {
   }
 
   gc_.addSegmentExtentToCrashManager(newSeg, std::to_string(numSegments()));
+  gc_.peakSegmentFootprint_ =
+      std::max(gc_.peakSegmentFootprint_, gc_.segmentFootprint());
 }
 
 HadesGC::HeapSegment HadesGC::OldGen::removeSegment(size_t segmentIdx) {
   assert(segmentIdx < segments_.size());
+  dropSizeClassPages(segmentIdx);
+  for (SizeClass &sizeClass : sizeClasses_) {
+    if (sizeClass.segmentIdx > segmentIdx)
+      sizeClass.segmentIdx--;
+  }
   eraseSegmentFreelists(segmentIdx);
   allocatedBytes_ -= segmentAllocatedBytes_[segmentIdx].first;
   segmentAllocatedBytes_.erase(segmentAllocatedBytes_.begin() + segmentIdx);
@@ -190,6 +190,16 @@ enum class GCEventKind {
   /* Whether to use mprotect on GC metadata between GCs. */               \
   F(constexpr, bool, ProtectMetadata, false)                              \
                                                                           \
+  /* Number of threads, including the mutator, that share */              \
+  /* stop-the-world GC work. 0 picks a count from the number of */        \
+  /* cores, and 1 disables parallel collection. */                        \
+  F(constexpr, unsigned, ParallelGCThreads, 0)                            \
+                                                                          \
+  /* Number of threads that mark and sweep the old generation */          \
+  /* concurrently with the mutator. 0 picks a count from the number of */ \
+  /* cores, and 1 uses a single background thread. */                     \
+  F(constexpr, unsigned, ConcurrentGCThreads, 0)                          \
+                                                                          \
   /* Callout for an analytics event. */                                   \
   F(HERMES_NON_CONSTEXPR,                                                 \
     std::function<void(const GCAnalyticsEvent &)>,                        \
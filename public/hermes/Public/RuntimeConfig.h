@@ -40,6 +40,17 @@ class PinnedHermesValue;
   /* Whether or not the JIT is enabled */                              \
   F(constexpr, bool, EnableJIT, false)                                 \
                                                                        \
+  /* Whether the JIT compiles every function on its first call */      \
+  F(constexpr, bool, ForceJIT, false)                                  \
+                                                                       \
+  /* Whether regexes fall back to a linear-time automaton when */      \
+  /* backtracking becomes excessive */                                 \
+  F(constexpr, bool, EnableRegexAutomaton, true)                       \
+                                                                       \
+  /* Whether regexes use their automaton, when they have one, for */   \
+  /* every search */                                                   \
+  F(constexpr, bool, ForceRegexAutomaton, false)                       \
+                                                                       \
   /* Whether to allow eval and Function ctor */                        \
   F(constexpr, bool, EnableEval, true)                                 \
                                                                        \
@@ -33,7 +33,7 @@ try {
 //CHECK-NEXT:    ProfilePoint      7
 //CHECK-NEXT:L6:
 //CHECK-NEXT:    ProfilePoint      5
-//CHECK-NEXT:    TryGetById        r1, r2, 1, "print"
+//CHECK-NEXT:    TryGetByIdThenGetByIdShort r1, r2, 1, "print"
 //CHECK-NEXT:    GetByIdShort      r6, r2, 2, "condition"
 //CHECK-NEXT:    JmpFalse          L1, r6
 //CHECK-NEXT:    ProfilePoint      4
@@ -59,7 +59,7 @@ try {
 //CHECK-NEXT:L4:
 //CHECK-NEXT:    Catch             r1
 //CHECK-NEXT:    ProfilePoint      9
-//CHECK-NEXT:    TryGetById        r2, r2, 1, "print"
+//CHECK-NEXT:    TryGetByIdThenGetByIdShort r2, r2, 1, "print"
 //CHECK-NEXT:    GetByIdShort      r1, r1, 3, "stack"
 //CHECK-NEXT:    Call2             r0, r2, r3, r1
 //CHECK-NEXT:L3:
@@ -13,7 +13,7 @@
 //CHECK-NEXT:    GetByIdShort      r1, r0, 1, "foo"
 //CHECK-NEXT:    LoadConstUndefined r2
 //CHECK-NEXT:    Call1             r1, r1, r2
-//CHECK-NEXT:    GetByIdShort      r0, r0, 1, "foo"
+//CHECK-NEXT:    GetByIdShortThenCall1 r0, r0, 1, "foo"
 //CHECK-NEXT:    Call1             r0, r0, r2
 //CHECK-NEXT:    Eq                r2, r1, r0
 //CHECK-NEXT:    Neq               r2, r1, r0
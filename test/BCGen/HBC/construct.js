@@ -14,7 +14,7 @@ function foo(x) {
 //CHECK-LABEL:Function<bar>(1 params, {{[0-9]+}} registers, 0 symbols):
 //CHECK-NEXT:Offset in debug table: {{.*}}
 //CHECK-NEXT:{{.*}} GetGlobalObject 0<Reg8>
-//CHECK-NEXT:{{.*}} GetByIdShort 2<Reg8>, 0<Reg8>, 1<UInt8>, 2<UInt8>
+//CHECK-NEXT:{{.*}} GetByIdShortThenGetByIdShort 2<Reg8>, 0<Reg8>, 1<UInt8>, 2<UInt8>
 //CHECK-NEXT:{{.*}} GetByIdShort 0<Reg8>, 2<Reg8>, 2<UInt8>, 3<UInt8>
 //CHECK-NEXT:{{.*}} CreateThis 1<Reg8>, 0<Reg8>, 2<Reg8>
 //CHECK-NEXT:{{.*}} LoadConstUInt8 3<Reg8>, 1<UInt8>
@@ -27,13 +27,13 @@
 //CHECK-NEXT:    LoadConstZero     r5
 //CHECK-NEXT:    AsyncBreakCheck
 //CHECK-NEXT:L3:
-//CHECK-NEXT:    TryGetById        r6, r0, 1, "Math"
+//CHECK-NEXT:    TryGetByIdThenGetByIdShort r6, r0, 1, "Math"
 //CHECK-NEXT:    GetByIdShort      r2, r6, 2, "random"
 //CHECK-NEXT:    Call1             r6, r2, r6
 //CHECK-NEXT:    Mov               r2, r5
 //CHECK-NEXT:    AsyncBreakCheck
 //CHECK-NEXT:    JStrictEqual      L1, r6, r4
-//CHECK-NEXT:    TryGetById        r7, r0, 1, "Math"
+//CHECK-NEXT:    TryGetByIdThenGetByIdShort r7, r0, 1, "Math"
 //CHECK-NEXT:    GetByIdShort      r6, r7, 2, "random"
 //CHECK-NEXT:    Call1             r6, r6, r7
 //CHECK-NEXT:    JStrictEqual      L2, r6, r1
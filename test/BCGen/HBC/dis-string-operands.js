@@ -22,7 +22,7 @@ delete glob.baz;
 //CHECK:    PutById           {{r[0-9]+}}, {{r[0-9]+}}, 1, "glob"
 //CHECK:    CreateRegExp      {{r[0-9]+}}, "foo", "i", 0
 //CHECK:    PutById           {{r[0-9]+}}, {{r[0-9]+}}, 2, "re"
-//CHECK:    GetByIdShort      {{r[0-9]+}}, {{r[0-9]+}}, 2, "glob"
+//CHECK:    GetByIdShortThenGetByIdShort {{r[0-9]+}}, {{r[0-9]+}}, 2, "glob"
 //CHECK:    GetByIdShort      {{r[0-9]+}}, {{r[0-9]+}}, 3, "baz"
 //CHECK:    LoadConstString   {{r[0-9]+}}, "const-string"
 //CHECK:    TryPutById        {{r[0-9]+}}, {{r[0-9]+}}, 3, "bazz"
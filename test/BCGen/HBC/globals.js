@@ -18,7 +18,7 @@ y = x;
 //CHECK-NEXT:    LoadConstUInt8    r0, 5
 //CHECK-NEXT:    GetGlobalObject   r1
 //CHECK-NEXT:    PutById           r1, r0, 1, "x"
-//CHECK-NEXT:    TryGetById        r3, r1, 1, "foo"
+//CHECK-NEXT:    TryGetByIdThenGetByIdShort r3, r1, 1, "foo"
 //CHECK-NEXT:    GetByIdShort      r2, r1, 2, "x"
 //CHECK-NEXT:    LoadConstUndefined r0
 //CHECK-NEXT:    Call2             r0, r3, r0, r2
@@ -32,7 +32,7 @@ y = x;
 //CHKNONSTRICT-NEXT:    LoadConstUInt8    r0, 5
 //CHKNONSTRICT-NEXT:    GetGlobalObject   r1
 //CHKNONSTRICT-NEXT:    PutById           r1, r0, 1, "x"
-//CHKNONSTRICT-NEXT:    TryGetById        r3, r1, 1, "foo"
+//CHKNONSTRICT-NEXT:    TryGetByIdThenGetByIdShort r3, r1, 1, "foo"
 //CHKNONSTRICT-NEXT:    GetByIdShort      r2, r1, 2, "x"
 //CHKNONSTRICT-NEXT:    LoadConstUndefined r0
 //CHKNONSTRICT-NEXT:    Call2             r0, r3, r0, r2
@@ -35,7 +35,7 @@ function foo() {
 // CHECK-NEXT:     LoadConstString   r1, "a string"
 // CHECK-NEXT:     StoreToEnvironment r0, 2, r1
 // CHECK-NEXT:     GetGlobalObject   r1
-// CHECK-NEXT:     TryGetById        r1, r1, 1, "Object"
+// CHECK-NEXT:     TryGetByIdThenGetByIdShort r1, r1, 1, "Object"
 // CHECK-NEXT:     GetByIdShort      r2, r1, 2, "prototype"
 // CHECK-NEXT:     CreateThis        r2, r2, r1
 // CHECK-NEXT:     Mov               r3, r2
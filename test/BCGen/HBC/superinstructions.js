@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermesc -O -dump-bytecode %s | %FileCheck --match-full-lines %s
+// RUN: %hermesc -O0 -dump-bytecode %s | %FileCheck --match-full-lines --check-prefix=CHKO0 %s
+
+// Check that adjacent pairs of instructions are fused into superinstructions
+// when optimizing, without changing the second instruction.
+
+function chain(o) {
+  return o.a.b;
+}
+// CHECK-LABEL: Function<chain>(2 params, {{[0-9]+}} registers, 0 symbols):
+// CHECK:    GetByIdShortThenGetByIdShort r0, r0, 1, "a"
+// CHECK-NEXT:    GetByIdShort      r0, r0, 2, "b"
+// CHECK-NEXT:    Ret               r0
+
+function longChain(o) {
+  return o.a.b.c;
+}
+// Pairs don't overlap.
+// CHECK-LABEL: Function<longChain>(2 params, {{[0-9]+}} registers, 0 symbols):
+// CHECK:    GetByIdShortThenGetByIdShort r0, r0, 1, "a"
+// CHECK-NEXT:    GetByIdShort      r0, r0, 2, "b"
+// CHECK-NEXT:    GetByIdShort      r0, r0, 3, "c"
+// CHECK-NEXT:    Ret               r0
+
+function method(o) {
+  return o.f();
+}
+// CHECK-LABEL: Function<method>(2 params, {{[0-9]+}} registers, 0 symbols):
+// CHECK:    GetByIdShortThenCall1 r0, r1, 1, "f"
+// CHECK-NEXT:    Call1             r0, r0, r1
+// CHECK-NEXT:    Ret               r0
+
+function global() {
+  return Math.PI;
+}
+// CHECK-LABEL: Function<global>(1 params, {{[0-9]+}} registers, 0 symbols):
+// CHECK:    TryGetByIdThenGetByIdShort r0, r0, 1, "Math"
+// CHECK-NEXT:    GetByIdShort      r0, r0, 2, "PI"
+// CHECK-NEXT:    Ret               r0
+
+// CHKO0-NOT: Then
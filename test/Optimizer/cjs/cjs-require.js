@@ -22,7 +22,7 @@ exports.bar = bar;
 //CHKOPT-NEXT:Offset in debug table: {{.*}}
 //CHKOPT-NEXT:    LoadConstUInt8    r2, 1
 //CHKOPT-NEXT:    CallBuiltin       r1, "HermesBuiltin.requireFast", 2
-//CHKOPT-NEXT:    GetByIdShort      r0, r1, 1, "foo"
+//CHKOPT-NEXT:    GetByIdShortThenCall1 r0, r1, 1, "foo"
 //CHKOPT-NEXT:    Call1             r0, r0, r1
 //CHKOPT-NEXT:    CreateEnvironment r0
 //CHKOPT-NEXT:    CreateClosure     r1, r0, 2
@@ -35,7 +35,7 @@ exports.bar = bar;
 //CHKOPT-NEXT:Offset in debug table: {{.*}}
 //CHKOPT-NEXT:    LoadConstUInt8    r2, 2
 //CHKOPT-NEXT:    CallBuiltin       r1, "HermesBuiltin.requireFast", 2
-//CHKOPT-NEXT:    GetByIdShort      r0, r1, 1, "baz"
+//CHKOPT-NEXT:    GetByIdShortThenCall1 r0, r1, 1, "baz"
 //CHKOPT-NEXT:    Call1             r0, r0, r1
 //CHKOPT-NEXT:    LoadConstUndefined r0
 //CHKOPT-NEXT:    Ret               r0
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O -dump-ir %s | %FileCheck --match-full-lines %s
+
+// Small functions are inlined into all their direct call sites, large ones
+// are only inlined if they have a single call.
+
+function sharedSmall(x) {
+  function sq(a) {
+    return a * a;
+  }
+  return sq(x) + sq(x + 1);
+}
+//CHECK-LABEL:function sharedSmall(x) : number
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = BinaryOperatorInst '*', %x, %x
+//CHECK-NEXT:  %1 = BinaryOperatorInst '+', %x, 1 : number
+//CHECK-NEXT:  %2 = BinaryOperatorInst '*', %1 : string|number, %1 : string|number
+//CHECK-NEXT:  %3 = BinaryOperatorInst '+', %0 : number, %2 : number
+//CHECK-NEXT:  %4 = ReturnInst %3 : number
+//CHECK-NEXT:function_end
+
+function sharedEscaping(x) {
+  function inc(a) {
+    return a + 1;
+  }
+  globalThis.inc = inc;
+  return inc(inc(x));
+}
+// The calls are inlined even though the closure escapes.
+//CHECK-LABEL:function sharedEscaping(x) : string|number
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = CreateFunctionInst %inc() : string|number
+//CHECK-NEXT:  %1 = TryLoadGlobalPropertyInst globalObject : object, "globalThis" : string
+//CHECK-NEXT:  %2 = StorePropertyInst %0 : closure, %1, "inc" : string
+//CHECK-NEXT:  %3 = BinaryOperatorInst '+', %x, 1 : number
+//CHECK-NEXT:  %4 = BinaryOperatorInst '+', %3 : string|number, 1 : number
+//CHECK-NEXT:  %5 = ReturnInst %4 : string|number
+//CHECK-NEXT:function_end
+
+//CHECK-LABEL:function inc(a) : string|number
+
+function sharedLarge(o) {
+  function big(o) {
+    o.a = 1; o.b = 2; o.c = 3; o.d = 4; o.e = 5; o.f = 6;
+    o.g = 7; o.h = 8; o.i = 9; o.j = 10; o.k = 11; o.l = 12;
+    o.m = 13; o.n = 14; o.o = 15; o.p = 16;
+    return o;
+  }
+  big(o);
+  return big(o);
+}
+//CHECK-LABEL:function sharedLarge(o)
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = CreateFunctionInst %big()
+//CHECK-NEXT:  %1 = CallInst %0 : closure, undefined : undefined, %o
+//CHECK-NEXT:  %2 = CallInst %0 : closure, undefined : undefined, %o
+//CHECK-NEXT:  %3 = ReturnInst %o
+//CHECK-NEXT:function_end
+
+//CHECK-LABEL:function big(o)
+
+function usesNewTarget() {
+  function nt() {
+    return new.target;
+  }
+  return nt();
+}
+// new.target would be the caller's after inlining.
+//CHECK-LABEL:function usesNewTarget()
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = CreateFunctionInst %nt()
+//CHECK-NEXT:  %1 = CallInst %0 : closure, undefined : undefined
+//CHECK-NEXT:  %2 = ReturnInst %1
+//CHECK-NEXT:function_end
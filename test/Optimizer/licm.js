@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O -dump-ir %s | %FileCheck --match-full-lines %s
+
+// Loop invariant computations are hoisted to the loop preheader.
+
+function capturedInvariant(k) {
+  k = k | 0;
+  return function (arr) {
+    var s = 0;
+    for (var i = 0; i < arr.length; i++)
+      s += arr[i] * (k + 1);
+    return s;
+  };
+}
+// The captured variable is only written by its owner, so it can be loaded
+// once even though the loop reads properties, which may run getters.
+//CHECK-LABEL:function capturedInvariant(k) : closure
+//CHECK-NEXT:frame = [k : number]
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = AsInt32Inst %k
+//CHECK-NEXT:  %1 = StoreFrameInst %0 : number, [k] : number
+//CHECK-NEXT:  %2 = CreateFunctionInst %""() : string|number
+//CHECK-NEXT:  %3 = ReturnInst %2 : closure
+//CHECK-NEXT:function_end
+//CHECK-LABEL:function ""(arr) : string|number
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = LoadPropertyInst %arr, "length" : string
+//CHECK-NEXT:  %1 = BinaryOperatorInst '<', 0 : number, %0
+//CHECK-NEXT:  %2 = CondBranchInst %1 : boolean, %BB1, %BB2
+//CHECK-NEXT:%BB1:
+//CHECK-NEXT:  %3 = LoadFrameInst [k@capturedInvariant] : number
+//CHECK-NEXT:  %4 = BinaryOperatorInst '+', %3 : number, 1 : number
+//CHECK-NEXT:  %5 = BranchInst %BB3
+//CHECK-NEXT:%BB3:
+//CHECK-NEXT:  %6 = PhiInst %10 : string|number, %BB3, 0 : number, %BB1
+//CHECK-NEXT:  %7 = PhiInst %11 : number, %BB3, 0 : number, %BB1
+//CHECK-NEXT:  %8 = LoadPropertyInst %arr, %7 : number
+//CHECK-NEXT:  %9 = BinaryOperatorInst '*', %8, %4 : number
+//CHECK-NEXT:  %10 = BinaryOperatorInst '+', %6 : string|number, %9 : number
+//CHECK-NEXT:  %11 = UnaryOperatorInst '++', %7 : number
+//CHECK-NEXT:  %12 = LoadPropertyInst %arr, "length" : string
+//CHECK-NEXT:  %13 = BinaryOperatorInst '<', %11 : number, %12
+//CHECK-NEXT:  %14 = CondBranchInst %13 : boolean, %BB3, %BB2
+//CHECK-NEXT:%BB2:
+//CHECK-NEXT:  %15 = PhiInst 0 : number, %BB0, %10 : string|number, %BB3
+//CHECK-NEXT:  %16 = ReturnInst %15 : string|number
+//CHECK-NEXT:function_end
+
+function nested(a, b) {
+  var x = +a, y = +b;
+  var s = 0;
+  for (var i = 0; i < 10; i++)
+    for (var j = 0; j < 10; j++)
+      s += x * y + j;
+  return s;
+}
+// The product is hoisted out of both loops.
+//CHECK-LABEL:function nested(a, b) : string|number
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = AsNumberInst %a
+//CHECK-NEXT:  %1 = AsNumberInst %b
+//CHECK-NEXT:  %2 = BinaryOperatorInst '*', %0 : number, %1 : number
+//CHECK-NEXT:  %3 = BranchInst %BB1
+//CHECK-NEXT:%BB1:
+//CHECK-NEXT:  %4 = PhiInst 0 : number, %BB0, %14 : string|number, %BB2
+//CHECK-NEXT:  %5 = PhiInst 0 : number, %BB0, %8 : number, %BB2
+//CHECK-NEXT:  %6 = BranchInst %BB3
+//CHECK-NEXT:%BB4:
+//CHECK-NEXT:  %7 = ReturnInst %14 : string|number
+//CHECK-NEXT:%BB2:
+//CHECK-NEXT:  %8 = UnaryOperatorInst '++', %5 : number
+//CHECK-NEXT:  %9 = BinaryOperatorInst '<', %8 : number, 10 : number
+//CHECK-NEXT:  %10 = CondBranchInst %9 : boolean, %BB1, %BB4
+//CHECK-NEXT:%BB3:
+//CHECK-NEXT:  %11 = PhiInst %4 : string|number, %BB1, %14 : string|number, %BB3
+//CHECK-NEXT:  %12 = PhiInst 0 : number, %BB1, %15 : number, %BB3
+//CHECK-NEXT:  %13 = BinaryOperatorInst '+', %2 : number, %12 : number
+//CHECK-NEXT:  %14 = BinaryOperatorInst '+', %11 : string|number, %13 : number
+//CHECK-NEXT:  %15 = UnaryOperatorInst '++', %12 : number
+//CHECK-NEXT:  %16 = BinaryOperatorInst '<', %15 : number, 10 : number
+//CHECK-NEXT:  %17 = CondBranchInst %16 : boolean, %BB3, %BB2
+//CHECK-NEXT:function_end
+
+function multipleEntries(a, b, c) {
+  var x = +a, y = +b;
+  var i = 0;
+  if (c) i = 5;
+  var s = 0;
+  do {
+    s += x * y;
+  } while (++i < 10);
+  return s;
+}
+// A preheader is created to merge the entries of the loop.
+//CHECK-LABEL:function multipleEntries(a, b, c) : string|number
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = AsNumberInst %a
+//CHECK-NEXT:  %1 = AsNumberInst %b
+//CHECK-NEXT:  %2 = CondBranchInst %c, %BB1, %BB2
+//CHECK-NEXT:%BB1:
+//CHECK-NEXT:  %3 = BranchInst %BB2
+//CHECK-NEXT:%BB2:
+//CHECK-NEXT:  %4 = PhiInst 5 : number, %BB1, 0 : number, %BB0
+//CHECK-NEXT:  %5 = BinaryOperatorInst '*', %0 : number, %1 : number
+//CHECK-NEXT:  %6 = BranchInst %BB3
+//CHECK-NEXT:%BB3:
+//CHECK-NEXT:  %7 = PhiInst %4 : number, %BB2, %10 : number, %BB3
+//CHECK-NEXT:  %8 = PhiInst 0 : number, %BB2, %9 : string|number, %BB3
+//CHECK-NEXT:  %9 = BinaryOperatorInst '+', %8 : string|number, %5 : number
+//CHECK-NEXT:  %10 = UnaryOperatorInst '++', %7 : number
+//CHECK-NEXT:  %11 = BinaryOperatorInst '<', %10 : number, 10 : number
+//CHECK-NEXT:  %12 = CondBranchInst %11 : boolean, %BB3, %BB4
+//CHECK-NEXT:%BB4:
+//CHECK-NEXT:  %13 = ReturnInst %9 : string|number
+//CHECK-NEXT:function_end
+
+function writtenByCallee(cb) {
+  var k = 0;
+  cb(function () {
+    k++;
+  });
+  var s = 0;
+  for (var i = 0; i < 10; i++) {
+    s += k * 2;
+    cb();
+  }
+  return s;
+}
+// The call in the loop may write the variable, so it is loaded in every
+// iteration.
+//CHECK-LABEL:function writtenByCallee(cb) : string|number
+//CHECK-NEXT:frame = [k : number]
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = StoreFrameInst 0 : number, [k] : number
+//CHECK-NEXT:  %1 = CreateFunctionInst %" 1#"() : undefined
+//CHECK-NEXT:  %2 = CallInst %cb, undefined : undefined, %1 : closure
+//CHECK-NEXT:  %3 = BranchInst %BB1
+//CHECK-NEXT:%BB1:
+//CHECK-NEXT:  %4 = PhiInst 0 : number, %BB0, %8 : string|number, %BB1
+//CHECK-NEXT:  %5 = PhiInst 0 : number, %BB0, %10 : number, %BB1
+//CHECK-NEXT:  %6 = LoadFrameInst [k] : number
+//CHECK-NEXT:  %7 = BinaryOperatorInst '*', %6 : number, 2 : number
+//CHECK-NEXT:  %8 = BinaryOperatorInst '+', %4 : string|number, %7 : number
+//CHECK-NEXT:  %9 = CallInst %cb, undefined : undefined
+//CHECK-NEXT:  %10 = UnaryOperatorInst '++', %5 : number
+//CHECK-NEXT:  %11 = BinaryOperatorInst '<', %10 : number, 10 : number
+//CHECK-NEXT:  %12 = CondBranchInst %11 : boolean, %BB1, %BB2
+//CHECK-NEXT:%BB2:
+//CHECK-NEXT:  %13 = ReturnInst %8 : string|number
+//CHECK-NEXT:function_end
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O -dump-ir %s | %FileCheck --match-full-lines %s
+
+// Object literals which don't escape are replaced with their properties.
+
+function point(ax, ay, bx, by) {
+  var p = {x: bx - ax, y: by - ay};
+  return p.x * p.x + p.y * p.y;
+}
+//CHECK-LABEL:function point(ax, ay, bx, by) : number
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = BinaryOperatorInst '-', %bx, %ax
+//CHECK-NEXT:  %1 = BinaryOperatorInst '-', %by, %ay
+//CHECK-NEXT:  %2 = BinaryOperatorInst '*', %0 : number, %0 : number
+//CHECK-NEXT:  %3 = BinaryOperatorInst '*', %1 : number, %1 : number
+//CHECK-NEXT:  %4 = BinaryOperatorInst '+', %2 : number, %3 : number
+//CHECK-NEXT:  %5 = ReturnInst %4 : number
+//CHECK-NEXT:function_end
+
+function optionBag(a) {
+  var o = {verbose: false, depth: 3};
+  if (a)
+    o.depth = a;
+  return o.depth;
+}
+// The conditional store becomes a phi.
+//CHECK-LABEL:function optionBag(a)
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = CondBranchInst %a, %BB1, %BB2
+//CHECK-NEXT:%BB1:
+//CHECK-NEXT:  %1 = BranchInst %BB2
+//CHECK-NEXT:%BB2:
+//CHECK-NEXT:  %2 = PhiInst %a, %BB1, 3 : number, %BB0
+//CHECK-NEXT:  %3 = ReturnInst %2
+//CHECK-NEXT:function_end
+
+function inLoop(n) {
+  var acc = {sum: 0, count: 0};
+  for (var i = 0; i < n; i++) {
+    acc.sum += i;
+    acc.count++;
+  }
+  return acc.sum / acc.count;
+}
+// The properties updated in the loop become loop-carried values.
+//CHECK-LABEL:function inLoop(n) : number
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = BinaryOperatorInst '<', 0 : number, %n
+//CHECK-NEXT:  %1 = CondBranchInst %0 : boolean, %BB1, %BB2
+//CHECK-NEXT:%BB1:
+//CHECK-NEXT:  %2 = PhiInst 0 : number, %BB0, %6 : number, %BB1
+//CHECK-NEXT:  %3 = PhiInst 0 : number, %BB0, %5 : string|number, %BB1
+//CHECK-NEXT:  %4 = PhiInst 0 : number, %BB0, %7 : number, %BB1
+//CHECK-NEXT:  %5 = BinaryOperatorInst '+', %3 : string|number, %4 : number
+//CHECK-NEXT:  %6 = UnaryOperatorInst '++', %2 : number
+//CHECK-NEXT:  %7 = UnaryOperatorInst '++', %4 : number
+//CHECK-NEXT:  %8 = BinaryOperatorInst '<', %7 : number, %n
+//CHECK-NEXT:  %9 = CondBranchInst %8 : boolean, %BB1, %BB2
+//CHECK-NEXT:%BB2:
+//CHECK-NEXT:  %10 = PhiInst 0 : number, %BB0, %6 : number, %BB1
+//CHECK-NEXT:  %11 = PhiInst 0 : number, %BB0, %5 : string|number, %BB1
+//CHECK-NEXT:  %12 = BinaryOperatorInst '/', %11 : string|number, %10 : number
+//CHECK-NEXT:  %13 = ReturnInst %12 : number
+//CHECK-NEXT:function_end
+
+function afterInlining(a, b) {
+  function area(rect) {
+    return rect.w * rect.h;
+  }
+  return area({w: a, h: b});
+}
+// The object only stops escaping once the call is inlined.
+//CHECK-LABEL:function afterInlining(a, b) : number
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = BinaryOperatorInst '*', %a, %b
+//CHECK-NEXT:  %1 = ReturnInst %0 : number
+//CHECK-NEXT:function_end
+
+function escapes(a) {
+  var o = {x: a};
+  print(o);
+  return o.x;
+}
+// The object is passed to a call, so it is kept.
+//CHECK-LABEL:function escapes(a)
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = AllocObjectLiteralInst "x" : string, %a
+//CHECK-NEXT:  %1 = TryLoadGlobalPropertyInst globalObject : object, "print" : string
+//CHECK-NEXT:  %2 = CallInst %1, undefined : undefined, %0 : object
+//CHECK-NEXT:  %3 = LoadPropertyInst %0 : object, "x" : string
+//CHECK-NEXT:  %4 = ReturnInst %3
+//CHECK-NEXT:function_end
+
+function unknownProperty(a) {
+  var o = {x: a};
+  return o.y;
+}
+// Reading a property the literal doesn't define looks up the prototype, so
+// the object is kept.
+//CHECK-LABEL:function unknownProperty(a)
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = AllocObjectLiteralInst "x" : string, %a
+//CHECK-NEXT:  %1 = LoadPropertyInst %0 : object, "y" : string
+//CHECK-NEXT:  %2 = ReturnInst %1
+//CHECK-NEXT:function_end
@@ -5,7 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
-// RUN: %hermes -dump-ir %s -O | %FileCheck %s --match-full-lines
+// RUN: %hermes -dump-ir %s -O -fno-inline | %FileCheck %s --match-full-lines
 
 //CHECK-LABEL:function g14(z) : undefined|object
 //CHECK-NEXT:frame = [w : closure]
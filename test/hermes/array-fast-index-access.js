@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// Indexed reads and writes of arrays must bypass the generic property lookup
+// only when that is unobservable.
+
+function get(a, i) {
+  return a[i];
+}
+function put(a, i, v) {
+  a[i] = v;
+}
+
+var a = [1, 2, 3];
+put(a, 1, 'x');
+put(a, 3, 'appended');
+print(get(a, 0), get(a, 1), get(a, 3), a.length);
+// CHECK: 1 x appended 4
+
+// Holes are looked up on the prototype chain.
+var holey = [0, , 2];
+Array.prototype[1] = 'proto';
+print(get(holey, 1));
+// CHECK-NEXT: proto
+delete Array.prototype[1];
+print(get(holey, 1));
+// CHECK-NEXT: undefined
+
+// Filling holes and appending must call setters on the prototype chain.
+Object.defineProperty(Array.prototype, 5, {
+  set: function (v) {
+    print('setter', v);
+  },
+  configurable: true,
+});
+var b = [0, 1, 2, 3, 4];
+put(b, 5, 'five');
+// CHECK-NEXT: setter five
+print(b.length, b.hasOwnProperty(5));
+// CHECK-NEXT: 5 false
+delete Array.prototype[5];
+Object.defineProperty(Object.prototype, '2', {
+  set: function (v) {
+    print('object setter', v);
+  },
+  configurable: true,
+});
+put(holey, 2, 'ok');
+put(holey, 1, 'filled');
+print(holey[1], holey[2]);
+// CHECK-NEXT: filled ok
+var c = [0, 1];
+put(c, 2, 'two');
+// CHECK-NEXT: object setter two
+print(c.length);
+// CHECK-NEXT: 2
+delete Object.prototype[2];
+
+// Frozen, sealed and non-extensible arrays.
+var frozen = Object.freeze([1, 2]);
+put(frozen, 0, 'x');
+put(frozen, 2, 'x');
+print(frozen[0], frozen.length);
+// CHECK-NEXT: 1 2
+var sealed = Object.seal([1, 2]);
+put(sealed, 0, 'x');
+put(sealed, 2, 'x');
+print(sealed[0], sealed.length);
+// CHECK-NEXT: x 2
+var noExt = Object.preventExtensions([1, , 3]);
+put(noExt, 1, 'x');
+print(noExt[1], noExt.length);
+// CHECK-NEXT: undefined 3
+
+// A read-only length prevents appending.
+var fixed = [1, 2];
+Object.defineProperty(fixed, 'length', {writable: false});
+put(fixed, 2, 'x');
+print(fixed.length, fixed[2]);
+// CHECK-NEXT: 2 undefined
+
+// Non-index keys and index-like strings go through the slow path.
+var d = [10, 20];
+put(d, '1', 'str');
+put(d, 1.5, 'frac');
+put(d, -1, 'neg');
+print(get(d, '1'), get(d, 1.5), get(d, -1), d.length);
+// CHECK-NEXT: str frac neg 2
+
+// Growing past the initial capacity.
+var e = [];
+for (var i = 0; i < 100; ++i)
+  put(e, i, i);
+print(e.length, get(e, 99));
+// CHECK-NEXT: 100 99
+
+// Arrays with a different prototype.
+var f = [];
+Object.setPrototypeOf(f, {
+  set 0(v) {
+    print('custom proto', v);
+  },
+});
+put(f, 0, 'zero');
+// CHECK-NEXT: custom proto zero
+print(f.length);
+// CHECK-NEXT: 0
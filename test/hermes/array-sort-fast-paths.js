@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+"use strict";
+
+// Dense arrays are sorted as a list of values, and arrays of numbers or
+// strings sorted without a compare function don't call into JS.
+
+print('array-sort-fast-paths');
+// CHECK-LABEL: array-sort-fast-paths
+
+// Numbers are ordered by their string conversion.
+print([10, 9, 1, 2, 100, -1, -10, -2, 0, -0, undefined, 3].sort().join());
+// CHECK-NEXT: -1,-10,-2,0,0,1,10,100,2,3,9,
+print([1.5, 10, 2.25, -0.5, 1e21, NaN, Infinity, -Infinity, 2].sort().join());
+// CHECK-NEXT: -0.5,-Infinity,1.5,10,1e+21,2,2.25,Infinity,NaN
+print([2147483647, -2147483648, 214748364, 0].sort().join());
+// CHECK-NEXT: -2147483648,0,214748364,2147483647
+var a = [3, -0, 0, -0, 1];
+a.sort();
+print(a.map(function(x) { return Object.is(x, -0) ? '-0' : x; }).join());
+// CHECK-NEXT: -0,0,-0,1,3
+
+// Strings, with undefined last.
+print(['b', 'a', undefined, 'c', 'aa', 'B', 'aé', 'aè'].sort().join());
+// CHECK-NEXT: B,a,aa,aè,aé,b,c,
+
+// Mixed values are converted to strings when compared.
+print([3, '2', 1, {toString: function() { return '0'; }}, true].sort().join());
+// CHECK-NEXT: 0,1,2,3,true
+
+// The sort is stable, and takes advantage of existing runs.
+var rows = [];
+for (var i = 0; i < 2000; i++)
+  rows.push({k: (i * 7) % 13, i: i});
+rows.sort(function(x, y) { return x.k - y.k; });
+var stable = true;
+for (var i = 1; i < rows.length; i++) {
+  var p = rows[i - 1], c = rows[i];
+  if (p.k > c.k || (p.k === c.k && p.i > c.i))
+    stable = false;
+}
+print(stable);
+// CHECK-NEXT: true
+var calls = 0;
+var sorted = [];
+for (var i = 0; i < 1000; i++)
+  sorted.push(i);
+sorted.sort(function(x, y) { calls++; return x - y; });
+print(calls);
+// CHECK-NEXT: 999
+sorted.reverse();
+calls = 0;
+sorted.sort(function(x, y) { calls++; return x - y; });
+print(calls, sorted[0], sorted[999]);
+// CHECK-NEXT: 999 0 999
+
+// Holes are moved to the end.
+var h = [5, , 3, undefined, 1];
+h.sort();
+print(h.length, 3 in h, 4 in h, h.join());
+// CHECK-NEXT: 5 true false 1,3,5,,
+
+// The compare function sees a copy of the values, and they are written back
+// even if it changes the array.
+var c = [3, 2, 1];
+c.sort(function(x, y) { c.length = 0; return x - y; });
+print(c.join(), c.length);
+// CHECK-NEXT: 1,2,3 3
+
+// Exceptions from the compare function propagate.
+try {
+  [2, 1, 3].sort(function() { throw new Error('cmp'); });
+} catch (e) {
+  print(e.message);
+}
+// CHECK-NEXT: cmp
+
+// Frozen arrays can't be sorted.
+try {
+  Object.freeze([2, 1]).sort();
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: TypeError
+
+// Typed arrays without a compare function are sorted numerically, with -0
+// before +0 and NaN last.
+function show(t) {
+  return Array.prototype.map.call(t, function(x) {
+    return Object.is(x, -0) ? '-0' : String(x);
+  }).join();
+}
+var f = new Float64Array([3, NaN, -0, 0, -1, Infinity, -Infinity, 0, -0]);
+print(show(f.sort()));
+// CHECK-NEXT: -Infinity,-1,-0,-0,0,0,3,Infinity,NaN
+print(show(new Float32Array([NaN, 1.5, -0, -2]).sort()));
+// CHECK-NEXT: -2,-0,1.5,NaN
+print(new Int8Array([5, -128, 127, 0, -1]).sort().join());
+// CHECK-NEXT: -128,-1,0,5,127
+print(new Uint8ClampedArray([255, 0, 7, 7]).sort().join());
+// CHECK-NEXT: 0,7,7,255
+print(new Uint32Array([4000000000, 1, 3]).sort().join());
+// CHECK-NEXT: 1,3,4000000000
+var w = new Int16Array(10000);
+for (var i = 0; i < w.length; i++)
+  w[i] = (i * 7919) % 65536 - 32768;
+w.sort();
+var ordered = true;
+for (var i = 1; i < w.length; i++)
+  ordered = ordered && w[i - 1] <= w[i];
+print(ordered, w[0], w[w.length - 1]);
+// CHECK-NEXT: true -32768 32762
+print(new Int32Array([3, 1, 2]).sort(function(x, y) { return y - x; }).join());
+// CHECK-NEXT: 3,2,1
@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O -gc-parallel-threads=4 %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -gc-parallel-threads=1 %s | %FileCheck --match-full-lines %s
+
+// Build linked object graphs that survive several young gen collections, with
+// old-to-young pointers that are only reachable through dirty cards.
+
+var old = [];
+for (var i = 0; i < 1000; i++) old.push({idx: i, ref: null});
+
+var keep = [];
+for (var round = 0; round < 8; round++) {
+  var arr = [];
+  for (var i = 0; i < 20000; i++) {
+    var o = {a: i, b: 'x' + i, c: [i, i + 1], d: null};
+    if (i > 0) o.d = arr[i - 1];
+    arr.push(o);
+    if (i % 10 === 0) old[(i + round) % old.length].ref = o;
+  }
+  keep.push(arr);
+  if (keep.length > 3) keep.shift();
+}
+
+var sum = 0;
+for (var k = 0; k < keep.length; k++) {
+  var a = keep[k];
+  for (var i = 0; i < a.length; i++) {
+    if (a[i].a !== i || a[i].b !== 'x' + i || a[i].c[1] !== i + 1)
+      throw new Error('bad object ' + i);
+    if (i > 0 && a[i].d !== a[i - 1])
+      throw new Error('bad link ' + i);
+    sum += a[i].c[0];
+  }
+}
+for (var i = 0; i < old.length; i++) {
+  if (old[i].ref && typeof old[i].ref.a !== 'number')
+    throw new Error('bad old object ' + i);
+}
+print(sum);
+// CHECK: 599970000
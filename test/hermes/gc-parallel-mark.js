@@ -0,0 +1,40 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -gc-concurrent-threads=4 %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -gc-concurrent-threads=1 %s | %FileCheck --match-full-lines %s
+
+// Wide trees that survive into the OG, so that OG marking has plenty of
+// cells to share between threads.
+function makeTree(depth, width) {
+  if (depth === 0) return {leaf: true, s: 'v' + width};
+  var children = [];
+  for (var i = 0; i < width; i++) children.push(makeTree(depth - 1, width));
+  return {children: children, weak: new WeakMap()};
+}
+function count(t) {
+  if (t.leaf) return 1;
+  var n = 0;
+  for (var i = 0; i < t.children.length; i++) n += count(t.children[i]);
+  return n;
+}
+var keep = [];
+var wm = new WeakMap();
+for (var round = 0; round < 8; round++) {
+  var t = makeTree(4, 10);
+  wm.set(t, {round: round});
+  keep.push(t);
+  if (keep.length > 3) keep.shift();
+  for (var j = 0; j < 20000; j++) ({garbage: j, s: 'g' + j});
+}
+var total = 0;
+for (var k = 0; k < keep.length; k++) {
+  total += count(keep[k]);
+  if (wm.get(keep[k]).round !== 5 + k) throw new Error('bad weak map');
+}
+print(total);
+// CHECK: 30000
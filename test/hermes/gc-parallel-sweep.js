@@ -0,0 +1,32 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -gc-concurrent-threads=4 %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -gc-concurrent-threads=1 %s | %FileCheck --match-full-lines %s
+
+// Fill several OG segments, then drop most of it, so that sweeping finds dead
+// cells with and without finalizers across many segments.
+
+var keep = [];
+for (var round = 0; round < 4; round++) {
+  var arr = [];
+  for (var i = 0; i < 40000; i++)
+    arr.push({i: i, s: 'str' + i + '_' + round, b: new ArrayBuffer(16)});
+  keep.push(arr);
+  if (keep.length > 1) keep.shift();
+}
+
+var total = 0;
+for (var k = 0; k < keep.length; k++) {
+  for (var i = 0; i < keep[k].length; i++) {
+    if (keep[k][i].s !== 'str' + i + '_3')
+      throw new Error('bad string ' + i);
+    total += keep[k][i].i + keep[k][i].b.byteLength;
+  }
+}
+print(total);
+// CHECK: 800620000
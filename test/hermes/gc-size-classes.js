@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -gc-init-heap=4M %s | %FileCheck --match-full-lines %s
+
+// Promote small objects of several sizes into old generation size class
+// pages, free some of them, and keep pointing old objects at new ones so that
+// the card boundaries within the pages get used.
+
+function make(i) {
+  switch (i % 4) {
+    case 0:
+      return {i: i};
+    case 1:
+      return {i: i, a: null, b: null};
+    case 2:
+      return [i, null, null, null, null, null];
+    default:
+      return {i: i, s: 'cell' + i};
+  }
+}
+
+var keep = [];
+for (var round = 0; round < 5; round++) {
+  for (var i = 0; i < 10000; i++) {
+    var obj = make(i);
+    if (keep.length > 20000)
+      keep[(i * 7 + round) % keep.length] = obj;
+    else
+      keep.push(obj);
+    var old = keep[(i * 13) % keep.length];
+    if (i % 4 === 1 && old.a === null)
+      old.a = {young: i};
+  }
+}
+
+var total = 0;
+for (var i = 0; i < keep.length; i++) {
+  var obj = keep[i];
+  total += Array.isArray(obj) ? obj[0] : obj.i;
+  if (obj.a)
+    total += obj.a.young;
+}
+print(keep.length, total);
+// CHECK: 20001 100266436
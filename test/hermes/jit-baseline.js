@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -Xforce-jit -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -Xforce-jit -O0 %s | %FileCheck --match-full-lines %s
+
+// Check that functions compiled by the baseline JIT behave like interpreted
+// ones. Without JIT support the flag has no effect and the test still passes.
+
+print('jit');
+// CHECK-LABEL: jit
+
+function arith(a, b) {
+  return [a + b, a - b, a * b, a / b, a % b, -a, a < b, a <= b, a > b, a >= b];
+}
+print(arith(7, 2).join());
+// CHECK-NEXT: 9,5,14,3.5,1,-7,false,false,true,true
+print(arith('7', 2).join());
+// CHECK-NEXT: 72,5,14,3.5,1,-7,false,false,true,true
+print(arith(NaN, 1).join());
+// CHECK-NEXT: NaN,NaN,NaN,NaN,NaN,NaN,false,false,false,false
+print(arith({valueOf: function() { return 3; }}, 3).join());
+// CHECK-NEXT: 6,0,9,1,0,-3,false,true,false,true
+
+function sumTo(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++)
+    sum += i;
+  return sum;
+}
+print(sumTo(100), sumTo('10'), sumTo(NaN));
+// CHECK-NEXT: 4950 45 0
+
+function countDown(n) {
+  var steps = 0;
+  while (n >= 1) {
+    n = n / 2;
+    --n;
+    ++steps;
+  }
+  return steps;
+}
+print(countDown(1000));
+// CHECK-NEXT: 9
+
+function truthy(v) {
+  if (v)
+    return 'yes';
+  return 'no';
+}
+print(
+    truthy(true), truthy(false), truthy(0), truthy(-0), truthy(NaN),
+    truthy(''), truthy('a'), truthy(null), truthy(undefined), truthy({}));
+// CHECK-NEXT: yes no no no no no yes no no yes
+
+function equality(a, b) {
+  var r = '';
+  if (a == b) r += 'eq ';
+  if (a != b) r += 'ne ';
+  if (a === b) r += 'seq ';
+  if (a !== b) r += 'sne ';
+  if (a === undefined) r += 'undef';
+  return r;
+}
+print(equality(1, '1'));
+// CHECK-NEXT: eq sne
+print(equality(undefined, null));
+// CHECK-NEXT: eq sne undef
+print(equality(NaN, NaN));
+// CHECK-NEXT: ne sne
+
+function Point(x, y) {
+  this.x = x;
+  this.y = y;
+}
+Point.prototype.norm2 = function() {
+  return this.x * this.x + this.y * this.y;
+};
+function makePoints(n) {
+  var points = [];
+  for (var i = 0; i < n; ++i)
+    points.push(new Point(i, i + 1));
+  var total = 0;
+  for (var j = 0; j < points.length; ++j)
+    total += points[j].norm2();
+  return total;
+}
+print(makePoints(10));
+// CHECK-NEXT: 670
+
+function counter() {
+  var count = 0;
+  return function() {
+    return ++count;
+  };
+}
+var c = counter();
+c();
+c();
+print(c());
+// CHECK-NEXT: 3
+
+function iterate(obj, arr) {
+  var keys = [];
+  for (var k in obj)
+    keys.push(k + '=' + obj[k]);
+  for (var v of arr)
+    keys.push(v);
+  return keys.join();
+}
+print(iterate({a: 1, b: 2}, ['x', 'y']));
+// CHECK-NEXT: a=1,b=2,x,y
+
+function sw(x) {
+  switch (x) {
+    case 0: return 'zero';
+    case 1: return 'one';
+    case 2: return 'two';
+    case 3: return 'three';
+    default: return 'many';
+  }
+}
+print(sw(0), sw(3), sw(7));
+// CHECK-NEXT: zero three many
+
+function thrower(x) {
+  if (x > 1)
+    throw new Error('too big: ' + x);
+  return x;
+}
+function catcher(n) {
+  var caught = 0;
+  for (var i = 0; i < n; ++i) {
+    try {
+      thrower(i);
+    } catch (e) {
+      ++caught;
+    }
+  }
+  return caught;
+}
+print(catcher(5));
+// CHECK-NEXT: 3
+
+try {
+  thrower(5);
+} catch (e) {
+  print(e.message);
+  print(e.stack.split('\n')[1].trim().split(' ')[1]);
+}
+// CHECK-NEXT: too big: 5
+// CHECK-NEXT: thrower
+
+function typeError(o) {
+  return o.missing.prop;
+}
+try {
+  typeError({});
+} catch (e) {
+  print(e.constructor.name);
+}
+// CHECK-NEXT: TypeError
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+"use strict";
+
+// The JSON lexer scans strings and whitespace in bulk, converts simple
+// numbers without strtod, and converts long ASCII input to UTF-16 a chunk at
+// a time. Check the boundary cases of each.
+
+print('json-parse-lexing');
+// CHECK-LABEL: json-parse-lexing
+
+// Numbers on both sides of the fast path.
+var nums = ['0', '-0', '7', '-12', '0.5', '-0.25', '123456789012345',
+  '1234567890123456', '12345678.9012345', '1234567.89012345678',
+  '0.000000000000001', '0.1', '0.3', '3.14159', '9007199254740993',
+  '1e3', '1.5E-3', '-2e+2', '1.7976931348623157e308', '5e-324'];
+var bad = 0;
+nums.forEach(function (n) {
+  var v = JSON.parse(n);
+  if (!Object.is(v, Number(n))) {
+    print('mismatch', n, v);
+    bad++;
+  }
+  // Followed by whitespace or punctuation, and inside an array.
+  if (!Object.is(JSON.parse(' ' + n + ' '), v) ||
+      !Object.is(JSON.parse('[' + n + ',' + n + ']')[1], v))
+    bad++;
+});
+print(bad, Object.is(JSON.parse('-0'), -0));
+// CHECK-NEXT: 0 true
+
+// Numbers made of random digits.
+var seed = 1;
+function random(n) {
+  seed = (seed * 1103515245 + 12345) % 2147483648;
+  return seed % n;
+}
+for (var i = 0; i < 2000; i++) {
+  var s = (random(2) ? '-' : '') + (1 + random(9));
+  for (var j = random(18); j > 0; j--)
+    s += random(10);
+  if (random(2)) {
+    s += '.';
+    for (var j = 1 + random(18); j > 0; j--)
+      s += random(10);
+  }
+  if (!Object.is(JSON.parse(s), Number(s))) {
+    print('mismatch', s);
+    bad++;
+  }
+}
+print(bad);
+// CHECK-NEXT: 0
+
+// Malformed numbers are still rejected.
+['01', '-', '.5', '1e', '1.2.3', '+1', '1-'].forEach(function (n) {
+  try {
+    JSON.parse(n);
+    print('accepted', n);
+  } catch (e) {
+    bad++;
+  }
+});
+print(bad);
+// CHECK-NEXT: 7
+
+// Strings with escapes and control characters at every position in a block.
+var escapes = ['\\"', '\\\\', '\\n', '\\u00e9', '\\ud83d\\ude00'];
+bad = 0;
+for (var len = 0; len < 40; len++) {
+  escapes.forEach(function (e) {
+    var prefix = 'x'.repeat(len);
+    var json = '"' + prefix + e + prefix + '"';
+    if (JSON.parse(json) !== prefix + JSON.parse('"' + e + '"') + prefix)
+      bad++;
+  });
+  try {
+    JSON.parse('"' + 'y'.repeat(len) + '\u0001"');
+    bad++;
+  } catch (e) {}
+}
+print(bad);
+// CHECK-NEXT: 0
+
+// Long input, so that escapes, numbers and whitespace straddle the boundaries
+// of the chunks converted from ASCII to UTF-16, and the same in UTF-16.
+function check(json) {
+  var res = JSON.parse(json);
+  return JSON.stringify(res) === JSON.stringify(JSON.parse(json.trim()));
+}
+var parts = [];
+for (var i = 0; i < 3000; i++) {
+  parts.push(' '.repeat(i % 37) + '{"k' + (i % 5) + '":"a\\tb\\"' +
+    'c'.repeat(i % 29) + '","n":' + (i * 1.25 - 1000) + '}\n');
+}
+var longJSON = '[' + parts.join(',') + ']';
+var parsed = JSON.parse(longJSON);
+print(longJSON.length > 100000, parsed.length, parsed[2999].n,
+  JSON.stringify(parsed[7]));
+// CHECK-NEXT: true 3000 2748.75 {"k2":"a\tb\"ccccccc","n":-991.25}
+var longUTF16 = longJSON.replace('"k0"', '"ké"');
+var parsed16 = JSON.parse(longUTF16);
+print(parsed16.length, Object.keys(parsed16[0])[0],
+  JSON.stringify(parsed16.slice(1)) === JSON.stringify(parsed.slice(1)));
+// CHECK-NEXT: 3000 ké true
+try {
+  JSON.parse(longJSON + ' "unterminated');
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: SyntaxError
+try {
+  JSON.parse(longJSON.slice(0, -1) + ', 012]');
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: SyntaxError
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+"use strict";
+
+// Objects with the same keys as the previous object at the same position in
+// the document are created with its hidden class. Check that objects whose
+// keys differ still come out right.
+
+print('json-parse-templates');
+// CHECK-LABEL: json-parse-templates
+
+function show(json) {
+  var res = JSON.parse(json);
+  var keys = [];
+  for (var i = 0; i < res.length; i++)
+    keys.push(Object.keys(res[i]).join(''));
+  print(JSON.stringify(res), keys.join(' '));
+}
+
+// Same keys, fewer keys, more keys, other keys, other order.
+show('[{"a":1,"b":2},{"a":3,"b":4},{"a":5},{"a":6,"b":7,"c":8},' +
+  '{"x":9},{"b":10,"a":11},{"b":12,"a":13},{}]');
+// CHECK-NEXT: [{"a":1,"b":2},{"a":3,"b":4},{"a":5},{"a":6,"b":7,"c":8},{"x":9},{"b":10,"a":11},{"b":12,"a":13},{}] ab ab a abc x ba ba
+// Duplicate keys.
+show('[{"a":1,"b":2},{"a":1,"a":2},{"a":3,"b":4,"a":5},{"a":6,"b":7}]');
+// CHECK-NEXT: [{"a":1,"b":2},{"a":2},{"a":5,"b":4},{"a":6,"b":7}] ab a ab ab
+// Index-like keys.
+show('[{"1":1,"0":0,"z":2},{"1":3,"0":4,"z":5}]');
+// CHECK-NEXT: [{"0":0,"1":1,"z":2},{"0":4,"1":3,"z":5}] 01z 01z
+
+// Nested records, and arrays of records inside records.
+var res = JSON.parse(
+  '[{"id":1,"user":{"name":"a","tags":[{"t":1},{"t":2}]}},' +
+  '{"id":2,"user":{"name":"b","tags":[{"t":3},{"u":4}]}},' +
+  '{"id":3,"user":{"name":"c","age":5,"tags":[]}},' +
+  '{"id":4,"user":null}]');
+print(JSON.stringify(res));
+// CHECK-NEXT: [{"id":1,"user":{"name":"a","tags":[{"t":1},{"t":2}]}},{"id":2,"user":{"name":"b","tags":[{"t":3},{"u":4}]}},{"id":3,"user":{"name":"c","age":5,"tags":[]}},{"id":4,"user":null}]
+
+// Objects are ordinary objects which can be modified independently.
+res[0].extra = true;
+delete res[1].id;
+res[2].user.name = 'd';
+print(JSON.stringify(res[0]), JSON.stringify(res[1]), res[2].user.name);
+// CHECK-NEXT: {"id":1,"user":{"name":"a","tags":[{"t":1},{"t":2}]},"extra":true} {"user":{"name":"b","tags":[{"t":3},{"u":4}]}} d
+
+// Many records with many properties, some of them in indirect storage.
+var json = [];
+for (var i = 0; i < 200; i++) {
+  var rec = {};
+  for (var j = 0; j < 20; j++)
+    rec['k' + j] = i * 100 + j;
+  if (i % 50 === 49)
+    rec['k' + (i % 20)] = 'x';
+  if (i % 30 === 29)
+    delete rec.k19;
+  json.push(rec);
+}
+var parsed = JSON.parse(JSON.stringify(json));
+print(JSON.stringify(parsed) === JSON.stringify(json), parsed[199].k9,
+  Object.keys(parsed[29]).length, parsed[49].k9);
+// CHECK-NEXT: true 19909 19 x
+
+// Records with more properties than a hidden class holds.
+var big = {};
+for (var i = 0; i < 100; i++)
+  big['p' + i] = i;
+var bigJSON = JSON.stringify([big, big, big]);
+var parsed = JSON.parse(bigJSON);
+print(JSON.stringify(parsed) === bigJSON, parsed[2].p99);
+// CHECK-NEXT: true 99
@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+"use strict";
+
+// JSON.stringify without a replacer or gap serializes plain objects and
+// arrays directly. Check that it agrees with the generic algorithm, and falls
+// back to it whenever JS code could run.
+
+print('json-stringify-fast');
+// CHECK-LABEL: json-stringify-fast
+
+// Primitives.
+print(JSON.stringify('a"b\\c\n\u0001\u001f'));
+// CHECK-NEXT: "a\"b\\c\n\u0001\u001f"
+print(JSON.stringify([0, -0, 1.5, -7, 2147483647, 2147483648, -2147483648]));
+// CHECK-NEXT: [0,0,1.5,-7,2147483647,2147483648,-2147483648]
+print(JSON.stringify([1e21, -1e-7, NaN, Infinity, -Infinity]));
+// CHECK-NEXT: [1e+21,-1e-7,null,null,null]
+print(JSON.stringify([true, false, null, undefined, Symbol(), function() {}]));
+// CHECK-NEXT: [true,false,null,null,null,null]
+print(JSON.stringify(undefined), JSON.stringify(Symbol()));
+// CHECK-NEXT: undefined undefined
+
+// Properties which serialize to undefined are omitted.
+print(JSON.stringify({a: undefined, b: 1, c: Symbol(), d: function() {}}));
+// CHECK-NEXT: {"b":1}
+print(JSON.stringify({[Symbol()]: 1, s: 'x'}));
+// CHECK-NEXT: {"s":"x"}
+
+// Non-ASCII strings and keys.
+print(JSON.stringify({'ké': ['é', '😀', 'ascii']}));
+// CHECK-NEXT: {"ké":["é","😀","ascii"]}
+var wide = 'é-ascii'.substring(2);
+print(JSON.stringify([wide, wide + '!']));
+// CHECK-NEXT: ["ascii","ascii!"]
+
+// Long output, and strings built by concatenation.
+var parts = [];
+for (var i = 0; i < 2000; i++)
+  parts.push({i: i, s: 'x' + i + 'y'});
+var out = JSON.stringify(parts);
+print(out.length, out.slice(0, 32));
+// CHECK-NEXT: 45781 [{"i":0,"s":"x0y"},{"i":1,"s":"x
+print(JSON.stringify(parts) === out);
+// CHECK-NEXT: true
+
+// Order of properties.
+var o = {b: 1, a: 2, c: 3};
+delete o.a;
+o.a = 4;
+print(JSON.stringify(o));
+// CHECK-NEXT: {"b":1,"c":3,"a":4}
+print(JSON.stringify({z: 1, 2: 'b', 1: 'a'}));
+// CHECK-NEXT: {"1":"a","2":"b","z":1}
+var hidden = {x: 1};
+Object.defineProperty(hidden, 'y', {value: 2, enumerable: false});
+print(JSON.stringify(hidden));
+// CHECK-NEXT: {"x":1}
+print(JSON.stringify([Object.create(null), {}, []]));
+// CHECK-NEXT: [{},{},[]]
+
+// Getters and toJSON run.
+print(JSON.stringify({a: [1, {get b() { return 'got'; }}]}));
+// CHECK-NEXT: {"a":[1,{"b":"got"}]}
+print(JSON.stringify({a: {toJSON: function(k) { return 'key ' + k; }}}));
+// CHECK-NEXT: {"a":"key a"}
+var arr = [1, 2];
+arr.toJSON = function() { return 'arr'; };
+print(JSON.stringify([arr]));
+// CHECK-NEXT: ["arr"]
+print(JSON.stringify(Object.create({toJSON: function() { return 'p'; }})));
+// CHECK-NEXT: "p"
+Object.prototype.toJSON = function() { return 'object'; };
+print(JSON.stringify({a: 1}));
+// CHECK-NEXT: "object"
+delete Object.prototype.toJSON;
+Array.prototype.toJSON = function() { return 'array'; };
+print(JSON.stringify({a: []}));
+// CHECK-NEXT: {"a":"array"}
+delete Array.prototype.toJSON;
+print(JSON.stringify({d: new Date(0)}));
+// CHECK-NEXT: {"d":"1970-01-01T00:00:00.000Z"}
+
+// Holes are read through the prototype chain.
+Array.prototype[1] = 'inherited';
+print(JSON.stringify([0, , 2]));
+// CHECK-NEXT: [0,"inherited",2]
+delete Array.prototype[1];
+print(JSON.stringify([0, , 2]));
+// CHECK-NEXT: [0,null,2]
+
+// Other objects.
+print(JSON.stringify([new Number(1), new String('s'), new Boolean(true)]));
+// CHECK-NEXT: [1,"s",true]
+var proxies = [new Proxy({a: 1}, {}), new Proxy([2], {})];
+print(JSON.stringify(proxies));
+// CHECK-NEXT: [{"a":1},[2]]
+
+// Cycles are still reported.
+var cyclic = {a: [1]};
+cyclic.a.push(cyclic);
+try {
+  JSON.stringify(cyclic);
+} catch (e) {
+  print(e.name, e.message);
+}
+// CHECK-NEXT: TypeError cyclical structure in JSON object
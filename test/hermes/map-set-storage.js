@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+"use strict";
+
+// Map and Set entries are stored in insertion order, and iterators must
+// survive erasure, growth, shrinking and clearing of the storage.
+
+print('map-set-storage');
+// CHECK-LABEL: map-set-storage
+
+function range(n) {
+  var s = new Set();
+  for (var i = 0; i < n; i++)
+    s.add(i);
+  return s;
+}
+
+// Entries added while iterating are visited, erased ones are not.
+var s = range(4);
+var seen = [];
+for (var v of s) {
+  seen.push(v);
+  if (v === 0) {
+    s.delete(1);
+    s.add(10);
+  }
+  if (v === 10)
+    s.add(1);
+}
+print(seen.join());
+// CHECK-NEXT: 0,2,3,10,1
+
+// An iterator keeps its place while the storage grows.
+var s = range(5);
+var it = s.values();
+it.next();
+it.next();
+for (var i = 100; i < 1100; i++)
+  s.add(i);
+var rest = Array.from(it);
+print(rest.length, rest[0], rest[3], rest[rest.length - 1]);
+// CHECK-NEXT: 1003 2 100 1099
+
+// And while it shrinks because most entries are erased.
+var s = range(1000);
+var it = s.keys();
+for (var i = 0; i < 500; i++)
+  it.next();
+for (var i = 0; i < 995; i++)
+  s.delete(i === 499 ? 999 : i);
+print(Array.from(it).join(), s.size);
+// CHECK-NEXT: 995,996,997,998 5
+
+// Clearing leaves active iterators ready for new entries.
+var m = new Map([[1, 'a'], [2, 'b'], [3, 'c']]);
+var it = m.entries();
+it.next();
+m.clear();
+m.set(4, 'd');
+print(Array.from(it).join(';'), m.size);
+// CHECK-NEXT: 4,d 1
+var done = m.values();
+print(JSON.stringify(Array.from(done)), JSON.stringify(done.next()));
+// CHECK-NEXT: ["d"] {"done":true}
+m.set(5, 'e');
+print(done.next().done);
+// CHECK-NEXT: true
+
+// forEach visits the entries added by the callback, across a rehash.
+var m = new Map([['x', 0]]);
+var count = 0;
+m.forEach(function (v, k) {
+  count++;
+  if (v < 50) {
+    m.delete(k);
+    m.set(k + v, v + 1);
+  }
+});
+print(count, m.size, m.values().next().value);
+// CHECK-NEXT: 51 1 50
+
+// Keys are compared with SameValueZero.
+var m = new Map();
+m.set(NaN, 1).set(-0, 2).set('1', 3).set(1, 4).set(2 ** 60, 5);
+print(m.get(NaN), m.get(0), m.get('1'), m.get(1), m.get(2 ** 60));
+// CHECK-NEXT: 1 2 3 4 5
+m.delete(0);
+m.set(0, 6);
+print(Array.from(m.keys()).join());
+// CHECK-NEXT: NaN,1,1,1152921504606847000,0
+
+// Large maps, with collections moving the storage while it is filled.
+var m = new Map();
+var objs = [];
+for (var i = 0; i < 30000; i++) {
+  var o = {i: i};
+  objs.push(o);
+  m.set(o, 'k' + i);
+  if (i % 3 === 0)
+    m.delete(objs[i >> 1]);
+  if (i % 10000 === 0 && typeof gc === 'function')
+    gc();
+}
+var missing = 0;
+for (var i = 0; i < objs.length; i += 7) {
+  if (m.has(objs[i]) !== (m.get(objs[i]) === 'k' + i))
+    missing++;
+}
+var prev = -1, ordered = true, n = 0;
+for (var [k, v] of m) {
+  ordered = ordered && k.i > prev;
+  prev = k.i;
+  n++;
+}
+print(missing, ordered, n === m.size);
+// CHECK-NEXT: 0 true true
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// Exercise a single GetById/PutById site with an increasing number of hidden
+// classes, so that it goes through the monomorphic, polymorphic and
+// megamorphic cache states. Every access must still observe the right slot.
+
+function getX(o) {
+  return o.x;
+}
+function setX(o, v) {
+  o.x = v;
+}
+
+// Build objects which all have 'x', but at different slots and with different
+// hidden classes.
+function makeObjects(n) {
+  var objs = [];
+  for (var i = 0; i < n; ++i) {
+    var o = {};
+    for (var j = 0; j < i; ++j) {
+      o['p' + j] = j;
+    }
+    o.x = i;
+    objs.push(o);
+  }
+  return objs;
+}
+
+function run(objs) {
+  var sum = 0;
+  for (var iter = 0; iter < 3; ++iter) {
+    for (var i = 0; i < objs.length; ++i) {
+      setX(objs[i], getX(objs[i]) + 1);
+      sum += getX(objs[i]);
+    }
+  }
+  return sum;
+}
+
+// Monomorphic.
+print(run(makeObjects(1)));
+// CHECK: 6
+// Polymorphic, two to four classes.
+print(run(makeObjects(2)));
+// CHECK-NEXT: 15
+print(run(makeObjects(4)));
+// CHECK-NEXT: 42
+// Megamorphic.
+print(run(makeObjects(20)));
+// CHECK-NEXT: 690
+
+// Collect the cached hidden classes, then access new objects with fresh ones.
+gc();
+print(run(makeObjects(6)));
+// CHECK-NEXT: 81
+
+// A read-only property must not be written through a cached slot.
+var frozen = Object.freeze({a: 1, x: 5});
+setX(frozen, 10);
+print(getX(frozen));
+// CHECK-NEXT: 5
+
+// A prototype property must not be confused with an own property.
+var proto = {x: 'proto'};
+var child = Object.create(proto);
+print(getX(child));
+// CHECK-NEXT: proto
+setX(child, 'own');
+print(getX(child), proto.x);
+// CHECK-NEXT: own proto
@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// Populate the prototype chain cache of a single GetById site, then change the
+// chain in every way that must invalidate it.
+
+function getM(o) {
+  return o.m;
+}
+
+function Base() {}
+Base.prototype.m = 'base';
+function Derived() {}
+Derived.prototype = Object.create(Base.prototype);
+var d = new Derived();
+
+// Depth two: d -> Derived.prototype -> Base.prototype.
+print(getM(d), getM(d));
+// CHECK: base base
+
+// Shadow the property on an intermediate prototype.
+Derived.prototype.m = 'derived';
+print(getM(d));
+// CHECK-NEXT: derived
+delete Derived.prototype.m;
+print(getM(d));
+// CHECK-NEXT: base
+
+// Update the value on the holder.
+Base.prototype.m = 'updated';
+print(getM(d));
+// CHECK-NEXT: updated
+
+// Give the receiver an own property.
+var e = new Derived();
+print(getM(e));
+// CHECK-NEXT: updated
+e.m = 'own';
+print(getM(e), getM(d));
+// CHECK-NEXT: own updated
+
+// Another object with the same class as d but a different prototype.
+var other = Object.create({m: 'other'});
+var same = Object.create(Derived.prototype);
+print(getM(same), getM(other), getM(same));
+// CHECK-NEXT: updated other updated
+
+// Change the prototype of the receiver and of an intermediate object.
+Object.setPrototypeOf(same, {m: 'swapped'});
+print(getM(same));
+// CHECK-NEXT: swapped
+print(getM(d));
+// CHECK-NEXT: updated
+Object.setPrototypeOf(Derived.prototype, {m: 'rebased'});
+print(getM(d));
+// CHECK-NEXT: rebased
+
+// Collect young objects, which may be cached once they have been promoted.
+gc();
+print(getM(d), getM(d));
+// CHECK-NEXT: rebased rebased
+
+// Turn the holder into an accessor.
+Object.defineProperty(Object.getPrototypeOf(Derived.prototype), 'm', {
+  get: function () {
+    return 'getter';
+  },
+});
+print(getM(d));
+// CHECK-NEXT: getter
+
+// Not found anywhere on the chain.
+print(getM({}));
+// CHECK-NEXT: undefined
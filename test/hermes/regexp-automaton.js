@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -Xforce-regex-automaton %s | %FileCheck --match-full-lines %s
+"use strict";
+
+// Regexes without backreferences or lookarounds also have a linear-time
+// automaton, used when backtracking becomes excessive. Check that it finds the
+// same matches as the backtracking executor.
+
+print('regexp-automaton');
+// CHECK-LABEL: regexp-automaton
+
+function show(re, str) {
+  print(JSON.stringify(re.exec(str)));
+}
+
+// Captures and priorities.
+show(/(a|ab)(c|bcd)(d*)/, 'abcd');
+// CHECK-NEXT: ["abcd","a","bcd",""]
+show(/((a)|b)+/, 'ab');
+// CHECK-NEXT: ["ab","b",null]
+show(/(z)((a+)?(b+)?(c))*/, 'zaacbbbcac');
+// CHECK-NEXT: ["zaacbbbcac","z","ac","a",null,"c"]
+show(/(a*?)(a*)/, 'aaa');
+// CHECK-NEXT: ["aaa","","aaa"]
+show(/(a+?)b/, 'xaaab');
+// CHECK-NEXT: ["aaab","aaa"]
+show(/(?:ab|a)(?:c|bcd)/, 'abcd');
+// CHECK-NEXT: ["abc"]
+show(/a{2,3}?/, 'aaaa');
+// CHECK-NEXT: ["aa"]
+show(/(a{2,3})+/, 'aaaaaaa');
+// CHECK-NEXT: ["aaaaaa","aaa"]
+show(/x(?:y|)*z/, 'xyyz');
+// CHECK-NEXT: ["xyyz"]
+
+// Assertions.
+show(/^\w+$/m, 'foo bar\nbaz');
+// CHECK-NEXT: ["baz"]
+show(/\b\w{3}\b/, 'abcd efg');
+// CHECK-NEXT: ["efg"]
+show(/\B.\B/, 'abc');
+// CHECK-NEXT: ["b"]
+
+// Sticky regexes only match at lastIndex.
+var re = /b+/y;
+re.lastIndex = 1;
+show(re, 'abbc');
+// CHECK-NEXT: ["bb"]
+show(re, 'abbc');
+// CHECK-NEXT: null
+
+// Surrogate pairs and case-insensitive matching.
+show(/(.)(.)/u, '😀x');
+// CHECK-NEXT: ["😀x","😀","x"]
+var m = /(.)(.)/.exec('😀x');
+print(m[1].charCodeAt(0).toString(16), m[2].charCodeAt(0).toString(16));
+// CHECK-NEXT: d83d de00
+show(/[😀x]+/u, 'a😀x😀b');
+// CHECK-NEXT: ["😀x😀"]
+show(/k+/iu, 'xKkK');
+// CHECK-NEXT: ["KkK"]
+
+// Patterns which make the backtracking executor take exponential time.
+var long = 'a'.repeat(40);
+print(/(a+)+b/.test(long), /(a|aa)+$/.test(long + '!'));
+// CHECK-NEXT: false false
+show(/(x+x+)+y/, 'x'.repeat(30) + 'y');
+// CHECK-NEXT: ["xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxy","xxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"]
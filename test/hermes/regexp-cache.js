@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+"use strict";
+
+// RegExps with the same pattern and flags share their compiled bytecode
+// through a runtime-wide cache.
+
+print('regexp-cache');
+// CHECK-LABEL: regexp-cache
+
+var last = counts();
+function counts() {
+  var stats = HermesInternal.getInstrumentedStats();
+  return [stats.js_regExpCacheHits, stats.js_regExpCacheMisses];
+}
+// Print the cache hits and misses since the last call.
+function printDelta() {
+  var now = counts();
+  print('hits', now[0] - last[0], 'misses', now[1] - last[1]);
+  last = now;
+}
+
+var res = [];
+for (var i = 0; i < 10; i++)
+  res.push(new RegExp('a+(b)', 'g'));
+printDelta();
+// CHECK-NEXT: hits 9 misses 1
+
+// Each RegExp still has its own state.
+res[0].lastIndex = 3;
+print(res[0].exec('aab_ab'), res[1].exec('aab_ab'), res[1].lastIndex);
+// CHECK-NEXT: ab,b aab,b 3
+
+// Flags in a different order are the same flags.
+new RegExp('x', 'gi');
+new RegExp('x', 'ig');
+new RegExp('x', 'i');
+printDelta();
+// CHECK-NEXT: hits 1 misses 2
+
+// Literals share the bytecode compiled ahead of time.
+for (var i = 0; i < 5; i++)
+  res.push(/c+d/y);
+printDelta();
+// CHECK-NEXT: hits 4 misses 1
+print(res[res.length - 1].test('ccd'), new RegExp('c+d', 'y').test('ccd'));
+// CHECK-NEXT: true true
+printDelta();
+// CHECK-NEXT: hits 1 misses 0
+
+// Copying a RegExp with other flags compiles it again.
+new RegExp(res[0]);
+new RegExp(res[0], 'i');
+printDelta();
+// CHECK-NEXT: hits 1 misses 1
+
+// Invalid patterns are not cached, and keep throwing.
+for (var i = 0; i < 2; i++) {
+  try {
+    new RegExp('(', 'g');
+  } catch (e) {
+    print(e.name);
+  }
+}
+// CHECK-NEXT: SyntaxError
+// CHECK-NEXT: SyntaxError
+printDelta();
+// CHECK-NEXT: hits 0 misses 0
+
+// The least recently used patterns are evicted.
+for (var i = 0; i < 200; i++)
+  new RegExp('p' + i);
+new RegExp('p199');
+new RegExp('p0');
+printDelta();
+// CHECK-NEXT: hits 1 misses 201
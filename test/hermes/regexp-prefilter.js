@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+"use strict";
+
+// Regexes whose matches start with a known literal prefix or first character
+// skip ahead to candidate positions. Check that this finds the same matches.
+
+print('regexp-prefilter');
+// CHECK-LABEL: regexp-prefilter
+
+var log = 'INFO: ok\nWARN: meh\nERROR: disk full\nERROR: oops';
+print(JSON.stringify(/ERROR: (\w+)/.exec(log)));
+// CHECK-NEXT: ["ERROR: disk","disk"]
+print(log.match(/ERROR: (\w+)/g));
+// CHECK-NEXT: ERROR: disk,ERROR: oops
+print(/ERROR: (\w+)/.exec(log + '€').index);
+// CHECK-NEXT: 19
+print(/FATAL/.test(log), /FATAL/.test(log + '€'));
+// CHECK-NEXT: false false
+
+// A prefix which only appears at the very end, or is cut off by the end.
+print(/abc/.exec('xxxxabc').index, /abc/.test('xxxxab'));
+// CHECK-NEXT: 4 false
+print(/€x/.exec('aaa€x').index, /€x/.test('aaa€'));
+// CHECK-NEXT: 3 false
+print(/€/.test('only ascii'));
+// CHECK-NEXT: false
+
+// Overlapping candidates.
+print(/aab/.exec('aaaab').index);
+// CHECK-NEXT: 2
+
+// lastIndex is respected.
+var re = /ab/g;
+re.lastIndex = 1;
+print(re.exec('abxab').index, re.lastIndex);
+// CHECK-NEXT: 3 5
+
+// Sticky regexes only try lastIndex.
+var sticky = /b/y;
+sticky.lastIndex = 0;
+print(sticky.test('ab'));
+// CHECK-NEXT: false
+
+// First character sets.
+print('xyz42'.search(/\d+/), 'xyz_'.search(/[\d_]/), 'x \ty'.search(/\s/));
+// CHECK-NEXT: 3 3 1
+print('abc　d'.search(/\s/), 'ab '.search(/\s/));
+// CHECK-NEXT: 3 2
+print('xxcat'.search(/dog|cat/), 'xxcat'.search(/(?:dog|c)at/));
+// CHECK-NEXT: 2 2
+print('xxb'.search(/a*b/), 'xxb'.search(/(?:a|)b/), 'xxb'.search(/(?=b)/));
+// CHECK-NEXT: 2 2 2
+print('xxb'.search(/(?=\w)b/), 'xxab'.search(/a+b/));
+// CHECK-NEXT: 2 2
+print('xyz'.search(/[^x]/), 'xyz'.search(/[\W\d]/), 'xy!'.search(/[\W\d]/));
+// CHECK-NEXT: 1 -1 2
+
+// Case-insensitive matching.
+print('xxABC'.search(/abc/i), 'xxaBc'.search(/ABC/i), 'xxé'.search(/É/i));
+// CHECK-NEXT: 2 2 2
+print('xxK'.search(/k/iu), 'xxK'.search(/k/i), 'xxſ'.search(/s/iu));
+// CHECK-NEXT: 2 -1 2
+print('xxK'.search(/[k]/iu), 'xxK'.search(/[k-m]/i));
+// CHECK-NEXT: 2 2
+
+// Surrogate pairs.
+print('x😀'.search(/😀/u), 'x😀'.search(/\ude00/));
+// CHECK-NEXT: 1 2
+print('x😀'.search(/\ude00/u), 'x😀\ude00'.search(/\ude00/u));
+// CHECK-NEXT: -1 3
+print('x😀'.search(/[\u{1f600}]/u), 'x😀'.search(/\u{1f600}/u));
+// CHECK-NEXT: 1 1
+
+// Backreferences make the regex start unknown.
+print('xxaa'.search(/(a)\1/), 'xx'.search(/()\1x/));
+// CHECK-NEXT: 2 0
@@ -183,6 +183,15 @@ print(re.exec("aab"));
 print(re.lastIndex);
 // CHECK-NEXT: 1
 
+// test() updates lastIndex and the legacy statics like exec() does
+re = /a(b)?/g;
+print(re.test("xaab"), re.lastIndex, RegExp.$1 === "", RegExp.lastMatch);
+// CHECK-NEXT: true 2 true a
+print(re.test("xaab"), re.lastIndex, RegExp.$1, RegExp.lastMatch);
+// CHECK-NEXT: true 4 b ab
+print(re.test("xaab"), re.lastIndex, RegExp.$1, RegExp.lastMatch);
+// CHECK-NEXT: false 0 b ab
+
 // Check RegExp flags
 // We need strict mode here.
 (function() {
@@ -529,6 +538,21 @@ print(/[0-9]+/g[Symbol.search]('hello'));
 // CHECK-NEXT: -1
 print(RegExp.prototype[Symbol.search].name);
 // CHECK-NEXT: [Symbol.search]
+var r = /b+/y;
+r.lastIndex = 3;
+print(r[Symbol.search]('abb'), 'abb'.search(r), r.lastIndex);
+// CHECK-NEXT: -1 -1 3
+r = /b+/g;
+r.lastIndex = 3;
+print(r[Symbol.search]('abb'), r.lastIndex);
+// CHECK-NEXT: 1 3
+r.exec = function (s) {
+  print('exec', s, this.lastIndex);
+  return { index: 'idx' };
+};
+print(r[Symbol.search]('xyz'), r.lastIndex);
+// CHECK-NEXT: exec xyz 0
+// CHECK-NEXT: idx 3
 
 print("RegExp.prototype[Symbol.replace]");
 // CHECK-LABEL: RegExp.prototype[Symbol.replace]
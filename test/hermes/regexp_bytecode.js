@@ -71,6 +71,10 @@ print(/\b\B/);
 // CHECK-NEXT:    0000  WordBoundary: \b
 // CHECK-NEXT:    0002  WordBoundary: \B
 // CHECK-NEXT:    0004  Goal
+// CHECK-NEXT:    Automaton:
+// CHECK-NEXT:    0005  WordBoundary: \b
+// CHECK-NEXT:    0007  WordBoundary: \B
+// CHECK-NEXT:    0009  Goal
 
 print(/abc(?=^)(?!def)/i);
 // CHECK: Header: marked: 0 loops: 0 flags: 1 constraints: 6
@@ -94,6 +98,24 @@ print(/ab*c+d{3,5}/);
 // CHECK-NEXT:    002a  Width1Loop: 2 greedy {3, 5}
 // CHECK-NEXT:    003c  MatchChar8: 'd'
 // CHECK-NEXT:    003e  Goal
+// CHECK-NEXT:    Prefilter: prefix 'a'
+// CHECK-NEXT:    Automaton:
+// CHECK-NEXT:    0063  MatchChar8: 'a'
+// CHECK-NEXT:    0065  Alternation: Target 0x73, constraints 0,0
+// CHECK-NEXT:    006c  MatchChar8: 'b'
+// CHECK-NEXT:    006e  Jump32: 0x65
+// CHECK-NEXT:    0073  MatchChar8: 'c'
+// CHECK-NEXT:    0075  Alternation: Target 0x83, constraints 0,0
+// CHECK-NEXT:    007c  MatchChar8: 'c'
+// CHECK-NEXT:    007e  Jump32: 0x75
+// CHECK-NEXT:    0083  MatchChar8: 'd'
+// CHECK-NEXT:    0085  MatchChar8: 'd'
+// CHECK-NEXT:    0087  MatchChar8: 'd'
+// CHECK-NEXT:    0089  Alternation: Target 0x9b, constraints 0,0
+// CHECK-NEXT:    0090  MatchChar8: 'd'
+// CHECK-NEXT:    0092  Alternation: Target 0x9b, constraints 0,0
+// CHECK-NEXT:    0099  MatchChar8: 'd'
+// CHECK-NEXT:    009b  Goal
 
 print(/a((b+){3})*/);
 // CHECK:        8: /a((b+){3})*/
@@ -282,3 +304,15 @@ print(/(abc|def)/);
 // CHECK-NEXT:    0014  MatchNChar8: 'def'
 // CHECK-NEXT:    0019  EndMarkedSubexpression: 0
 // CHECK-NEXT:    001c  Goal
+// CHECK-NEXT:    Prefilter: first [ad]
+
+print(/ERROR: (\w+)/);
+// CHECK:       28: /ERROR: (\w+)/
+// CHECK-NEXT:    Header: marked: 1 loops: 1 flags: 0 constraints: 4
+// CHECK-NEXT:    0000  MatchNChar8: 'ERROR: '
+// CHECK-NEXT:    0009  BeginMarkedSubexpression: 0
+// CHECK-NEXT:    000c  Width1Loop: 0 greedy {1, 4294967295}
+// CHECK-NEXT:    001e  Bracket: [\w]
+// CHECK-NEXT:    0024  EndMarkedSubexpression: 0
+// CHECK-NEXT:    0027  Goal
+// CHECK-NEXT:    Prefilter: prefix 'ERROR: '
@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -gc-sanitize-handles=1 %s | %FileCheck --match-full-lines %s
+"use strict";
+
+// Concatenations that prepend or wrap long strings create ropes. Make sure
+// they read back correctly wherever a flat string is expected.
+
+print('rope');
+// CHECK-LABEL: rope
+
+var big = 'x'.repeat(300);
+
+var prepended = big;
+for (var i = 0; i < 1000; ++i)
+  prepended = (i % 10) + prepended;
+print(prepended.length, prepended.slice(0, 12), prepended.slice(-3));
+// CHECK-NEXT: 1300 987654321098 xxx
+
+var wrapped = big;
+for (var i = 0; i < 100; ++i)
+  wrapped = '(' + wrapped + ')';
+print(wrapped.length, wrapped.indexOf('x'), wrapped.charAt(wrapped.length - 1));
+// CHECK-NEXT: 500 100 )
+
+var appended = big;
+for (var i = 0; i < 1000; ++i)
+  appended = appended + (i % 10);
+print(appended.length, appended.slice(-4));
+// CHECK-NEXT: 1300 6789
+
+var utf16 = 'ሴ' + big;
+print(utf16.length, utf16.charCodeAt(0), (big + 'ሴ').charCodeAt(300));
+// CHECK-NEXT: 301 4660 4660
+
+var a = 'a' + big;
+var b = 'a' + big;
+print(a === b, a === 'a' + big.slice(1) + 'x', a < 'b' + big);
+// CHECK-NEXT: true true true
+
+var obj = {};
+obj[a] = 1;
+print(obj[b], Object.keys(obj)[0].length);
+// CHECK-NEXT: 1 301
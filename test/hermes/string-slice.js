@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -gc-sanitize-handles=1 %s | %FileCheck --match-full-lines %s
+"use strict";
+
+// Long substrings share the characters of the string they are taken from.
+// Make sure they read back correctly, including after their parent moves.
+
+print('slice');
+// CHECK-LABEL: slice
+
+var line = '';
+for (var i = 0; i < 20; ++i)
+  line += 'field' + i + '-' + 'y'.repeat(40) + ',';
+
+var fields = line.split(',');
+print(fields.length, fields[3].length, fields[3].slice(0, 7));
+// CHECK-NEXT: 21 47 field3-
+
+var tail = line.substring(100);
+var tailOfTail = tail.substr(100, 60);
+print(tailOfTail === line.slice(200, 260), tailOfTail.length);
+// CHECK-NEXT: true 60
+
+var obj = {};
+obj[fields[7]] = 7;
+print(obj['field7-' + 'y'.repeat(40)]);
+// CHECK-NEXT: 7
+
+var wide = 'ሴ' + 'z'.repeat(100);
+var wideSlice = wide.slice(0, 50);
+print(wideSlice.charCodeAt(0), wideSlice.length, wide.slice(1) === 'z'.repeat(100));
+// CHECK-NEXT: 4660 50 true
+
+var rope = 'r'.repeat(10) + 'x'.repeat(300);
+print(rope.slice(5, 45));
+// CHECK-NEXT: rrrrrxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
+
+var slices = [];
+for (var i = 0; i < 1000; ++i)
+  slices.push(line.slice(i % 100, i % 100 + 64));
+gc();
+print(slices[999] === line.slice(99, 163), slices[250] === slices[350]);
+// CHECK-NEXT: true true
@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O0 %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -Xforce-jit -O %s | %FileCheck --match-full-lines %s
+
+// Check that superinstructions behave like the pairs of instructions they
+// replace, both when their fast path is taken and when it is not.
+
+print('superinstructions');
+// CHECK-LABEL: superinstructions
+
+function chain(o) {
+  return o.a.b;
+}
+function method0(o) {
+  return o.f();
+}
+function method1(o) {
+  return o.f(1);
+}
+function method2(o) {
+  return o.f(1, 2);
+}
+function global() {
+  return Math.PI;
+}
+
+var objs = [
+  {a: {b: 1}, f: function(x, y) { return [this.a.b, x, y].join(); }},
+  {x: 0, a: {x: 0, b: 2}, f: function(x, y) { return [x, y].join(); }},
+  {a: {get b() { return 'getter'; }}, f: function() { return 'proto'; }},
+];
+// Warm up the caches, then run with a different class at the same sites.
+var res = [];
+for (var i = 0; i < 3; ++i) {
+  for (var j = 0; j < objs.length; ++j) {
+    var o = objs[j];
+    res.push(chain(o), method0(o), method1(o), method2(o));
+  }
+}
+print(res.slice(0, 12).join(' '));
+// CHECK-NEXT: 1 1,, 1,1, 1,1,2 2 , 1, 1,2 getter proto proto proto
+print(res.slice(12).join(' ') === res.slice(0, 24).join(' '));
+// CHECK-NEXT: true
+print(global() === Math.PI);
+// CHECK-NEXT: true
+
+// The second instruction may still throw.
+try {
+  chain({});
+} catch (e) {
+  print(e.message);
+}
+// CHECK-NEXT: Cannot read property 'b' of undefined
+try {
+  method1({f: 1});
+} catch (e) {
+  print(e.constructor.name);
+}
+// CHECK-NEXT: TypeError
+
+// A call through a property read by a superinstruction returns normally.
+var counter = {n: 0, inc: function() { return ++this.n; }};
+function bump() {
+  return counter.inc();
+}
+for (var i = 0; i < 10; ++i)
+  bump();
+print(counter.n);
+// CHECK-NEXT: 10
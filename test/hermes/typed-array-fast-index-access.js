@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -Xhermes-internal-test-methods -O %s | %FileCheck --match-full-lines %s
+
+// Check that the interpreter's typed array element fast paths convert values
+// exactly like the generic path.
+
+function get(a, i) {
+  return a[i];
+}
+function put(a, i, v) {
+  a[i] = v;
+}
+
+var values = [300, -1, 1.5, 2.5, -0.5, 255.5, 1e10, NaN, -Infinity, 65537];
+var ctors = [
+  Int8Array,
+  Uint8Array,
+  Uint8ClampedArray,
+  Int16Array,
+  Uint16Array,
+  Int32Array,
+  Uint32Array,
+  Float32Array,
+  Float64Array,
+];
+for (var c = 0; c < ctors.length; ++c) {
+  var ta = new ctors[c](values.length);
+  for (var i = 0; i < values.length; ++i) put(ta, i, values[i]);
+  var out = [];
+  for (var i = 0; i < values.length; ++i) out.push(get(ta, i));
+  print(ctors[c].name, out.join(' '));
+}
+// CHECK: Int8Array 44 -1 1 2 0 -1 0 0 0 1
+// CHECK-NEXT: Uint8Array 44 255 1 2 0 255 0 0 0 1
+// CHECK-NEXT: Uint8ClampedArray 255 0 2 2 0 255 255 0 0 255
+// CHECK-NEXT: Int16Array 300 -1 1 2 0 255 -7168 0 0 1
+// CHECK-NEXT: Uint16Array 300 65535 1 2 0 255 58368 0 0 1
+// CHECK-NEXT: Int32Array 300 -1 1 2 0 255 1410065408 0 0 65537
+// CHECK-NEXT: Uint32Array 300 4294967295 1 2 0 255 1410065408 0 0 65537
+// CHECK-NEXT: Float32Array 300 -1 1.5 2.5 -0.5 255.5 10000000000 NaN -Infinity 65537
+// CHECK-NEXT: Float64Array 300 -1 1.5 2.5 -0.5 255.5 10000000000 NaN -Infinity 65537
+
+// Non-number values and keys take the generic path.
+var u8 = new Uint8Array(4);
+put(u8, 0, '7');
+put(u8, 1, {
+  valueOf: function () {
+    return 9;
+  },
+});
+put(u8, '2', 3);
+put(u8, 3, true);
+print(get(u8, 0), get(u8, 1), get(u8, '2'), get(u8, 3));
+// CHECK-NEXT: 7 9 3 1
+
+// Out of bounds reads are undefined and writes are ignored, even with an
+// index-like property on the prototype.
+Uint8Array.prototype[4] = 'proto';
+put(u8, 4, 1);
+print(get(u8, 4), get(u8, -1), get(u8, 1.5), u8.length);
+// CHECK-NEXT: undefined undefined undefined 4
+delete Uint8Array.prototype[4];
+
+// A detached buffer no longer exposes its elements and cannot be written.
+var detached = new Float64Array([1, 2]);
+print(get(detached, 1));
+// CHECK-NEXT: 2
+HermesInternal.detachArrayBuffer(detached.buffer);
+print(get(detached, 1) === 2);
+// CHECK-NEXT: false
+try {
+  put(detached, 0, 5);
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: TypeError
+
+// Views with an offset into a shared buffer.
+var buf = new ArrayBuffer(8);
+var whole = new Uint8Array(buf);
+var view = new Uint16Array(buf, 2, 2);
+put(view, 1, 0x0102);
+print(get(whole, 4) + get(whole, 5), view.length);
+// CHECK-NEXT: 3 2
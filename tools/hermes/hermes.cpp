@@ -54,6 +54,21 @@ static opt<bool> GCRevertToYGAtTTI(
     cat(GCCategory),
     init(false));
 
+static opt<unsigned> GCParallelThreads(
+    "gc-parallel-threads",
+    desc("Number of threads, including the mutator, that share "
+         "stop-the-world GC work (0 picks a count from the number of cores)"),
+    cat(GCCategory),
+    init(0));
+
+static opt<unsigned> GCConcurrentThreads(
+    "gc-concurrent-threads",
+    desc("Number of threads that mark and sweep the old generation "
+         "concurrently with the mutator (0 picks a count from the number of "
+         "cores)"),
+    cat(GCCategory),
+    init(0));
+
 static opt<bool> GCBeforeStats(
     "gc-before-stats",
     desc("Perform a full GC just before printing statistics at exit"),
@@ -98,6 +113,8 @@ static int executeHBCBytecodeFromCL(
                   .withShouldReleaseUnused(vm::kReleaseUnusedNone)
                   .withAllocInYoung(cl::GCAllocYoung)
                   .withRevertToYGAtTTI(cl::GCRevertToYGAtTTI)
+                  .withParallelGCThreads(cl::GCParallelThreads)
+                  .withConcurrentGCThreads(cl::GCConcurrentThreads)
                   .build())
           .withEnableEval(cl::EnableEval)
           .withVerifyEvalIR(cl::VerifyIR)
@@ -107,6 +124,11 @@ static int executeHBCBytecodeFromCL(
           .withES6Promise(cl::ES6Promise)
           .withES6Proxy(cl::ES6Proxy)
           .withIntl(cl::Intl)
+          .withEnableJIT(cl::EnableJIT || cl::ForceJIT)
+          .withForceJIT(cl::ForceJIT)
+          .withEnableRegexAutomaton(
+              cl::RegexAutomaton || cl::ForceRegexAutomaton)
+          .withForceRegexAutomaton(cl::ForceRegexAutomaton)
           .withEnableSampleProfiling(cl::SampleProfiling)
           .withRandomizeMemoryLayout(cl::RandomizeMemoryLayout)
           .withTrackIO(cl::TrackBytecodeIO)
@@ -0,0 +1,26 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// This benchmark tests the speed of growing arrays by writing at their length.
+
+function fill(n) {
+    var array = [];
+    for (var i = 0; i < n; i++) {
+        array[array.length] = i;
+    }
+    return array;
+}
+
+function run(numTimes) {
+    var totalLength = 0;
+    for (var i = 0; i < numTimes; i++) {
+        totalLength += fill(100).length;
+    }
+    return totalLength;
+}
+
+print(run(100000));
@@ -0,0 +1,52 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Sorting a table of rows by a column with a compare function, re-sorting it
+// once it is mostly sorted, and sorting numbers, strings and typed arrays
+// with the default order.
+(function() {
+  var numIter = 3;
+  var len = 100000;
+  var rows = [];
+  var nums = [];
+  var strs = [];
+  var floats = new Float64Array(len);
+  var seed = 1;
+  function random() {
+    seed = (seed * 16807) % 2147483647;
+    return seed;
+  }
+  for (var i = 0; i < len; i++) {
+    var r = random();
+    rows.push({id: i, score: r % 1000, name: 'row' + r});
+    nums.push(r % 100000);
+    strs.push('s' + (r % 50000));
+    floats[i] = r / 7;
+  }
+  function byScore(a, b) {
+    return a.score - b.score;
+  }
+
+  var sum = 0;
+  for (var iter = 0; iter < numIter; iter++) {
+    var t = rows.slice();
+    t.sort(byScore);
+    // Touch a few rows and sort again: the input is made of long runs.
+    for (var i = 0; i < len; i += 1000) {
+      t[i].score = (t[i].score + 500) % 1000;
+    }
+    t.sort(byScore);
+    sum += t[0].id + t[len - 1].id;
+    sum += nums.slice().sort()[len >> 1];
+    sum += strs.slice().sort()[len >> 1].length;
+    sum += floats.slice().sort()[len >> 1];
+  }
+  print(sum);
+})();
+print('done');
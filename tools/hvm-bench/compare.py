@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+#
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""Compare the run time of hvm-bench benchmarks between two Hermes binaries.
+
+Each benchmark is run several times with each binary, and the fastest wall
+clock time is reported along with the speedup of the new binary relative to
+the baseline. The output of both binaries must match, which guards against
+comparing a broken build.
+
+Example:
+  compare.py --baseline base/bin/hermes --new new/bin/hermes arrayRead.js
+
+With no benchmark arguments, all benchmarks in this directory are run. A named
+suite may be selected with --suite instead.
+"""
+
+from __future__ import absolute_import, division, print_function, unicode_literals
+
+import argparse
+import os
+import subprocess
+import sys
+import time
+
+
+BENCH_DIR = os.path.dirname(os.path.abspath(__file__))
+
+SUITES = {
+    "array": [
+        "arrayRead.js",
+        "arrayWrite.js",
+        "arrayAppend.js",
+        "largeArrayRead.js",
+        "largeArrayWrite.js",
+        "typedArrayReadWrite.js",
+        "arraySort.js",
+    ],
+    "json": [
+        "jsonParseTwitter.js",
+        "jsonParseCanada.js",
+        "jsonStringify.js",
+    ],
+    "map": [
+        "mapSet.js",
+    ],
+}
+
+
+def run_once(hermes, bench, flags):
+    start = time.time()
+    out = subprocess.check_output([hermes] + flags + [bench])
+    return time.time() - start, out
+
+
+def measure(hermes, bench, flags, runs):
+    best = None
+    output = None
+    for _ in range(runs):
+        elapsed, out = run_once(hermes, bench, flags)
+        if output is not None and out != output:
+            raise RuntimeError("%s: output differs between runs" % bench)
+        output = out
+        best = elapsed if best is None else min(best, elapsed)
+    return best, output
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--baseline", required=True, help="baseline hermes")
+    parser.add_argument("--new", required=True, help="hermes to evaluate")
+    parser.add_argument("--runs", type=int, default=5, help="runs per binary")
+    parser.add_argument("--suite", choices=sorted(SUITES), help="named suite")
+    parser.add_argument(
+        "--flag",
+        action="append",
+        default=None,
+        help="flag passed to both binaries (default: -O)",
+    )
+    parser.add_argument("benchmarks", nargs="*", help="benchmark files")
+    args = parser.parse_args()
+
+    flags = args.flag if args.flag is not None else ["-O"]
+    if args.benchmarks:
+        benches = args.benchmarks
+    elif args.suite:
+        benches = SUITES[args.suite]
+    else:
+        benches = sorted(f for f in os.listdir(BENCH_DIR) if f.endswith(".js"))
+
+    print("%-24s %10s %10s %8s" % ("benchmark", "baseline", "new", "speedup"))
+    failed = False
+    for bench in benches:
+        path = bench if os.path.exists(bench) else os.path.join(BENCH_DIR, bench)
+        base_time, base_out = measure(args.baseline, path, flags, args.runs)
+        new_time, new_out = measure(args.new, path, flags, args.runs)
+        note = ""
+        if base_out != new_out:
+            note = "  OUTPUT MISMATCH"
+            failed = True
+        print(
+            "%-24s %9.3fs %9.3fs %7.2fx%s"
+            % (
+                os.path.basename(path),
+                base_time,
+                new_time,
+                base_time / new_time if new_time > 0 else float("inf"),
+                note,
+            )
+        )
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
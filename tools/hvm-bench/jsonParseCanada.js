@@ -0,0 +1,52 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// JSON.parse of a synthetic document shaped like canada.json: a GeoJSON
+// feature collection whose polygons are long arrays of coordinate pairs, so
+// it is almost all numbers, with both short and full precision decimals.
+(function() {
+  var seed = 7;
+  function random(n) {
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+    return seed % n;
+  }
+  var features = [];
+  for (var f = 0; f < 20; f++) {
+    var rings = [];
+    for (var r = 0; r < 5; r++) {
+      var ring = [];
+      var lon = -140 + random(80);
+      var lat = 42 + random(40);
+      for (var p = 0; p < 400; p++) {
+        lon += (random(2001) - 1000) / 100000;
+        lat += (random(2001) - 1000) / 100000;
+        // Half of the points are rounded, like hand-written data.
+        ring.push(
+          p % 2 ? [Math.round(lon * 1e6) / 1e6, Math.round(lat * 1e6) / 1e6]
+                : [lon, lat]);
+      }
+      rings.push(ring);
+    }
+    features.push({
+      type: 'Feature',
+      properties: {name: 'Canada', id: f},
+      geometry: {type: 'Polygon', coordinates: rings},
+    });
+  }
+  var json = JSON.stringify({type: 'FeatureCollection', features: features});
+
+  var numIter = 10;
+  var count = 0;
+  for (var i = 0; i < numIter; i++) {
+    count += JSON.parse(json).features[0].geometry.coordinates[0].length;
+  }
+
+  print(count);
+  print('done');
+})();
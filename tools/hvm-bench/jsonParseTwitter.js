@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// JSON.parse of a synthetic document shaped like twitter.json: an indented
+// array of statuses with nested user and entity records, many short strings
+// with escapes and non-ASCII characters, integers, booleans and nulls.
+(function() {
+  var seed = 42;
+  function random(n) {
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+    return seed % n;
+  }
+  var words = [
+    'hermes', 'json', 'parse', 'lorem', 'ipsum', 'dolor', 'sit', 'amet',
+    'café', '中文', 'naïve', '"quoted"', 'back\\slash',
+    'tab\there', 'line\nbreak', '@user', '#tag', 'https://t.co/abc',
+  ];
+  function sentence(n) {
+    var s = [];
+    for (var i = 0; i < n; i++) {
+      s.push(words[random(words.length)]);
+    }
+    return s.join(' ');
+  }
+  function user(i) {
+    return {
+      id: 100000 + i,
+      id_str: String(100000 + i),
+      name: sentence(2),
+      screen_name: 'user_' + i,
+      location: random(3) ? sentence(1) : '',
+      description: sentence(8),
+      url: random(2) ? null : 'https://example.com/' + i,
+      protected: false,
+      followers_count: random(100000),
+      friends_count: random(5000),
+      created_at: 'Sun Aug 31 00:29:15 +0000 2014',
+      verified: random(10) === 0,
+      profile_image_url: 'http://pbs.twimg.com/profile_images/' + i + '.jpeg',
+    };
+  }
+  var statuses = [];
+  for (var i = 0; i < 200; i++) {
+    var hashtags = [];
+    for (var j = random(3); j > 0; j--) {
+      hashtags.push({text: words[random(words.length)], indices: [j, j + 5]});
+    }
+    statuses.push({
+      metadata: {result_type: 'recent', iso_language_code: 'en'},
+      created_at: 'Sun Aug 31 00:29:15 +0000 2014',
+      id: 505874924095815700 + i,
+      id_str: String(505874924095815700 + i),
+      text: sentence(15),
+      source: '<a href="http://twitter.com" rel="nofollow">Twitter</a>',
+      truncated: false,
+      in_reply_to_status_id: random(4) ? null : 505874000000000000 + i,
+      user: user(i),
+      retweet_count: random(1000),
+      favorite_count: random(1000),
+      entities: {hashtags: hashtags, symbols: [], urls: [], user_mentions: []},
+      favorited: false,
+      retweeted: false,
+      lang: 'en',
+    });
+  }
+  var json = JSON.stringify({statuses: statuses}, null, 2);
+
+  var numIter = 100;
+  var count = 0;
+  for (var i = 0; i < numIter; i++) {
+    count += JSON.parse(json).statuses.length;
+  }
+
+  print(count);
+  print('done');
+})();
@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// JSON.stringify of an application state snapshot: arrays of records sharing
+// their shape, with short strings, integers, doubles, booleans and nulls.
+(function() {
+  var seed = 42;
+  function random(n) {
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+    return seed % n;
+  }
+  var words = [
+    'hermes', 'json', 'stringify', 'lorem', 'ipsum', 'dolor', 'sit', 'amet',
+    '"quoted"', 'back\\slash', 'tab\there', 'line\nbreak', '@user', '#tag',
+  ];
+  function sentence(n) {
+    var s = [];
+    for (var i = 0; i < n; i++) {
+      s.push(words[random(words.length)]);
+    }
+    return s.join(' ');
+  }
+  var items = [];
+  for (var i = 0; i < 500; i++) {
+    items.push({
+      id: i,
+      title: sentence(4),
+      done: random(2) === 0,
+      price: random(100000) / 100,
+      tags: [words[random(words.length)], words[random(words.length)]],
+      owner: random(4) ? {id: random(50), name: sentence(2)} : null,
+      updatedAt: 1409444955000 + random(1000000),
+    });
+  }
+  var state = {
+    version: 3,
+    session: {user: 'user_1', token: 'abcdef0123456789', expires: 3600},
+    items: items,
+    filters: {query: '', sort: 'title', ascending: true, pageSize: 50},
+  };
+
+  var numIter = 200;
+  var length = 0;
+  for (var i = 0; i < numIter; i++) {
+    length += JSON.stringify(state).length;
+  }
+
+  print(length);
+  print('done');
+})();
@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// A large Map used as a cache keyed by strings and objects, and a Set of
+// numbers: inserts, lookups, deletes and iteration.
+(function() {
+  var numIter = 5;
+  var len = 200000;
+  var keys = [];
+  var objs = [];
+  for (var i = 0; i < len; i++) {
+    keys.push('key' + i);
+    objs.push({i: i});
+  }
+
+  var sum = 0;
+  for (var iter = 0; iter < numIter; iter++) {
+    var map = new Map();
+    var set = new Set();
+    for (var i = 0; i < len; i++) {
+      map.set(keys[i], i);
+      map.set(objs[i], i);
+      set.add(i * 3);
+    }
+    for (var i = 0; i < len; i++) {
+      sum += map.get(keys[i]) + map.get(objs[(i * 7) % len]);
+      if (set.has(i)) {
+        sum++;
+      }
+    }
+    for (var i = 0; i < len; i += 2) {
+      map.delete(keys[i]);
+      set.delete(i * 3);
+    }
+    map.forEach(function(v) {
+      sum += v;
+    });
+    for (var v of set) {
+      sum -= v;
+    }
+  }
+  print(sum);
+})();
+print('done');
@@ -22,5 +22,24 @@
     source.indexOf('haaal');
   }
 
+  // Multi-KB haystacks, ASCII and UTF-16, with the match near the end.
+  var filler = 'the quick brown fox jumps over the lazy dog; '.repeat(100);
+  var large = filler + 'needle in a haystack' + filler.slice(0, 50);
+  var largeUTF16 = '\u00e9' + large;
+  var longNeedle = 'needle in a haystack, and some more words to make it long';
+  var numLargeIter = numIter / 20;
+
+  for (var i = 0; i < numLargeIter; i++) {
+    large.indexOf('n');
+    large.indexOf('needle');
+    large.indexOf(longNeedle);
+  }
+
+  for (var i = 0; i < numLargeIter; i++) {
+    largeUTF16.indexOf('n');
+    largeUTF16.indexOf('needle');
+    largeUTF16.indexOf(longNeedle);
+  }
+
   print('done');
 })();
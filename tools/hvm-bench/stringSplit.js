@@ -19,5 +19,16 @@
     s.split(separator);
   }
 
+  // Multi-KB records with separators far apart, ASCII and UTF-16.
+  var record = 'x'.repeat(2000) + '\r\n';
+  var records = record.repeat(20);
+  var recordsUTF16 = '\u00e9' + records;
+  var recordSeparator = USE_REGEXP ? /\r\n/ : '\r\n';
+
+  for (var j = 0; j < numIter / 10; j++) {
+    records.split(recordSeparator);
+    recordsUTF16.split(recordSeparator);
+  }
+
   print('done');
 })();
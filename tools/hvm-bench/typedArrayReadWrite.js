@@ -0,0 +1,47 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// This benchmark tests the speed of typed array element reads and writes, in
+// the style of image and binary decoding loops.
+
+function decode(src, dst) {
+    // Expand 3-byte RGB pixels into 4-byte RGBA pixels.
+    var j = 0;
+    for (var i = 0; i < src.length; i += 3) {
+        dst[j++] = src[i];
+        dst[j++] = src[i + 1];
+        dst[j++] = src[i + 2];
+        dst[j++] = 255;
+    }
+    return j;
+}
+
+function brightness(pixels, weights) {
+    var sum = 0;
+    for (var i = 0; i < pixels.length; i += 4) {
+        sum += pixels[i] * weights[0] + pixels[i + 1] * weights[1] +
+            pixels[i + 2] * weights[2];
+    }
+    return sum;
+}
+
+function run(numTimes) {
+    var src = new Uint8Array(3 * 1024);
+    for (var i = 0; i < src.length; i++) {
+        src[i] = i * 7;
+    }
+    var dst = new Uint8ClampedArray(4 * 1024);
+    var weights = new Float64Array([0.299, 0.587, 0.114]);
+    var total = 0;
+    for (var i = 0; i < numTimes; i++) {
+        total += decode(src, dst);
+        total += brightness(dst, weights);
+    }
+    return Math.round(total);
+}
+
+print(run(1000));
@@ -123,6 +123,11 @@ int main(int argc, char **argv) {
           .withES6Promise(cl::ES6Promise)
           .withES6Proxy(cl::ES6Proxy)
           .withIntl(cl::Intl)
+          .withEnableJIT(cl::EnableJIT || cl::ForceJIT)
+          .withForceJIT(cl::ForceJIT)
+          .withEnableRegexAutomaton(
+              cl::RegexAutomaton || cl::ForceRegexAutomaton)
+          .withForceRegexAutomaton(cl::ForceRegexAutomaton)
           .withTrackIO(cl::TrackBytecodeIO)
           .withEnableHermesInternal(cl::EnableHermesInternal)
           .withEnableHermesInternalTestMethods(
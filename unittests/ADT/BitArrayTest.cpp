@@ -10,6 +10,7 @@
 #include "gtest/gtest.h"
 
 #include <deque>
+#include <thread>
 
 namespace {
 
@@ -137,4 +138,31 @@ TYPED_TEST(BitArrayTest, PrevZeroBit) {
   }
 }
 
+TYPED_TEST(BitArrayTest, AtomicSet) {
+  constexpr size_t N = TypeParam::value;
+  BitArray<N> ba;
+  ba.reset();
+  // Each thread sets every bit congruent to its index, so all threads write
+  // to every word. Any lost update would leave a bit unset.
+  constexpr size_t kNumThreads = 4;
+  size_t numSet[kNumThreads] = {};
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&ba, &numSet, t] {
+      for (size_t idx = t; idx < N; idx += kNumThreads)
+        numSet[t] += ba.atomicSet(idx);
+      // Setting a bit again reports that it was already set.
+      for (size_t idx = t; idx < N; idx += kNumThreads)
+        EXPECT_FALSE(ba.atomicSet(idx));
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  size_t total = 0;
+  for (size_t n : numSet)
+    total += n;
+  EXPECT_EQ(N, total);
+  EXPECT_EQ(N, ba.findNextZeroBitFrom(0));
+}
+
 } // namespace
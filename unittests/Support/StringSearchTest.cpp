@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/StringSearch.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+using namespace hermes;
+
+namespace {
+
+llvh::ArrayRef<char> arrayRef(const std::string &str) {
+  return llvh::ArrayRef<char>(str.data(), str.size());
+}
+
+llvh::ArrayRef<char16_t> arrayRef(const std::u16string &str) {
+  return llvh::ArrayRef<char16_t>(str.data(), str.size());
+}
+
+/// Check searchString against std::string::find for every combination of
+/// ASCII and UTF-16 haystack and needle.
+void expectSameAsFind(const std::string &haystack, const std::string &needle) {
+  size_t expected = haystack.find(needle);
+  std::u16string haystack16(haystack.begin(), haystack.end());
+  std::u16string needle16(needle.begin(), needle.end());
+  for (auto found :
+       {searchString(arrayRef(haystack), arrayRef(needle)),
+        searchString(arrayRef(haystack), arrayRef(needle16)),
+        searchString(arrayRef(haystack16), arrayRef(needle)),
+        searchString(arrayRef(haystack16), arrayRef(needle16))}) {
+    if (expected == std::string::npos) {
+      EXPECT_FALSE(found.hasValue()) << haystack << " / " << needle;
+    } else {
+      ASSERT_TRUE(found.hasValue()) << haystack << " / " << needle;
+      EXPECT_EQ(expected, *found) << haystack << " / " << needle;
+    }
+  }
+}
+
+TEST(StringSearchTest, ShortNeedles) {
+  expectSameAsFind("", "");
+  expectSameAsFind("abc", "");
+  expectSameAsFind("", "a");
+  expectSameAsFind("a", "a");
+  expectSameAsFind("abc", "c");
+  expectSameAsFind("abc", "d");
+  expectSameAsFind("abc", "abcd");
+  expectSameAsFind("abcabd", "abd");
+  expectSameAsFind("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab", "aab");
+  expectSameAsFind("abababababababababababababababababababac", "abac");
+}
+
+TEST(StringSearchTest, EveryPosition) {
+  // Place the needle at every offset within a haystack longer than any vector
+  // block, with near misses before it.
+  const std::string needle = "xyzzy";
+  for (size_t pos = 0; pos < 100; ++pos) {
+    std::string haystack(100 + needle.size(), 'x');
+    for (size_t i = 0; i + 3 < pos; i += 7)
+      haystack.replace(i, 4, "xyzy");
+    haystack.replace(pos, needle.size(), needle);
+    expectSameAsFind(haystack, needle);
+  }
+}
+
+TEST(StringSearchTest, LongNeedles) {
+  std::string needle;
+  for (unsigned i = 0; i < 40; ++i)
+    needle.push_back('a' + i % 7);
+  for (size_t pos = 0; pos < 200; pos += 13) {
+    std::string haystack(300, 'a');
+    for (size_t i = 0; i < haystack.size(); ++i)
+      haystack[i] = 'a' + (i * 5) % 7;
+    haystack.replace(pos, needle.size(), needle);
+    expectSameAsFind(haystack, needle);
+    // Also search for a needle that only differs in its first character.
+    std::string miss = needle;
+    miss[0] = 'z';
+    expectSameAsFind(haystack, miss);
+  }
+}
+
+TEST(StringSearchTest, NonASCII) {
+  const std::u16string haystack(u"abc\u1234def\u1234\u5678");
+  const std::u16string needle1(u"\u1234");
+  const std::u16string needle2(u"\u1234\u5678");
+  EXPECT_EQ(3u, *searchString(arrayRef(haystack), arrayRef(needle1)));
+  EXPECT_EQ(7u, *searchString(arrayRef(haystack), arrayRef(needle2)));
+
+  // Code units that only share their low byte must not match.
+  const std::u16string lowByteOnly(u"\u1334");
+  EXPECT_FALSE(
+      searchString(arrayRef(haystack), arrayRef(lowByteOnly)).hasValue());
+
+  // An ASCII haystack never contains a non-ASCII needle, even if the low byte
+  // of the needle is there.
+  const std::string asciiHaystack("abc4");
+  EXPECT_FALSE(
+      searchString(arrayRef(asciiHaystack), arrayRef(needle1)).hasValue());
+
+  // Long UTF-16 needles whose code units only share their low byte with the
+  // haystack.
+  std::u16string longHaystack(200, u'\u0141');
+  std::u16string longNeedle(40, u'\u0141');
+  longNeedle.back() = u'\u0241';
+  EXPECT_FALSE(
+      searchString(arrayRef(longHaystack), arrayRef(longNeedle)).hasValue());
+  longHaystack.replace(100, longNeedle.size(), longNeedle);
+  EXPECT_EQ(
+      100u, *searchString(arrayRef(longHaystack), arrayRef(longNeedle)));
+}
+
+} // end anonymous namespace
@@ -206,6 +206,36 @@ TEST(UTF16StreamTest, UTF8InputTest) {
   }
 }
 
+TEST(UTF16StreamTest, AvailableTest) {
+  // ASCII runs of every length up to a few words, separated by a non-ASCII
+  // character, read back in bulk.
+  std::vector<uint8_t> str8;
+  std::vector<char16_t> expected;
+  for (int len = 0; len < 3000; len = len * 2 + 1) {
+    for (int i = 0; i < len; ++i) {
+      str8.push_back('a' + i % 26);
+      expected.push_back('a' + i % 26);
+    }
+    str8.insert(str8.end(), {0xC3, 0xA9});
+    expected.push_back(0xE9);
+  }
+  UTF16Stream stream(llvh::ArrayRef<uint8_t>(str8.data(), str8.size()));
+  std::vector<char16_t> actual;
+  while (stream.hasChar()) {
+    llvh::ArrayRef<char16_t> chars = stream.available();
+    EXPECT_FALSE(chars.empty());
+    // Consume a prefix in bulk, then one character at a time.
+    size_t count = chars.size() / 2;
+    actual.insert(actual.end(), chars.begin(), chars.begin() + count);
+    stream.skip(count);
+    if (stream.hasChar()) {
+      actual.push_back(*stream);
+      ++stream;
+    }
+  }
+  EXPECT_EQ(expected, actual);
+}
+
 size_t countRemainingCharsInStream(UTF16Stream &&str) {
   size_t size = 0;
   while (str.hasChar()) {
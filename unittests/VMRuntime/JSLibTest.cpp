@@ -972,7 +972,7 @@ TEST_F(JSLibTest, SmallSortTest) {
        "seven",
        "eight",
        "nine"});
-  ASSERT_EQ(ExecutionStatus::RETURNED, quickSort(&sbl, 0, sbl.v.size()));
+  ASSERT_EQ(ExecutionStatus::RETURNED, timSort(&sbl, 0, sbl.v.size()));
   std::vector<std::string> expected = {
       "one",
       "two",
@@ -992,7 +992,7 @@ TEST_F(JSLibTest, SmallSortTest) {
     vs[i] = std::string(i, 'x');
   do {
     StringByLength sm(vs);
-    ASSERT_EQ(ExecutionStatus::RETURNED, quickSort(&sm, 0, vs.size()));
+    ASSERT_EQ(ExecutionStatus::RETURNED, timSort(&sm, 0, vs.size()));
     for (unsigned i = 0; i < vs.size(); ++i)
       EXPECT_EQ(i, sm.v[i].size());
   } while (std::next_permutation(vs.begin(), vs.end()));
@@ -1021,7 +1021,7 @@ TEST_F(JSLibTest, HugeSortTest) {
   for (uint64_t i = 0; i < size; ++i)
     v[i] |= i;
   Uint64ByHigh32 ubh(v);
-  ASSERT_EQ(ExecutionStatus::RETURNED, quickSort(&ubh, 0, ubh.v.size()));
+  ASSERT_EQ(ExecutionStatus::RETURNED, timSort(&ubh, 0, ubh.v.size()));
   for (uint64_t i = 0; i < size; ++i) {
     auto cur = ubh.v[i];
     EXPECT_EQ(i / 10, cur >> 32);
@@ -1045,7 +1045,55 @@ TEST_F(JSLibTest, HugeSortTest) {
     }
   };
   RandomLess rl;
-  ASSERT_EQ(ExecutionStatus::RETURNED, quickSort(&rl, 0, 1000 * 1000));
+  ASSERT_EQ(ExecutionStatus::RETURNED, timSort(&rl, 0, 1000 * 1000));
+}
+
+TEST_F(JSLibTest, TimSortRunsTest) {
+  // Ascending and descending runs of various lengths, with many equivalent
+  // elements. The low 32 bits are the original index, to check stability.
+  std::vector<uint64_t> v;
+  std::mt19937_64 rng;
+  while (v.size() < 100 * 1000) {
+    uint64_t runLen = rng() % 2000 + 1;
+    uint64_t start = rng() % 1000;
+    bool descending = rng() % 2;
+    for (uint64_t i = 0; i < runLen; ++i) {
+      uint64_t key = descending ? start + runLen - i : start + i / 3;
+      v.push_back((key << 32) | v.size());
+    }
+  }
+  auto lessByHigh32 = [](uint64_t a, uint64_t b) -> CallResult<bool> {
+    return (a >> 32) < (b >> 32);
+  };
+  std::vector<uint64_t> sorted = v;
+  ASSERT_EQ(
+      ExecutionStatus::RETURNED,
+      timSort(sorted.data(), sorted.data() + sorted.size(), lessByHigh32));
+  std::vector<uint64_t> expected = v;
+  std::stable_sort(
+      expected.begin(), expected.end(), [](uint64_t a, uint64_t b) {
+        return (a >> 32) < (b >> 32);
+      });
+  EXPECT_EQ(expected, sorted);
+
+  // A failing comparison stops the sort, and leaves a permutation of the
+  // original elements.
+  for (unsigned failAfter : {10u, 1000u, 100000u}) {
+    sorted = v;
+    unsigned count = 0;
+    auto failingLess = [&](uint64_t a, uint64_t b) -> CallResult<bool> {
+      if (++count == failAfter)
+        return ExecutionStatus::EXCEPTION;
+      return (a >> 32) < (b >> 32);
+    };
+    ASSERT_EQ(
+        ExecutionStatus::EXCEPTION,
+        timSort(sorted.data(), sorted.data() + sorted.size(), failingLess));
+    std::sort(sorted.begin(), sorted.end(), [](uint64_t a, uint64_t b) {
+      return (a & 0xffffffff) < (b & 0xffffffff);
+    });
+    EXPECT_EQ(v, sorted);
+  }
 }
 
 class JSLibMockedEnvironmentTest : public RuntimeTestFixtureBase {
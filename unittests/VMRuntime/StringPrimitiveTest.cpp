@@ -328,4 +328,152 @@ TEST_F(StringPrimTest, FastConcatTest) {
   EXPECT_TRUE(utf16Ref.size() == utfStr3.size());
   EXPECT_TRUE(std::equal(utfStr3.begin(), utfStr3.end(), utf16Ref.begin()));
 }
+
+TEST_F(StringPrimTest, RopeConcatTest) {
+  CallResult<HermesValue> cr{ExecutionStatus::EXCEPTION};
+  std::string bigStrA(300, 'a');
+  std::string strB("small");
+
+  //=======================================
+  // A long right operand creates a rope instead of copying it.
+  auto a = StringPrimitive::createNoThrow(runtime, bigStrA);
+  auto b = StringPrimitive::createNoThrow(runtime, strB);
+  cr = StringPrimitive::concat(runtime, b, a);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto rope_1 = runtime.makeHandle<RopeASCIIStringPrimitive>(*cr);
+  EXPECT_FALSE(rope_1->isFlat());
+
+  std::string asciiStr1 = strB + bigStrA;
+  auto asciiRef = rope_1->getStringRef<char>();
+  EXPECT_TRUE(rope_1->isFlat());
+  EXPECT_TRUE(asciiRef.size() == asciiStr1.size());
+  EXPECT_TRUE(std::equal(asciiStr1.begin(), asciiStr1.end(), asciiRef.begin()));
+
+  //=======================================
+  // A flattened rope is appended to like any other flat string.
+  cr = StringPrimitive::concat(runtime, rope_1, b);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  EXPECT_TRUE(vmisa<BufferedASCIIStringPrimitive>(*cr));
+
+  //=======================================
+  // Short strings appended to an unflattened rope extend the rope.
+  cr = StringPrimitive::concat(runtime, b, a);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto rope_2 = runtime.makeHandle<StringPrimitive>(*cr);
+  cr = StringPrimitive::concat(runtime, rope_2, b);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto rope_3 = runtime.makeHandle<RopeASCIIStringPrimitive>(*cr);
+  EXPECT_EQ(2u, RopeASCIIStringPrimitive::depthOf(*rope_3));
+  EXPECT_TRUE(
+      StringPrimitive::createStringView(runtime, rope_3)
+          .equals(ASCIIRef((asciiStr1 + strB).data(), asciiStr1.size() + 5)));
+  EXPECT_TRUE(rope_3->isFlat());
+  EXPECT_EQ(0u, RopeASCIIStringPrimitive::depthOf(*rope_3));
+
+  //=======================================
+  // Mixing in UTF16 creates a UTF16 rope.
+  std::u16string strC(u"utf16\u1234");
+  auto c = StringPrimitive::createNoThrow(
+      runtime, UTF16Ref(strC.data(), strC.size()));
+  cr = StringPrimitive::concat(runtime, c, a);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto rope_4 = runtime.makeHandle<RopeUTF16StringPrimitive>(*cr);
+
+  std::u16string utfStr1 = strC;
+  utfStr1.append(bigStrA.begin(), bigStrA.end());
+  auto utf16Ref = rope_4->getStringRef<char16_t>();
+  EXPECT_TRUE(utf16Ref.size() == utfStr1.size());
+  EXPECT_TRUE(std::equal(utfStr1.begin(), utfStr1.end(), utf16Ref.begin()));
+
+  //=======================================
+  // Deep ropes built by prepending can be flattened.
+  const unsigned kNumPrepends = 10000;
+  MutableHandle<StringPrimitive> deep{runtime, *a};
+  {
+    GCScopeMarkerRAII marker{runtime};
+    for (unsigned i = 0; i < kNumPrepends; ++i) {
+      cr = StringPrimitive::concat(runtime, b, deep);
+      ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+      deep = vmcast<StringPrimitive>(*cr);
+      marker.flush();
+    }
+  }
+  EXPECT_EQ(kNumPrepends, RopeASCIIStringPrimitive::depthOf(*deep));
+  EXPECT_EQ(
+      kNumPrepends * strB.size() + bigStrA.size(), deep->getStringLength());
+  StringPrimitive::ensureFlat(runtime, deep);
+  EXPECT_TRUE(deep->isFlat());
+  asciiRef = deep->getStringRef<char>();
+  EXPECT_EQ('s', asciiRef.front());
+  EXPECT_EQ('a', asciiRef.back());
+}
+
+TEST_F(StringPrimTest, SliceTest) {
+  CallResult<HermesValue> cr{ExecutionStatus::EXCEPTION};
+  std::string strA;
+  for (unsigned i = 0; i < 100; ++i)
+    strA.push_back('a' + i % 26);
+  auto a = StringPrimitive::createNoThrow(runtime, strA);
+
+  //=======================================
+  // Short slices are copied.
+  cr = StringPrimitive::slice(runtime, a, 3, 10);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  EXPECT_TRUE(vmisa<DynamicASCIIStringPrimitive>(*cr));
+  EXPECT_TRUE(vmcast<StringPrimitive>(*cr)->getStringRef<char>().equals(
+      ASCIIRef(strA.data() + 3, 10)));
+
+  //=======================================
+  // Long slices share the characters of their parent.
+  cr = StringPrimitive::slice(runtime, a, 10, 80);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto slice_1 = runtime.makeHandle<SlicedASCIIStringPrimitive>(*cr);
+  EXPECT_EQ(*a, slice_1->getParent());
+  EXPECT_EQ(
+      a->getStringRef<char>().data() + 10,
+      slice_1->getStringRef<char>().data());
+  EXPECT_TRUE(slice_1->getStringRef<char>().equals(
+      ASCIIRef(strA.data() + 10, 80)));
+
+  //=======================================
+  // Slices of slices share the original parent.
+  cr = StringPrimitive::slice(runtime, slice_1, 5, 40);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto slice_2 = runtime.makeHandle<SlicedASCIIStringPrimitive>(*cr);
+  EXPECT_EQ(*a, slice_2->getParent());
+  EXPECT_EQ(15u, slice_2->getOffset());
+  EXPECT_TRUE(slice_2->getStringRef<char>().equals(
+      ASCIIRef(strA.data() + 15, 40)));
+
+  //=======================================
+  // Slices of UTF16 strings are UTF16.
+  std::u16string strB(u"\u1234");
+  strB.append(strA.begin(), strA.end());
+  auto b = StringPrimitive::createNoThrow(
+      runtime, UTF16Ref(strB.data(), strB.size()));
+  cr = StringPrimitive::slice(runtime, b, 0, 50);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto slice_3 = runtime.makeHandle<SlicedUTF16StringPrimitive>(*cr);
+  EXPECT_TRUE(slice_3->getStringRef<char16_t>().equals(
+      UTF16Ref(strB.data(), 50)));
+
+  //=======================================
+  // Slices survive their parent moving.
+  runtime.collect("test");
+  EXPECT_TRUE(slice_2->getStringRef<char>().equals(
+      ASCIIRef(strA.data() + 15, 40)));
+  EXPECT_TRUE(slice_3->getStringRef<char16_t>().equals(
+      UTF16Ref(strB.data(), 50)));
+
+  //=======================================
+  // Small slices of huge strings are copied.
+  std::string strC(StringPrimitive::SLICED_STRING_HUGE_PARENT_SIZE, 'c');
+  auto c = StringPrimitive::createNoThrow(runtime, strC);
+  cr = StringPrimitive::slice(runtime, c, 0, 100);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  EXPECT_FALSE(vmisa<SlicedASCIIStringPrimitive>(*cr));
+  cr = StringPrimitive::slice(runtime, c, 0, strC.size() / 2);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  EXPECT_TRUE(vmisa<SlicedASCIIStringPrimitive>(*cr));
+}
 } // namespace